@@ -26,7 +26,10 @@
 #include <stack>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <set>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -84,8 +87,119 @@ DocumentObject::DocumentObject()
     Visibility.setStatus(Property::NoModify, true);
 }
 
+namespace
+{
+// Results of DocumentObject::getCachedSubObject(). An entry is dropped as soon as one of the
+// objects it depends on is changed or destroyed.
+class SubObjectCache
+{
+public:
+    struct Entry
+    {
+        DocumentObject* object = nullptr;
+        // the transformation accumulated along the path, the caller's matrix is multiplied
+        // from the left
+        Base::Matrix4D matrix;
+        std::vector<const DocumentObject*> depends;
+    };
+
+    SubObjectCache() = default;
+    SubObjectCache(const SubObjectCache&) = delete;
+    SubObjectCache(SubObjectCache&&) = delete;
+    SubObjectCache& operator=(const SubObjectCache&) = delete;
+    SubObjectCache& operator=(SubObjectCache&&) = delete;
+    ~SubObjectCache()
+    {
+        destroyed = true;
+    }
+
+    // Objects that are destroyed after the cache during the static destruction get nullptr
+    static SubObjectCache* instance()
+    {
+        static SubObjectCache cache;
+        return destroyed ? nullptr : &cache;
+    }
+
+    static void invalidateObject(const DocumentObject* obj)
+    {
+        if (auto cache = instance()) {
+            cache->invalidate(obj);
+        }
+    }
+
+    bool find(const DocumentObject* obj, const char* subname, bool transform, Entry& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(Key(obj, transform, subname));
+        if (it == entries.end()) {
+            return false;
+        }
+        entry = it->second;
+        return true;
+    }
+
+    void add(const DocumentObject* obj, const char* subname, bool transform, const Entry& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (entries.size() >= maxEntries || dependCount >= 4 * maxEntries) {
+            entries.clear();
+            dependents.clear();
+            dependCount = 0;
+        }
+
+        Key key(obj, transform, subname);
+        entries[key] = entry;
+        for (auto dep : entry.depends) {
+            dependents[dep].push_back(key);
+            ++dependCount;
+        }
+    }
+
+    void invalidate(const DocumentObject* obj)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = dependents.find(obj);
+        if (it == dependents.end()) {
+            return;
+        }
+        // the keys may be outdated, which only drops an entry too often
+        for (const auto& key : it->second) {
+            entries.erase(key);
+        }
+        dependCount -= it->second.size();
+        dependents.erase(it);
+    }
+
+private:
+    using Key = std::tuple<const DocumentObject*, bool, std::string>;
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            std::size_t hash = std::hash<std::string> {}(std::get<2>(key));
+            hash ^= std::hash<const void*> {}(std::get<0>(key)) + 0x9e3779b9 + (hash << 6)
+                + (hash >> 2);
+            return hash ^ static_cast<std::size_t>(std::get<1>(key));
+        }
+    };
+
+    static constexpr std::size_t maxEntries = 10000;
+    static inline bool destroyed = false;
+
+    std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    std::unordered_map<const DocumentObject*, std::vector<Key>> dependents;
+    std::size_t dependCount = 0;
+};
+
+// The objects that getSubObject() is called for while getCachedSubObject() resolves a path
+thread_local std::vector<const DocumentObject*>* visitedObjects = nullptr;
+}  // namespace
+
 DocumentObject::~DocumentObject()
 {
+    SubObjectCache::invalidateObject(this);
+
     if (!PythonObject.is(Py::_None())) {
         Base::PyGILStateLocker lock;
         // Remark: The API of Py::Object has been changed to set whether the wrapper owns the passed
@@ -862,6 +976,8 @@ void DocumentObject::onEarlyChange(const Property* prop)
 /// get called by the container when a Property was changed
 void DocumentObject::onChanged(const Property* prop)
 {
+    SubObjectCache::invalidateObject(this);
+
     if (prop == &Label && _pDoc && _pDoc->containsObject(this) && oldLabel != Label.getStrValue()) {
         _pDoc->unregisterLabel(oldLabel);
         _pDoc->registerLabel(Label.getStrValue());
@@ -920,6 +1036,7 @@ void DocumentObject::onChanged(const Property* prop)
 
 void DocumentObject::clearOutListCache() const
 {
+    SubObjectCache::invalidateObject(this);
     _outList.clear();
     _outListMap.clear();
     _outListCached = false;
@@ -940,6 +1057,10 @@ DocumentObject* DocumentObject::getSubObject(const char* subname,
                                              bool transform,
                                              int depth) const
 {
+    if (visitedObjects) {
+        visitedObjects->push_back(this);
+    }
+
     DocumentObject* ret = nullptr;
     auto exts = getExtensionsDerivedFromType<App::DocumentObjectExtension>();
     for (auto ext : exts) {
@@ -993,6 +1114,75 @@ DocumentObject* DocumentObject::getSubObject(const char* subname,
     return ret;
 }
 
+DocumentObject* DocumentObject::getCachedSubObject(const char* subname,
+                                                   Base::Matrix4D* mat,
+                                                   bool transform) const
+{
+    std::size_t len = subname ? strlen(subname) : 0;
+    if (len == 0 || subname[len - 1] != '.' || !isAttachedToDocument()) {
+        return getSubObject(subname, nullptr, mat, transform);
+    }
+
+    auto cache = SubObjectCache::instance();
+    if (!cache) {
+        return getSubObject(subname, nullptr, mat, transform);
+    }
+
+    SubObjectCache::Entry entry;
+    if (!cache->find(this, subname, transform, entry)) {
+        // The result depends on all objects visited along the path, also inside of links,
+        // and on the objects they link to
+        std::vector<const DocumentObject*> visited {this};
+        auto previous = visitedObjects;
+        visitedObjects = &visited;
+        try {
+            entry.object = getSubObject(subname, nullptr, &entry.matrix, transform);
+            if (entry.object) {
+                visited.push_back(entry.object);
+            }
+            // getLinkedObject() returns the object itself at the end of the chain
+            for (std::size_t i = 0; i < visited.size(); i++) {
+                auto linked = visited[i]->getLinkedObject(false);
+                if (linked && std::ranges::find(visited, linked) == visited.end()) {
+                    visited.push_back(linked);
+                }
+            }
+        }
+        catch (...) {
+            visitedObjects = previous;
+            throw;
+        }
+        visitedObjects = previous;
+        if (previous) {
+            previous->insert(previous->end(), visited.begin(), visited.end());
+        }
+
+        if (!entry.object) {
+            return nullptr;
+        }
+
+        for (auto obj : visited) {
+            if (std::ranges::find(entry.depends, obj) == entry.depends.end()) {
+                // Python objects may resolve their sub-objects in any way
+                if (obj->getPropertyByName("Proxy")) {
+                    return getSubObject(subname, nullptr, mat, transform);
+                }
+                entry.depends.push_back(obj);
+            }
+        }
+        cache->add(this, subname, transform, entry);
+    }
+    else if (visitedObjects) {
+        // an enclosing lookup also depends on the objects of this path
+        visitedObjects->insert(visitedObjects->end(), entry.depends.begin(), entry.depends.end());
+    }
+
+    if (mat) {
+        *mat *= entry.matrix;
+    }
+    return entry.object;
+}
+
 namespace
 {
 std::vector<DocumentObject*>
@@ -1067,7 +1257,7 @@ std::vector<DocumentObject*> DocumentObject::getSubObjectList(const char* subnam
     for (auto pos = sub.find('.'); pos != std::string::npos; pos = sub.find('.', pos + 1)) {
         char subTail = sub[pos + 1];
         sub[pos + 1] = '\0';
-        auto sobj = getSubObject(sub.c_str());
+        auto sobj = getCachedSubObject(sub.c_str());
         if (!sobj || !sobj->isAttachedToDocument()) {
             continue;
         }
@@ -1361,7 +1551,13 @@ DocumentObject* DocumentObject::resolve(const char* subname,
         *subElement = nullptr;
     }
 
-    auto obj = getSubObject(subname, pyObj, pmat, transform, depth);
+    DocumentObject* obj = nullptr;
+    if (!pyObj && depth == 0) {
+        obj = getCachedSubObject(subname, pmat, transform);
+    }
+    else {
+        obj = getSubObject(subname, pyObj, pmat, transform, depth);
+    }
     if (!obj || !subname || *subname == 0) {
         return self;
     }
@@ -1410,7 +1606,7 @@ DocumentObject* DocumentObject::resolve(const char* subname,
             if (dot == subname) {
                 break;
             }
-            auto sobj = getSubObject(std::string(subname, dot - subname + 1).c_str());
+            auto sobj = getCachedSubObject(std::string(subname, dot - subname + 1).c_str());
             if (sobj != obj) {
                 if (parent) {
                     // Link/LinkGroup has special visibility handling of plain
@@ -1423,7 +1619,8 @@ DocumentObject* DocumentObject::resolve(const char* subname,
                         if (*ddot != '.') {
                             continue;
                         }
-                        auto sobj = getSubObject(std::string(subname, ddot - subname + 1).c_str());
+                        auto sobj =
+                            getCachedSubObject(std::string(subname, ddot - subname + 1).c_str());
                         if (!sobj->hasExtension(GroupExtension::getExtensionClassTypeId(), false)) {
                             *parent = sobj;
                             break;
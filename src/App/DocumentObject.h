@@ -451,6 +451,15 @@ public:
                                                   std::vector<int>* subsizes = nullptr,
                                                   bool flatten = false) const;
 
+    /** Same as getSubObject() without returning a Python object, but the result is cached
+     *
+     * Only subnames of objects, i.e. ending with a '.', are cached. The result is kept until
+     * one of the objects along the path or one of the objects they link to is changed.
+     */
+    DocumentObject* getCachedSubObject(const char* subname,
+                                       Base::Matrix4D* mat = nullptr,
+                                       bool transform = true) const;
+
     /// reason of calling getSubObjects()
     enum GSReason
     {
@@ -154,7 +154,7 @@ DocumentObject* GeoFeature::resolveElement(const DocumentObject* obj,
     if (_element) {
         *_element = element;
     }
-    auto sobj = obj->getSubObject(std::string(subname, element).c_str());
+    auto sobj = obj->getCachedSubObject(std::string(subname, element).c_str());
     if (!sobj) {
         return nullptr;
     }
@@ -22,6 +22,8 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <vector>
+
 #include <Base/MatrixPy.h>
 #include <Base/PlacementPy.h>
 #include <Base/Reader.h>
@@ -46,6 +48,28 @@ using namespace App;
 using namespace Base;
 using namespace std;
 
+namespace
+{
+// The list properties store their values as contiguous arrays of numbers, so they can be
+// written and read in blocks
+template<typename T>
+void appendVector(std::vector<T>& block, const Base::Vector3d& vec)
+{
+    block.insert(block.end(), {T(vec.x), T(vec.y), T(vec.z)});
+}
+
+template<typename T>
+void appendPlacement(std::vector<T>& block, const Base::Placement& plm)
+{
+    const Base::Vector3d& pos = plm.getPosition();
+    const Base::Rotation& rot = plm.getRotation();
+    block.insert(
+        block.end(),
+        {T(pos.x), T(pos.y), T(pos.z), T(rot[0]), T(rot[1]), T(rot[2]), T(rot[3])}
+    );
+}
+}  // namespace
+
 
 //**************************************************************************
 //**************************************************************************
@@ -333,17 +357,10 @@ void PropertyVectorList::SaveDocFile(Base::Writer& writer) const
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
     if (!isSinglePrecision()) {
-        for (const auto& it : _lValueList) {
-            str << it.x << it.y << it.z;
-        }
+        str.writeBlocks<double>(_lValueList.begin(), _lValueList.end(), appendVector<double>);
     }
     else {
-        for (const auto& it : _lValueList) {
-            float x = (float)it.x;
-            float y = (float)it.y;
-            float z = (float)it.z;
-            str << x << y << z;
-        }
+        str.writeBlocks<float>(_lValueList.begin(), _lValueList.end(), appendVector<float>);
     }
 }
 
@@ -353,17 +370,14 @@ void PropertyVectorList::RestoreDocFile(Base::Reader& reader)
     uint32_t uCt = 0;
     str >> uCt;
     std::vector<Base::Vector3d> values(uCt);
+    auto assign = [&values](std::size_t index, const auto* it) {
+        values[index].Set(it[0], it[1], it[2]);
+    };
     if (!isSinglePrecision()) {
-        for (auto& it : values) {
-            str >> it.x >> it.y >> it.z;
-        }
+        str.readBlocks<double>(values.size(), 3, assign);
     }
     else {
-        Base::Vector3f vec;
-        for (auto& it : values) {
-            str >> vec.x >> vec.y >> vec.z;
-            it.Set(vec.x, vec.y, vec.z);
-        }
+        str.readBlocks<float>(values.size(), 3, assign);
     }
     setValues(values);
 }
@@ -960,23 +974,10 @@ void PropertyPlacementList::SaveDocFile(Base::Writer& writer) const
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
     if (!isSinglePrecision()) {
-        for (const auto& it : _lValueList) {
-            str << it.getPosition().x << it.getPosition().y << it.getPosition().z
-                << it.getRotation()[0] << it.getRotation()[1] << it.getRotation()[2]
-                << it.getRotation()[3];
-        }
+        str.writeBlocks<double>(_lValueList.begin(), _lValueList.end(), appendPlacement<double>);
     }
     else {
-        for (const auto& it : _lValueList) {
-            float x = (float)it.getPosition().x;
-            float y = (float)it.getPosition().y;
-            float z = (float)it.getPosition().z;
-            float q0 = (float)it.getRotation()[0];
-            float q1 = (float)it.getRotation()[1];
-            float q2 = (float)it.getRotation()[2];
-            float q3 = (float)it.getRotation()[3];
-            str << x << y << z << q0 << q1 << q2 << q3;
-        }
+        str.writeBlocks<float>(_lValueList.begin(), _lValueList.end(), appendPlacement<float>);
     }
 }
 
@@ -985,27 +986,17 @@ void PropertyPlacementList::RestoreDocFile(Base::Reader& reader)
     Base::InputStream str(reader);
     uint32_t uCt = 0;
     str >> uCt;
+    // position and quaternion of each placement
     std::vector<Base::Placement> values(uCt);
+    auto assign = [&values](std::size_t index, const auto* it) {
+        values[index].setPosition(Base::Vector3d(it[0], it[1], it[2]));
+        values[index].setRotation(Base::Rotation(it[3], it[4], it[5], it[6]));
+    };
     if (!isSinglePrecision()) {
-        for (auto& it : values) {
-            Base::Vector3d pos;
-            double q0, q1, q2, q3;
-            str >> pos.x >> pos.y >> pos.z >> q0 >> q1 >> q2 >> q3;
-            Base::Rotation rot(q0, q1, q2, q3);
-            it.setPosition(pos);
-            it.setRotation(rot);
-        }
+        str.readBlocks<double>(values.size(), 7, assign);
     }
     else {
-        float x {}, y {}, z {};
-        float q0 {}, q1 {}, q2 {}, q3 {};
-        for (auto& it : values) {
-            str >> x >> y >> z >> q0 >> q1 >> q2 >> q3;
-            Base::Vector3d pos(x, y, z);
-            Base::Rotation rot(q0, q1, q2, q3);
-            it.setPosition(pos);
-            it.setRotation(rot);
-        }
+        str.readBlocks<float>(values.size(), 7, assign);
     }
     setValues(values);
 }
@@ -1368,15 +1368,13 @@ void PropertyFloatList::SaveDocFile(Base::Writer& writer) const
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
     if (!isSinglePrecision()) {
-        for (double it : _lValueList) {
-            str << it;
-        }
+        str.write(_lValueList.data(), _lValueList.size());
     }
     else {
-        for (double it : _lValueList) {
-            float v = static_cast<float>(it);
-            str << v;
-        }
+        auto append = [](std::vector<float>& block, double value) {
+            block.push_back(static_cast<float>(value));
+        };
+        str.writeBlocks<float>(_lValueList.begin(), _lValueList.end(), append);
     }
 }
 
@@ -1387,16 +1385,12 @@ void PropertyFloatList::RestoreDocFile(Base::Reader& reader)
     str >> uCt;
     std::vector<double> values(uCt);
     if (!isSinglePrecision()) {
-        for (double& it : values) {
-            str >> it;
-        }
+        str.read(values.data(), values.size());
     }
     else {
-        for (double& it : values) {
-            float val;
-            str >> val;
-            it = val;
-        }
+        str.readBlocks<float>(values.size(), 1, [&values](std::size_t index, const float* it) {
+            values[index] = *it;
+        });
     }
     setValues(values);
 }
@@ -2486,9 +2480,10 @@ void PropertyColorList::SaveDocFile(Base::Writer& writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (auto it : _lValueList) {
-        str << it.getPackedValue();
-    }
+    auto append = [](std::vector<uint32_t>& block, const Base::Color& color) {
+        block.push_back(color.getPackedValue());
+    };
+    str.writeBlocks<uint32_t>(_lValueList.begin(), _lValueList.end(), append);
 }
 
 void PropertyColorList::RestoreDocFile(Base::Reader& reader)
@@ -2497,11 +2492,10 @@ void PropertyColorList::RestoreDocFile(Base::Reader& reader)
     uint32_t uCt = 0;
     str >> uCt;
     std::vector<Base::Color> values(uCt);
-    uint32_t value;  // must be 32 bit long
-    for (auto& it : values) {
-        str >> value;
-        it.setPackedValue(value);
-    }
+    // the packed values must be 32 bit long
+    str.readBlocks<uint32_t>(values.size(), 1, [&values](std::size_t index, const uint32_t* it) {
+        values[index].setPackedValue(*it);
+    });
     if (requiresAlphaConversion) {
         for (auto& it : values) {
             it.a = 1.0F - it.a;
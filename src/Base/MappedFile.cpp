@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 51 Franklin Street,      *
+ *   Fifth Floor, Boston, MA  02110-1301, USA                              *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include <FCConfig.h>
+
+#include <algorithm>
+#include <utility>
+#ifdef FC_OS_WIN32
+# include <Windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+#include "Exception.h"
+#include "FileInfo.h"
+
+using namespace Base;
+
+
+MappedFile::MappedFile(const std::string& fileName)
+{
+    open(fileName);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mapped(std::exchange(other.mapped, nullptr))
+    , length(std::exchange(other.length, 0))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        mapped = std::exchange(other.mapped, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
+
+#ifdef FC_OS_WIN32
+void MappedFile::open(const std::string& fileName)
+{
+    close();
+
+    FileInfo fi(fileName);
+    HANDLE file = CreateFileW(
+        fi.toStdWString().c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        throw FileException("Cannot open file", fileName);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw FileException("Cannot determine file size", fileName);
+    }
+
+    // an empty file cannot be mapped
+    if (fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        throw FileException("Cannot map file", fileName);
+    }
+
+    // the view keeps the mapping alive
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        throw FileException("Cannot map file", fileName);
+    }
+
+    mapped = static_cast<const char*>(view);
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+}
+
+void MappedFile::close()
+{
+    if (mapped) {
+        UnmapViewOfFile(mapped);
+    }
+    mapped = nullptr;
+    length = 0;
+}
+#else
+void MappedFile::open(const std::string& fileName)
+{
+    close();
+
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw FileException("Cannot open file", fileName);
+    }
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw FileException("Cannot determine file size", fileName);
+    }
+
+    // an empty file cannot be mapped
+    if (st.st_size == 0) {
+        ::close(fd);
+        return;
+    }
+
+    // the mapping stays valid after closing the file descriptor
+    void* view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        throw FileException("Cannot map file", fileName);
+    }
+
+    madvise(view, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+    mapped = static_cast<const char*>(view);
+    length = static_cast<std::size_t>(st.st_size);
+}
+
+void MappedFile::close()
+{
+    if (mapped) {
+        munmap(const_cast<char*>(mapped), length);  // NOLINT
+    }
+    mapped = nullptr;
+    length = 0;
+}
+#endif
+
+std::vector<std::string_view> Base::splitAtLines(std::string_view data, std::size_t chunkSize)
+{
+    std::vector<std::string_view> chunks;
+    chunkSize = std::max<std::size_t>(chunkSize, 1);
+
+    std::size_t start = 0;
+    while (start < data.size()) {
+        std::size_t end = start + chunkSize;
+        if (end >= data.size()) {
+            end = data.size();
+        }
+        else {
+            std::size_t eol = data.find('\n', end - 1);
+            end = eol == std::string_view::npos ? data.size() : eol + 1;
+        }
+
+        chunks.push_back(data.substr(start, end - start));
+        start = end;
+    }
+
+    return chunks;
+}
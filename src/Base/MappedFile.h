@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 51 Franklin Street,      *
+ *   Fifth Floor, Boston, MA  02110-1301, USA                              *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef BASE_MAPPEDFILE_H
+#define BASE_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <FCGlobal.h>
+
+
+namespace Base
+{
+
+/** Read-only memory mapping of a file
+ * The content of the file is accessible as one contiguous block of memory without
+ * copying it into a buffer first. The pages are loaded on demand by the operating
+ * system which makes it suitable for parsing large files, also from several threads.
+ * The file name is expected to be UTF-8 encoded.
+ */
+class BaseExport MappedFile
+{
+public:
+    MappedFile() = default;
+    /// Maps the given file, throws a FileException on failure
+    explicit MappedFile(const std::string& fileName);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// Maps the given file, throws a FileException on failure
+    void open(const std::string& fileName);
+    /// Unmaps the file
+    void close();
+
+    bool isOpen() const
+    {
+        return mapped != nullptr;
+    }
+    const char* data() const
+    {
+        return mapped;
+    }
+    std::size_t size() const
+    {
+        return length;
+    }
+    std::string_view view() const
+    {
+        return {mapped, length};
+    }
+
+private:
+    const char* mapped = nullptr;
+    std::size_t length = 0;
+};
+
+/** Splits \a data into consecutive chunks of roughly \a chunkSize bytes.
+ * Each chunk except the last one ends right after a line feed, so that no line is
+ * split between two chunks. The chunks can then be parsed independently.
+ */
+BaseExport std::vector<std::string_view> splitAtLines(std::string_view data, std::size_t chunkSize);
+
+}  // namespace Base
+
+#endif  // BASE_MAPPEDFILE_H
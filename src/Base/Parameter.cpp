@@ -708,6 +708,7 @@ void ParameterGrp::_SetAttribute(ParamType T, const char* Name, const char* Valu
         // set the value only if different
         if (strcmp(StrX(pcElem->getAttribute(attr.unicodeForm())).c_str(), Value) != 0) {
             pcElem->setAttribute(attr.unicodeForm(), XStr(Value).unicodeForm());
+            _Uncache(T, Name);
             // trigger observer
             _Notify(T, Name, Value);
         }
@@ -717,21 +718,84 @@ void ParameterGrp::_SetAttribute(ParamType T, const char* Name, const char* Valu
     }
 }
 
+namespace
+{
+// Returns the cached value of a parameter or reads it with 'read' if not yet cached
+template<typename Map, typename Func>
+typename Map::mapped_type findCached(Map& cache, const char* Name, Func&& read)
+{
+    // without a name the first parameter of the type is read, which isn't cached
+    if (!Name) {
+        return read();
+    }
+
+    auto it = cache.find(std::string_view(Name));
+    if (it == cache.end()) {
+        it = cache.emplace(Name, read()).first;
+    }
+    return it->second;
+}
+}  // namespace
+
+void ParameterGrp::_Uncache(ParamType Type, const char* Name)
+{
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    auto uncache = [Name](auto& cache) {
+        if (Name) {
+            auto it = cache.find(std::string_view(Name));
+            if (it != cache.end()) {
+                cache.erase(it);
+            }
+        }
+        else {
+            cache.clear();
+        }
+    };
+
+    switch (Type) {
+        case ParamType::FCBool:
+            uncache(_Cache.Bools);
+            break;
+        case ParamType::FCInt:
+            uncache(_Cache.Ints);
+            break;
+        case ParamType::FCUInt:
+            uncache(_Cache.Unsigneds);
+            break;
+        case ParamType::FCFloat:
+            uncache(_Cache.Floats);
+            break;
+        case ParamType::FCText:
+            uncache(_Cache.Strings);
+            break;
+        case ParamType::FCInvalid:
+            _Cache = ValueCache();
+            break;
+        default:
+            break;
+    }
+}
+
 bool ParameterGrp::GetBool(const char* Name, bool bPreset) const
 {
     if (!_pGroupNode) {
         return bPreset;
     }
 
-    // check if Element in group
-    DOMElement* pcElem = FindElement(_pGroupNode, "FCBool", Name);
-    // if not return preset
-    if (!pcElem) {
-        return bPreset;
-    }
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    const auto& value = findCached(_Cache.Bools, Name, [this, Name]() -> std::optional<bool> {
+        // check if Element in group
+        DOMElement* pcElem = FindElement(_pGroupNode, "FCBool", Name);
+        if (!pcElem) {
+            return std::nullopt;
+        }
+
+        StrX value(pcElem->getAttribute(XStrLiteral("Value").unicodeForm()));
+        return strcmp(value.c_str(), "1") == 0;
+    });
 
-    // if yes check the value and return
-    return (strcmp(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str(), "1") == 0);
+    // if not in group return preset
+    return value.value_or(bPreset);
 }
 
 void ParameterGrp::SetBool(const char* Name, bool bValue)
@@ -801,14 +865,19 @@ long ParameterGrp::GetInt(const char* Name, long lPreset) const
         return lPreset;
     }
 
-    // check if Element in group
-    DOMElement* pcElem = FindElement(_pGroupNode, "FCInt", Name);
-    // if not return preset
-    if (!pcElem) {
-        return lPreset;
-    }
-    // if yes check the value and return
-    return atol(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str());
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    const auto& value = findCached(_Cache.Ints, Name, [this, Name]() -> std::optional<long> {
+        // check if Element in group
+        DOMElement* pcElem = FindElement(_pGroupNode, "FCInt", Name);
+        if (!pcElem) {
+            return std::nullopt;
+        }
+
+        return atol(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str());
+    });
+
+    // if not in group return preset
+    return value.value_or(lPreset);
 }
 
 void ParameterGrp::SetInt(const char* Name, long lValue)
@@ -872,16 +941,28 @@ unsigned long ParameterGrp::GetUnsigned(const char* Name, unsigned long lPreset)
         return lPreset;
     }
 
-    // check if Element in group
-    DOMElement* pcElem = FindElement(_pGroupNode, "FCUInt", Name);
-    // if not return preset
-    if (!pcElem) {
-        return lPreset;
-    }
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    const auto& value = findCached(
+        _Cache.Unsigneds,
+        Name,
+        [this, Name]() -> std::optional<unsigned long> {
+            // check if Element in group
+            DOMElement* pcElem = FindElement(_pGroupNode, "FCUInt", Name);
+            if (!pcElem) {
+                return std::nullopt;
+            }
 
-    // if yes check the value and return
-    const int base = 10;
-    return strtoul(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str(), nullptr, base);
+            const int base = 10;
+            return strtoul(
+                StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str(),
+                nullptr,
+                base
+            );
+        }
+    );
+
+    // if not in group return preset
+    return value.value_or(lPreset);
 }
 
 void ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
@@ -953,14 +1034,19 @@ double ParameterGrp::GetFloat(const char* Name, double dPreset) const
         return dPreset;
     }
 
-    // check if Element in group
-    DOMElement* pcElem = FindElement(_pGroupNode, "FCFloat", Name);
-    // if not return preset
-    if (!pcElem) {
-        return dPreset;
-    }
-    // if yes check the value and return
-    return atof(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str());
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    const auto& value = findCached(_Cache.Floats, Name, [this, Name]() -> std::optional<double> {
+        // check if Element in group
+        DOMElement* pcElem = FindElement(_pGroupNode, "FCFloat", Name);
+        if (!pcElem) {
+            return std::nullopt;
+        }
+
+        return atof(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str());
+    });
+
+    // if not in group return preset
+    return value.value_or(dPreset);
 }
 
 void ParameterGrp::SetFloat(const char* Name, double dValue)
@@ -1048,12 +1134,14 @@ void ParameterGrp::SetASCII(const char* Name, const char* sValue)
             DOMDocument* pDocument = _pGroupNode->getOwnerDocument();
             DOMText* pText = pDocument->createTextNode(XUTF8Str(sValue).unicodeForm());
             pcElem->appendChild(pText);
+            _Uncache(ParamType::FCText, Name);
             if (isNew || sValue[0] != 0) {
                 _Notify(ParamType::FCText, Name, sValue);
             }
         }
         else if (strcmp(StrXUTF8(pcElem2->getNodeValue()).c_str(), sValue) != 0) {
             pcElem2->setNodeValue(XUTF8Str(sValue).unicodeForm());
+            _Uncache(ParamType::FCText, Name);
             _Notify(ParamType::FCText, Name, sValue);
         }
         // trigger observer
@@ -1067,21 +1155,33 @@ std::string ParameterGrp::GetASCII(const char* Name, const char* pPreset) const
         return pPreset ? pPreset : "";
     }
 
-    // check if Element in group
-    DOMElement* pcElem = FindElement(_pGroupNode, "FCText", Name);
-    // if not return preset
-    if (!pcElem) {
-        if (!pPreset) {
-            return {};
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    const auto& value = findCached(
+        _Cache.Strings,
+        Name,
+        [this, Name]() -> std::optional<std::string> {
+            // check if Element in group
+            DOMElement* pcElem = FindElement(_pGroupNode, "FCText", Name);
+            if (!pcElem) {
+                return std::nullopt;
+            }
+
+            DOMNode* pcElem2 = pcElem->getFirstChild();
+            if (pcElem2) {
+                return std::string(StrXUTF8(pcElem2->getNodeValue()).c_str());
+            }
+            return std::string();
         }
-        return {pPreset};
+    );
+
+    // if not in group return preset
+    if (value) {
+        return *value;
     }
-    // if yes check the value and return
-    DOMNode* pcElem2 = pcElem->getFirstChild();
-    if (pcElem2) {
-        return {StrXUTF8(pcElem2->getNodeValue()).c_str()};
+    if (!pPreset) {
+        return {};
     }
-    return {};
+    return {pPreset};
 }
 
 std::vector<std::string> ParameterGrp::GetASCIIs(const char* sFilter) const
@@ -1163,6 +1263,7 @@ void ParameterGrp::RemoveASCII(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    _Uncache(ParamType::FCText, Name);
 
     // trigger observer
     _Notify(ParamType::FCText, Name, nullptr);
@@ -1184,6 +1285,7 @@ void ParameterGrp::RemoveBool(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    _Uncache(ParamType::FCBool, Name);
 
     // trigger observer
     _Notify(ParamType::FCBool, Name, nullptr);
@@ -1206,6 +1308,7 @@ void ParameterGrp::RemoveFloat(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    _Uncache(ParamType::FCFloat, Name);
 
     // trigger observer
     _Notify(ParamType::FCFloat, Name, nullptr);
@@ -1227,6 +1330,7 @@ void ParameterGrp::RemoveInt(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    _Uncache(ParamType::FCInt, Name);
 
     // trigger observer
     _Notify(ParamType::FCInt, Name, nullptr);
@@ -1248,6 +1352,7 @@ void ParameterGrp::RemoveUnsigned(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    _Uncache(ParamType::FCUInt, Name);
 
     // trigger observer
     _Notify(ParamType::FCUInt, Name, nullptr);
@@ -1414,6 +1519,7 @@ void ParameterGrp::Clear(bool notify)
         DOMNode* node = _pGroupNode->removeChild(child);
         node->release();
     }
+    _Uncache(ParamType::FCInvalid);
 
     for (auto& v : params) {
         _Notify(v.first, v.second.c_str(), nullptr);
@@ -1585,6 +1691,7 @@ void ParameterGrp::NotifyAll()
 void ParameterGrp::_Reset()
 {
     _pGroupNode = nullptr;
+    _Uncache(ParamType::FCInvalid);
     for (auto& v : _GroupMap) {
         v.second->_Reset();
     }
@@ -1922,6 +2029,7 @@ int ParameterManager::LoadDocument(const XERCES_CPP_NAMESPACE::InputSource& inpu
     }
 
     _pGroupNode = FindElement(rootElem, "FCParamGroup", "Root");
+    _Uncache(ParamType::FCInvalid);
 
     if (!_pGroupNode) {
         throw XMLBaseException("Malformed Parameter document: Root group not found");
@@ -2049,6 +2157,7 @@ void ParameterManager::CreateDocument()
     _pGroupNode = _pDocument->createElement(XStrLiteral("FCParamGroup").unicodeForm());
     _pGroupNode->setAttribute(XStrLiteral("Name").unicodeForm(), XStrLiteral("Root").unicodeForm());
     rootElem->appendChild(_pGroupNode);
+    _Uncache(ParamType::FCInvalid);
 }
 
 void ParameterManager::CheckDocument() const
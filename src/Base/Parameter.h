@@ -50,6 +50,10 @@ using PyObject = struct _object;
 #endif
 
 #include <map>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <fastsignals/signal.h>
 #include <xercesc/util/XercesDefs.hpp>
@@ -483,6 +487,12 @@ protected:
         const char* Name
     ) const;
 
+    /** Removes a parameter from the cache of decoded values
+     *  Must be called after the DOM element of the parameter has been changed. If no name is
+     *  given all parameters of the type are removed, for ParamType::FCInvalid all of them.
+     */
+    void _Uncache(ParamType Type, const char* Name = nullptr);
+
     /// DOM Node of the Base node of this group
     XERCES_CPP_NAMESPACE::DOMElement* _pGroupNode;
     /// the own name
@@ -498,6 +508,34 @@ protected:
      * This is used to prevent anynew value/sub-group to be added in observer
      */
     bool _Clearing = false;
+
+    struct CacheHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view str) const
+        {
+            return std::hash<std::string_view> {}(str);
+        }
+    };
+    template<typename T>
+    using CacheMap = std::unordered_map<std::string, std::optional<T>, CacheHash, std::equal_to<>>;
+
+    /** The decoded values of the parameters that have been read
+     *  This avoids searching the DOM and transcoding the strings for each read. A parameter
+     *  that doesn't exist has an empty value.
+     *  The mutex only allows several threads to read parameters at the same time. Like for
+     *  the DOM itself, changing a group while another thread reads it is not supported.
+     */
+    struct ValueCache
+    {
+        CacheMap<bool> Bools;
+        CacheMap<long> Ints;
+        CacheMap<unsigned long> Unsigneds;
+        CacheMap<double> Floats;
+        CacheMap<std::string> Strings;
+    };
+    mutable ValueCache _Cache;
+    mutable std::mutex _CacheMutex;
 };
 
 /** The parameter serializer class
@@ -22,6 +22,10 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
 #include <QBuffer>
 #include <QIODevice>
 #ifdef __GNUC__
@@ -35,6 +39,63 @@
 
 using namespace Base;
 
+namespace
+{
+// The byte swapping is done on unsigned integers with plain shifts because
+// compilers recognize this pattern and vectorize the loops over it
+uint32_t swapBytes(uint32_t v)
+{
+    return ((v & 0x000000FFU) << 24) | ((v & 0x0000FF00U) << 8) | ((v & 0x00FF0000U) >> 8)
+        | ((v & 0xFF000000U) >> 24);
+}
+
+uint64_t swapBytes(uint64_t v)
+{
+    return (uint64_t(swapBytes(uint32_t(v))) << 32) | uint64_t(swapBytes(uint32_t(v >> 32)));
+}
+
+template<typename T>
+void swapArray(T* values, std::size_t count)
+{
+    using Word = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+    static_assert(sizeof(T) == sizeof(Word), "Unsupported type");
+    for (std::size_t i = 0; i < count; i++) {
+        Word word {};
+        std::memcpy(&word, values + i, sizeof(Word));
+        word = swapBytes(word);
+        std::memcpy(values + i, &word, sizeof(Word));
+    }
+}
+
+template<typename T>
+void writeArray(std::ostream& out, const T* values, std::size_t count, bool swap)
+{
+    if (!swap) {
+        out.write(reinterpret_cast<const char*>(values), std::streamsize(count * sizeof(T)));
+        return;
+    }
+
+    // swap a copy of the data in small blocks
+    constexpr std::size_t blockSize = 1024;
+    std::array<T, blockSize> buffer;
+    for (std::size_t pos = 0; pos < count; pos += blockSize) {
+        std::size_t num = std::min(blockSize, count - pos);
+        std::copy_n(values + pos, num, buffer.begin());
+        swapArray(buffer.data(), num);
+        out.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(num * sizeof(T)));
+    }
+}
+
+template<typename T>
+void readArray(std::istream& in, T* values, std::size_t count, bool swap)
+{
+    in.read(reinterpret_cast<char*>(values), std::streamsize(count * sizeof(T)));
+    if (swap) {
+        swapArray(values, count);
+    }
+}
+}  // namespace
+
 Stream::Stream() = default;
 
 Stream::~Stream() = default;
@@ -151,6 +212,24 @@ OutputStream& OutputStream::write(const char* s, int n)
     return *this;
 }
 
+OutputStream& OutputStream::write(const uint32_t* values, std::size_t count)
+{
+    writeArray(_out, values, count, isSwapped());
+    return *this;
+}
+
+OutputStream& OutputStream::write(const float* values, std::size_t count)
+{
+    writeArray(_out, values, count, isSwapped());
+    return *this;
+}
+
+OutputStream& OutputStream::write(const double* values, std::size_t count)
+{
+    writeArray(_out, values, count, isSwapped());
+    return *this;
+}
+
 InputStream::InputStream(std::istream& rin)
     : _in(rin)
 {}
@@ -253,6 +332,24 @@ InputStream& InputStream::read(char* s, int n)
     return *this;
 }
 
+InputStream& InputStream::read(uint32_t* values, std::size_t count)
+{
+    readArray(_in, values, count, isSwapped());
+    return *this;
+}
+
+InputStream& InputStream::read(float* values, std::size_t count)
+{
+    readArray(_in, values, count, isSwapped());
+    return *this;
+}
+
+InputStream& InputStream::read(double* values, std::size_t count)
+{
+    readArray(_in, values, count, isSwapped());
+    return *this;
+}
+
 // ----------------------------------------------------------------------
 
 ByteArrayOStreambuf::ByteArrayOStreambuf(QByteArray& ba)
@@ -30,6 +30,7 @@
 # include <cstdint>
 #endif
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -70,6 +71,9 @@ protected:
         return _swap;
     };
 
+    /// The number of values that writeBlocks() and readBlocks() hold in memory
+    static constexpr std::size_t blockSize = 4096;
+
 private:
     bool _swap {false};
 };
@@ -98,6 +102,35 @@ public:
 
     OutputStream& write(const char* s, int n);
 
+    /** @name Bulk output
+     * Writes \a count values with a single call to the underlying stream. This is much
+     * faster than writing them one by one and gives the same result.
+     */
+    //@{
+    OutputStream& write(const uint32_t* values, std::size_t count);
+    OutputStream& write(const float* values, std::size_t count);
+    OutputStream& write(const double* values, std::size_t count);
+
+    /** Writes the values of the elements in [\a first, \a last) in blocks of a fixed size,
+     * so that no copy of all values is needed. \a append adds the values of one element to
+     * the block.
+     */
+    template<typename T, typename Iter, typename Func>
+    OutputStream& writeBlocks(Iter first, Iter last, Func&& append)
+    {
+        std::vector<T> block;
+        block.reserve(blockSize);
+        for (; first != last; ++first) {
+            append(block, *first);
+            if (block.size() >= blockSize) {
+                write(block.data(), block.size());
+                block.clear();
+            }
+        }
+        return write(block.data(), block.size());
+    }
+    //@}
+
     OutputStream(const OutputStream&) = delete;
     OutputStream(OutputStream&&) = delete;
     void operator=(const OutputStream&) = delete;
@@ -131,6 +164,34 @@ public:
 
     InputStream& read(char* s, int n);
 
+    /** @name Bulk input
+     * Reads \a count values with a single call to the underlying stream into an array
+     * that must have at least this size.
+     */
+    //@{
+    InputStream& read(uint32_t* values, std::size_t count);
+    InputStream& read(float* values, std::size_t count);
+    InputStream& read(double* values, std::size_t count);
+
+    /** Reads \a count elements of \a size values each in blocks of a fixed size. \a assign
+     * gets the index of an element and a pointer to its values.
+     */
+    template<typename T, typename Func>
+    InputStream& readBlocks(std::size_t count, std::size_t size, Func&& assign)
+    {
+        const std::size_t elementsPerBlock = std::max<std::size_t>(blockSize / size, 1);
+        std::vector<T> block(std::min(count, elementsPerBlock) * size);
+        for (std::size_t index = 0; index < count;) {
+            std::size_t num = std::min(count - index, elementsPerBlock);
+            read(block.data(), num * size);
+            for (std::size_t i = 0; i < num; i++, index++) {
+                assign(index, block.data() + i * size);
+            }
+        }
+        return *this;
+    }
+    //@}
+
     explicit operator bool() const
     {
         // test if _Ipfx succeeded
@@ -23,6 +23,7 @@
 
 #include <boost/core/ignore_unused.hpp>
 #include <cmath>
+#include <cstring>
 #include <vector>
 #include <unordered_map>
 
@@ -88,6 +89,7 @@ FC_LOG_LEVEL_INIT("Assembly", true, true, true)
 
 using namespace Assembly;
 using namespace MbD;
+namespace sp = std::placeholders;
 
 
 namespace PartApp = Part;
@@ -137,42 +139,162 @@ App::DocumentObjectExecReturn* AssemblyObject::execute()
     return ret;
 }
 
+void AssemblyObject::onSettingDocument()
+{
+    App::Document* doc = getDocument();
+    if (doc) {
+        connChangedObject = doc->signalChangedObject.connect(
+            std::bind(&AssemblyObject::slotChangedObject, this, sp::_1, sp::_2)
+        );
+        // New objects change the structure only when they are added to a group, which is
+        // handled by slotChangedObject
+        connDeletedObject = doc->signalDeletedObject.connect(
+            std::bind(&AssemblyObject::slotChangedStructure, this, sp::_1)
+        );
+    }
+
+    App::Part::onSettingDocument();
+}
+
+void AssemblyObject::unsetupObject()
+{
+    connChangedObject.disconnect();
+    connDeletedObject.disconnect();
+
+    App::Part::unsetupObject();
+}
+
+void AssemblyObject::invalidateMbdModel()
+{
+    mbdModelValid = false;
+}
+
+void AssemblyObject::invalidateCaches()
+{
+    mbdModelValid = false;
+    jointsCacheValid = false;
+    groundedCacheValid = false;
+}
+
+bool AssemblyObject::isJointPlacementUnchanged(const App::DocumentObject& joint) const
+{
+    auto it = mbdJointPlacements.find(&joint);
+    if (it == mbdJointPlacements.end()) {
+        return false;
+    }
+
+    auto* obj = const_cast<App::DocumentObject*>(&joint);
+    return getPlacementFromProp(obj, "Placement1").isSame(it->second.first)
+        && getPlacementFromProp(obj, "Placement2").isSame(it->second.second);
+}
+
+void AssemblyObject::slotChangedObject(const App::DocumentObject& obj, const App::Property& prop)
+{
+    if (!mbdModelValid && !jointsCacheValid && !groundedCacheValid) {
+        return;
+    }
+
+    const char* name = prop.getName();
+    if (!name) {
+        return;
+    }
+
+    auto* group = App::GroupExtension::getGroupOfObject(&obj);
+    if (group && group->isDerivedFrom<JointGroup>()) {
+        if (!hasObject(group)) {
+            return;
+        }
+        if (strcmp(name, "Visibility") == 0 || strcmp(name, "Label") == 0) {
+            return;
+        }
+        if (strcmp(name, "Placement1") == 0 || strcmp(name, "Placement2") == 0) {
+            // The joint placements are set again whenever the joints are redrawn.
+            if (!isJointPlacementUnchanged(obj)) {
+                invalidateMbdModel();
+            }
+            return;
+        }
+        invalidateCaches();
+        return;
+    }
+
+    // Moving a part doesn't change the model, but relinking or attaching objects may.
+    if (prop.isDerivedFrom<App::PropertyLinkBase>() || strcmp(name, "MapMode") == 0
+        || obj.isDerivedFrom<AssemblyLink>()) {
+        if (isUsedByModel(obj)) {
+            invalidateCaches();
+        }
+    }
+}
+
+void AssemblyObject::slotChangedStructure(const App::DocumentObject& obj)
+{
+    if (isUsedByModel(obj)) {
+        invalidateCaches();
+    }
+}
+
+// Checks if the object is the assembly, one of its parts or joints, or inside one of them
+bool AssemblyObject::isUsedByModel(const App::DocumentObject& obj) const
+{
+    auto* object = const_cast<App::DocumentObject*>(&obj);
+    if (object == this || objectPartMap.contains(object) || mbdGroundedPlacements.contains(object)
+        || mbdJointPlacements.contains(&obj)) {
+        return true;
+    }
+    if (std::ranges::find(cachedJoints, object) != cachedJoints.end()
+        || cachedGroundedParts.contains(object)) {
+        return true;
+    }
+    return hasObject(&obj, true);
+}
+
 int AssemblyObject::solve(bool enableRedo, bool updateJCS)
 {
     lastDoF = numberOfComponents() * 6;
 
     ensureIdentityPlacements();
 
-    mbdAssembly = makeMbdAssembly();
-    objectPartMap.clear();
     motions.clear();
 
-    auto groundedObjs = fixGroundedParts();
+    auto groundedObjs = getGroundedParts();
     if (groundedObjs.empty()) {
         // If no part fixed we can't solve.
         return -6;
     }
 
+    // Updating the joint placements may invalidate the model
     std::vector<App::DocumentObject*> joints = getJoints(updateJCS);
 
-    removeUnconnectedJoints(joints, groundedObjs);
-
-    jointParts(joints);
+    // A bundled model is only needed for dragging but can be kept for the next solves
+    if (!mbdModelValid || (bundleFixed && !mbdModelBundled) || !updateMbdParts()) {
+        buildMbdModel(groundedObjs, joints);
+    }
+    joints = mbdJoints;
 
     if (enableRedo) {
         savePlacementsForUndo();
     }
 
-    try {
-        mbdAssembly->runPreDrag();
+    // Only the components with moved parts need to be solved
+    std::vector<MbdComponent*> dirtyComponents;
+    for (auto& component : mbdComponents) {
+        if (component.dirty) {
+            dirtyComponents.push_back(&component);
+        }
     }
-    catch (const std::exception& e) {
-        FC_ERR("Solve failed: " << e.what());
+
+    std::string error;
+    auto runPreDrag = [](MbdComponent& component) {
+        component.assembly->runPreDrag();
+    };
+    if (!runMbdComponents(dirtyComponents, runPreDrag, error)) {
+        FC_ERR("Solve failed: " << error);
+        mbdModelValid = false;
         return -1;
     }
-    catch (...) {
-        FC_ERR("Solve failed: unhandled exception");
-        return -1;
+    for (auto* component : dirtyComponents) {
+        component->dirty = false;
     }
 
     setNewPlacements();
@@ -184,9 +306,218 @@ int AssemblyObject::solve(bool enableRedo, bool updateJCS)
     return 0;
 }
 
+void AssemblyObject::buildMbdModel(
+    const std::unordered_set<App::DocumentObject*>& groundedObjs,
+    std::vector<App::DocumentObject*> joints
+)
+{
+    removeUnconnectedJoints(joints, groundedObjs);
+    draggedComponents.clear();
+
+    std::vector<std::unordered_set<App::DocumentObject*>> groundedOfComponents;
+    partitionMbdModel(groundedObjs, joints, groundedOfComponents);
+
+    // The helpers that create the MbD objects work on mbdAssembly and objectPartMap
+    std::unordered_map<App::DocumentObject*, MbDPartData> partMap;
+    for (std::size_t i = 0; i < mbdComponents.size(); i++) {
+        MbdComponent& component = mbdComponents[i];
+        mbdAssembly = makeMbdAssembly();
+        objectPartMap.clear();
+
+        for (auto* obj : groundedOfComponents[i]) {
+            Base::Placement plc = getPlacementFromProp(obj, "Placement");
+            std::string str = obj->getFullName();
+            fixGroundedPart(obj, plc, str);
+        }
+
+        jointParts(component.joints);
+
+        component.assembly = mbdAssembly;
+        component.partMap = objectPartMap;
+
+        // Grounded parts and parts bundled with them can be in several components
+        for (auto& [obj, data] : component.partMap) {
+            auto it = mbdComponentOfPart.find(obj);
+            if (it != mbdComponentOfPart.end() && it->second == i) {
+                partMap[obj] = data;
+            }
+            else {
+                partMap.emplace(obj, data);
+            }
+        }
+    }
+    objectPartMap = std::move(partMap);
+
+    // Remember what the model depends on apart from the joint properties
+    mbdJoints = joints;
+    mbdModelBundled = bundleFixed;
+    mbdGroundedPlacements.clear();
+    for (auto* obj : groundedObjs) {
+        if (!obj) {
+            continue;
+        }
+        mbdGroundedPlacements[obj] = getPlacementFromProp(obj, "Placement");
+    }
+    mbdJointPlacements.clear();
+    for (auto* joint : joints) {
+        mbdJointPlacements[joint] = {
+            getPlacementFromProp(joint, "Placement1"),
+            getPlacementFromProp(joint, "Placement2")
+        };
+    }
+
+    // Simulations add motions to the model
+    mbdModelValid = motions.empty();
+    mbdModelBuilds++;
+}
+
+// Splits the joints into components that can be solved independently. Parts connected by a
+// joint are in the same component, the grounded parts don't connect anything.
+void AssemblyObject::partitionMbdModel(
+    const std::unordered_set<App::DocumentObject*>& groundedObjs,
+    const std::vector<App::DocumentObject*>& joints,
+    std::vector<std::unordered_set<App::DocumentObject*>>& groundedOfComponents
+)
+{
+    auto isMoving = [&groundedObjs](App::DocumentObject* part) {
+        return part && !groundedObjs.contains(part);
+    };
+
+    std::unordered_map<App::DocumentObject*, App::DocumentObject*> parent;
+    auto findRoot = [&parent](App::DocumentObject* part) {
+        while (parent[part] != part) {
+            parent[part] = parent[parent[part]];
+            part = parent[part];
+        }
+        return part;
+    };
+
+    std::vector<std::pair<App::DocumentObject*, App::DocumentObject*>> jointEnds;
+    jointEnds.reserve(joints.size());
+    for (auto* joint : joints) {
+        App::DocumentObject* part1 = getMovingPartFromRef(this, joint, "Reference1");
+        App::DocumentObject* part2 = getMovingPartFromRef(this, joint, "Reference2");
+        for (auto* part : {part1, part2}) {
+            if (isMoving(part)) {
+                parent.try_emplace(part, part);
+            }
+        }
+        if (isMoving(part1) && isMoving(part2)) {
+            parent[findRoot(part1)] = findRoot(part2);
+        }
+        jointEnds.emplace_back(part1, part2);
+    }
+
+    mbdComponents.clear();
+    mbdComponentOfPart.clear();
+    groundedOfComponents.clear();
+
+    std::unordered_map<App::DocumentObject*, std::size_t> componentOfRoot;
+    for (std::size_t i = 0; i < joints.size(); i++) {
+        auto [part1, part2] = jointEnds[i];
+        App::DocumentObject* root = nullptr;
+        if (isMoving(part1)) {
+            root = findRoot(part1);
+        }
+        else if (isMoving(part2)) {
+            root = findRoot(part2);
+        }
+
+        // A joint between two grounded parts gets a component of its own
+        std::size_t index = mbdComponents.size();
+        if (root) {
+            index = componentOfRoot.try_emplace(root, index).first->second;
+        }
+        if (index == mbdComponents.size()) {
+            mbdComponents.emplace_back();
+            groundedOfComponents.emplace_back();
+        }
+
+        mbdComponents[index].joints.push_back(joints[i]);
+        for (auto* part : {part1, part2}) {
+            if (part && groundedObjs.contains(part)) {
+                groundedOfComponents[index].insert(part);
+            }
+        }
+    }
+
+    for (auto& it : parent) {
+        mbdComponentOfPart[it.first] = componentOfRoot[findRoot(it.first)];
+    }
+}
+
+// Moves the parts of the kept model to the current placements of their objects and marks
+// their components as dirty. Returns false if the model must be rebuilt.
+bool AssemblyObject::updateMbdParts()
+{
+    // The grounded parts are fixed by markers of the assembly
+    for (auto& [obj, plc] : mbdGroundedPlacements) {
+        if (!getPlacementFromProp(obj, "Placement").isSame(plc)) {
+            return false;
+        }
+    }
+
+    for (std::size_t i = 0; i < mbdComponents.size(); i++) {
+        MbdComponent& component = mbdComponents[i];
+        for (auto& [obj, data] : component.partMap) {
+            auto it = mbdComponentOfPart.find(obj);
+            if (it == mbdComponentOfPart.end() || it->second != i || !data.part
+                || !data.offsetPlc.isIdentity()) {
+                // Bundled objects move with the first object of their bundle
+                continue;
+            }
+
+            Base::Placement plc = getPlacementFromProp(obj, "Placement");
+            if (!plc.isSame(getMbdPlacement(data.part))) {
+                setMbdPlacement(data.part, plc);
+                component.dirty = true;
+            }
+        }
+
+        // A bundle of parts can't be kept if its parts were moved relative to each other
+        for (auto& [obj, data] : component.partMap) {
+            if (!obj || !data.part || mbdGroundedPlacements.contains(obj)) {
+                continue;
+            }
+
+            Base::Placement plc = getPlacementFromProp(obj, "Placement");
+            if (!plc.isSame(getMbdPlacement(data.part) * data.offsetPlc)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Runs func for each of the components. Returns false if it failed for any component.
+// The components are solved one after the other because OndselSolver is not known to be
+// reentrant, although the MbD assemblies of the components don't share any objects.
+bool AssemblyObject::runMbdComponents(
+    const std::vector<MbdComponent*>& components,
+    const std::function<void(MbdComponent&)>& func,
+    std::string& error
+)
+{
+    for (auto* component : components) {
+        try {
+            func(*component);
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+            return false;
+        }
+        catch (...) {
+            error = "unhandled exception";
+            return false;
+        }
+    }
+    return true;
+}
+
 int AssemblyObject::generateSimulation(App::DocumentObject* sim)
 {
     mbdAssembly = makeMbdAssembly();
+    mbdModelValid = false;
     objectPartMap.clear();
 
     motions = getMotionsFromSimulation(sim);
@@ -292,20 +623,34 @@ void AssemblyObject::preDrag(std::vector<App::DocumentObject*> dragParts)
 
         draggedParts.push_back(part);
     }
+
+    // Only the components of the dragged parts are solved while dragging
+    draggedComponents.clear();
+    for (auto* part : draggedParts) {
+        auto it = mbdComponentOfPart.find(part);
+        if (it == mbdComponentOfPart.end()) {
+            continue;
+        }
+        if (std::ranges::find(draggedComponents, it->second) == draggedComponents.end()) {
+            draggedComponents.push_back(it->second);
+        }
+    }
 }
 
 void AssemblyObject::doDragStep()
 {
     try {
-        std::vector<std::shared_ptr<MbD::ASMTPart>> dragMbdParts;
+        std::unordered_map<MbdComponent*, std::vector<std::shared_ptr<MbD::ASMTPart>>>
+            dragMbdParts;
 
         for (auto& part : draggedParts) {
-            if (!part) {
+            auto it = part ? mbdComponentOfPart.find(part) : mbdComponentOfPart.end();
+            if (it == mbdComponentOfPart.end()) {
                 continue;
             }
 
             auto mbdPart = getMbDPart(part);
-            dragMbdParts.push_back(mbdPart);
+            dragMbdParts[&mbdComponents[it->second]].push_back(mbdPart);
 
             // Update the MBD part's position
             Base::Placement plc = getPlacementFromProp(part, "Placement");
@@ -324,9 +669,21 @@ void AssemblyObject::doDragStep()
             mbdPart->updateMbDFromRotationMatrix(r0.x, r0.y, r0.z, r1.x, r1.y, r1.z, r2.x, r2.y, r2.z);
         }
 
-        // Timing mbdAssembly->runDragStep()
-        auto dragPartsVec = std::make_shared<std::vector<std::shared_ptr<ASMTPart>>>(dragMbdParts);
-        mbdAssembly->runDragStep(dragPartsVec);
+        // The dragged components are independent of each other
+        std::string error;
+        auto runDragStep = [&dragMbdParts](MbdComponent& component) {
+            auto dragPartsVec = std::make_shared<std::vector<std::shared_ptr<ASMTPart>>>(
+                dragMbdParts.at(&component)
+            );
+            component.assembly->runDragStep(dragPartsVec);
+        };
+        std::vector<MbdComponent*> components;
+        for (std::size_t index : draggedComponents) {
+            components.push_back(&mbdComponents[index]);
+        }
+        if (!runMbdComponents(components, runDragStep, error)) {
+            return;
+        }
 
         // Timing the validation and placement setting
         if (validateNewPlacements()) {
@@ -374,8 +731,13 @@ bool AssemblyObject::validateNewPlacements()
         if (propPlacement) {
             Base::Placement oldPlc = propPlacement->getValue();
 
-            auto it = objectPartMap.find(obj);
-            if (it != objectPartMap.end()) {
+            // A grounded object is part of each component it is connected to
+            for (auto& component : mbdComponents) {
+                auto it = component.partMap.find(obj);
+                if (it == component.partMap.end()) {
+                    continue;
+                }
+
                 std::shared_ptr<MbD::ASMTPart> mbdPart = it->second.part;
                 Base::Placement newPlacement = getMbdPlacement(mbdPart);
                 if (!it->second.offsetPlc.isIdentity()) {
@@ -400,7 +762,13 @@ bool AssemblyObject::validateNewPlacements()
 
 void AssemblyObject::postDrag()
 {
-    mbdAssembly->runPostDrag();  // Do this after last drag
+    // Do this after last drag
+    for (std::size_t index : draggedComponents) {
+        mbdComponents[index].assembly->runPostDrag();
+        // The next drag needs a new runPreDrag()
+        mbdComponents[index].dirty = true;
+    }
+    draggedComponents.clear();
 }
 
 void AssemblyObject::savePlacementsForUndo()
@@ -463,6 +831,7 @@ void AssemblyObject::clearUndo()
 void AssemblyObject::exportAsASMT(std::string fileName)
 {
     mbdAssembly = makeMbdAssembly();
+    mbdModelValid = false;
     objectPartMap.clear();
     fixGroundedParts();
 
@@ -658,6 +1027,16 @@ ViewGroup* AssemblyObject::getExplodedViewGroup() const
 
 std::vector<App::DocumentObject*> AssemblyObject::getJoints(bool updateJCS, bool delBadJoints, bool subJoints)
 {
+    // Only the default selection of joints is cached
+    bool useCache = !delBadJoints && subJoints;
+    if (useCache && jointsCacheValid) {
+        std::vector<App::DocumentObject*> joints = cachedJoints;
+        if (updateJCS) {
+            recomputeJointPlacements(joints);
+        }
+        return joints;
+    }
+
     std::vector<App::DocumentObject*> joints = {};
 
     JointGroup* jointGroup = getJointGroup();
@@ -704,6 +1083,11 @@ std::vector<App::DocumentObject*> AssemblyObject::getJoints(bool updateJCS, bool
         }
     }
 
+    if (useCache) {
+        cachedJoints = joints;
+        jointsCacheValid = true;
+    }
+
     // Make sure the joints are up to date.
     if (updateJCS) {
         recomputeJointPlacements(joints);
@@ -778,6 +1162,10 @@ std::vector<App::DocumentObject*> AssemblyObject::getJointsOfPart(App::DocumentO
 
 std::unordered_set<App::DocumentObject*> AssemblyObject::getGroundedParts()
 {
+    if (groundedCacheValid) {
+        return cachedGroundedParts;
+    }
+
     std::vector<App::DocumentObject*> groundedJoints = getGroundedJoints();
 
     std::unordered_set<App::DocumentObject*> groundedSet;
@@ -821,6 +1209,8 @@ std::unordered_set<App::DocumentObject*> AssemblyObject::getGroundedParts()
     // Origin is not in Group so we add it separately
     groundedSet.insert(Origin.getValue());
 
+    cachedGroundedParts = groundedSet;
+    groundedCacheValid = true;
     return groundedSet;
 }
 
@@ -1854,6 +2244,13 @@ std::shared_ptr<ASMTPart> AssemblyObject::makeMbdPart(std::string& name, Base::P
     massMarker->setMomentOfInertias(1.0, 1.0, 1.0);
     mbdPart->setPrincipalMassMarker(massMarker);
 
+    setMbdPlacement(mbdPart, plc);
+
+    return mbdPart;
+}
+
+void AssemblyObject::setMbdPlacement(std::shared_ptr<ASMTPart> mbdPart, const Base::Placement& plc)
+{
     Base::Vector3d pos = plc.getPosition();
     mbdPart->setPosition3D(pos.x, pos.y, pos.z);
 
@@ -1865,8 +2262,6 @@ std::shared_ptr<ASMTPart> AssemblyObject::makeMbdPart(std::string& name, Base::P
     Base::Vector3d r1 = mat.getRow(1);
     Base::Vector3d r2 = mat.getRow(2);
     mbdPart->setRotationMatrix(r0.x, r0.y, r0.z, r1.x, r1.y, r1.z, r2.x, r2.y, r2.z);
-
-    return mbdPart;
 }
 
 std::shared_ptr<ASMTMarker> AssemblyObject::makeMbdMarker(std::string& name, Base::Placement& plc)
@@ -25,6 +25,8 @@
 #ifndef ASSEMBLY_AssemblyObject_H
 #define ASSEMBLY_AssemblyObject_H
 
+#include <functional>
+
 #include <boost/signals2.hpp>
 
 #include <Mod/Assembly/AssemblyGlobal.h>
@@ -96,6 +98,11 @@ public:
     int generateSimulation(App::DocumentObject* sim);
     int updateForFrame(size_t index, bool updateJCS = true);
     size_t numberOfFrames();
+    /// Returns how often the solver model was built, it is kept as long as the joints don't change
+    std::size_t numberOfModelBuilds() const
+    {
+        return mbdModelBuilds;
+    }
     void preDrag(std::vector<App::DocumentObject*> dragParts);
     void doDragStep();
     void postDrag();
@@ -258,8 +265,64 @@ public:
     }
     fastsignals::signal<void()> signalSolverUpdate;
 
+protected:
+    void onSettingDocument() override;
+    void unsetupObject() override;
+
+private:
+    // The grounded parts don't move, so they split the joints into independent components.
+    // Each component has its own MbD assembly and is only solved when one of its parts moved.
+    struct MbdComponent
+    {
+        std::shared_ptr<MbD::ASMTAssembly> assembly;
+        std::unordered_map<App::DocumentObject*, MbDPartData> partMap;
+        std::vector<App::DocumentObject*> joints;
+        bool dirty {true};
+    };
+
+    // The MbD model of the last solve is kept alive and only the part placements are updated
+    // for the next solve. It is rebuilt when a joint or the set of grounded parts changes.
+    void buildMbdModel(
+        const std::unordered_set<App::DocumentObject*>& groundedObjs,
+        std::vector<App::DocumentObject*> joints
+    );
+    void partitionMbdModel(
+        const std::unordered_set<App::DocumentObject*>& groundedObjs,
+        const std::vector<App::DocumentObject*>& joints,
+        std::vector<std::unordered_set<App::DocumentObject*>>& groundedOfComponents
+    );
+    bool updateMbdParts();
+    static bool runMbdComponents(
+        const std::vector<MbdComponent*>& components,
+        const std::function<void(MbdComponent&)>& func,
+        std::string& error
+    );
+    static void setMbdPlacement(std::shared_ptr<MbD::ASMTPart> mbdPart, const Base::Placement& plc);
+    void invalidateMbdModel();
+    void invalidateCaches();
+    bool isJointPlacementUnchanged(const App::DocumentObject& joint) const;
+    bool isUsedByModel(const App::DocumentObject& obj) const;
+    void slotChangedObject(const App::DocumentObject& obj, const App::Property& prop);
+    void slotChangedStructure(const App::DocumentObject& obj);
+
 private:
     std::shared_ptr<MbD::ASMTAssembly> mbdAssembly;
+    bool mbdModelValid {false};
+    bool mbdModelBundled {false};
+    std::size_t mbdModelBuilds {0};
+    std::vector<App::DocumentObject*> mbdJoints;
+    std::unordered_map<App::DocumentObject*, Base::Placement> mbdGroundedPlacements;
+    std::unordered_map<const App::DocumentObject*, std::pair<Base::Placement, Base::Placement>>
+        mbdJointPlacements;
+    std::vector<MbdComponent> mbdComponents;
+    std::unordered_map<App::DocumentObject*, std::size_t> mbdComponentOfPart;
+    std::vector<std::size_t> draggedComponents;
+
+    // getJoints() and getGroundedParts() are called many times per solve and drag step
+    bool jointsCacheValid {false};
+    std::vector<App::DocumentObject*> cachedJoints;
+    bool groundedCacheValid {false};
+    std::unordered_set<App::DocumentObject*> cachedGroundedParts;
 
     std::unordered_map<App::DocumentObject*, MbDPartData> objectPartMap;
     std::vector<std::pair<App::DocumentObject*, double>> objMasses;
@@ -281,6 +344,9 @@ private:
     std::vector<int> lastRedundant;
     std::vector<int> lastPartiallyRedundant;
     std::vector<int> lastMalformedConstraints;
+
+    fastsignals::scoped_connection connChangedObject;
+    fastsignals::scoped_connection connDeletedObject;
 };
 
 }  // namespace Assembly
@@ -78,6 +78,11 @@ class AssemblyObject(Part):
         """Return Number of frames"""
         ...
 
+    @constmethod
+    def numberOfModelBuilds(self) -> int:
+        """Return how often the solver model was built"""
+        ...
+
     @constmethod
     def undoSolve(self) -> None:
         """
@@ -112,6 +112,15 @@ PyObject* AssemblyObjectPy::numberOfFrames(PyObject* args) const
     return Py_BuildValue("k", ret);
 }
 
+PyObject* AssemblyObjectPy::numberOfModelBuilds(PyObject* args) const
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+    size_t ret = this->getAssemblyObjectPtr()->numberOfModelBuilds();
+    return Py_BuildValue("k", ret);
+}
+
 PyObject* AssemblyObjectPy::undoSolve(PyObject* args) const
 {
     if (!PyArg_ParseTuple(args, "")) {
@@ -213,3 +213,83 @@ class TestCore(unittest.TestCase):
         joint.Proxy.setJointConnectors(joint, refs)
 
         self.assertTrue(box.Placement.isSame(box2.Placement, 1e-6), "'{}'".format(operation))
+
+    def test_keep_solver_model(self):
+        """Test that the solver model is only rebuilt when the joints change."""
+        operation = "Keep solver model"
+        _msg("  Test '{}'".format(operation))
+
+        box = self.assembly.newObject("Part::Box", "Box")
+        box2 = self.assembly.newObject("Part::Box", "Box")
+        box2.Placement = App.Placement(App.Vector(40, 50, 60), App.Rotation(45, 55, 65))
+
+        ground = self.jointgroup.newObject("App::FeaturePython", "GroundedJoint")
+        JointObject.GroundedJoint(ground, box2)
+
+        joint = self.jointgroup.newObject("App::FeaturePython", "testJoint")
+        JointObject.Joint(joint, 0)
+
+        refs = [
+            [self.assembly, [box2.Name + ".Face6", box2.Name + ".Vertex7"]],
+            [self.assembly, [box.Name + ".Face6", box.Name + ".Vertex7"]],
+        ]
+
+        joint.Proxy.setJointConnectors(joint, refs)
+        self.doc.recompute()
+        builds = self.assembly.numberOfModelBuilds()
+        self.assertGreater(builds, 0, "'{}' failed: no model".format(operation))
+
+        # Moving a part and recomputing reuse the model
+        box.Placement = App.Placement(App.Vector(10, 20, 30), App.Rotation(15, 25, 35))
+        self.assertEqual(self.assembly.solve(), 0, "'{}' failed: solve".format(operation))
+        self.assertTrue(box.Placement.isSame(box2.Placement, 1e-6), "'{}'".format(operation))
+        self.doc.recompute()
+        self.assertEqual(self.assembly.solve(), 0, "'{}' failed: solve".format(operation))
+        self.assertEqual(
+            self.assembly.numberOfModelBuilds(),
+            builds,
+            "'{}' failed: model rebuilt without changes".format(operation),
+        )
+
+        # Changing the type of a joint rebuilds it
+        joint.JointType = "Revolute"
+        self.assembly.solve()
+        self.assertEqual(
+            self.assembly.numberOfModelBuilds(),
+            builds + 1,
+            "'{}' failed: model not rebuilt".format(operation),
+        )
+
+    def test_solve_independent_parts(self):
+        """Test solving an assembly with two groups of parts that are not joined."""
+        operation = "Solve independent parts"
+        _msg("  Test '{}'".format(operation))
+
+        pairs = []
+        for i in range(2):
+            fixed = self.assembly.newObject("Part::Box", "Box")
+            fixed.Placement = App.Placement(App.Vector(40 * i, 50, 60), App.Rotation(45, 55, 65))
+            moving = self.assembly.newObject("Part::Box", "Box")
+
+            ground = self.jointgroup.newObject("App::FeaturePython", "GroundedJoint")
+            JointObject.GroundedJoint(ground, fixed)
+
+            joint = self.jointgroup.newObject("App::FeaturePython", "testJoint")
+            JointObject.Joint(joint, 0)
+            refs = [
+                [self.assembly, [fixed.Name + ".Face6", fixed.Name + ".Vertex7"]],
+                [self.assembly, [moving.Name + ".Face6", moving.Name + ".Vertex7"]],
+            ]
+            joint.Proxy.setJointConnectors(joint, refs)
+            pairs.append((fixed, moving))
+
+        # Both groups are moved and solved in the same solve
+        for i, (fixed, moving) in enumerate(pairs):
+            moving.Placement = App.Placement(App.Vector(10, 20 * i, 30), App.Rotation(15, 25, 35))
+        self.assertEqual(self.assembly.solve(), 0, "'{}' failed: solve".format(operation))
+
+        # Each group gives the same result as the single joint of test_solve_assembly
+        for fixed, moving in pairs:
+            self.assertTrue(
+                moving.Placement.isSame(fixed.Placement, 1e-6), "'{}'".format(operation)
+            )
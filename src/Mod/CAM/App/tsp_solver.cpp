@@ -26,6 +26,8 @@
 #include <limits>
 #include <cmath>
 #include <algorithm>
+#include <deque>
+#include <numeric>
 #include <Base/Precision.h>
 
 namespace
@@ -64,13 +66,521 @@ double distSquared(const TSPPoint& a, const TSPPoint& b)
     return dx * dx + dy * dy;
 }
 
+/**
+ * @brief Static 2D k-d tree for nearest neighbor queries on a shrinking point set
+ *
+ * The tree is built once; points are removed by marking them. Every subtree keeps the
+ * number of its remaining points, so subtrees without points are skipped by the queries.
+ * A subtree is a range of the order array with its splitting point in the middle.
+ */
+class KdTree
+{
+public:
+    explicit KdTree(const std::vector<TSPPoint>& points)
+        : pts(points)
+        , order(points.size())
+        , position(points.size())
+        , remaining(points.size(), 0)
+        , removed(points.size(), false)
+    {
+        std::iota(order.begin(), order.end(), 0);
+        build(0, order.size(), 0);
+        for (size_t i = 0; i < order.size(); ++i) {
+            position[order[i]] = i;
+        }
+    }
+
+    void remove(int id)
+    {
+        if (removed[id]) {
+            return;
+        }
+        removed[id] = true;
+
+        // the path from the root to the point only depends on its position in the order array
+        size_t lo = 0;
+        size_t hi = order.size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            --remaining[mid];
+            if (position[id] == mid) {
+                break;
+            }
+            if (position[id] < mid) {
+                hi = mid;
+            }
+            else {
+                lo = mid + 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Find the nearest remaining point
+     * @return Index of the point, the smaller index on equal distances, or -1 if there is none
+     */
+    int nearest(const TSPPoint& p) const
+    {
+        int best = -1;
+        double bestDist = std::numeric_limits<double>::max();
+        nearest(p, 0, order.size(), 0, best, bestDist);
+        return best;
+    }
+
+    /**
+     * @brief Collect all remaining points with a squared distance of at most maxDist
+     */
+    void within(const TSPPoint& p, double maxDist, std::vector<int>& result) const
+    {
+        within(p, 0, order.size(), 0, maxDist, result);
+    }
+
+    /**
+     * @brief Collect the k nearest remaining points, in no particular order
+     */
+    void nearestK(const TSPPoint& p, size_t k, std::vector<int>& result) const
+    {
+        std::vector<std::pair<double, int>> heap;
+        if (k > 0) {
+            nearestK(p, 0, order.size(), 0, k, heap);
+        }
+        result.clear();
+        for (const auto& it : heap) {
+            result.push_back(it.second);
+        }
+    }
+
+private:
+    static double coord(const TSPPoint& p, int axis)
+    {
+        return axis == 0 ? p.x : p.y;
+    }
+
+    void build(size_t lo, size_t hi, int axis)
+    {
+        if (lo >= hi) {
+            return;
+        }
+        size_t mid = (lo + hi) / 2;
+        std::nth_element(
+            order.begin() + lo,
+            order.begin() + mid,
+            order.begin() + hi,
+            [this, axis](int a, int b) { return coord(pts[a], axis) < coord(pts[b], axis); }
+        );
+        remaining[mid] = hi - lo;
+        build(lo, mid, 1 - axis);
+        build(mid + 1, hi, 1 - axis);
+    }
+
+    void nearest(
+        const TSPPoint& p,
+        size_t lo,
+        size_t hi,
+        int axis,
+        int& best,
+        double& bestDist
+    ) const
+    {
+        if (lo >= hi) {
+            return;
+        }
+        size_t mid = (lo + hi) / 2;
+        if (remaining[mid] == 0) {
+            return;
+        }
+
+        int id = order[mid];
+        if (!removed[id]) {
+            double d = distSquared(p, pts[id]);
+            if (d < bestDist || (d == bestDist && id < best)) {
+                bestDist = d;
+                best = id;
+            }
+        }
+
+        // search the side of the query point first, the other one only if it can be closer
+        double diff = coord(p, axis) - coord(pts[id], axis);
+        if (diff < 0) {
+            nearest(p, lo, mid, 1 - axis, best, bestDist);
+            if (diff * diff <= bestDist) {
+                nearest(p, mid + 1, hi, 1 - axis, best, bestDist);
+            }
+        }
+        else {
+            nearest(p, mid + 1, hi, 1 - axis, best, bestDist);
+            if (diff * diff <= bestDist) {
+                nearest(p, lo, mid, 1 - axis, best, bestDist);
+            }
+        }
+    }
+
+    void within(
+        const TSPPoint& p,
+        size_t lo,
+        size_t hi,
+        int axis,
+        double maxDist,
+        std::vector<int>& result
+    ) const
+    {
+        if (lo >= hi) {
+            return;
+        }
+        size_t mid = (lo + hi) / 2;
+        if (remaining[mid] == 0) {
+            return;
+        }
+
+        int id = order[mid];
+        if (!removed[id] && distSquared(p, pts[id]) <= maxDist) {
+            result.push_back(id);
+        }
+
+        double diff = coord(p, axis) - coord(pts[id], axis);
+        if (diff <= 0 || diff * diff <= maxDist) {
+            within(p, lo, mid, 1 - axis, maxDist, result);
+        }
+        if (diff >= 0 || diff * diff <= maxDist) {
+            within(p, mid + 1, hi, 1 - axis, maxDist, result);
+        }
+    }
+
+    // heap is a max-heap of (squared distance, index) with at most k entries
+    void nearestK(
+        const TSPPoint& p,
+        size_t lo,
+        size_t hi,
+        int axis,
+        size_t k,
+        std::vector<std::pair<double, int>>& heap
+    ) const
+    {
+        if (lo >= hi) {
+            return;
+        }
+        size_t mid = (lo + hi) / 2;
+        if (remaining[mid] == 0) {
+            return;
+        }
+
+        int id = order[mid];
+        if (!removed[id]) {
+            double d = distSquared(p, pts[id]);
+            if (heap.size() < k) {
+                heap.emplace_back(d, id);
+                std::push_heap(heap.begin(), heap.end());
+            }
+            else if (d < heap.front().first) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = {d, id};
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+
+        double diff = coord(p, axis) - coord(pts[id], axis);
+        size_t nearLo = diff < 0 ? lo : mid + 1;
+        size_t nearHi = diff < 0 ? mid : hi;
+        size_t farLo = diff < 0 ? mid + 1 : lo;
+        size_t farHi = diff < 0 ? hi : mid;
+        nearestK(p, nearLo, nearHi, 1 - axis, k, heap);
+        if (heap.size() < k || diff * diff < heap.front().first) {
+            nearestK(p, farLo, farHi, 1 - axis, k, heap);
+        }
+    }
+
+    const std::vector<TSPPoint>& pts;
+    std::vector<int> order;         // point indices, each subtree is a range of it
+    std::vector<size_t> position;   // position of each point in order
+    std::vector<size_t> remaining;  // remaining points of the subtree split at this position
+    std::vector<bool> removed;
+};
+
+/**
+ * @brief An element of a route, a point or a tunnel with separate entry and exit
+ */
+struct RouteNode
+{
+    TSPPoint entry;
+    TSPPoint exit;
+    bool reversible;  // Whether the node may be passed from exit to entry
+    bool flipped;     // Tracks if entry and exit have been swapped
+};
+
+/**
+ * @brief Local search on a route with 2-opt and Or-opt moves
+ *
+ * Instead of trying all pairs of positions, only moves that connect a node with one of its
+ * nearest neighbors are evaluated. Nodes whose surroundings changed are put into a work queue
+ * until no move improves the route any more. The number of evaluated nodes is limited to a
+ * multiple of the route size, so that the result doesn't depend on the speed of the machine.
+ * Usually the queue runs empty after two or three evaluations per node. Position 0 of the
+ * route is never moved, nor is the last position if the route has a fixed end.
+ *
+ * Moves:
+ * - 2-opt: Reverse a range of the route, this also flips the nodes in it. A range of a
+ *   single node just flips it. Ranges with nodes that aren't reversible are skipped.
+ * - Or-opt: Move a segment of up to three nodes to another place, optionally reversed.
+ */
+class RouteImprover
+{
+public:
+    RouteImprover(std::vector<RouteNode>& routeNodes, std::vector<int>& order, bool fixedEnd)
+        : nodes(routeNodes)
+        , route(order)
+        , last(route.size() - (fixedEnd ? 2 : 1))
+        , position(nodes.size())
+        , blocked(route.size() + 1, 0)
+        , queued(nodes.size(), false)
+    {
+        updatePositions(0, route.size() - 1);
+        findNeighbours();
+    }
+
+    void run()
+    {
+        size_t evaluations = maxEvaluationsPerNode * nodes.size();
+        for (int node : route) {
+            activate(node);
+        }
+        while (!queue.empty() && evaluations > 0) {
+            --evaluations;
+            int node = queue.front();
+            queue.pop_front();
+            queued[node] = false;
+            if (improve(node)) {
+                activate(node);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t neighbourCount = 10;
+    static constexpr size_t maxSegment = 3;
+    static constexpr size_t maxEvaluationsPerNode = 20;
+
+    void findNeighbours()
+    {
+        // index the entries and the exits that differ from them
+        std::vector<TSPPoint> ends;
+        std::vector<int> owner;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            ends.push_back(nodes[i].entry);
+            owner.push_back(static_cast<int>(i));
+            if (distSquared(nodes[i].entry, nodes[i].exit) > 0) {
+                ends.push_back(nodes[i].exit);
+                owner.push_back(static_cast<int>(i));
+            }
+        }
+
+        KdTree tree(ends);
+        std::vector<int> found;
+        neighbours.resize(nodes.size());
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            auto& list = neighbours[i];
+            auto addNearest = [&](const TSPPoint& p) {
+                tree.nearestK(p, neighbourCount + 2, found);
+                for (int id : found) {
+                    int other = owner[id];
+                    if (other != static_cast<int>(i)
+                        && std::find(list.begin(), list.end(), other) == list.end()) {
+                        list.push_back(other);
+                    }
+                }
+            };
+            addNearest(nodes[i].entry);
+            if (distSquared(nodes[i].entry, nodes[i].exit) > 0) {
+                addNearest(nodes[i].exit);
+            }
+        }
+    }
+
+    void activate(int node)
+    {
+        if (!queued[node]) {
+            queued[node] = true;
+            queue.push_back(node);
+        }
+    }
+
+    void updatePositions(size_t lo, size_t hi)
+    {
+        for (size_t k = lo; k <= hi; ++k) {
+            position[route[k]] = k;
+            blocked[k + 1] = blocked[k] + (nodes[route[k]].reversible ? 0 : 1);
+        }
+    }
+
+    void flip(int node)
+    {
+        RouteNode& n = nodes[node];
+        std::swap(n.entry, n.exit);
+        n.flipped = !n.flipped;
+    }
+
+    bool canReverse(size_t l, size_t r) const
+    {
+        return blocked[r + 1] == blocked[l];
+    }
+
+    static bool improves(double delta)
+    {
+        return delta < -Base::Precision::Confusion();
+    }
+
+    // Reverse the range [l, r] of the route
+    bool tryReverse(size_t l, size_t r)
+    {
+        if (l < 1 || l > r || r > last || !canReverse(l, r)) {
+            return false;
+        }
+
+        const RouteNode& prev = nodes[route[l - 1]];
+        const RouteNode& first = nodes[route[l]];
+        const RouteNode& lastNode = nodes[route[r]];
+        double before = dist(prev.exit, first.entry);
+        double after = dist(prev.exit, lastNode.exit);
+        if (r + 1 < route.size()) {
+            const RouteNode& next = nodes[route[r + 1]];
+            before += dist(lastNode.exit, next.entry);
+            after += dist(first.entry, next.entry);
+        }
+        if (!improves(after - before)) {
+            return false;
+        }
+
+        std::reverse(route.begin() + l, route.begin() + r + 1);
+        for (size_t k = l; k <= r; ++k) {
+            flip(route[k]);
+        }
+        updatePositions(l, r);
+        activate(route[l - 1]);
+        activate(route[l]);
+        activate(route[r]);
+        if (r + 1 < route.size()) {
+            activate(route[r + 1]);
+        }
+        return true;
+    }
+
+    // Move the segment [s, e] of the route behind position x
+    bool tryMove(size_t s, size_t e, size_t x, bool reversed)
+    {
+        if (s < 1 || e > last || x > last || (x + 1 >= s && x <= e)) {
+            return false;
+        }
+        if (reversed && !canReverse(s, e)) {
+            return false;
+        }
+
+        const RouteNode& prev = nodes[route[s - 1]];
+        const RouteNode& first = nodes[route[s]];
+        const RouteNode& lastNode = nodes[route[e]];
+        const RouteNode& insertAfter = nodes[route[x]];
+        const TSPPoint& segmentEntry = reversed ? lastNode.exit : first.entry;
+        const TSPPoint& segmentExit = reversed ? first.entry : lastNode.exit;
+
+        double removedLength = dist(prev.exit, first.entry);
+        double addedLength = dist(insertAfter.exit, segmentEntry);
+        if (e + 1 < route.size()) {
+            const RouteNode& next = nodes[route[e + 1]];
+            removedLength += dist(lastNode.exit, next.entry);
+            addedLength += dist(prev.exit, next.entry);
+        }
+        if (x + 1 < route.size()) {
+            const RouteNode& insertBefore = nodes[route[x + 1]];
+            removedLength += dist(insertAfter.exit, insertBefore.entry);
+            addedLength += dist(segmentExit, insertBefore.entry);
+        }
+        if (!improves(addedLength - removedLength)) {
+            return false;
+        }
+
+        std::vector<int> touched {route[s - 1], route[s], route[e], route[x]};
+        if (e + 1 < route.size()) {
+            touched.push_back(route[e + 1]);
+        }
+        if (x + 1 < route.size()) {
+            touched.push_back(route[x + 1]);
+        }
+
+        if (reversed) {
+            std::reverse(route.begin() + s, route.begin() + e + 1);
+            for (size_t k = s; k <= e; ++k) {
+                flip(route[k]);
+            }
+        }
+        if (x < s) {
+            std::rotate(route.begin() + x + 1, route.begin() + s, route.begin() + e + 1);
+            updatePositions(x + 1, e);
+        }
+        else {
+            std::rotate(route.begin() + s, route.begin() + e + 1, route.begin() + x + 1);
+            updatePositions(s, x);
+        }
+        for (int node : touched) {
+            activate(node);
+        }
+        return true;
+    }
+
+    // Try to move the segment [s, e] next to the node at position j
+    bool tryMoveNear(size_t s, size_t e, size_t j)
+    {
+        // behind the node or in front of it
+        if (tryMove(s, e, j, false) || tryMove(s, e, j, true)) {
+            return true;
+        }
+        return j > 0 && (tryMove(s, e, j - 1, false) || tryMove(s, e, j - 1, true));
+    }
+
+    bool improve(int node)
+    {
+        size_t i = position[node];
+        if (tryReverse(i, i)) {
+            return true;
+        }
+
+        for (int other : neighbours[node]) {
+            size_t j = position[other];
+            size_t lo = std::min(i, j);
+            size_t hi = std::max(i, j);
+
+            // 2-opt moves that make the node and its neighbor adjacent
+            if (tryReverse(lo + 1, hi) || tryReverse(lo, hi - 1)) {
+                return true;
+            }
+
+            // Or-opt moves of the segments starting or ending with the node
+            for (size_t len = 1; len <= maxSegment; ++len) {
+                if (i + len <= route.size() && tryMoveNear(i, i + len - 1, j)) {
+                    return true;
+                }
+                if (len > 1 && i + 1 >= len && tryMoveNear(i + 1 - len, i, j)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    std::vector<RouteNode>& nodes;
+    std::vector<int>& route;
+    size_t last;                               // last position that may be changed
+    std::vector<size_t> position;              // position of each node in the route
+    std::vector<size_t> blocked;               // prefix count of nodes that aren't reversible
+    std::vector<std::vector<int>> neighbours;  // nearest nodes of each node
+    std::deque<int> queue;
+    std::vector<bool> queued;
+};
+
 /**
  * @brief Core TSP solver implementation using nearest neighbor + iterative improvement
  *
  * Algorithm steps:
  * 1. Add temporary start/end points if specified
  * 2. Build initial route using nearest neighbor heuristic
- * 3. Optimize route with 2-opt and relocation moves
+ * 3. Optimize route with 2-opt and Or-opt moves
  * 4. Remove temporary points and map back to original indices
  *
  * @param points Input points to visit
@@ -84,6 +594,10 @@ std::vector<int> solve_impl(
     const TSPPoint* endPoint
 )
 {
+    if (points.empty()) {
+        return {};
+    }
+
     // ========================================================================
     // STEP 1: Prepare point set with temporary start/end markers
     // ========================================================================
@@ -113,52 +627,59 @@ std::vector<int> solve_impl(
     // STEP 2: Build initial route using Nearest Neighbor algorithm
     // ========================================================================
     // Greedy approach: always visit the closest unvisited point next.
-    // This gives a decent initial solution quickly (O(n²) complexity).
+    // The points are kept in a k-d tree, so finding the next one takes O(log n)
+    // instead of scanning all points.
     //
     // Tie-breaking rule:
     // - If distances are within ±0.1, prefer point with y-value closer to start
     // - This provides deterministic results when points are nearly equidistant
     std::vector<int> route;
-    std::vector<bool> visited(pts.size(), false);
+    KdTree tree(pts);
     route.push_back(0);  // Start from temp start point (index 0)
-    visited[0] = true;
+    tree.remove(0);
 
+    std::vector<int> candidates;
     for (size_t step = 1; step < pts.size(); ++step) {
+        const TSPPoint& current = pts[route.back()];
+        int nearest = tree.nearest(current);
+        if (nearest == -1) {
+            break;  // No more unvisited points
+        }
+
+        // Only points within the tie tolerance of the nearest one are candidates,
+        // they are checked in the order of the input
+        candidates.clear();
+        tree.within(current, distSquared(current, pts[nearest]) + 0.1, candidates);
+        std::sort(candidates.begin(), candidates.end());
+
         double minDist = std::numeric_limits<double>::max();
         int next = -1;
         double nextYDiff = std::numeric_limits<double>::max();
-
-        // Find nearest unvisited neighbor
-        for (size_t i = 0; i < pts.size(); ++i) {
-            if (!visited[i]) {
-                // Use squared distance for speed (no sqrt needed for comparison)
-                double d = distSquared(pts[route.back()], pts[i]);
-                double yDiff = std::abs(pts[route.front()].y - pts[i].y);
-
-                // Tie-breaking logic:
-                if (d > minDist + 0.1) {
-                    continue;  // Clearly farther, skip
-                }
-                else if (d < minDist - 0.1) {
-                    // Clearly closer, use it
-                    minDist = d;
-                    next = static_cast<int>(i);
-                    nextYDiff = yDiff;
-                }
-                else if (yDiff < nextYDiff) {
-                    // Tie: prefer point closer to start in Y-axis
-                    minDist = d;
-                    next = static_cast<int>(i);
-                    nextYDiff = yDiff;
-                }
+        for (int i : candidates) {
+            // Use squared distance for speed (no sqrt needed for comparison)
+            double d = distSquared(current, pts[i]);
+            double yDiff = std::abs(pts[route.front()].y - pts[i].y);
+
+            // Tie-breaking logic:
+            if (d > minDist + 0.1) {
+                continue;  // Clearly farther, skip
+            }
+            else if (d < minDist - 0.1) {
+                // Clearly closer, use it
+                minDist = d;
+                next = i;
+                nextYDiff = yDiff;
+            }
+            else if (yDiff < nextYDiff) {
+                // Tie: prefer point closer to start in Y-axis
+                minDist = d;
+                next = i;
+                nextYDiff = yDiff;
             }
         }
 
-        if (next == -1) {
-            break;  // No more unvisited points
-        }
         route.push_back(next);
-        visited[next] = true;
+        tree.remove(next);
     }
 
     // Ensure temporary end point is at the end of route
@@ -171,169 +692,23 @@ std::vector<int> solve_impl(
     }
 
     // ========================================================================
-    // STEP 3: Iterative improvement using 2-Opt and Relocation
+    // STEP 3: Iterative improvement using 2-Opt and Or-Opt
     // ========================================================================
     // Repeatedly apply local optimizations until no improvement is possible.
-    // This typically converges quickly (a few iterations) to a near-optimal solution.
+    // Only moves that connect a point with one of its nearest neighbors are tried,
+    // see RouteImprover.
     //
     // Two optimization techniques:
     // 1. 2-Opt: Reverse segments of the route to eliminate crossing paths
-    // 2. Relocation: Move individual points to better positions in the route
+    // 2. Or-Opt: Move up to three consecutive points to better positions in the route
     //
-    // For open routes (no endPoint), additional optimizations are applied that
-    // allow reversing/relocating segments to the end of the route.
-    size_t limitReorderI = route.size() - 2;
-    if (tempEndIdx != -1) {
-        limitReorderI -= 1;
-    }
-    size_t limitReorderJ = route.size();
-    size_t limitRelocationI = route.size() - 1;
-    size_t limitRelocationJ = route.size() - 1;
-    int lastImprovementAtStep = 0;
-
-    while (true) {
-
-        // --- 2-Opt Optimization ---
-        // Try reversing every possible segment of the route.
-        // If reversing segment [i+1...j-1] reduces total distance, keep it.
-        //
-        // Example: Route A-B-C-D-E becomes A-D-C-B-E if reversing B-C-D is better
-        if (lastImprovementAtStep == 1) {
-            break;
-        }
-        bool reorderFound = true;
-        while (reorderFound) {
-            reorderFound = false;
-            for (size_t i = 0; i < limitReorderI; ++i) {
-                double subRouteLengthCurrentPart = dist(pts[route[i]], pts[route[i + 1]]);
-
-                for (size_t j = i + 3; j < limitReorderJ; ++j) {
-                    // Current edges: i→(i+1) and (j-1)→j
-                    double curLen = subRouteLengthCurrentPart
-                        + dist(pts[route[j - 1]], pts[route[j]]);
-
-                    // New edges after reversal: (i+1)→j and i→(j-1)
-                    // Add epsilon to prevent cycles from floating point errors
-                    double newLen = dist(pts[route[i + 1]], pts[route[j]])
-                        + dist(pts[route[i]], pts[route[j - 1]]) + Base::Precision::Confusion();
-
-                    if (newLen < curLen) {
-                        // Reverse the segment between i+1 and j (exclusive)
-                        std::reverse(route.begin() + i + 1, route.begin() + j);
-                        subRouteLengthCurrentPart = dist(pts[route[i]], pts[route[i + 1]]);
-                        reorderFound = true;
-                        lastImprovementAtStep = 1;
-                    }
-                }
-
-                // Open route optimization: can reverse from i to end if no endpoint constraint
-                if (tempEndIdx == -1) {
-                    double curLen = dist(pts[route[i]], pts[route[i + 1]]);
-                    double newLen = dist(pts[route[i]], pts[route[limitReorderJ - 1]])
-                        + Base::Precision::Confusion();
-
-                    if (newLen < curLen) {
-                        // Reverse the order of points after i-th to the last point
-                        std::reverse(route.begin() + i + 1, route.begin() + limitReorderJ);
-                        reorderFound = true;
-                        lastImprovementAtStep = 1;
-                    }
-                }
-            }
-        }
-
-        // --- Relocation Optimization ---
-        // Try moving each point to a different position in the route.
-        // If moving point i to position j improves the route, do it.
-        if (lastImprovementAtStep == 2) {
-            break;
-        }
-        bool relocateFound = true;
-        while (relocateFound) {
-            relocateFound = false;
-            for (size_t i = 1; i < limitRelocationI; ++i) {
-                double subRouteLengthCurrentPart = dist(pts[route[i - 1]], pts[route[i]])
-                    + dist(pts[route[i]], pts[route[i + 1]]);
-                double subRouteLengthNewPart = dist(pts[route[i - 1]], pts[route[i + 1]])
-                    + Base::Precision::Confusion();
-
-                // Try moving point i backward (to positions before i)
-                for (size_t j = 0; j + 2 < i; ++j) {
-                    // Current cost: edges around point i and edge j→(j+1)
-                    double curLen = subRouteLengthCurrentPart
-                        + dist(pts[route[j]], pts[route[j + 1]]);
-
-                    // New cost: bypass i, insert i after j
-                    double newLen = subRouteLengthNewPart + dist(pts[route[j]], pts[route[i]])
-                        + dist(pts[route[i]], pts[route[j + 1]]);
-
-                    if (newLen < curLen) {
-                        // Move point i to position after j
-                        int node = route[i];
-                        route.erase(route.begin() + i);
-                        route.insert(route.begin() + j + 1, node);
-                        subRouteLengthCurrentPart = dist(pts[route[i - 1]], pts[route[i]])
-                            + dist(pts[route[i]], pts[route[i + 1]]);
-                        subRouteLengthNewPart = dist(pts[route[i - 1]], pts[route[i + 1]])
-                            + Base::Precision::Confusion();
-                        relocateFound = true;
-                        lastImprovementAtStep = 2;
-                    }
-                }
-
-                // Try moving point i forward (to positions after i)
-                for (size_t j = i + 1; j < limitRelocationJ; ++j) {
-                    double curLen = subRouteLengthCurrentPart
-                        + dist(pts[route[j]], pts[route[j + 1]]);
-
-                    double newLen = subRouteLengthNewPart + dist(pts[route[j]], pts[route[i]])
-                        + dist(pts[route[i]], pts[route[j + 1]]);
-
-                    if (newLen < curLen) {
-                        int node = route[i];
-                        route.erase(route.begin() + i);
-                        route.insert(route.begin() + j, node);
-                        subRouteLengthCurrentPart = dist(pts[route[i - 1]], pts[route[i]])
-                            + dist(pts[route[i]], pts[route[i + 1]]);
-                        subRouteLengthNewPart = dist(pts[route[i - 1]], pts[route[i + 1]])
-                            + Base::Precision::Confusion();
-                        relocateFound = true;
-                        lastImprovementAtStep = 2;
-                    }
-                }
-            }
-
-            // Open route optimization: can relocate the last point anywhere
-            if (tempEndIdx == -1) {
-                double subRouteLengthCurrentPart
-                    = dist(pts[route[route.size() - 2]], pts[route[route.size() - 1]]);
-
-                for (size_t j = 0; j + 2 < route.size(); ++j) {
-                    double curLen = subRouteLengthCurrentPart
-                        + dist(pts[route[j]], pts[route[j + 1]]);
-
-                    double newLen = dist(pts[route[j]], pts[route[route.size() - 1]])
-                        + dist(pts[route[route.size() - 1]], pts[route[j + 1]])
-                        + Base::Precision::Confusion();
-
-                    if (newLen < curLen) {
-                        // Relocate the last point after j-th point
-                        int node = route[route.size() - 1];
-                        route.erase(route.begin() + route.size() - 1);
-                        route.insert(route.begin() + j + 1, node);
-                        subRouteLengthCurrentPart
-                            = dist(pts[route[route.size() - 2]], pts[route[route.size() - 1]]);
-                        relocateFound = true;
-                        lastImprovementAtStep = 2;
-                    }
-                }
-            }
-        }
-
-        if (lastImprovementAtStep == 0) {
-            break;  // No additional improvements could be made
-        }
+    // For open routes (no endPoint), the moves may also change the end of the route.
+    std::vector<RouteNode> nodes;
+    nodes.reserve(pts.size());
+    for (const TSPPoint& p : pts) {
+        nodes.push_back({p, p, true, false});
     }
+    RouteImprover(nodes, route, tempEndIdx != -1).run();
 
     // ========================================================================
     // STEP 4: Remove temporary start/end points
@@ -415,54 +790,47 @@ std::vector<TSPTunnel> TSPSolver::solveTunnels(
     }
 
     // STEP 2: Apply nearest neighbor algorithm
-    std::vector<TSPTunnel> potentialNeighbours(tunnels.begin() + 1, tunnels.end());
-    std::vector<TSPTunnel> route;
-    route.push_back(tunnels[0]);
-
-    while (!potentialNeighbours.empty()) {
-        double costCurrent = std::numeric_limits<double>::max();
-        bool toBeFlipped = false;
-        auto nearestNeighbour = potentialNeighbours.begin();
-
-        // Check normal orientation
-        for (auto it = potentialNeighbours.begin(); it != potentialNeighbours.end(); ++it) {
-            double dx = route.back().endX - it->startX;
-            double dy = route.back().endY - it->startY;
-            double costNew = dx * dx + dy * dy;
-
-            if (costNew < costCurrent) {
-                costCurrent = costNew;
-                toBeFlipped = false;
-                nearestNeighbour = it;
+    // The entries of the tunnels are kept in a k-d tree, the exits of open tunnels are added
+    // behind them as entries of the flipped tunnels. On equal distances the smaller index wins,
+    // so a tunnel is only flipped if this is shorter.
+    std::vector<TSPPoint> entries;
+    std::vector<int> entryTunnel;
+    std::vector<int> flippedEntry(tunnels.size(), -1);
+    for (size_t i = 1; i < tunnels.size(); ++i) {
+        entries.emplace_back(tunnels[i].startX, tunnels[i].startY);
+        entryTunnel.push_back(static_cast<int>(i));
+    }
+    if (allowFlipping) {
+        for (size_t i = 1; i < tunnels.size(); ++i) {
+            if (tunnels[i].isOpen) {
+                flippedEntry[i] = static_cast<int>(entries.size());
+                entries.emplace_back(tunnels[i].endX, tunnels[i].endY);
+                entryTunnel.push_back(static_cast<int>(i));
             }
         }
+    }
 
-        // Check flipped orientation if allowed
-        if (allowFlipping) {
-            for (auto it = potentialNeighbours.begin(); it != potentialNeighbours.end(); ++it) {
-                if (it->isOpen) {
-                    double dx = route.back().endX - it->endX;
-                    double dy = route.back().endY - it->endY;
-                    double costNew = dx * dx + dy * dy;
+    KdTree tree(entries);
+    std::vector<TSPTunnel> route;
+    route.push_back(tunnels[0]);
 
-                    if (costNew < costCurrent) {
-                        costCurrent = costNew;
-                        toBeFlipped = true;
-                        nearestNeighbour = it;
-                    }
-                }
-            }
-        }
+    while (route.size() < tunnels.size()) {
+        int entry = tree.nearest(TSPPoint(route.back().endX, route.back().endY));
+        int idx = entryTunnel[entry];
+        TSPTunnel& nearestNeighbour = tunnels[idx];
 
         // Apply flipping if needed
-        if (toBeFlipped) {
-            nearestNeighbour->flipped = !nearestNeighbour->flipped;
-            std::swap(nearestNeighbour->startX, nearestNeighbour->endX);
-            std::swap(nearestNeighbour->startY, nearestNeighbour->endY);
+        if (entry == flippedEntry[idx]) {
+            nearestNeighbour.flipped = !nearestNeighbour.flipped;
+            std::swap(nearestNeighbour.startX, nearestNeighbour.endX);
+            std::swap(nearestNeighbour.startY, nearestNeighbour.endY);
         }
 
-        route.push_back(*nearestNeighbour);
-        potentialNeighbours.erase(nearestNeighbour);
+        route.push_back(nearestNeighbour);
+        tree.remove(idx - 1);  // entry in the original direction
+        if (flippedEntry[idx] != -1) {
+            tree.remove(flippedEntry[idx]);
+        }
     }
 
     // STEP 3: Add the routeEndPoint (will be deleted at the end)
@@ -473,297 +841,33 @@ std::vector<TSPTunnel> TSPSolver::solveTunnels(
     }
 
     // STEP 4: Additional improvement of the route
-    size_t limitReorderI = route.size() - 2;
-    if (routeEndPoint) {
-        limitReorderI -= 1;
+    // 2-opt reverses the order of tunnels and flips them, so it is only applied to open
+    // tunnels if flipping is allowed. Or-opt relocates tunnels.
+    std::vector<RouteNode> nodes;
+    std::vector<int> order;
+    for (const TSPTunnel& tunnel : route) {
+        nodes.push_back(
+            {TSPPoint(tunnel.startX, tunnel.startY),
+             TSPPoint(tunnel.endX, tunnel.endY),
+             allowFlipping && tunnel.isOpen,
+             false}
+        );
+        order.push_back(static_cast<int>(order.size()));
     }
-    size_t limitReorderJ = route.size();
-    size_t limitFlipI = route.size() - 1;
-    size_t limitRelocationI = route.size() - 1;
-    size_t limitRelocationJ = route.size() - 1;
-    int lastImprovementAtStep = 0;
-
-    while (true) {
-
-        if (allowFlipping) {
-            // STEP 4.1: Apply 2-opt
-            if (lastImprovementAtStep == 1) {
-                break;
-            }
-            bool improvementFound = true;
-            while (improvementFound) {
-                improvementFound = false;
-                for (size_t i = 0; i < limitReorderI; ++i) {
-                    double subRouteLengthCurrentPart = std::sqrt(
-                        std::pow(route[i].endX - route[i + 1].startX, 2)
-                        + std::pow(route[i].endY - route[i + 1].startY, 2)
-                    );
-                    for (size_t j = i + 3; j < limitReorderJ; ++j) {
-                        double subRouteLengthCurrent = subRouteLengthCurrentPart;
-                        subRouteLengthCurrent += std::sqrt(
-                            std::pow(route[j - 1].endX - route[j].startX, 2)
-                            + std::pow(route[j - 1].endY - route[j].startY, 2)
-                        );
-                        double subRouteLengthNew = std::sqrt(
-                            std::pow(route[i + 1].startX - route[j].startX, 2)
-                            + std::pow(route[i + 1].startY - route[j].startY, 2)
-                        );
-                        subRouteLengthNew += std::sqrt(
-                            std::pow(route[i].endX - route[j - 1].endX, 2)
-                            + std::pow(route[i].endY - route[j - 1].endY, 2)
-                        );
-                        subRouteLengthNew += Base::Precision::Confusion();
-
-                        if (subRouteLengthNew < subRouteLengthCurrent) {
-                            // Flip direction of each tunnel between i-th and j-th tunnel
-                            for (size_t k = i + 1; k < j; ++k) {
-                                if (route[k].isOpen) {
-                                    route[k].flipped = !route[k].flipped;
-                                    std::swap(route[k].startX, route[k].endX);
-                                    std::swap(route[k].startY, route[k].endY);
-                                }
-                            }
-                            // Reverse the order of tunnels between i-th and j-th tunnel
-                            std::reverse(route.begin() + i + 1, route.begin() + j);
-                            subRouteLengthCurrentPart = std::sqrt(
-                                std::pow(route[i].endX - route[i + 1].startX, 2)
-                                + std::pow(route[i].endY - route[i + 1].startY, 2)
-                            );
-                            improvementFound = true;
-                            lastImprovementAtStep = 1;
-                        }
-                    }
-                    if (!routeEndPoint) {
-                        double subRouteLengthCurrent = std::sqrt(
-                            std::pow(route[i].endX - route[i + 1].startX, 2)
-                            + std::pow(route[i].endY - route[i + 1].startY, 2)
-                        );
-                        double subRouteLengthNew = std::sqrt(
-                            std::pow(route[i].endX - route[route.size() - 1].endX, 2)
-                            + std::pow(route[i].endY - route[route.size() - 1].endY, 2)
-                        );
-                        subRouteLengthNew += Base::Precision::Confusion();
-                        if (subRouteLengthNew < subRouteLengthCurrent) {
-                            // Flip direction of each tunnel after i-th to the last tunnel
-                            for (size_t k = i + 1; k < limitReorderJ; ++k) {
-                                if (route[k].isOpen) {
-                                    route[k].flipped = !route[k].flipped;
-                                    std::swap(route[k].startX, route[k].endX);
-                                    std::swap(route[k].startY, route[k].endY);
-                                }
-                            }
-                            // Reverse the order of tunnels after i-th to the last tunnel
-                            std::reverse(route.begin() + i + 1, route.begin() + limitReorderJ);
-                            improvementFound = true;
-                            lastImprovementAtStep = 1;
-                        }
-                    }
-                }
-            }
-
-            // STEP 4.2: Apply flipping
-            if (lastImprovementAtStep == 2) {
-                break;
-            }
-            improvementFound = true;
-            while (improvementFound) {
-                improvementFound = false;
-                for (size_t i = 1; i < limitFlipI; ++i) {
-                    if (route[i].isOpen) {
-                        double subRouteLengthCurrent = std::sqrt(
-                            std::pow(route[i - 1].endX - route[i].startX, 2)
-                            + std::pow(route[i - 1].endY - route[i].startY, 2)
-                        );
-                        subRouteLengthCurrent += std::sqrt(
-                            std::pow(route[i].endX - route[i + 1].startX, 2)
-                            + std::pow(route[i].endY - route[i + 1].startY, 2)
-                        );
-
-                        double subRouteLengthNew = std::sqrt(
-                            std::pow(route[i - 1].endX - route[i].endX, 2)
-                            + std::pow(route[i - 1].endY - route[i].endY, 2)
-                        );
-                        subRouteLengthNew += std::sqrt(
-                            std::pow(route[i].startX - route[i + 1].startX, 2)
-                            + std::pow(route[i].startY - route[i + 1].startY, 2)
-                        );
-                        subRouteLengthNew += Base::Precision::Confusion();
-
-                        if (subRouteLengthNew < subRouteLengthCurrent) {
-                            // Flip direction of i-th tunnel
-                            route[i].flipped = !route[i].flipped;
-                            std::swap(route[i].startX, route[i].endX);
-                            std::swap(route[i].startY, route[i].endY);
-                            improvementFound = true;
-                            lastImprovementAtStep = 2;
-                        }
-                    }
-                }
-                if (!routeEndPoint) {
-                    if (route[route.size() - 1].isOpen) {
-                        double subRouteLengthCurrent = std::sqrt(
-                            std::pow(route[route.size() - 2].endX - route[route.size() - 1].startX, 2)
-                            + std::pow(route[route.size() - 2].endY - route[route.size() - 1].startY, 2)
-                        );
-                        double subRouteLengthNew = std::sqrt(
-                            std::pow(route[route.size() - 2].endX - route[route.size() - 1].endX, 2)
-                            + std::pow(route[route.size() - 2].endY - route[route.size() - 1].endY, 2)
-                        );
-                        subRouteLengthNew += Base::Precision::Confusion();
-                        if (subRouteLengthNew < subRouteLengthCurrent) {
-                            // Flip direction of the last tunnel
-                            route[route.size() - 1].flipped = !route[route.size() - 1].flipped;
-                            std::swap(route[route.size() - 1].startX, route[route.size() - 1].endX);
-                            std::swap(route[route.size() - 1].startY, route[route.size() - 1].endY);
-                            improvementFound = true;
-                            lastImprovementAtStep = 2;
-                        }
-                    }
-                }
-            }
-        }
-
-        // STEP 4.3: Apply relocation
-        if (lastImprovementAtStep == 3) {
-            break;
-        }
-        bool improvementFound = true;
-        while (improvementFound) {
-            improvementFound = false;
-            for (size_t i = 1; i < limitRelocationI; ++i) {
-                double subRouteLengthCurrentPart = std::sqrt(
-                    std::pow(route[i - 1].endX - route[i].startX, 2)
-                    + std::pow(route[i - 1].endY - route[i].startY, 2)
-                );
-                subRouteLengthCurrentPart += std::sqrt(
-                    std::pow(route[i].endX - route[i + 1].startX, 2)
-                    + std::pow(route[i].endY - route[i + 1].startY, 2)
-                );
-                double subRouteLengthNewPart = std::sqrt(
-                    std::pow(route[i - 1].endX - route[i + 1].startX, 2)
-                    + std::pow(route[i - 1].endY - route[i + 1].startY, 2)
-                );
-                subRouteLengthNewPart += Base::Precision::Confusion();
-
-                // Try relocating backward
-                for (size_t j = 0; j + 2 < i; ++j) {
-                    double subRouteLengthCurrent = subRouteLengthCurrentPart;
-                    subRouteLengthCurrent += std::sqrt(
-                        std::pow(route[j].endX - route[j + 1].startX, 2)
-                        + std::pow(route[j].endY - route[j + 1].startY, 2)
-                    );
-                    double subRouteLengthNew = subRouteLengthNewPart;
-                    subRouteLengthNew += std::sqrt(
-                        std::pow(route[j].endX - route[i].startX, 2)
-                        + std::pow(route[j].endY - route[i].startY, 2)
-                    );
-                    subRouteLengthNew += std::sqrt(
-                        std::pow(route[i].endX - route[j + 1].startX, 2)
-                        + std::pow(route[i].endY - route[j + 1].startY, 2)
-                    );
-                    if (subRouteLengthNew < subRouteLengthCurrent) {
-                        // Relocate the i-th tunnel backward (after j-th tunnel)
-                        TSPTunnel temp = route[i];
-                        route.erase(route.begin() + i);
-                        route.insert(route.begin() + j + 1, temp);
-                        subRouteLengthCurrentPart = std::sqrt(
-                            std::pow(route[i - 1].endX - route[i].startX, 2)
-                            + std::pow(route[i - 1].endY - route[i].startY, 2)
-                        );
-                        subRouteLengthCurrentPart += std::sqrt(
-                            std::pow(route[i].endX - route[i + 1].startX, 2)
-                            + std::pow(route[i].endY - route[i + 1].startY, 2)
-                        );
-                        subRouteLengthNewPart = std::sqrt(
-                            std::pow(route[i - 1].endX - route[i + 1].startX, 2)
-                            + std::pow(route[i - 1].endY - route[i + 1].startY, 2)
-                        );
-                        subRouteLengthNewPart += Base::Precision::Confusion();
-                        improvementFound = true;
-                        lastImprovementAtStep = 3;
-                    }
-                }
-
-                // Try relocating forward
-                for (size_t j = i + 1; j < limitRelocationJ; ++j) {
-                    double subRouteLengthCurrent = subRouteLengthCurrentPart;
-                    subRouteLengthCurrent += std::sqrt(
-                        std::pow(route[j].endX - route[j + 1].startX, 2)
-                        + std::pow(route[j].endY - route[j + 1].startY, 2)
-                    );
-                    double subRouteLengthNew = subRouteLengthNewPart;
-                    subRouteLengthNew += std::sqrt(
-                        std::pow(route[j].endX - route[i].startX, 2)
-                        + std::pow(route[j].endY - route[i].startY, 2)
-                    );
-                    subRouteLengthNew += std::sqrt(
-                        std::pow(route[i].endX - route[j + 1].startX, 2)
-                        + std::pow(route[i].endY - route[j + 1].startY, 2)
-                    );
-                    if (subRouteLengthNew < subRouteLengthCurrent) {
-                        // Relocate the i-th tunnel forward (after j-th tunnel)
-                        TSPTunnel temp = route[i];
-                        route.erase(route.begin() + i);
-                        route.insert(route.begin() + j, temp);
-                        subRouteLengthCurrentPart = std::sqrt(
-                            std::pow(route[i - 1].endX - route[i].startX, 2)
-                            + std::pow(route[i - 1].endY - route[i].startY, 2)
-                        );
-                        subRouteLengthCurrentPart += std::sqrt(
-                            std::pow(route[i].endX - route[i + 1].startX, 2)
-                            + std::pow(route[i].endY - route[i + 1].startY, 2)
-                        );
-                        subRouteLengthNewPart = std::sqrt(
-                            std::pow(route[i - 1].endX - route[i + 1].startX, 2)
-                            + std::pow(route[i - 1].endY - route[i + 1].startY, 2)
-                        );
-                        subRouteLengthNewPart += Base::Precision::Confusion();
-                        improvementFound = true;
-                        lastImprovementAtStep = 3;
-                    }
-                }
-            }
-            if (!routeEndPoint) {
-                double subRouteLengthCurrentPart = std::sqrt(
-                    std::pow(route[route.size() - 2].endX - route[route.size() - 1].startX, 2)
-                    + std::pow(route[route.size() - 2].endY - route[route.size() - 1].startY, 2)
-                );
-                for (size_t j = 0; j + 2 < route.size(); ++j) {
-                    double subRouteLengthCurrent = subRouteLengthCurrentPart;
-                    subRouteLengthCurrent += std::sqrt(
-                        std::pow(route[j].endX - route[j + 1].startX, 2)
-                        + std::pow(route[j].endY - route[j + 1].startY, 2)
-                    );
-                    double subRouteLengthNew = std::sqrt(
-                        std::pow(route[j].endX - route[route.size() - 1].startX, 2)
-                        + std::pow(route[j].endY - route[route.size() - 1].startY, 2)
-                    );
-                    subRouteLengthNew += std::sqrt(
-                        std::pow(route[route.size() - 1].endX - route[j + 1].startX, 2)
-                        + std::pow(route[route.size() - 1].endY - route[j + 1].startY, 2)
-                    );
-                    subRouteLengthNew += Base::Precision::Confusion();
-                    if (subRouteLengthNew < subRouteLengthCurrent) {
-                        // Relocate the last tunnel after j-th tunnel
-                        TSPTunnel temp = route[route.size() - 1];
-                        route.erase(route.begin() + route.size() - 1);
-                        route.insert(route.begin() + j + 1, temp);
-                        subRouteLengthCurrentPart = std::sqrt(
-                            std::pow(route[route.size() - 2].endX - route[route.size() - 1].startX, 2)
-                            + std::pow(route[route.size() - 2].endY - route[route.size() - 1].startY, 2)
-                        );
-                        improvementFound = true;
-                        lastImprovementAtStep = 3;
-                    }
-                }
-            }
-        }
-
-        if (lastImprovementAtStep == 0) {
-            break;  // No additional improvements could be made
+    RouteImprover(nodes, order, routeEndPoint != nullptr).run();
+
+    std::vector<TSPTunnel> improved;
+    improved.reserve(route.size());
+    for (int idx : order) {
+        TSPTunnel tunnel = route[idx];
+        if (nodes[idx].flipped) {
+            tunnel.flipped = !tunnel.flipped;
+            std::swap(tunnel.startX, tunnel.endX);
+            std::swap(tunnel.startY, tunnel.endY);
         }
+        improved.push_back(tunnel);
     }
-
+    route = std::move(improved);
     // STEP 5: Delete temporary start and end point
     if (!route.empty()) {
         route.erase(route.begin());  // Remove temp start
@@ -0,0 +1,163 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# ***************************************************************************
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+import FreeCAD
+import Part
+import Path
+import PathSimulator
+
+from CAMTests.PathTestUtils import PathTestBase
+
+
+class TestPathSimulator(PathTestBase):
+    """Test the headless verification of the heightmap simulator."""
+
+    def setUp(self):
+        # a 20x20x10 stock with a 5mm high target and a 2mm flat end mill
+        self.sim = PathSimulator.PathSim()
+        self.sim.BeginSimulation(stock=Part.makeBox(20, 20, 10), resolution=0.1)
+        self.sim.SetTargetShape(Part.makeBox(20, 20, 5), 0.1)
+        self.sim.SetToolShape(Part.makeCylinder(1, 10), 0.1)
+        self.start = FreeCAD.Placement(FreeCAD.Vector(0, 0, 12), FreeCAD.Rotation())
+
+    def cut(self, commands):
+        path = Path.Path([Path.Command(name, params) for name, params in commands])
+        return self.sim.ApplyToolpath(position=self.start, toolpath=path)
+
+    def test00(self):
+        """Verify the untouched stock"""
+        report = self.sim.Verify()
+        self.assertRoughly(report["Volume"], 4000, 0.01)
+        self.assertRoughly(report["MinRemaining"], 5, 0.01)
+        self.assertRoughly(report["MaxRemaining"], 5, 0.01)
+        self.assertEqual(report["GougeVolume"], 0)
+        self.assertEqual(len(report["Gouges"]), 0)
+
+    def test01(self):
+        """Verify a slot above the target"""
+        volume = self.sim.Verify()["Volume"]
+        pos = self.cut(
+            [
+                ("G0", {"X": 5, "Y": 10, "Z": 12}),
+                ("G1", {"Z": 6}),
+                ("G1", {"X": 15}),
+                ("G0", {"Z": 12}),
+            ]
+        )
+        self.assertRoughly(pos.Base.x, 15)
+        self.assertRoughly(pos.Base.z, 12)
+
+        report = self.sim.Verify()
+        # a 2x10 slot with round ends, 4mm deep
+        removed = volume - report["Volume"]
+        self.assertRoughly(removed, (2 * 10 + 3.1416) * 4, 10)
+        self.assertRoughly(report["MinRemaining"], 1, 0.01)
+        self.assertEqual(len(report["Gouges"]), 0)
+
+    def test02(self):
+        """Verify a plunge below the target"""
+        self.cut(
+            [
+                ("G0", {"X": 5, "Y": 5, "Z": 12}),
+                ("G1", {"Z": 3}),
+                ("G0", {"Z": 12}),
+            ]
+        )
+
+        report = self.sim.Verify(tolerance=0.01)
+        self.assertRoughly(report["MinRemaining"], -2, 0.01)
+        self.assertEqual(len(report["Gouges"]), 1)
+        gouge = report["Gouges"][0]
+        self.assertRoughly(gouge["MaxDepth"], 2, 0.01)
+        self.assertRoughly(gouge["Area"], 3.1416, 0.3)
+        self.assertRoughly(gouge["Volume"], 2 * 3.1416, 0.6)
+        self.assertTrue(gouge["BoundBox"].isInside(FreeCAD.Vector(5, 5, 0)))
+
+        # a tolerance deeper than the gouge accepts it
+        self.assertEqual(len(self.sim.Verify(tolerance=2.5)["Gouges"]), 0)
+
+    def test03(self):
+        """Verify a drilling cycle"""
+        self.cut(
+            [
+                ("G0", {"X": 10, "Y": 10, "Z": 12}),
+                ("G81", {"X": 10, "Y": 10, "Z": 4, "R": 11}),
+                ("G80", {}),
+            ]
+        )
+
+        report = self.sim.Verify()
+        self.assertEqual(len(report["Gouges"]), 1)
+        self.assertRoughly(report["Gouges"][0]["MaxDepth"], 1, 0.01)
+
+    def test04(self):
+        """Verify a rapid move into the stock"""
+        self.cut(
+            [
+                ("G0", {"X": 5, "Y": 10, "Z": 12}),
+                ("G0", {"Z": 8}),
+                ("G1", {"X": 15}),
+                ("G0", {"Z": 12}),
+            ]
+        )
+
+        # only the rapid plunge is reported, not the slot cut at feed rate
+        cuts = self.sim.GetRapidCuts()
+        self.assertEqual(len(cuts), 1)
+        self.assertEqual(cuts[0]["Command"], 1)
+        self.assertRoughly(cuts[0]["Start"].z, 12)
+        self.assertRoughly(cuts[0]["End"].z, 8)
+        self.assertRoughly(cuts[0]["Volume"], 2 * 3.1416, 0.6)
+
+        # rapid moves above the stock don't cut
+        self.cut([("G0", {"X": 5, "Y": 5, "Z": 12}), ("G0", {"X": 15})])
+        self.assertEqual(len(self.sim.GetRapidCuts()), 0)
+
+    def test05(self):
+        """Verify the rapid cuts in the report of a job"""
+        import Path.Main.Job as PathJob
+        import Path.Main.Verify as PathVerify
+        import Path.Op.Custom as PathCustom
+
+        doc = FreeCAD.newDocument("TestPathSimulator")
+        try:
+            box = doc.addObject("Part::Box", "Box")
+            box.Length = 20
+            box.Width = 20
+            box.Height = 10
+            doc.recompute()
+            job = PathJob.Create("Job", [box], None)
+
+            # a rapid plunge into the stock, which is at least as high as the model
+            op = PathCustom.Create("Custom")
+            op.Gcode = ["G0 Z20", "G0 X10 Y10", "G0 Z8", "G0 Z20"]
+            doc.recompute()
+
+            report = PathVerify.verifyJob(job, resolution=0.5)
+            self.assertEqual(len(report["Operations"]), 1)
+            cuts = report["Operations"][0]["RapidCuts"]
+            self.assertEqual(len(cuts), 1)
+            self.assertRoughly(cuts[0]["End"][2], 8)
+            self.assertGreater(cuts[0]["Volume"], 0)
+            self.assertRoughly(report["RapidCutVolume"], cuts[0]["Volume"])
+        finally:
+            FreeCAD.closeDocument(doc.Name)
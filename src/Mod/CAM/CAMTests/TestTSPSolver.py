@@ -23,6 +23,7 @@
 
 import FreeCAD
 import math
+import random
 import tsp_solver
 import PathScripts.PathUtils as PathUtils
 from CAMTests.PathTestUtils import PathTestBase
@@ -442,6 +443,53 @@ class TestTSPSolver(PathTestBase):
             elif tunnel["index"] == 1:
                 self.assertEqual(tunnel["notes"], "high precision")
 
+    def test_10_large_grid(self):
+        """Test TSP solver on a shuffled grid with many points."""
+        points = [(x, y) for x in range(40) for y in range(50)]
+        random.Random(1).shuffle(points)
+
+        route = tsp_solver.solve(points, startPoint=[-1, -1], endPoint=[40, 50])
+
+        self.assertEqual(sorted(route), list(range(len(points))))
+        self.assertEqual(points[route[0]], (0, 0))
+        self.assertEqual(points[route[-1]], (39, 49))
+
+        # the shortest route has a length of 1999 (one step per point)
+        total_distance = sum(
+            math.dist(points[route[i]], points[route[i + 1]]) for i in range(len(route) - 1)
+        )
+        self.assertLess(total_distance, 1999 * 1.2)
+
+        # the improvement is bounded by a number of steps, not by time
+        again = tsp_solver.solve(points, startPoint=[-1, -1], endPoint=[40, 50])
+        self.assertEqual(again, route)
+
+    def test_11_closed_tunnels(self):
+        """Test that tunnels which aren't open are never flipped."""
+        rng = random.Random(2)
+        tunnels = []
+        for i in range(300):
+            x, y = rng.uniform(0, 100), rng.uniform(0, 100)
+            tunnels.append(
+                {
+                    "startX": x,
+                    "startY": y,
+                    "endX": x + rng.uniform(-5, 5),
+                    "endY": y + rng.uniform(-5, 5),
+                    "isOpen": i % 3 != 0,
+                }
+            )
+
+        result = PathUtils.sort_tunnels_tsp(tunnels, allowFlipping=True)
+
+        self.assertEqual(sorted(tunnel["index"] for tunnel in result), list(range(len(tunnels))))
+        for tunnel in result:
+            original = tunnels[tunnel["index"]]
+            if not original["isOpen"]:
+                self.assertFalse(tunnel["flipped"])
+            start = "endX" if tunnel["flipped"] else "startX"
+            self.assertRoughly(tunnel["startX"], original[start], 0.001)
+
 
 if __name__ == "__main__":
     import unittest
@@ -0,0 +1,222 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# ***************************************************************************
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+"""
+Headless verification of CAM jobs with the heightmap simulator.
+
+The operations of a job are cut from its stock and the result is compared
+with the job's models. The report contains the removed volume, the cycle time
+of each operation, the remaining stock above the models and the regions cut
+below the model surface (gouges). Rapid moves that remove stock are listed with
+the operation they belong to. Collisions of the tool holder or the spindle with
+the stock or the fixtures are not checked.
+
+It doesn't need a GUI, so it can be run from FreeCADCmd, e.g. on a build
+server. Each process verifies the given files, so several jobs can be checked
+in parallel by starting several processes:
+
+    FreeCADCmd <path>/Path/Main/Verify.py --pass [options] job1.FCStd ...
+
+The report is printed as JSON, the exit code is 1 if a job has gouges or
+rapid moves that cut the stock.
+"""
+
+import argparse
+import json
+import sys
+
+import FreeCAD
+import Part
+import Path
+import Path.Log
+import Path.Base.Util as PathUtil
+import Path.Dressup.Utils as PathDressup
+import PathScripts.PathUtils as PathUtils
+import PathSimulator
+
+
+if False:
+    Path.Log.setLevel(Path.Log.Level.DEBUG, Path.Log.thisModule())
+    Path.Log.trackModule(Path.Log.thisModule())
+else:
+    Path.Log.setLevel(Path.Log.Level.INFO, Path.Log.thisModule())
+
+
+def defaultResolution(job):
+    """defaultResolution(job) ... pixel size used if none is given, 1/200 of the stock size"""
+    bb = job.Stock.Shape.BoundBox
+    return 0.005 * max(bb.XLength, bb.YLength)
+
+
+def _cycleTime(op, path):
+    """Returns the cycle time of the operation in seconds, or None if there are no feeds."""
+    tc = PathUtil.opProperty(op, "ToolController")
+    if tc is None or tc.HorizFeed.Value == 0 or tc.VertFeed.Value == 0:
+        return None
+    return path.getCycleTime(
+        tc.HorizFeed.Value, tc.VertFeed.Value, tc.HorizRapid.Value, tc.VertRapid.Value
+    )
+
+
+def _gouges(report):
+    gouges = []
+    for region in report["Gouges"]:
+        bb = region["BoundBox"]
+        gouges.append(
+            {
+                "Area": region["Area"],
+                "Volume": region["Volume"],
+                "MaxDepth": region["MaxDepth"],
+                "BoundBox": [bb.XMin, bb.YMin, bb.XMax, bb.YMax],
+            }
+        )
+    return gouges
+
+
+def _rapidCuts(sim):
+    cuts = []
+    for cut in sim.GetRapidCuts():
+        cuts.append(
+            {
+                "Command": cut["Command"],
+                "Start": [cut["Start"].x, cut["Start"].y, cut["Start"].z],
+                "End": [cut["End"].x, cut["End"].y, cut["End"].z],
+                "Volume": cut["Volume"],
+            }
+        )
+    return cuts
+
+
+def verifyJob(job, resolution=None, tolerance=0.0):
+    """verifyJob(job, resolution=None, tolerance=0.0) ... simulates all active operations of
+    the job and returns a dict with the results. Cuts deeper than tolerance below the models
+    are reported as gouges."""
+    if resolution is None:
+        resolution = defaultResolution(job)
+
+    stock = job.Stock.Shape
+    sim = PathSimulator.PathSim()
+    sim.BeginSimulation(stock=stock, resolution=resolution)
+    target = Part.makeCompound([model.Shape for model in job.Model.Group])
+    sim.SetTargetShape(target, resolution)
+
+    stockVolume = sim.Verify(tolerance)["Volume"]
+    volume = stockVolume
+    pos = FreeCAD.Placement(FreeCAD.Vector(0, 0, stock.BoundBox.ZMax), FreeCAD.Rotation())
+    operations = []
+    for op in job.Operations.OutList:
+        if not PathUtil.opProperty(op, "Active"):
+            continue
+
+        result = {"Name": op.Name, "Label": op.Label}
+        try:
+            tc = PathDressup.toolController(op)
+            sim.SetToolShape(tc.Tool.Shape, resolution)
+            result["ToolController"] = tc.Label
+        except Exception as e:
+            Path.Log.error("{}: no valid tool - {}".format(op.Label, e))
+            result["Error"] = str(e)
+            operations.append(result)
+            continue
+
+        path = PathUtils.getPathWithPlacement(op)
+        rapidCuts = []
+        if path is not None:
+            pos = sim.ApplyToolpath(position=pos, toolpath=path)
+            rapidCuts = _rapidCuts(sim)
+        newVolume = sim.Verify(tolerance)["Volume"]
+        result["CycleTime"] = _cycleTime(op, path) if path is not None else 0
+        result["RemovedVolume"] = volume - newVolume
+        result["RapidCuts"] = rapidCuts
+        volume = newVolume
+        operations.append(result)
+
+    report = sim.Verify(tolerance)
+    return {
+        "Job": job.Label,
+        "Resolution": resolution,
+        "Tolerance": tolerance,
+        "StockVolume": stockVolume,
+        "RemovedVolume": stockVolume - report["Volume"],
+        "CycleTime": sum(result.get("CycleTime") or 0 for result in operations),
+        "RapidCutVolume": sum(
+            cut["Volume"] for result in operations for cut in result.get("RapidCuts", [])
+        ),
+        "Operations": operations,
+        "TargetArea": report["TargetArea"],
+        "MinRemaining": report["MinRemaining"],
+        "MaxRemaining": report["MaxRemaining"],
+        "MeanRemaining": report["MeanRemaining"],
+        "GougeVolume": report["GougeVolume"],
+        "Gouges": _gouges(report),
+    }
+
+
+def verifyDocument(doc, resolution=None, tolerance=0.0):
+    """verifyDocument(doc, resolution=None, tolerance=0.0) ... returns the reports of all
+    jobs in the document"""
+    import Path.Main.Job as PathJob
+
+    jobs = [
+        obj
+        for obj in doc.Objects
+        if hasattr(obj, "Proxy") and isinstance(obj.Proxy, PathJob.ObjectJob)
+    ]
+    return [verifyJob(job, resolution, tolerance) for job in jobs]
+
+
+def main(args):
+    """main(args) ... verifies all jobs of the given files and prints the reports as JSON.
+    Returns 1 if any job has gouges or rapid moves that cut the stock, otherwise 0."""
+    parser = argparse.ArgumentParser(prog="Verify", description="Verify CAM jobs")
+    parser.add_argument("files", nargs="+", help="documents with the jobs to verify")
+    parser.add_argument("--resolution", type=float, help="pixel size of the simulation in mm")
+    parser.add_argument(
+        "--tolerance", type=float, default=0.0, help="allowed depth of cuts below the models"
+    )
+    parser.add_argument("--output", help="write the report to this file instead of stdout")
+    options = parser.parse_args(args)
+
+    reports = {}
+    for name in options.files:
+        doc = FreeCAD.openDocument(name, hidden=True)
+        try:
+            reports[name] = verifyDocument(doc, options.resolution, options.tolerance)
+        finally:
+            FreeCAD.closeDocument(doc.Name)
+
+    text = json.dumps(reports, indent=2)
+    if options.output:
+        with open(options.output, "w") as f:
+            f.write(text)
+    else:
+        print(text)
+
+    failed = any(
+        job["Gouges"] or job["RapidCutVolume"] > 0 for jobs in reports.values() for job in jobs
+    )
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    argv = sys.argv[sys.argv.index("--pass") + 1 :] if "--pass" in sys.argv else sys.argv[1:]
+    sys.exit(main(argv))
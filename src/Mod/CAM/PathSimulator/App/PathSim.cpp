@@ -22,6 +22,9 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <set>
+
+#include <Base/Exception.h>
 
 #include "PathSim.h"
 
@@ -62,15 +65,15 @@ Base::Placement* PathSim::ApplyCommand(Base::Placement* pos, Command* cmd)
     Point3D toPos(*pos);
     toPos.UpdateCmd(*cmd);
     if (m_tool) {
-        if (cmd->Name == "G0" || cmd->Name == "G1") {
+        if (cmd->Name == "G0" || cmd->Name == "G1" || cmd->Name == "G00" || cmd->Name == "G01") {
             m_stock->ApplyLinearTool(fromPos, toPos, *m_tool);
         }
-        else if (cmd->Name == "G2") {
+        else if (cmd->Name == "G2" || cmd->Name == "G02") {
             Vector3d vcent = cmd->getCenter();
             Point3D cent(vcent);
             m_stock->ApplyCircularTool(fromPos, toPos, cent, *m_tool, false);
         }
-        else if (cmd->Name == "G3") {
+        else if (cmd->Name == "G3" || cmd->Name == "G03") {
             Vector3d vcent = cmd->getCenter();
             Point3D cent(vcent);
             m_stock->ApplyCircularTool(fromPos, toPos, cent, *m_tool, true);
@@ -82,3 +85,101 @@ Base::Placement* PathSim::ApplyCommand(Base::Placement* pos, Command* cmd)
     plc->setPosition(vec);
     return plc;
 }
+
+Base::Placement PathSim::ApplyToolpath(const Base::Placement& pos, const Toolpath& path)
+{
+    if (!m_stock) {
+        throw Base::RuntimeError("Path Simulation: Simulation has no stock object");
+    }
+
+    // rapid moves are tracked to report the ones that cut the stock
+    std::vector<RapidCut> rapids;
+    std::size_t index = 0;
+    Base::Placement curPos(pos);
+    auto apply = [this, &curPos, &rapids, &index](Command& cmd) {
+        if (m_tool && (cmd.Name == "G0" || cmd.Name == "G00")) {
+            Point3D fromPos(curPos);
+            Point3D toPos(curPos);
+            toPos.UpdateCmd(cmd);
+            m_stock->ApplyLinearTool(fromPos, toPos, *m_tool, static_cast<int>(rapids.size()));
+            Base::Vector3d start = curPos.getPosition();
+            Base::Vector3d end(toPos.x, toPos.y, toPos.z);
+            rapids.push_back({index, start, end, 0.0});
+            curPos.setPosition(end);
+            return;
+        }
+        std::unique_ptr<Base::Placement> newPos(ApplyCommand(&curPos, &cmd));
+        curPos = *newPos;
+    };
+
+    // drilling cycles are expanded into single moves like in the GUI simulator
+    static const std::set<std::string> resetDrill
+        = {"G0", "G00", "G1", "G01", "G2", "G02", "G3", "G03", "G80"};
+    bool firstDrill = true;
+    for (; index < path.getCommands().size(); index++) {
+        Command* cmd = path.getCommands()[index];
+        const std::string& name = cmd->Name;
+        if (name == "G73" || name == "G81" || name == "G82" || name == "G83") {
+            Base::Vector3d cur = curPos.getPosition();
+            double x = cmd->getParam("X", cur.x);
+            double y = cmd->getParam("Y", cur.y);
+            double z = cmd->getParam("Z", cur.z);
+            double r = cmd->getParam("R", cur.z);
+            if (firstDrill) {
+                Command retract("G0", {{"Z", r}});
+                apply(retract);
+                firstDrill = false;
+            }
+            Command moveTo("G0", {{"X", x}, {"Y", y}, {"Z", r}});
+            apply(moveTo);
+            Command drill("G1", {{"X", x}, {"Y", y}, {"Z", z}});
+            apply(drill);
+            Command retract("G1", {{"X", x}, {"Y", y}, {"Z", r}});
+            apply(retract);
+            continue;
+        }
+
+        if (resetDrill.count(name) > 0) {
+            firstDrill = true;
+        }
+        apply(*cmd);
+    }
+
+    m_rapidCuts.clear();
+    for (const auto& it : m_stock->TakeRapidCuts()) {
+        RapidCut cut = rapids[it.first];
+        cut.volume = it.second;
+        m_rapidCuts.push_back(cut);
+    }
+    return curPos;
+}
+
+void PathSim::SetTargetShape(const Part::TopoShape& target, float accuracy)
+{
+    if (!m_stock) {
+        throw Base::RuntimeError("Path Simulation: Simulation has no stock object");
+    }
+
+    std::vector<Base::Vector3d> points;
+    std::vector<Data::ComplexGeoData::Facet> facets;
+    target.getFaces(points, facets, accuracy);
+
+    std::vector<Triangle3D> triangles;
+    triangles.reserve(facets.size());
+    for (const auto& facet : facets) {
+        triangles.emplace_back(
+            Point3D(points[facet.I1]),
+            Point3D(points[facet.I2]),
+            Point3D(points[facet.I3])
+        );
+    }
+    m_stock->SetTarget(triangles);
+}
+
+void PathSim::Verify(float tolerance, cVerifyReport& report)
+{
+    if (!m_stock) {
+        throw Base::RuntimeError("Path Simulation: Simulation has no stock object");
+    }
+    m_stock->Verify(tolerance, report);
+}
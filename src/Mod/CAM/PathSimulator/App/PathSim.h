@@ -26,9 +26,11 @@
 #define PATHSIMULATOR_PathSim_H
 
 #include <memory>
+#include <vector>
 #include <TopoDS_Shape.hxx>
 
 #include <Mod/CAM/App/Command.h>
+#include <Mod/CAM/App/Path.h>
 #include <Mod/Part/App/TopoShape.h>
 #include <Mod/CAM/PathGlobal.h>
 
@@ -40,6 +42,15 @@ using namespace Path;
 namespace PathSimulator
 {
 
+/** A rapid move that removed stock */
+struct RapidCut
+{
+    std::size_t command;  // index of the command in the toolpath
+    Base::Vector3d start;
+    Base::Vector3d end;
+    double volume;  // removed stock volume
+};
+
 /** The representation of a CNC Toolpath Simulator */
 
 class PathSimulatorExport PathSim: public Base::BaseClass
@@ -53,10 +64,21 @@ public:
     void BeginSimulation(Part::TopoShape* stock, float resolution);
     void SetToolShape(const TopoDS_Shape& toolShape, float resolution);
     Base::Placement* ApplyCommand(Base::Placement* pos, Command* cmd);
+    /// applies all commands of the toolpath and returns the final tool position
+    Base::Placement ApplyToolpath(const Base::Placement& pos, const Toolpath& path);
+    /// the rapid moves of the last ApplyToolpath() call that removed stock
+    const std::vector<RapidCut>& GetRapidCuts() const
+    {
+        return m_rapidCuts;
+    }
+    /// sets the shape the stock is compared with in Verify()
+    void SetTargetShape(const Part::TopoShape& target, float accuracy);
+    void Verify(float tolerance, cVerifyReport& report);
 
 public:
     std::unique_ptr<cStock> m_stock;
     std::unique_ptr<cSimTool> m_tool;
+    std::vector<RapidCut> m_rapidCuts;
 };
 
 }  // namespace PathSimulator
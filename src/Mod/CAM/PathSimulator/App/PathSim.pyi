@@ -10,6 +10,7 @@ from Base.Placement import Placement
 from Part.App.TopoShape import TopoShape
 from Mesh.App.Mesh import Mesh
 from CAM.App.Command import Command
+from CAM.App.Path import Path
 
 @export(
     FatherInclude="Base/BaseClassPy.h",
@@ -53,5 +54,37 @@ class PathSim(BaseClass):
         Apply a single path command on the stock starting from placement.
         """
         ...
+
+    def ApplyToolpath(self, position: Placement, toolpath: Path) -> Placement:
+        """
+        Apply all commands of a toolpath on the stock starting from position.
+        Drilling cycles are expanded into single moves.
+        Returns the final position of the tool.
+        """
+        ...
+
+    def GetRapidCuts(self) -> list[dict[str, Any]]:
+        """
+        Return the rapid moves of the last ApplyToolpath() call that removed stock.
+        Each one is a dict with the index of the command in the toolpath, the start
+        and end point of the move and the removed volume.
+        """
+        ...
+
+    def SetTargetShape(self, shape: TopoShape, accuracy: float, /) -> None:
+        """
+        Set the shape the stock is compared with in Verify().
+        The shape is tessellated with the given accuracy.
+        """
+        ...
+
+    def Verify(self, tolerance: float = 0.0) -> dict[str, Any]:
+        """
+        Compare the simulated stock with the target shape.
+        Returns a dict with the remaining stock volume, the minimum, maximum and mean
+        stock height above the target and the regions cut deeper than tolerance below
+        the target, sorted by volume.
+        """
+        ...
     Tool: Final[Any]
     """Return current simulation tool."""
@@ -23,11 +23,13 @@
  ***************************************************************************/
 
 
+#include <Base/GeometryPyCXX.h>
 #include <Base/PlacementPy.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
 
 #include <Mod/Mesh/App/MeshPy.h>
 #include <Mod/CAM/App/CommandPy.h>
+#include <Mod/CAM/App/PathPy.h>
 #include <Mod/Part/App/TopoShapePy.h>
 
 #include "PathSim.h"
@@ -145,6 +147,108 @@ PyObject* PathSimPy::ApplyCommand(PyObject* args, PyObject* kwds)
     return newposPy;
 }
 
+PyObject* PathSimPy::ApplyToolpath(PyObject* args, PyObject* kwds)
+{
+    static const std::array<const char*, 3> kwlist {"position", "toolpath", nullptr};
+    PyObject* pObjPlace;
+    PyObject* pObjPath;
+    if (!Base::Wrapped_ParseTupleAndKeywords(
+            args,
+            kwds,
+            "O!O!",
+            kwlist,
+            &(Base::PlacementPy::Type),
+            &pObjPlace,
+            &(Path::PathPy::Type),
+            &pObjPath
+        )) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        PathSim* sim = getPathSimPtr();
+        const Base::Placement* pos = static_cast<Base::PlacementPy*>(pObjPlace)->getPlacementPtr();
+        const Path::Toolpath* path = static_cast<Path::PathPy*>(pObjPath)->getToolpathPtr();
+        Base::Placement newpos = sim->ApplyToolpath(*pos, *path);
+        return new Base::PlacementPy(new Base::Placement(newpos));
+    }
+    PY_CATCH
+}
+
+PyObject* PathSimPy::GetRapidCuts(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+
+    Py::List cuts;
+    for (const auto& it : getPathSimPtr()->GetRapidCuts()) {
+        Py::Dict cut;
+        cut.setItem("Command", Py::Long(static_cast<unsigned long>(it.command)));
+        cut.setItem("Start", Py::Vector(it.start));
+        cut.setItem("End", Py::Vector(it.end));
+        cut.setItem("Volume", Py::Float(it.volume));
+        cuts.append(cut);
+    }
+    return Py::new_reference_to(cuts);
+}
+
+PyObject* PathSimPy::SetTargetShape(PyObject* args)
+{
+    PyObject* pObjTarget;
+    float accuracy;
+    if (!PyArg_ParseTuple(args, "O!f", &(Part::TopoShapePy::Type), &pObjTarget, &accuracy)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        const Part::TopoShape* target
+            = static_cast<Part::TopoShapePy*>(pObjTarget)->getTopoShapePtr();
+        getPathSimPtr()->SetTargetShape(*target, accuracy);
+        Py_Return;
+    }
+    PY_CATCH
+}
+
+PyObject* PathSimPy::Verify(PyObject* args, PyObject* kwds)
+{
+    static const std::array<const char*, 2> kwlist {"tolerance", nullptr};
+    float tolerance = 0;
+    if (!Base::Wrapped_ParseTupleAndKeywords(args, kwds, "|f", kwlist, &tolerance)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        cVerifyReport report;
+        getPathSimPtr()->Verify(tolerance, report);
+
+        Py::List gouges;
+        for (const auto& it : report.gouges) {
+            Py::Dict region;
+            region.setItem("Area", Py::Float(it.area));
+            region.setItem("Volume", Py::Float(it.volume));
+            region.setItem("MaxDepth", Py::Float(it.maxDepth));
+            Base::BoundBox3d box(it.xmin, it.ymin, 0, it.xmax, it.ymax, 0);
+            region.setItem("BoundBox", Py::BoundingBox(box));
+            gouges.append(region);
+        }
+
+        Py::Dict dict;
+        dict.setItem("Volume", Py::Float(report.volume));
+        dict.setItem("TargetArea", Py::Float(report.targetArea));
+        dict.setItem("MinRemaining", Py::Float(report.minRemaining));
+        dict.setItem("MaxRemaining", Py::Float(report.maxRemaining));
+        dict.setItem("MeanRemaining", Py::Float(report.meanRemaining));
+        dict.setItem("GougeVolume", Py::Float(report.gougeVolume));
+        dict.setItem("Gouges", gouges);
+        return Py::new_reference_to(dict);
+    }
+    PY_CATCH
+}
+
 Py::Object PathSimPy::getTool() const
 {
     // return Py::Object();
@@ -23,7 +23,10 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 
+#include <QtConcurrentMap>
 
 #include <BRepBndLib.hxx>
 #include <BRepCheck_Analyzer.hxx>
@@ -45,6 +48,9 @@ cStock::cStock(float px, float py, float pz, float lx, float ly, float lz, float
     , m_ly(ly)
     , m_lz(lz)
     , m_res(res)
+    , m_batchTool(nullptr)
+    , m_batchRad(0)
+    , m_hasTarget(false)
 {
     m_x = (int)(m_lx / res) + 1;
     m_y = (int)(m_ly / res) + 1;
@@ -57,13 +63,36 @@ cStock::cStock(float px, float py, float pz, float lx, float ly, float lz, float
             m_attr[x][y] = 0;
         }
     }
+
+    m_tilesX = (m_x + SIM_TILE_SIZE - 1) / SIM_TILE_SIZE;
+    m_tilesY = (m_y + SIM_TILE_SIZE - 1) / SIM_TILE_SIZE;
+    m_tiles.resize(m_tilesX * m_tilesY);
+    for (int ty = 0; ty < m_tilesY; ty++) {
+        for (int tx = 0; tx < m_tilesX; tx++) {
+            cStockTile& tile = m_tiles[ty * m_tilesX + tx];
+            tile.x0 = tx * SIM_TILE_SIZE;
+            tile.y0 = ty * SIM_TILE_SIZE;
+            tile.x1 = std::min(m_x, tile.x0 + SIM_TILE_SIZE);
+            tile.y1 = std::min(m_y, tile.y0 + SIM_TILE_SIZE);
+            tile.changed = false;
+            tile.dirty = true;
+        }
+    }
+    m_batch.reserve(SIM_BATCH_SIZE);
 }
 
 cStock::~cStock()
 {}
 
 
-float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz)
+float cStock::FindRectTop(
+    const cStockTile& tile,
+    int& xp,
+    int& yp,
+    int& x_size,
+    int& y_size,
+    bool scanHoriz
+)
 {
     float z = m_stock[xp][yp];
     bool xr_ok = true;
@@ -76,7 +105,7 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep right x direction
         if (xr_ok) {
             int tx = xp + x_size;
-            if (tx >= m_x) {
+            if (tx >= tile.x1) {
                 xr_ok = false;
             }
             else {
@@ -95,7 +124,7 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep left x direction
         if (xl_ok) {
             int tx = xp - 1;
-            if (tx < 0) {
+            if (tx < tile.x0) {
                 xl_ok = false;
             }
             else {
@@ -115,7 +144,7 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep up y direction
         if (yu_ok) {
             int ty = yp + y_size;
-            if (ty >= m_y) {
+            if (ty >= tile.y1) {
                 yu_ok = false;
             }
             else {
@@ -134,7 +163,7 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
         // sweep down y direction
         if (yd_ok) {
             int ty = yp - 1;
-            if (ty < 0) {
+            if (ty < tile.y0) {
                 yd_ok = false;
             }
             else {
@@ -154,21 +183,21 @@ float cStock::FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanH
     return z;
 }
 
-int cStock::TesselTop(int xp, int yp)
+int cStock::TesselTop(cStockTile& tile, int xp, int yp)
 {
     int x_size, y_size;
-    float z = FindRectTop(xp, yp, x_size, y_size, true);
+    float z = FindRectTop(tile, xp, yp, x_size, y_size, true);
     bool farRect = false;
     while (y_size / x_size > 5) {
         farRect = true;
         yp += x_size * 5;
-        z = FindRectTop(xp, yp, x_size, y_size, true);
+        z = FindRectTop(tile, xp, yp, x_size, y_size, true);
     }
 
     while (x_size / y_size > 5) {
         farRect = true;
         xp += y_size * 5;
-        z = FindRectTop(xp, yp, x_size, y_size, false);
+        z = FindRectTop(tile, xp, yp, x_size, y_size, false);
     }
 
     // mark all points inside
@@ -185,10 +214,10 @@ int cStock::TesselTop(int xp, int yp)
         Point3D ptl(xp, yp + y_size, z);
         Point3D ptr(xp + x_size, yp + y_size, z);
         if (fabs(m_pz + m_lz - z) < SIM_EPSILON) {
-            AddQuad(pbl, pbr, ptr, ptl, facetsOuter);
+            AddQuad(pbl, pbr, ptr, ptl, tile.facetsOuter);
         }
         else {
-            AddQuad(pbl, pbr, ptr, ptl, facetsInner);
+            AddQuad(pbl, pbr, ptr, ptl, tile.facetsInner);
         }
     }
 
@@ -200,7 +229,14 @@ int cStock::TesselTop(int xp, int yp)
 }
 
 
-void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz)
+void cStock::FindRectBot(
+    const cStockTile& tile,
+    int& xp,
+    int& yp,
+    int& x_size,
+    int& y_size,
+    bool scanHoriz
+)
 {
     bool xr_ok = true;
     bool xl_ok = scanHoriz;
@@ -212,7 +248,7 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep right x direction
         if (xr_ok) {
             int tx = xp + x_size;
-            if (tx >= m_x) {
+            if (tx >= tile.x1) {
                 xr_ok = false;
             }
             else {
@@ -231,7 +267,7 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep left x direction
         if (xl_ok) {
             int tx = xp - 1;
-            if (tx < 0) {
+            if (tx < tile.x0) {
                 xl_ok = false;
             }
             else {
@@ -251,7 +287,7 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep up y direction
         if (yu_ok) {
             int ty = yp + y_size;
-            if (ty >= m_y) {
+            if (ty >= tile.y1) {
                 yu_ok = false;
             }
             else {
@@ -270,7 +306,7 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
         // sweep down y direction
         if (yd_ok) {
             int ty = yp - 1;
-            if (ty < 0) {
+            if (ty < tile.y0) {
                 yd_ok = false;
             }
             else {
@@ -290,21 +326,21 @@ void cStock::FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHo
 }
 
 
-int cStock::TesselBot(int xp, int yp)
+int cStock::TesselBot(cStockTile& tile, int xp, int yp)
 {
     int x_size, y_size;
-    FindRectBot(xp, yp, x_size, y_size, true);
+    FindRectBot(tile, xp, yp, x_size, y_size, true);
     bool farRect = false;
     while (y_size / x_size > 5) {
         farRect = true;
         yp += x_size * 5;
-        FindRectTop(xp, yp, x_size, y_size, true);
+        FindRectTop(tile, xp, yp, x_size, y_size, true);
     }
 
     while (x_size / y_size > 5) {
         farRect = true;
         xp += y_size * 5;
-        FindRectTop(xp, yp, x_size, y_size, false);
+        FindRectTop(tile, xp, yp, x_size, y_size, false);
     }
 
     // mark all points inside
@@ -319,7 +355,7 @@ int cStock::TesselBot(int xp, int yp)
     Point3D pbr(xp + x_size, yp, m_pz);
     Point3D ptl(xp, yp + y_size, m_pz);
     Point3D ptr(xp + x_size, yp + y_size, m_pz);
-    AddQuad(pbl, ptl, ptr, pbr, facetsOuter);
+    AddQuad(pbl, ptl, ptr, pbr, tile.facetsOuter);
 
     if (farRect) {
         return -1;
@@ -329,25 +365,26 @@ int cStock::TesselBot(int xp, int yp)
 }
 
 
-int cStock::TesselSidesX(int yp)
+int cStock::TesselSidesX(cStockTile& tile, int yp)
 {
+    // the wall between the pixel rows yp - 1 and yp, limited to the x range of the tile
     float lastz1 = m_pz;
     if (yp < m_y) {
-        lastz1 = std::max(m_stock[0][yp], m_pz);
+        lastz1 = std::max(m_stock[tile.x0][yp], m_pz);
     }
     float lastz2 = m_pz;
     if (yp > 0) {
-        lastz2 = std::max(m_stock[0][yp - 1], m_pz);
+        lastz2 = std::max(m_stock[tile.x0][yp - 1], m_pz);
     }
 
-    std::vector<MeshCore::MeshGeomFacet>* facets = &facetsInner;
+    std::vector<MeshCore::MeshGeomFacet>* facets = &tile.facetsInner;
     if (yp == 0 || yp == m_y) {
-        facets = &facetsOuter;
+        facets = &tile.facetsOuter;
     }
 
     // bool lastzclip = (lastz - m_pz) < m_res;
-    int lastpoint = 0;
-    for (int x = 1; x <= m_x; x++) {
+    int lastpoint = tile.x0;
+    for (int x = tile.x0 + 1; x <= tile.x1; x++) {
         float newz1 = m_pz;
         if (yp < m_y && x < m_x) {
             newz1 = std::max(m_stock[x][yp], m_pz);
@@ -358,7 +395,8 @@ int cStock::TesselSidesX(int yp)
         }
 
         if (fabs(lastz1 - lastz2) > m_res) {
-            if (fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
+            // a wall always ends at the tile border
+            if (x < tile.x1 && fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
                 continue;
             }
             Point3D pbl(lastpoint, yp, lastz1);
@@ -374,25 +412,26 @@ int cStock::TesselSidesX(int yp)
     return 0;
 }
 
-int cStock::TesselSidesY(int xp)
+int cStock::TesselSidesY(cStockTile& tile, int xp)
 {
+    // the wall between the pixel columns xp - 1 and xp, limited to the y range of the tile
     float lastz1 = m_pz;
     if (xp < m_x) {
-        lastz1 = std::max(m_stock[xp][0], m_pz);
+        lastz1 = std::max(m_stock[xp][tile.y0], m_pz);
     }
     float lastz2 = m_pz;
     if (xp > 0) {
-        lastz2 = std::max(m_stock[xp - 1][0], m_pz);
+        lastz2 = std::max(m_stock[xp - 1][tile.y0], m_pz);
     }
 
-    std::vector<MeshCore::MeshGeomFacet>* facets = &facetsInner;
+    std::vector<MeshCore::MeshGeomFacet>* facets = &tile.facetsInner;
     if (xp == 0 || xp == m_x) {
-        facets = &facetsOuter;
+        facets = &tile.facetsOuter;
     }
 
     // bool lastzclip = (lastz - m_pz) < m_res;
-    int lastpoint = 0;
-    for (int y = 1; y <= m_y; y++) {
+    int lastpoint = tile.y0;
+    for (int y = tile.y0 + 1; y <= tile.y1; y++) {
         float newz1 = m_pz;
         if (xp < m_x && y < m_y) {
             newz1 = std::max(m_stock[xp][y], m_pz);
@@ -403,7 +442,8 @@ int cStock::TesselSidesY(int xp)
         }
 
         if (fabs(lastz1 - lastz2) > m_res) {
-            if (fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
+            // a wall always ends at the tile border
+            if (y < tile.y1 && fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res) {
                 continue;
             }
             Point3D pbr(xp, lastpoint, lastz1);
@@ -448,57 +488,94 @@ void cStock::AddQuad(
     facets.push_back(facet);
 }
 
-void cStock::Tessellate(Mesh::MeshObject& meshOuter, Mesh::MeshObject& meshInner)
+void cStock::TessellateTile(cStockTile& tile)
 {
     // reset attribs
-    for (int y = 0; y < m_y; y++) {
-        for (int x = 0; x < m_x; x++) {
+    for (int x = tile.x0; x < tile.x1; x++) {
+        for (int y = tile.y0; y < tile.y1; y++) {
             m_attr[x][y] = 0;
         }
     }
 
-    facetsOuter.clear();
-    facetsInner.clear();
+    tile.facetsOuter.clear();
+    tile.facetsInner.clear();
 
-    for (int y = 0; y < m_y; y++) {
-        for (int x = 0; x < m_x; x++) {
+    for (int y = tile.y0; y < tile.y1; y++) {
+        for (int x = tile.x0; x < tile.x1; x++) {
             int attr = m_attr[x][y];
             if ((attr & SIM_TESSEL_TOP) == 0) {
-                x += TesselTop(x, y);
+                x += TesselTop(tile, x, y);
             }
         }
     }
-    for (int y = 0; y < m_y; y++) {
-        for (int x = 0; x < m_x; x++) {
+    for (int y = tile.y0; y < tile.y1; y++) {
+        for (int x = tile.x0; x < tile.x1; x++) {
             if ((m_stock[x][y] - m_pz) < m_res) {
                 m_attr[x][y] |= SIM_TESSEL_BOT;
             }
             if ((m_attr[x][y] & SIM_TESSEL_BOT) == 0) {
-                x += TesselBot(x, y);
+                x += TesselBot(tile, x, y);
             }
         }
     }
-    for (int y = 0; y <= m_y; y++) {
-        TesselSidesX(y);
+
+    // the tiles at the far borders also get the closing walls of the stock
+    int ye = tile.y1 == m_y ? m_y : tile.y1 - 1;
+    for (int y = tile.y0; y <= ye; y++) {
+        TesselSidesX(tile, y);
     }
-    for (int x = 0; x <= m_x; x++) {
-        TesselSidesY(x);
+    int xe = tile.x1 == m_x ? m_x : tile.x1 - 1;
+    for (int x = tile.x0; x <= xe; x++) {
+        TesselSidesY(tile, x);
+    }
+    tile.dirty = false;
+}
+
+void cStock::Tessellate(Mesh::MeshObject& meshOuter, Mesh::MeshObject& meshInner)
+{
+    Flush();
+
+    // the tiles only write to their own region of m_attr, so they can be done in parallel
+    std::vector<cStockTile*> dirtyTiles;
+    for (auto& tile : m_tiles) {
+        if (tile.dirty) {
+            dirtyTiles.push_back(&tile);
+        }
+    }
+    QtConcurrent::blockingMap(dirtyTiles, [this](cStockTile* tile) {
+        TessellateTile(*tile);
+    });
+
+    std::size_t numOuter = 0;
+    std::size_t numInner = 0;
+    for (const auto& tile : m_tiles) {
+        numOuter += tile.facetsOuter.size();
+        numInner += tile.facetsInner.size();
+    }
+
+    std::vector<MeshCore::MeshGeomFacet> facetsOuter;
+    std::vector<MeshCore::MeshGeomFacet> facetsInner;
+    facetsOuter.reserve(numOuter);
+    facetsInner.reserve(numInner);
+    for (const auto& tile : m_tiles) {
+        facetsOuter.insert(facetsOuter.end(), tile.facetsOuter.begin(), tile.facetsOuter.end());
+        facetsInner.insert(facetsInner.end(), tile.facetsInner.begin(), tile.facetsInner.end());
     }
     meshOuter.addFacets(facetsOuter);
     meshInner.addFacets(facetsInner);
-    facetsOuter.clear();
-    facetsInner.clear();
 }
 
 
 void cStock::CreatePocket(float cxf, float cyf, float radf, float height)
 {
+    Flush();
+
     int cx = (int)((cxf - m_px) / m_res);
     int cy = (int)((cyf - m_py) / m_res);
     int rad = (int)(radf / m_res);
     int drad = rad * rad;
     int ys = std::max(0, cy - rad);
-    int ye = std::min(m_x, cy + rad);
+    int ye = std::min(m_y, cy + rad);
     int xs = std::max(0, cx - rad);
     int xe = std::min(m_x, cx + rad);
     for (int y = ys; y < ye; y++) {
@@ -506,76 +583,372 @@ void cStock::CreatePocket(float cxf, float cyf, float radf, float height)
             if (((x - cx) * (x - cx) + (y - cy) * (y - cy)) < drad) {
                 if (m_stock[x][y] > height) {
                     m_stock[x][y] = height;
+                    m_tiles[(y / SIM_TILE_SIZE) * m_tilesX + x / SIM_TILE_SIZE].changed = true;
                 }
             }
         }
     }
+    MarkChangedTiles();
 }
 
-void cStock::ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool)
+void cStock::MarkChangedTiles()
 {
-    // translate coordinates
-    Point3D pi1 = ToInner(p1);
-    Point3D pi2 = ToInner(p2);
-    float rad = tool.radius;
-    rad /= m_res;
-    float cupAngle = 180;
-
-    // strait motion
-    float perpDirX = 1;
-    float perpDirY = 0;
-    cLineSegment path(pi1, pi2);
-    if (path.lenXY > SIM_EPSILON)  // only if moving along xy
-    {
-        perpDirX = -path.pDirXY.y;
-        perpDirY = path.pDirXY.x;
-        Point3D start(perpDirX * rad + pi1.x, perpDirY * rad + pi1.y, pi1.z);
-        Point3D mainWay = path.pDir * SIM_WALK_RES;
-        Point3D sideWay(-perpDirX * SIM_WALK_RES, -perpDirY * SIM_WALK_RES, 0);
-        int lenSteps = (int)(path.len / SIM_WALK_RES) + 1;
-        int radSteps = (int)(rad * 2 / SIM_WALK_RES) + 1;
-        float zstep = (pi2.z - pi1.z) / radSteps;
-        float tstep = 2.0 / radSteps;
-        float t = -1;
-        for (int j = 0; j < radSteps; j++) {
-            float z = pi1.z + tool.GetToolProfileAt(t);
-            Point3D p = start;
-            for (int i = 0; i < lenSteps; i++) {
-                int x = (int)p.x;
-                int y = (int)p.y;
-                if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                    if (m_stock[x][y] > z) {
-                        m_stock[x][y] = z;
+    // the walls at the lower borders of a tile depend on the neighbour tiles
+    for (int ty = 0; ty < m_tilesY; ty++) {
+        for (int tx = 0; tx < m_tilesX; tx++) {
+            cStockTile& tile = m_tiles[ty * m_tilesX + tx];
+            if (!tile.changed) {
+                continue;
+            }
+            tile.changed = false;
+            tile.dirty = true;
+            if (tx + 1 < m_tilesX) {
+                m_tiles[ty * m_tilesX + tx + 1].dirty = true;
+            }
+            if (ty + 1 < m_tilesY) {
+                m_tiles[(ty + 1) * m_tilesX + tx].dirty = true;
+            }
+        }
+    }
+}
+
+void cStock::AddSegment(Point3D& pi1, Point3D& pi2, cSimTool& tool, int rapid)
+{
+    if (m_batchTool != &tool || m_batch.size() >= SIM_BATCH_SIZE) {
+        Flush();
+    }
+
+    if (m_batch.empty()) {
+        // sample the tool profile, so the sweep doesn't need to search it for every pixel
+        m_batchTool = &tool;
+        m_batchRad = tool.radius / m_res;
+        int steps = (int)(m_batchRad * SIM_PROFILE_STEPS) + 2;
+        m_profile.resize(steps);
+        for (int i = 0; i < steps; i++) {
+            float r = (float)i / SIM_PROFILE_STEPS;
+            m_profile[i] = tool.GetToolProfileAt(std::min(r / m_batchRad, 1.0f));
+        }
+    }
+
+    cSweepSegment seg;
+    seg.x = pi1.x;
+    seg.y = pi1.y;
+    seg.z = pi1.z;
+    seg.dx = pi2.x - pi1.x;
+    seg.dy = pi2.y - pi1.y;
+    seg.dz = pi2.z - pi1.z;
+    seg.rapid = rapid;
+    float lenXY2 = seg.dx * seg.dx + seg.dy * seg.dy;
+    if (lenXY2 > SIM_EPSILON) {
+        seg.invLenXY2 = 1.0f / lenXY2;
+    }
+    else {
+        // vertical move: only the lowest point matters
+        seg.dx = seg.dy = seg.dz = 0;
+        seg.z = std::min(pi1.z, pi2.z);
+        seg.invLenXY2 = 0;
+    }
+    m_batch.push_back(seg);
+}
+
+void cStock::SweepTile(cStockTile& tile)
+{
+    float rad = m_batchRad;
+    float rad2 = rad * rad;
+    float halfDiag = SIM_TILE_SIZE * 0.7072f;
+    float tcx = (tile.x0 + tile.x1) * 0.5f;
+    float tcy = (tile.y0 + tile.y1) * 0.5f;
+    const float* profile = m_profile.data();
+    bool changed = false;
+
+    for (const auto& seg : m_batch) {
+        double rapidCut = 0;
+
+        // skip segments whose swept area doesn't reach the tile
+        float tc = std::clamp(
+            ((tcx - seg.x) * seg.dx + (tcy - seg.y) * seg.dy) * seg.invLenXY2,
+            0.0f,
+            1.0f
+        );
+        float cx = tcx - (seg.x + tc * seg.dx);
+        float cy = tcy - (seg.y + tc * seg.dy);
+        if (cx * cx + cy * cy > (rad + halfDiag) * (rad + halfDiag)) {
+            continue;
+        }
+
+        int xs = std::max(tile.x0, (int)std::floor(std::min(seg.x, seg.x + seg.dx) - rad));
+        int xe = std::min(tile.x1, (int)std::ceil(std::max(seg.x, seg.x + seg.dx) + rad));
+        int ys = std::max(tile.y0, (int)std::floor(std::min(seg.y, seg.y + seg.dy) - rad));
+        int ye = std::min(tile.y1, (int)std::ceil(std::max(seg.y, seg.y + seg.dy) + rad));
+
+        // limit the columns to the band of width 2 * rad around the path
+        float slope = 0;
+        float halfWidth = (float)m_y;
+        if (std::fabs(seg.dx) > SIM_EPSILON) {
+            slope = seg.dy / seg.dx;
+            halfWidth = rad / (std::fabs(seg.dx) * std::sqrt(seg.invLenXY2)) + 1.0f;
+        }
+
+        for (int x = xs; x < xe; x++) {
+            // pixel centers relative to the segment start, a column is contiguous in memory
+            float* column = m_stock[x];
+            float qx = x + 0.5f - seg.x;
+            float qxd = qx * seg.dx;
+            float yc = seg.y + qx * slope;
+            int ycs = (int)std::max((float)ys, std::floor(yc - halfWidth));
+            int yce = (int)std::min((float)ye, std::ceil(yc + halfWidth));
+            for (int y = ycs; y < yce; y++) {
+                float qy = y + 0.5f - seg.y;
+                float t = std::clamp((qxd + qy * seg.dy) * seg.invLenXY2, 0.0f, 1.0f);
+                float ex = qx - t * seg.dx;
+                float ey = qy - t * seg.dy;
+                float d2 = ex * ex + ey * ey;
+                if (d2 <= rad2) {
+                    float z = seg.z + t * seg.dz
+                        + profile[(int)(std::sqrt(d2) * SIM_PROFILE_STEPS)];
+                    if (column[y] > z) {
+                        // rapid moves shouldn't cut, count what they remove from the stock
+                        if (seg.rapid >= 0 && column[y] > m_pz && column[y] - z > SIM_EPSILON) {
+                            rapidCut += column[y] - std::max(z, m_pz);
+                        }
+                        column[y] = z;
+                        changed = true;
                     }
                 }
-                p.Add(mainWay);
-                z += zstep;
             }
-            t += tstep;
-            start.Add(sideWay);
+        }
+
+        if (rapidCut > 0) {
+            tile.rapidCuts.emplace_back(seg.rapid, rapidCut * m_res * m_res);
         }
     }
-    else {
-        cupAngle = 360;
-    }
-
-    // end cup
-    for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES) {
-        Point3D cupCirc(perpDirX * r, perpDirY * r, pi2.z);
-        float rotang = 180 * SIM_WALK_RES / (pi * r);
-        cupCirc.SetRotationAngle(-rotang);
-        float z = pi2.z + tool.GetToolProfileAt(r / rad);
-        for (float a = 0; a < cupAngle; a += rotang) {
-            int x = (int)(pi2.x + cupCirc.x);
-            int y = (int)(pi2.y + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
+
+    if (changed) {
+        tile.changed = true;
+    }
+}
+
+void cStock::Flush()
+{
+    if (m_batch.empty()) {
+        return;
+    }
+
+    // tiles don't overlap, so every tile can be swept by all moves of the batch at once
+    float xmin = m_x;
+    float xmax = 0;
+    float ymin = m_y;
+    float ymax = 0;
+    for (const auto& seg : m_batch) {
+        xmin = std::min({xmin, seg.x, seg.x + seg.dx});
+        xmax = std::max({xmax, seg.x, seg.x + seg.dx});
+        ymin = std::min({ymin, seg.y, seg.y + seg.dy});
+        ymax = std::max({ymax, seg.y, seg.y + seg.dy});
+    }
+    int txs = std::max(0, (int)std::floor((xmin - m_batchRad) / SIM_TILE_SIZE));
+    int txe = std::min(m_tilesX - 1, (int)std::floor((xmax + m_batchRad) / SIM_TILE_SIZE));
+    int tys = std::max(0, (int)std::floor((ymin - m_batchRad) / SIM_TILE_SIZE));
+    int tye = std::min(m_tilesY - 1, (int)std::floor((ymax + m_batchRad) / SIM_TILE_SIZE));
+
+    std::vector<cStockTile*> tiles;
+    for (int ty = tys; ty <= tye; ty++) {
+        for (int tx = txs; tx <= txe; tx++) {
+            tiles.push_back(&m_tiles[ty * m_tilesX + tx]);
+        }
+    }
+    if (tiles.size() > 1) {
+        QtConcurrent::blockingMap(tiles, [this](cStockTile* tile) {
+            SweepTile(*tile);
+        });
+    }
+    else if (!tiles.empty()) {
+        SweepTile(*tiles.front());
+    }
+
+    m_batch.clear();
+    m_batchTool = nullptr;
+    MarkChangedTiles();
+}
+
+double cStock::GetVolume()
+{
+    Flush();
+
+    // The heights are sampled at the corners of the cells, so there is one more sample than
+    // cells along each side. The last cells are narrower if the size isn't a multiple of m_res.
+    double volume = 0;
+    for (int x = 0; x < m_x; x++) {
+        double width = std::min(m_res, m_lx - x * m_res);
+        if (width <= 0) {
+            break;
+        }
+        for (int y = 0; y < m_y; y++) {
+            double depth = std::min(m_res, m_ly - y * m_res);
+            if (depth <= 0) {
+                break;
+            }
+            volume += std::max(m_stock[x][y] - m_pz, 0.0f) * width * depth;
+        }
+    }
+    return volume;
+}
+
+std::map<int, double> cStock::TakeRapidCuts()
+{
+    Flush();
+
+    std::map<int, double> cuts;
+    for (auto& tile : m_tiles) {
+        for (const auto& it : tile.rapidCuts) {
+            cuts[it.first] += it.second;
+        }
+        tile.rapidCuts.clear();
+    }
+    return cuts;
+}
+
+void cStock::SetTarget(const std::vector<Triangle3D>& triangles)
+{
+    m_target.Init(m_x, m_y);
+    for (int x = 0; x < m_x; x++) {
+        for (int y = 0; y < m_y; y++) {
+            m_target[x][y] = -FLT_MAX;
+        }
+    }
+
+    // rasterize the triangles and keep the highest point at every pixel center
+    for (const auto& tri : triangles) {
+        Point3D p0 = tri.points[0];
+        Point3D p1 = tri.points[1];
+        Point3D p2 = tri.points[2];
+        p0 = ToInner(p0);
+        p1 = ToInner(p1);
+        p2 = ToInner(p2);
+        float area = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+        if (fabs(area) < SIM_EPSILON) {
+            // vertical faces don't cover any pixel
+            continue;
+        }
+
+        int xs = std::max(0, (int)std::ceil(std::min({p0.x, p1.x, p2.x}) - 0.5f));
+        int xe = std::min(m_x - 1, (int)std::floor(std::max({p0.x, p1.x, p2.x}) - 0.5f));
+        int ys = std::max(0, (int)std::ceil(std::min({p0.y, p1.y, p2.y}) - 0.5f));
+        int ye = std::min(m_y - 1, (int)std::floor(std::max({p0.y, p1.y, p2.y}) - 0.5f));
+        for (int x = xs; x <= xe; x++) {
+            float cx = x + 0.5f;
+            for (int y = ys; y <= ye; y++) {
+                float cy = y + 0.5f;
+                float w0 = ((p1.x - cx) * (p2.y - cy) - (p2.x - cx) * (p1.y - cy)) / area;
+                float w1 = ((p2.x - cx) * (p0.y - cy) - (p0.x - cx) * (p2.y - cy)) / area;
+                float w2 = 1.0f - w0 - w1;
+                if (w0 < -SIM_EPSILON || w1 < -SIM_EPSILON || w2 < -SIM_EPSILON) {
+                    continue;
+                }
+                float z = w0 * p0.z + w1 * p1.z + w2 * p2.z;
+                if (m_target[x][y] < z) {
+                    m_target[x][y] = z;
+                }
+            }
+        }
+    }
+    m_hasTarget = true;
+}
+
+void cStock::Verify(float tolerance, cVerifyReport& report)
+{
+    report.volume = GetVolume();
+    report.targetArea = 0;
+    report.minRemaining = 0;
+    report.maxRemaining = 0;
+    report.meanRemaining = 0;
+    report.gougeVolume = 0;
+    report.gouges.clear();
+    if (!m_hasTarget) {
+        return;
+    }
+
+    double pixelArea = m_res * m_res;
+    double sum = 0;
+    int count = 0;
+    float minRemaining = FLT_MAX;
+    float maxRemaining = -FLT_MAX;
+    auto isGouge = [this, tolerance](int x, int y) {
+        return m_target[x][y] != -FLT_MAX && m_stock[x][y] - m_target[x][y] < -tolerance;
+    };
+
+    std::vector<char> visited(m_x * m_y, 0);
+    std::vector<std::pair<int, int>> stack;
+    for (int x = 0; x < m_x; x++) {
+        for (int y = 0; y < m_y; y++) {
+            if (m_target[x][y] == -FLT_MAX) {
+                continue;
+            }
+            float remaining = m_stock[x][y] - m_target[x][y];
+            minRemaining = std::min(minRemaining, remaining);
+            maxRemaining = std::max(maxRemaining, remaining);
+            sum += remaining;
+            count++;
+            if (visited[x * m_y + y] || !isGouge(x, y)) {
+                continue;
+            }
+
+            // collect the connected gouged pixels into one region
+            cGougeRegion region {0, 0, 0, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX};
+            visited[x * m_y + y] = 1;
+            stack.emplace_back(x, y);
+            while (!stack.empty()) {
+                auto [gx, gy] = stack.back();
+                stack.pop_back();
+                float depth = m_target[gx][gy] - m_stock[gx][gy];
+                region.area += pixelArea;
+                region.volume += depth * pixelArea;
+                region.maxDepth = std::max(region.maxDepth, depth);
+                region.xmin = std::min(region.xmin, gx * m_res + m_px);
+                region.ymin = std::min(region.ymin, gy * m_res + m_py);
+                region.xmax = std::max(region.xmax, (gx + 1) * m_res + m_px);
+                region.ymax = std::max(region.ymax, (gy + 1) * m_res + m_py);
+
+                const int neighbours[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+                for (const auto& it : neighbours) {
+                    int nx = gx + it[0];
+                    int ny = gy + it[1];
+                    if (nx < 0 || ny < 0 || nx >= m_x || ny >= m_y) {
+                        continue;
+                    }
+                    if (!visited[nx * m_y + ny] && isGouge(nx, ny)) {
+                        visited[nx * m_y + ny] = 1;
+                        stack.emplace_back(nx, ny);
+                    }
                 }
             }
-            cupCirc.Rotate();
+            report.gougeVolume += region.volume;
+            report.gouges.push_back(region);
         }
     }
+
+    if (count > 0) {
+        report.targetArea = count * pixelArea;
+        report.minRemaining = minRemaining;
+        report.maxRemaining = maxRemaining;
+        report.meanRemaining = sum / count;
+    }
+
+    // the worst gouges first
+    std::sort(
+        report.gouges.begin(),
+        report.gouges.end(),
+        [](const cGougeRegion& r1, const cGougeRegion& r2) {
+            return r1.volume > r2.volume;
+        }
+    );
+}
+
+void cStock::ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool, int rapid)
+{
+    // translate coordinates
+    Point3D pi1 = ToInner(p1);
+    Point3D pi2 = ToInner(p2);
+    AddSegment(pi1, pi2, tool, rapid);
 }
 
 void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool& tool, bool isCCW)
@@ -584,16 +957,10 @@ void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool
     Point3D pi1 = ToInner(p1);
     Point3D pi2 = ToInner(p2);
     Point3D centi(cent.x / m_res, cent.y / m_res, cent.z);
-    float rad = tool.radius;
-    rad /= m_res;
     float cpx = centi.x;
     float cpy = centi.y;
 
-    Point3D xynorm = unit(Point3D(-cpx, -cpy, 0));
     float crad = sqrt(cpx * cpx + cpy * cpy);
-    float crad1 = std::max((float)0.5, crad - rad);
-    float crad2 = crad + rad;
-
     float sang = atan2(-cpy, -cpx);  // start angle
 
     cpx += pi1.x;
@@ -607,59 +974,22 @@ void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool
     if (isCCW && ang < 0) {
         ang += 2 * pi;
     }
-    ang = fabs(ang);
-
-    // apply path
-    Point3D cupCirc;
-    float tstep = (float)SIM_WALK_RES / rad;
-    float t = -1;
-    for (float r = crad1; r <= crad2; r += (float)SIM_WALK_RES) {
-        cupCirc.x = xynorm.x * r;
-        cupCirc.y = xynorm.y * r;
-        float rotang = (float)SIM_WALK_RES / r;
-        int ndivs = (int)(ang / rotang) + 1;
-        if (!isCCW) {
-            rotang = -rotang;
-        }
-        cupCirc.SetRotationAngleRad(rotang);
-        float z = pi1.z + tool.GetToolProfileAt(t);
-        float zstep = (pi2.z - pi1.z) / ndivs;
-        for (int i = 0; i < ndivs; i++) {
-            int x = (int)(cpx + cupCirc.x);
-            int y = (int)(cpy + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
-                }
-            }
-            z += zstep;
-            cupCirc.Rotate();
-        }
-        t += tstep;
-    }
-
-    // apply end cup
-    xynorm.SetRotationAngleRad(ang);
-    xynorm.Rotate();
-    for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES) {
-        Point3D cupCirc(xynorm.x * r, xynorm.y * r, 0);
-        float rotang = (float)SIM_WALK_RES / r;
-        int ndivs = (int)(pi / rotang) + 1;
-        if (!isCCW) {
-            rotang = -rotang;
-        }
-        cupCirc.SetRotationAngleRad(rotang);
-        float z = pi2.z + tool.GetToolProfileAt(r / rad);
-        for (int i = 0; i < ndivs; i++) {
-            int x = (int)(pi2.x + cupCirc.x);
-            int y = (int)(pi2.y + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
-                }
-            }
-            cupCirc.Rotate();
+
+    // split the arc into chords that deviate less than SIM_ARC_TOLERANCE from it
+    int ndivs = 1;
+    if (crad > SIM_ARC_TOLERANCE) {
+        double maxStep = 2 * acos(1 - SIM_ARC_TOLERANCE / crad);
+        ndivs = std::max(1, (int)ceil(fabs(ang) / maxStep));
+    }
+    Point3D last = pi1;
+    for (int i = 1; i <= ndivs; i++) {
+        Point3D next = pi2;
+        if (i < ndivs) {
+            double a = sang + ang * i / ndivs;
+            next.set(cpx + crad * cos(a), cpy + crad * sin(a), pi1.z + (pi2.z - pi1.z) * i / ndivs);
         }
+        AddSegment(last, next, tool);
+        last = next;
     }
 }
 
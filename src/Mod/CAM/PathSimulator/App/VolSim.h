@@ -27,6 +27,7 @@
 #ifndef PATHSIMULATOR_VolSim_H
 #define PATHSIMULATOR_VolSim_H
 
+#include <map>
 #include <vector>
 
 #include <Mod/Mesh/App/Mesh.h>
@@ -36,8 +37,10 @@
 #define SIM_EPSILON 0.00001
 #define SIM_TESSEL_TOP 1
 #define SIM_TESSEL_BOT 2
-#define SIM_WALK_RES \
-    0.6  // step size in pixel units (to make sure all pixels in the path are visited)
+#define SIM_TILE_SIZE 64        // tile edge length in pixel units
+#define SIM_BATCH_SIZE 256      // number of tool moves swept in one pass
+#define SIM_PROFILE_STEPS 4     // tool profile samples per pixel
+#define SIM_ARC_TOLERANCE 0.25  // max. chord deviation of arcs in pixel units
 
 struct toolShapePoint
 {
@@ -143,7 +146,7 @@ struct Triangle3D
 {
     Triangle3D()
     {}
-    Triangle3D(Point3D& p1, Point3D& p2, Point3D& p3)
+    Triangle3D(const Point3D& p1, const Point3D& p2, const Point3D& p3)
     {
         points[0] = p1;
         points[1] = p2;
@@ -206,6 +209,7 @@ public:
 
     void Init(int x, int y)
     {
+        delete[] data;
         data = new T[x * y];
         height = y;
     }
@@ -220,6 +224,50 @@ private:
     int height;
 };
 
+/* A rectangular part of the stock. Tiles are swept and tessellated independently, so
+   they can be processed in parallel, and only tiles touched by the tool since the last
+   tessellation have to be tessellated again. */
+struct cStockTile
+{
+    int x0, y0;  // first pixel
+    int x1, y1;  // one past the last pixel
+    bool changed;
+    bool dirty;
+    std::vector<std::pair<int, double>> rapidCuts;  // volume removed by rapid moves, by id
+    std::vector<MeshCore::MeshGeomFacet> facetsOuter;
+    std::vector<MeshCore::MeshGeomFacet> facetsInner;
+};
+
+/* A straight tool move in pixel units, the z value is the tool tip height */
+struct cSweepSegment
+{
+    float x, y, z;
+    float dx, dy, dz;
+    float invLenXY2;  // 1 / (dx * dx + dy * dy), or 0 for vertical moves
+    int rapid;        // id of a rapid move, or -1 for a move at feed rate
+};
+
+/* A connected area where the stock was cut below the target surface */
+struct cGougeRegion
+{
+    double area;                   // in mm^2
+    double volume;                 // in mm^3
+    float maxDepth;                // deepest cut below the target surface
+    float xmin, ymin, xmax, ymax;  // extent in model coordinates
+};
+
+/* Result of comparing the stock with the target surface */
+struct cVerifyReport
+{
+    double volume;         // remaining stock volume
+    double targetArea;     // area covered by the target
+    float minRemaining;    // smallest stock height above the target, negative if gouged
+    float maxRemaining;    // largest stock height above the target
+    double meanRemaining;  // mean stock height above the target
+    double gougeVolume;    // total volume cut below the target surface
+    std::vector<cGougeRegion> gouges;
+};
+
 class cStock
 {
 public:
@@ -227,16 +275,43 @@ public:
     ~cStock();
     void Tessellate(Mesh::MeshObject& meshOuter, Mesh::MeshObject& meshInner);
     void CreatePocket(float x, float y, float rad, float height);
-    void ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool);
+    /* rapid is the id of a rapid move or -1, the stock removed by rapid moves is recorded */
+    void ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool, int rapid = -1);
     void ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool& tool, bool isCCW);
+    /* tool moves are collected and swept in batches, Flush() applies the pending ones */
+    void Flush();
+    double GetVolume();
+    /* returns the volume removed by every rapid move that cut the stock, by id, and clears it */
+    std::map<int, double> TakeRapidCuts();
+    /* sets the surface the stock is compared with from the triangles of the target shape */
+    void SetTarget(const std::vector<Triangle3D>& triangles);
+    bool HasTarget() const
+    {
+        return m_hasTarget;
+    }
+    void Verify(float tolerance, cVerifyReport& report);
     inline Point3D ToInner(Point3D& p)
     {
         return Point3D((p.x - m_px) / m_res, (p.y - m_py) / m_res, p.z);
     }
 
 private:
-    float FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz);
-    void FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz);
+    float FindRectTop(
+        const cStockTile& tile,
+        int& xp,
+        int& yp,
+        int& x_size,
+        int& y_size,
+        bool scanHoriz
+    );
+    void FindRectBot(
+        const cStockTile& tile,
+        int& xp,
+        int& yp,
+        int& x_size,
+        int& y_size,
+        bool scanHoriz
+    );
     void SetFacetPoints(MeshCore::MeshGeomFacet& facet, Point3D& p1, Point3D& p2, Point3D& p3);
     void AddQuad(
         Point3D& p1,
@@ -245,10 +320,14 @@ private:
         Point3D& p4,
         std::vector<MeshCore::MeshGeomFacet>& facets
     );
-    int TesselTop(int x, int y);
-    int TesselBot(int x, int y);
-    int TesselSidesX(int yp);
-    int TesselSidesY(int xp);
+    int TesselTop(cStockTile& tile, int x, int y);
+    int TesselBot(cStockTile& tile, int x, int y);
+    int TesselSidesX(cStockTile& tile, int yp);
+    int TesselSidesY(cStockTile& tile, int xp);
+    void TessellateTile(cStockTile& tile);
+    void AddSegment(Point3D& pi1, Point3D& pi2, cSimTool& tool, int rapid = -1);
+    void SweepTile(cStockTile& tile);
+    void MarkChangedTiles();
     Array2D<float> m_stock;
     Array2D<char> m_attr;
     float m_px, m_py, m_pz;  // stock zero position
@@ -256,8 +335,15 @@ private:
     float m_res;             // resoulution
     float m_plane;           // stock plane height
     int m_x, m_y;            // stock array size
-    std::vector<MeshCore::MeshGeomFacet> facetsOuter;
-    std::vector<MeshCore::MeshGeomFacet> facetsInner;
+    std::vector<cStockTile> m_tiles;
+    int m_tilesX, m_tilesY;  // number of tiles in x and y
+    // pending tool moves, all of them made with the same tool
+    std::vector<cSweepSegment> m_batch;
+    const cSimTool* m_batchTool;
+    float m_batchRad;              // tool radius in pixel units
+    std::vector<float> m_profile;  // tool profile sampled in SIM_PROFILE_STEPS per pixel
+    Array2D<float> m_target;       // top of the target shape, -FLT_MAX where there is none
+    bool m_hasTarget;
 };
 
 class cVolSim
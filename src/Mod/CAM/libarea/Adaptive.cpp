@@ -28,8 +28,11 @@
 #include <cstring>
 #include <ctime>
 #include <algorithm>
+#include <condition_variable>
+#include <exception>
 #include <numbers>
 #include <optional>
+#include <thread>
 
 namespace ClipperLib
 {
@@ -975,6 +978,9 @@ PerfCounter Perf_AppendToolPath("AppendToolPath");
 PerfCounter Perf_IsAllowedToCutTrough("IsAllowedToCutTrough");
 PerfCounter Perf_IsClearPath("IsClearPath");
 
+// time of the last progress report, each worker thread reports in its own interval
+thread_local std::chrono::steady_clock::time_point lastProgressTime;
+
 //***********************************
 // Cleared area bounding support
 //***********************************
@@ -1761,7 +1767,6 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(
     // 1/"tolerance" = number of min-size adaptive steps per stepover
     scaleFactor = MIN_STEP_CLIPPER / tolerance / min(1.0, stepOverFactor * toolDiameter);
 
-    current_region = 0;
     cout << "Tool Diameter: " << toolDiameter << endl;
     cout << "Min step size: " << round(MIN_STEP_CLIPPER / scaleFactor * 1000 * 10) / 10 << " um"
          << endl;
@@ -1770,7 +1775,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(
     toolRadiusScaled = long(toolDiameter * scaleFactor / 2);
     stepOverScaled = toolRadiusScaled * stepOverFactor;
     progressCallback = &progressCallbackFn;
-    lastProgressTime = clock();
+    lastProgressTime = std::chrono::steady_clock::now();
     stopProcessing = false;
 
     if (helixRampTargetDiameter < NTOL) {
@@ -1852,6 +1857,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(
     //***************************************
     //	Resolve hierarchy and run processing
     //***************************************
+    std::vector<std::pair<Paths, Paths>> regions;  // bound paths and tool bound paths
     double cornerRoundingOffset = 0.15 * toolRadiusScaled / 2;
     if (opType == OperationType::otClearingInside || opType == OperationType::otClearingOutside) {
 
@@ -1903,7 +1909,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(
                 clipof.Clear();
                 clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
                 clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
-                ProcessPolyNode(boundPaths, toolBoundPaths);
+                regions.emplace_back(boundPaths, toolBoundPaths);
             }
         }
     }
@@ -1960,14 +1966,114 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(
                     clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
                     clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
 
-                    ProcessPolyNode(boundPaths, toolBoundPaths);
+                    regions.emplace_back(boundPaths, toolBoundPaths);
                 }
             }
         }
     }
+    ProcessRegions(regions);
     return results;
 }
 
+void Adaptive2d::ProcessRegions(const std::vector<std::pair<Paths, Paths>>& regions)
+{
+    // regions are independent, the results are added in the order of the regions
+    std::vector<AdaptiveOutput> outputs(regions.size());
+    std::vector<char> processed(regions.size(), 0);
+
+    size_t threadCount = std::min<size_t>(regions.size(), std::thread::hardware_concurrency());
+#ifdef DEV_MODE
+    threadCount = 1;  // the debugging functions and perf counters are not thread safe
+#endif
+
+    if (threadCount <= 1) {
+        for (size_t i = 0; i < regions.size(); i++) {
+            processed[i] = ProcessPolyNode(i + 1, regions[i].first, regions[i].second, outputs[i]);
+        }
+    }
+    else {
+        // the progress callback may call into python, so the worker threads only collect the
+        // progress and the calling thread reports it
+        std::condition_variable workersDone;
+        std::atomic<size_t> nextRegion = 0;
+        size_t runningWorkers = threadCount;
+        std::exception_ptr workerError;
+        reportFromWorkers = true;
+
+        auto worker = [&]() {
+            try {
+                for (size_t i = nextRegion++; i < regions.size(); i = nextRegion++) {
+                    processed[i] = ProcessPolyNode(
+                        i + 1,
+                        regions[i].first,
+                        regions[i].second,
+                        outputs[i]
+                    );
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(progressMutex);
+                if (!workerError) {
+                    workerError = std::current_exception();
+                }
+                stopProcessing = true;
+            }
+            std::lock_guard<std::mutex> lock(progressMutex);
+            runningWorkers--;
+            workersDone.notify_one();
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < threadCount; i++) {
+            workers.emplace_back(worker);
+        }
+
+        std::exception_ptr callbackError;
+        std::unique_lock<std::mutex> lock(progressMutex);
+        bool done = false;
+        while (!done) {
+            done = workersDone.wait_for(lock, PROGRESS_INTERVAL, [&]() {
+                return runningWorkers == 0;
+            });
+            if (workerProgress.empty() || !progressCallback || callbackError) {
+                continue;
+            }
+            TPaths progressPaths;
+            progressPaths.swap(workerProgress);
+            lock.unlock();
+            try {
+                if ((*progressCallback)(progressPaths)) {
+                    stopProcessing = true;
+                }
+            }
+            catch (...) {
+                callbackError = std::current_exception();
+                stopProcessing = true;
+            }
+            lock.lock();
+        }
+        lock.unlock();
+
+        for (auto& thread : workers) {
+            thread.join();
+        }
+        reportFromWorkers = false;
+        workerProgress.clear();
+        if (workerError) {
+            std::rethrow_exception(workerError);
+        }
+        if (callbackError) {
+            std::rethrow_exception(callbackError);
+        }
+    }
+
+    for (size_t i = 0; i < regions.size(); i++) {
+        if (processed[i]) {
+            results.push_back(outputs[i]);
+        }
+    }
+}
+
 bool Adaptive2d::FindEntryPoint(
     TPaths& progressPaths,
     const Paths& toolBoundPaths,
@@ -2271,15 +2377,16 @@ bool Adaptive2d::ResolveLinkPath(
     double par;
 
     // put a time limit on the resolving the link path
-    clock_t time_limit = (clock_t)(max(keepToolDownDistRatio, 3.0) * CLOCKS_PER_SEC / 6);
+    // wall time, the regions are processed in parallel
+    auto time_limit = std::chrono::duration<double>(max(keepToolDownDistRatio, 3.0) / 6);
 
-    clock_t time_out = clock() + time_limit;
+    auto time_out = std::chrono::steady_clock::now() + time_limit;
 
     while (!queue.empty()) {
         if (stopProcessing) {
             return false;
         }
-        if (clock() > time_out) {
+        if (std::chrono::steady_clock::now() > time_out) {
             cout << "Unable to resolve tool down linking path (limit reached)." << endl;
             return false;
         }
@@ -2725,14 +2832,20 @@ void Adaptive2d::AppendToolPath(
 
 void Adaptive2d::CheckReportProgress(TPaths& progressPaths, bool force)
 {
-    if (!force && (clock() - lastProgressTime < PROGRESS_TICKS)) {
+    auto now = std::chrono::steady_clock::now();
+    if (!force && (now - lastProgressTime < PROGRESS_INTERVAL)) {
         return;  // not yet
     }
-    lastProgressTime = clock();
+    lastProgressTime = now;
     if (progressPaths.empty()) {
         return;
     }
-    if (progressCallback) {
+    if (reportFromWorkers) {
+        // reported by the thread that called Execute, see ProcessRegions
+        std::lock_guard<std::mutex> lock(progressMutex);
+        workerProgress.insert(workerProgress.end(), progressPaths.begin(), progressPaths.end());
+    }
+    else if (progressCallback) {
         if ((*progressCallback)(progressPaths)) {
             stopProcessing = true;  // call python function, if returns true signal stop processing
         }
@@ -2788,11 +2901,15 @@ void Adaptive2d::AddPathToProgress(TPaths& progressPaths, const Path pth, Motion
     }
 }
 
-void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
+bool Adaptive2d::ProcessPolyNode(
+    size_t region,
+    Paths boundPaths,
+    Paths toolBoundPaths,
+    AdaptiveOutput& output
+)
 {
     Perf_ProcessPolyNode.Start();
-    current_region++;
-    cout << "** Processing region: " << current_region << endl;
+    cout << "** Processing region: " << region << endl;
 
     // node paths are already constrained to tool boundary path for adaptive path before finishing
     // pass
@@ -2856,7 +2973,7 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
                 helixRadiusScaled
             )) {
             Perf_ProcessPolyNode.Stop();
-            return;
+            return false;
         }
     }
 
@@ -2873,7 +2990,6 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
     // cout << "Entry point:" << double(entryPoint.X)/scaleFactor << "," <<
     // double(entryPoint.Y)/scaleFactor << endl;
 
-    AdaptiveOutput output;
     output.ReturnMotionType = 0;
     output.HelixCenterPoint.first = double(entryPoint.X) / scaleFactor;
     output.HelixCenterPoint.second = double(entryPoint.Y) / scaleFactor;
@@ -3442,7 +3558,7 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
                  << "Hint: try to modify accuracy and/or step-over." << endl;
         }
     }
-    results.push_back(output);
+    return true;
 }
 
 }  // namespace AdaptivePath
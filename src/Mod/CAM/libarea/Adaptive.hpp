@@ -23,6 +23,10 @@
  ***************************************************************************/
 
 #include "clipper.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
 #include <vector>
 #include <list>
 #include <time.h>
@@ -80,7 +84,8 @@ struct AdaptiveOutput
     int ReturnMotionType;  // MotionType enum, problem with serialization if enum is used
 };
 
-// used to isolate state -> enable potential adding of multi-threaded processing of separate regions
+// used to isolate state -> separate regions are processed by multiple threads, each with its own
+// Clipper instances and cleared area
 
 class Adaptive2d
 {
@@ -123,14 +128,21 @@ private:
     long helixRampMinRadiusScaled = 0;
     double referenceCutArea = 0;
     double optimalCutAreaPD = 0;
-    bool stopProcessing = false;
-    int current_region = 0;
-    clock_t lastProgressTime = 0;
+    std::atomic<bool> stopProcessing = false;
 
     std::function<bool(TPaths)>* progressCallback = NULL;
+    std::mutex progressMutex;        // guards the progress of the worker threads
+    TPaths workerProgress;           // progress of the worker threads, not yet reported
+    bool reportFromWorkers = false;  // whether the progress is reported by the calling thread
     Path toolGeometry;  // tool geometry at coord 0,0, should not be modified
 
-    void ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths);
+    void ProcessRegions(const std::vector<std::pair<Paths, Paths>>& regions);
+    bool ProcessPolyNode(
+        size_t region,
+        Paths boundPaths,
+        Paths toolBoundPaths,
+        AdaptiveOutput& output /*output*/
+    );
     bool FindEntryPoint(
         TPaths& progressPaths,
         const Paths& toolBoundPaths,
@@ -219,9 +231,9 @@ private:  // constants for fine tuning
     const double CLEAN_PATH_TOLERANCE = 1.41;            // should be >1
     const double FINISHING_CLEAN_PATH_TOLERANCE = 1.41;  // should be >1
 
-    const long PASSES_LIMIT = __LONG_MAX__;              // limit used while debugging
-    const long POINTS_PER_PASS_LIMIT = __LONG_MAX__;     // limit used while debugging
-    const clock_t PROGRESS_TICKS = CLOCKS_PER_SEC / 10;  // progress report interval
+    const long PASSES_LIMIT = __LONG_MAX__;                   // limit used while debugging
+    const long POINTS_PER_PASS_LIMIT = __LONG_MAX__;          // limit used while debugging
+    const std::chrono::milliseconds PROGRESS_INTERVAL {100};  // progress report interval
 };
 }  // namespace AdaptivePath
 #endif
@@ -21,23 +21,33 @@
  ***************************************************************************/
 
 #include <Python.h>
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <unordered_map>
 
+#include <BRepAdaptor_Curve.hxx>
 #include <BRepBndLib.hxx>
-#include <BRepBuilderAPI_MakeVertex.hxx>
-#include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepClass3d_SolidClassifier.hxx>
+#include <BRepTools.hxx>
+#include <BRepTopAdaptor_FClass2d.hxx>
 #include <BRep_Tool.hxx>
 #include <Bnd_Box.hxx>
+#include <ElCLib.hxx>
+#include <Geom_Surface.hxx>
 #include <SMDS_MeshGroup.hxx>
 #include <SMESHDS_Group.hxx>
 #include <SMESHDS_GroupBase.hxx>
 #include <SMESHDS_Mesh.hxx>
+#include <SMESHDS_SubMesh.hxx>
 #include <SMESH_Gen.hxx>
 #include <SMESH_Group.hxx>
 #include <SMESH_Mesh.hxx>
 #include <SMESH_MeshEditor.hxx>
+#include <ShapeAnalysis_Curve.hxx>
 #include <ShapeAnalysis_ShapeTolerance.hxx>
+#include <ShapeAnalysis_Surface.hxx>
 #include <StdMeshers_Deflection1D.hxx>
 #include <StdMeshers_LocalLength.hxx>
 #include <StdMeshers_MaxElementArea.hxx>
@@ -47,16 +57,23 @@
 #include <StdMeshers_Quadrangle_2D.hxx>
 #include <StdMeshers_Regular_1D.hxx>
 #include <StdMeshers_StartEndLength.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Solid.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <gp_Pnt.hxx>
+#include <gp_Pnt2d.hxx>
 
 #include <boost/assign/list_of.hpp>
 #include <boost/tokenizer.hpp>  //to simplify parsing input files we use the boost lib
 
 #include <App/Application.h>
+#include <Base/BoundBox.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
@@ -339,111 +356,533 @@ std::set<long> FemMesh::getSurfaceNodes(long /*ElemId*/, short /*FaceId*/, float
     return result;
 }
 
-/*! That function returns map containing volume ID and face ID.
+namespace
+{
+/*! A uniform grid over the mesh nodes in absolute space. It is used to restrict the
+ * geometric classification to the nodes close to a shape.
  */
-std::list<std::pair<int, int>> FemMesh::getVolumesByFace(const TopoDS_Face& face) const
+class NodeGrid
+{
+public:
+    NodeGrid(const SMESHDS_Mesh* meshDS, const Base::Matrix4D& mat)
+    {
+        SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
+        while (aNodeIter->more()) {
+            const SMDS_MeshNode* aNode = aNodeIter->next();
+            Base::Vector3d vec(aNode->X(), aNode->Y(), aNode->Z());
+            // Apply the matrix to hold the nodes in absolute space.
+            vec = mat * vec;
+            ids.push_back(aNode->GetID());
+            points.emplace_back(vec.x, vec.y, vec.z);
+            bbox.Add(vec);
+        }
+
+        build();
+    }
+
+    std::size_t size() const
+    {
+        return points.size();
+    }
+    int id(std::size_t index) const
+    {
+        return ids[index];
+    }
+    const gp_Pnt& point(std::size_t index) const
+    {
+        return points[index];
+    }
+
+    /// Appends the indices of all nodes inside the box
+    void inside(const Bnd_Box& box, std::vector<std::size_t>& indices) const
+    {
+        if (points.empty() || box.IsVoid()) {
+            return;
+        }
+
+        double xmin, ymin, zmin, xmax, ymax, zmax;
+        box.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+        if (xmax < bbox.MinX || ymax < bbox.MinY || zmax < bbox.MinZ || xmin > bbox.MaxX
+            || ymin > bbox.MaxY || zmin > bbox.MaxZ) {
+            return;
+        }
+
+        int ix0 = cellX(xmin), ix1 = cellX(xmax);
+        int iy0 = cellY(ymin), iy1 = cellY(ymax);
+        int iz0 = cellZ(zmin), iz1 = cellZ(zmax);
+        for (int ix = ix0; ix <= ix1; ix++) {
+            for (int iy = iy0; iy <= iy1; iy++) {
+                for (int iz = iz0; iz <= iz1; iz++) {
+                    std::size_t cell = cellIndex(ix, iy, iz);
+                    for (std::size_t i = offsets[cell]; i < offsets[cell + 1]; i++) {
+                        std::size_t index = sorted[i];
+                        if (!box.IsOut(points[index])) {
+                            indices.push_back(index);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    void build()
+    {
+        if (points.empty()) {
+            return;
+        }
+
+        // aim at a few nodes per cell but keep the grid bounded for degenerated meshes
+        const double nodesPerCell = 8.0;
+        const int maxCellsPerAxis = 1024;
+        double eps = std::max(bbox.CalcDiagonalLength() * 1e-6, 1e-12);
+        double lx = std::max(bbox.LengthX(), eps);
+        double ly = std::max(bbox.LengthY(), eps);
+        double lz = std::max(bbox.LengthZ(), eps);
+        double cellSize = std::cbrt(lx * ly * lz * nodesPerCell / double(points.size()));
+        auto cellCount = [&](double len) {
+            double count = std::clamp(len / cellSize + 1.0, 1.0, double(maxCellsPerAxis));
+            return static_cast<int>(count);
+        };
+        nx = cellCount(lx);
+        ny = cellCount(ly);
+        nz = cellCount(lz);
+        sx = nx / lx;
+        sy = ny / ly;
+        sz = nz / lz;
+
+        // counting sort of the node indices by cell
+        std::vector<std::size_t> cells(points.size());
+        offsets.assign(std::size_t(nx) * ny * nz + 1, 0);
+        for (std::size_t i = 0; i < points.size(); i++) {
+            const gp_Pnt& pnt = points[i];
+            cells[i] = cellIndex(cellX(pnt.X()), cellY(pnt.Y()), cellZ(pnt.Z()));
+            offsets[cells[i] + 1]++;
+        }
+        for (std::size_t i = 1; i < offsets.size(); i++) {
+            offsets[i] += offsets[i - 1];
+        }
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        sorted.resize(points.size());
+        for (std::size_t i = 0; i < points.size(); i++) {
+            sorted[fill[cells[i]]++] = i;
+        }
+    }
+
+    int cellX(double x) const
+    {
+        return static_cast<int>(std::clamp((x - bbox.MinX) * sx, 0.0, nx - 1.0));
+    }
+    int cellY(double y) const
+    {
+        return static_cast<int>(std::clamp((y - bbox.MinY) * sy, 0.0, ny - 1.0));
+    }
+    int cellZ(double z) const
+    {
+        return static_cast<int>(std::clamp((z - bbox.MinZ) * sz, 0.0, nz - 1.0));
+    }
+    std::size_t cellIndex(int ix, int iy, int iz) const
+    {
+        return (std::size_t(ix) * ny + iy) * nz + iz;
+    }
+
+private:
+    std::vector<int> ids;
+    std::vector<gp_Pnt> points;
+    Base::BoundBox3d bbox;
+    int nx = 1, ny = 1, nz = 1;
+    double sx = 1.0, sy = 1.0, sz = 1.0;
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> sorted;
+};
+
+/*! Tests if a point lies on an edge by projecting it onto the bounded curve.
+ */
+class EdgeProjector
 {
-    std::list<std::pair<int, int>> result;
-    std::set<int> nodes_on_face = getNodesByFace(face);
+public:
+    EdgeProjector(const TopoDS_Edge& edge, double limit)
+        : limit(limit)
+        , degenerated(BRep_Tool::Degenerated(edge))
+    {
+        if (!degenerated) {
+            curve.Initialize(edge);
+            BRepBndLib::Add(edge, box);
+            box.Enlarge(limit);
+        }
+    }
+
+    bool isOn(const gp_Pnt& pnt) const
+    {
+        if (degenerated || box.IsOut(pnt)) {
+            return false;
+        }
+
+        gp_Pnt proj;
+        double param;
+        ShapeAnalysis_Curve analysis;
+        return analysis.Project(curve, pnt, limit, proj, param) < limit;
+    }
+
+private:
+    double limit;
+    bool degenerated;
+    BRepAdaptor_Curve curve;
+    Bnd_Box box;
+};
+
+/*! Tests if a point lies on a face by projecting it onto the underlying surface and
+ * classifying the parameters against the face boundary. Points the 2D classification
+ * rejects are finally tested against the boundary edges.
+ * On periodic surfaces the projected parameters are shifted into the period centred on
+ * the parameter range of the face, as the face may lie in any period of the surface.
+ * An instance must not be shared between threads.
+ */
+class FaceProjector
+{
+public:
+    FaceProjector(const TopoDS_Face& face, double limit)
+        : limit(limit)
+        , surface(new ShapeAnalysis_Surface(BRep_Tool::Surface(face)))
+        , classifier(face, limit)
+    {
+        for (TopExp_Explorer xp(face, TopAbs_EDGE); xp.More(); xp.Next()) {
+            const TopoDS_Edge& edge = TopoDS::Edge(xp.Current());
+            edges.emplace_back(edge, std::max(limit, BRep_Tool::Tolerance(edge)));
+        }
+
+        double umin, umax, vmin, vmax;
+        BRepTools::UVBounds(face, umin, umax, vmin, vmax);
+        const Handle(Geom_Surface)& surf = surface->Surface();
+        if (surf->IsUPeriodic()) {
+            uPeriod = surf->UPeriod();
+            uStart = 0.5 * (umin + umax - uPeriod);
+        }
+        if (surf->IsVPeriodic()) {
+            vPeriod = surf->VPeriod();
+            vStart = 0.5 * (vmin + vmax - vPeriod);
+        }
+    }
+
+    bool isOn(const gp_Pnt& pnt)
+    {
+        gp_Pnt2d uv = surface->ValueOfUV(pnt, limit);
+        if (surface->Gap() >= limit) {
+            return false;
+        }
+
+        if (uPeriod > 0.0) {
+            uv.SetX(ElCLib::InPeriod(uv.X(), uStart, uStart + uPeriod));
+        }
+        if (vPeriod > 0.0) {
+            uv.SetY(ElCLib::InPeriod(uv.Y(), vStart, vStart + vPeriod));
+        }
+
+        TopAbs_State state = classifier.Perform(uv);
+        if (state == TopAbs_IN || state == TopAbs_ON) {
+            return true;
+        }
+
+        return std::ranges::any_of(edges, [&pnt](const EdgeProjector& edge) {
+            return edge.isOn(pnt);
+        });
+    }
+
+private:
+    double limit;
+    double uStart {0.0};
+    double uPeriod {0.0};
+    double vStart {0.0};
+    double vPeriod {0.0};
+    Handle(ShapeAnalysis_Surface) surface;
+    BRepTopAdaptor_FClass2d classifier;
+    std::vector<EdgeProjector> edges;
+};
+
+/*! For tetrahedral elements as per CalculiX definition:
+ * Face 1: 1-2-3, missing point 4 means it's face P1
+ * Face 2: 1-4-2, missing point 3 means it's face P2
+ * Face 3: 2-4-3, missing point 1 means it's face P3
+ * Face 4: 3-4-1, missing point 2 means it's face P4
+ */
+int ccxFaceByMissingNode(int missing_node)
+{
+    switch (missing_node) {
+        case 1:
+            return 3;
+        case 2:
+            return 4;
+        case 3:
+            return 2;
+        case 4:
+            return 1;
+        default:
+            assert(false);  // should never happen
+            return 0;
+    }
+}
+
+/*! Maps each node ID to the indices of the node sets it belongs to.
+ */
+std::unordered_map<int, std::vector<std::size_t>> nodeSetIndex(
+    const std::vector<std::set<int>>& nodeSets
+)
+{
+    std::unordered_map<int, std::vector<std::size_t>> index;
+    for (std::size_t i = 0; i < nodeSets.size(); i++) {
+        for (int id : nodeSets[i]) {
+            index[id].push_back(i);
+        }
+    }
+    return index;
+}
+}  // namespace
+
+/*! Collects the nodes of the sub-meshes of \a shape and of all its edges and vertices.
+ * Returns false if the mesh hasn't been computed from a shape containing \a shape.
+ */
+bool FemMesh::getNodesBySubMesh(const TopoDS_Shape& shape, std::set<int>& nodes) const
+{
+    if (!myMesh->HasShapeToMesh()) {
+        return false;
+    }
+
+    SMESHDS_Mesh* meshDS = myMesh->GetMeshDS();
+    if (meshDS->ShapeToIndex(shape) <= 0) {
+        return false;
+    }
+
+    // the nodes on the boundary of a shape are stored in the sub-meshes of its sub-shapes
+    TopTools_IndexedMapOfShape subShapes;
+    subShapes.Add(shape);
+    TopExp::MapShapes(shape, TopAbs_FACE, subShapes);
+    TopExp::MapShapes(shape, TopAbs_EDGE, subShapes);
+    TopExp::MapShapes(shape, TopAbs_VERTEX, subShapes);
+
+    std::set<int> result;
+    for (int i = 1; i <= subShapes.Extent(); i++) {
+        SMESHDS_SubMesh* subMesh = meshDS->MeshElements(subShapes(i));
+        if (!subMesh) {
+            continue;
+        }
+
+        SMDS_NodeIteratorPtr aNodeIter = subMesh->GetNodes();
+        while (aNodeIter && aNodeIter->more()) {
+            result.insert(aNodeIter->next()->GetID());
+        }
+    }
+
+    // an empty result means the mesh hasn't been computed yet
+    if (result.empty()) {
+        return false;
+    }
+
+    nodes = std::move(result);
+    return true;
+}
+
+std::vector<std::set<int>> FemMesh::getNodesByFaces(const std::vector<TopoDS_Face>& faces) const
+{
+    std::vector<std::set<int>> result(faces.size());
+
+    std::vector<std::size_t> pending;
+    for (std::size_t i = 0; i < faces.size(); ++i) {
+        if (!getNodesBySubMesh(faces[i], result[i])) {
+            pending.push_back(i);
+        }
+    }
+
+    if (pending.empty()) {
+        return result;
+    }
+
+    NodeGrid grid(myMesh->GetMeshDS(), getTransform());
+
+#pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const TopoDS_Face& face = faces[pending[i]];
+        std::set<int>& nodes = result[pending[i]];
+
+        Bnd_Box box;
+        BRepBndLib::Add(
+            face,
+            box,
+            Standard_False
+        );  // https://forum.freecad.org/viewtopic.php?f=18&t=21571&start=70#p221591
+        // limit where the mesh node belongs to the face:
+        double limit = BRep_Tool::Tolerance(face);
+        box.Enlarge(limit);
+
+        std::vector<std::size_t> candidates;
+        grid.inside(box, candidates);
+        if (candidates.empty()) {
+            continue;
+        }
+
+        FaceProjector projector(face, limit);
+        for (std::size_t index : candidates) {
+            if (projector.isOn(grid.point(index))) {
+                nodes.insert(grid.id(index));
+            }
+        }
+    }
+
+    return result;
+}
+
+std::vector<std::set<int>> FemMesh::getNodesByEdges(const std::vector<TopoDS_Edge>& edges) const
+{
+    std::vector<std::set<int>> result(edges.size());
+
+    std::vector<std::size_t> pending;
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        if (!getNodesBySubMesh(edges[i], result[i])) {
+            pending.push_back(i);
+        }
+    }
+
+    if (pending.empty()) {
+        return result;
+    }
+
+    NodeGrid grid(myMesh->GetMeshDS(), getTransform());
+
+#pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const TopoDS_Edge& edge = edges[pending[i]];
+        std::set<int>& nodes = result[pending[i]];
+
+        Bnd_Box box;
+        BRepBndLib::Add(edge, box);
+        // limit where the mesh node belongs to the edge:
+        double limit = BRep_Tool::Tolerance(edge);
+        box.Enlarge(limit);
+
+        std::vector<std::size_t> candidates;
+        grid.inside(box, candidates);
+
+        EdgeProjector projector(edge, limit);
+        for (std::size_t index : candidates) {
+            if (projector.isOn(grid.point(index))) {
+                nodes.insert(grid.id(index));
+            }
+        }
+    }
+
+    return result;
+}
+
+/*! That function returns for each face a list containing volume ID and face ID.
+ */
+std::vector<std::list<std::pair<int, int>>> FemMesh::getVolumesByFaces(
+    const std::vector<TopoDS_Face>& faces
+) const
+{
+    std::vector<std::list<std::pair<int, int>>> result(faces.size());
+    std::vector<std::set<int>> nodes_on_faces = getNodesByFaces(faces);
+    std::unordered_map<int, std::vector<std::size_t>> node_faces = nodeSetIndex(nodes_on_faces);
 
     // SMDS_MeshVolume::facesIterator() is broken with SMESH7 as it is impossible
     // to iterate volume faces
     // In SMESH9 this function has been removed
     //
-    std::map<int, std::set<int>> face_nodes;
-
-    // get faces that contribute to 'nodes_on_face' with all of its nodes
+    // get faces that contribute to 'nodes_on_faces' with all of its nodes and
+    // then the volumes sharing all nodes of such a face
     SMDS_FaceIteratorPtr face_iter = myMesh->GetMeshDS()->facesIterator();
     while (face_iter && face_iter->more()) {
         const SMDS_MeshFace* face = face_iter->next();
-        SMDS_NodeIteratorPtr node_iter = face->nodeIterator();
-
-        // all nodes of the current face must be part of 'nodes_on_face'
-        std::set<int> node_ids;
-        while (node_iter && node_iter->more()) {
-            const SMDS_MeshNode* node = node_iter->next();
-            node_ids.insert(node->GetID());
-        }
-
-        std::vector<int> element_face_nodes;
-        std::set_intersection(
-            nodes_on_face.begin(),
-            nodes_on_face.end(),
-            node_ids.begin(),
-            node_ids.end(),
-            std::back_insert_iterator<std::vector<int>>(element_face_nodes)
-        );
-
-        if (element_face_nodes.size() == node_ids.size()) {
-            face_nodes[face->GetID()] = node_ids;
+        if (face->NbNodes() == 0) {
+            continue;
         }
-    }
 
-    // get all nodes of a volume and check which faces contribute to it with all of its nodes
-    SMDS_VolumeIteratorPtr vol_iter = myMesh->GetMeshDS()->volumesIterator();
-    while (vol_iter->more()) {
-        const SMDS_MeshVolume* vol = vol_iter->next();
-        SMDS_NodeIteratorPtr node_iter = vol->nodeIterator();
-        std::set<int> node_ids;
-        while (node_iter && node_iter->more()) {
-            const SMDS_MeshNode* node = node_iter->next();
-            node_ids.insert(node->GetID());
+        auto it = node_faces.find(face->GetNode(0)->GetID());
+        if (it == node_faces.end()) {
+            continue;
         }
 
-        for (const auto& it : face_nodes) {
-            std::vector<int> element_face_nodes;
-            std::set_intersection(
-                node_ids.begin(),
-                node_ids.end(),
-                it.second.begin(),
-                it.second.end(),
-                std::back_insert_iterator<std::vector<int>>(element_face_nodes)
-            );
+        for (std::size_t index : it->second) {
+            const std::set<int>& nodes_on_face = nodes_on_faces[index];
+            bool on_face = true;
+            for (int i = 1; i < face->NbNodes() && on_face; i++) {
+                on_face = nodes_on_face.contains(face->GetNode(i)->GetID());
+            }
+            if (!on_face) {
+                continue;
+            }
 
             // For curved faces it is possible that a volume contributes more than one face
-            if (element_face_nodes.size() == it.second.size()) {
-                result.emplace_back(vol->GetID(), it.first);
+            SMDS_ElemIteratorPtr vol_iter = face->GetNode(0)->GetInverseElementIterator(
+                SMDSAbs_Volume
+            );
+            while (vol_iter && vol_iter->more()) {
+                const SMDS_MeshElement* vol = vol_iter->next();
+                bool in_volume = true;
+                for (int i = 1; i < face->NbNodes() && in_volume; i++) {
+                    in_volume = vol->GetNodeIndex(face->GetNode(i)) >= 0;
+                }
+                if (in_volume) {
+                    result[index].emplace_back(vol->GetID(), face->GetID());
+                }
             }
         }
     }
-    result.sort();
+
+    for (auto& it : result) {
+        it.sort();
+    }
     return result;
 }
 
+/*! That function returns map containing volume ID and face ID.
+ */
+std::list<std::pair<int, int>> FemMesh::getVolumesByFace(const TopoDS_Face& face) const
+{
+    return getVolumesByFaces({face}).front();
+}
+
 /*! That function returns a list of face IDs.
  */
 std::list<int> FemMesh::getFacesByFace(const TopoDS_Face& face) const
 {
-    // TODO: This function is broken with SMESH7 as it is impossible to iterate volume faces
-    std::list<int> result;
-    std::set<int> nodes_on_face = getNodesByFace(face);
+    return getFacesByFaces({face}).front();
+}
 
-    SMDS_FaceIteratorPtr face_iter = myMesh->GetMeshDS()->facesIterator();
-    while (face_iter->more()) {
-        const SMDS_MeshFace* face = static_cast<const SMDS_MeshFace*>(face_iter->next());
-        int numNodes = face->NbNodes();
+/*! That function returns for each face a list of the IDs of the mesh faces lying on it.
+ */
+std::vector<std::list<int>> FemMesh::getFacesByFaces(const std::vector<TopoDS_Face>& faces) const
+{
+    std::vector<std::list<int>> result(faces.size());
+    std::vector<std::set<int>> nodes_on_faces = getNodesByFaces(faces);
+    std::unordered_map<int, std::vector<std::size_t>> node_faces = nodeSetIndex(nodes_on_faces);
 
-        std::set<int> face_nodes;
-        for (int i = 0; i < numNodes; i++) {
-            face_nodes.insert(face->GetNode(i)->GetID());
+    SMDS_FaceIteratorPtr face_iter = myMesh->GetMeshDS()->facesIterator();
+    while (face_iter && face_iter->more()) {
+        const SMDS_MeshFace* face = face_iter->next();
+        if (face->NbNodes() == 0) {
+            continue;
         }
 
-        std::vector<int> element_face_nodes;
-        std::set_intersection(
-            nodes_on_face.begin(),
-            nodes_on_face.end(),
-            face_nodes.begin(),
-            face_nodes.end(),
-            std::back_insert_iterator<std::vector<int>>(element_face_nodes)
-        );
+        auto it = node_faces.find(face->GetNode(0)->GetID());
+        if (it == node_faces.end()) {
+            continue;
+        }
 
         // For curved faces it is possible that a volume contributes more than one face
-        if (element_face_nodes.size() == static_cast<std::size_t>(numNodes)) {
-            result.push_back(face->GetID());
+        for (std::size_t index : it->second) {
+            const std::set<int>& nodes_on_face = nodes_on_faces[index];
+            bool on_face = true;
+            for (int i = 1; i < face->NbNodes() && on_face; i++) {
+                on_face = nodes_on_face.contains(face->GetNode(i)->GetID());
+            }
+            if (on_face) {
+                result[index].push_back(face->GetID());
+            }
         }
     }
 
-    result.sort();
+    for (auto& it : result) {
+        it.sort();
+    }
     return result;
 }
 
@@ -479,15 +918,26 @@ std::list<int> FemMesh::getEdgesByEdge(const TopoDS_Edge& edge) const
     result.sort();
     return result;
 }
-
 /*! That function returns map containing volume ID and face number
  * as per CalculiX definition for tetrahedral elements. See CalculiX
  * documentation for the details.
  */
 std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face& face) const
 {
-    std::map<int, int> result;
-    std::set<int> nodes_on_face = getNodesByFace(face);
+    return getccxVolumesByFaces({face}).front();
+}
+
+/*! That function returns for each face a map containing volume ID and face number
+ * as per CalculiX definition for tetrahedral elements. All faces are handled in a
+ * single pass over the volumes.
+ */
+std::vector<std::map<int, int>> FemMesh::getccxVolumesByFaces(
+    const std::vector<TopoDS_Face>& faces
+) const
+{
+    std::vector<std::map<int, int>> result(faces.size());
+    std::vector<std::set<int>> nodes_on_faces = getNodesByFaces(faces);
+    std::unordered_map<int, std::vector<std::size_t>> node_faces = nodeSetIndex(nodes_on_faces);
 
     static std::map<int, std::vector<int>> elem_order;
     if (elem_order.empty()) {
@@ -499,70 +949,45 @@ std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face& face) const
     }
 
     SMDS_VolumeIteratorPtr vol_iter = myMesh->GetMeshDS()->volumesIterator();
-    std::set<int> element_nodes;
-    int num_of_nodes;
+    std::vector<int> element_nodes;
+    std::map<std::size_t, int> face_node_count;
     while (vol_iter->more()) {
         const SMDS_MeshVolume* vol = vol_iter->next();
-        num_of_nodes = vol->NbNodes();
-        std::pair<int, std::vector<int>> apair;
-        apair.first = vol->GetID();
+        int num_of_nodes = vol->NbNodes();
 
         std::map<int, std::vector<int>>::iterator it = elem_order.find(num_of_nodes);
-        if (it != elem_order.end()) {
-            const std::vector<int>& order = it->second;
-            for (int jt : order) {
-                int vid = vol->GetNode(jt)->GetID();
-                apair.second.push_back(vid);
-            }
+        if (it == elem_order.end()) {
+            continue;
         }
 
-        // Get volume nodes on face
-        std::vector<int> element_face_nodes;
-        std::set<int> element_nodes;
-        element_nodes.insert(apair.second.begin(), apair.second.end());
-        std::set_intersection(
-            nodes_on_face.begin(),
-            nodes_on_face.end(),
-            element_nodes.begin(),
-            element_nodes.end(),
-            std::back_insert_iterator<std::vector<int>>(element_face_nodes)
-        );
+        element_nodes.clear();
+        for (int jt : it->second) {
+            element_nodes.push_back(vol->GetNode(jt)->GetID());
+        }
 
-        if ((element_face_nodes.size() == 3 && num_of_nodes == 4)
-            || (element_face_nodes.size() == 6 && num_of_nodes == 10)) {
-            int missing_node = 0;
-            for (int i = 0; i < 4; i++) {
-                // search for the ID of the volume which is not part of 'element_face_nodes'
-                if (std::ranges::find(element_face_nodes, apair.second[i])
-                    == element_face_nodes.end()) {
-                    missing_node = i + 1;
-                    break;
+        // count the volume nodes on each face
+        face_node_count.clear();
+        for (int vid : element_nodes) {
+            auto jt = node_faces.find(vid);
+            if (jt != node_faces.end()) {
+                for (std::size_t index : jt->second) {
+                    face_node_count[index]++;
                 }
             }
-            /* for tetrahedral elements as per CalculiX definition:
-             Face 1: 1-2-3, missing point 4 means it's face P1
-             Face 2: 1-4-2, missing point 3 means it's face P2
-             Face 3: 2-4-3, missing point 1 means it's face P3
-             Face 4: 3-4-1, missing point 2 means it's face P4 */
-            int face_ccx = 0;
-            switch (missing_node) {
-                case 1:
-                    face_ccx = 3;
-                    break;
-                case 2:
-                    face_ccx = 4;
-                    break;
-                case 3:
-                    face_ccx = 2;
-                    break;
-                case 4:
-                    face_ccx = 1;
-                    break;
-                default:
-                    assert(false);  // should never happen
-                    break;
+        }
+
+        for (const auto& [index, count] : face_node_count) {
+            if ((count == 3 && num_of_nodes == 4) || (count == 6 && num_of_nodes == 10)) {
+                int missing_node = 0;
+                for (int i = 0; i < 4; i++) {
+                    // search for the ID of the volume which is not part of the face nodes
+                    if (!nodes_on_faces[index].contains(element_nodes[i])) {
+                        missing_node = i + 1;
+                        break;
+                    }
+                }
+                result[index][vol->GetID()] = ccxFaceByMissingNode(missing_node);
             }
-            result[apair.first] = face_ccx;
         }
     }
 
@@ -572,6 +997,9 @@ std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face& face) const
 std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid& solid) const
 {
     std::set<int> result;
+    if (getNodesBySubMesh(solid, result)) {
+        return result;
+    }
 
     Bnd_Box box;
     BRepBndLib::Add(solid, box);
@@ -581,151 +1009,41 @@ std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid& solid) const
     ShapeAnalysis_ShapeTolerance analysis;
     double limit = analysis.Tolerance(solid, 1, shapetype);
     Base::Console().log("The limit if a node is in or out: %.12lf in scientific: %.4e \n", limit, limit);
+    box.Enlarge(limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(solid, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
-            }
+    NodeGrid grid(myMesh->GetMeshDS(), getTransform());
+    std::vector<std::size_t> candidates;
+    grid.inside(box, candidates);
 
-            if (measure.Value() < limit)
+#pragma omp parallel
+    {
+        // the classifier keeps state and thus is created per thread
+        BRepClass3d_SolidClassifier classifier(solid);
+
+#pragma omp for schedule(dynamic)
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            std::size_t index = candidates[i];
+            classifier.Perform(grid.point(index), limit);
+            TopAbs_State state = classifier.State();
+            if (state == TopAbs_IN || state == TopAbs_ON)
 #pragma omp critical
             {
-                result.insert(aNode->GetID());
+                result.insert(grid.id(index));
             }
         }
     }
+
     return result;
 }
 
 std::set<int> FemMesh::getNodesByFace(const TopoDS_Face& face) const
 {
-    std::set<int> result;
-
-    Bnd_Box box;
-    BRepBndLib::Add(
-        face,
-        box,
-        Standard_False
-    );  // https://forum.freecad.org/viewtopic.php?f=18&t=21571&start=70#p221591
-    // limit where the mesh node belongs to the face:
-    double limit = BRep_Tool::Tolerance(face);
-    box.Enlarge(limit);
-
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(face, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
-            }
-
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
-            }
-        }
-    }
-
-    return result;
+    return getNodesByFaces({face}).front();
 }
 
 std::set<int> FemMesh::getNodesByEdge(const TopoDS_Edge& edge) const
 {
-    std::set<int> result;
-
-    Bnd_Box box;
-    BRepBndLib::Add(edge, box);
-    // limit where the mesh node belongs to the edge:
-    double limit = BRep_Tool::Tolerance(edge);
-    box.Enlarge(limit);
-
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(edge, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
-            }
-
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
-            }
-        }
-    }
-
-    return result;
+    return getNodesByEdges({edge}).front();
 }
 
 std::set<int> FemMesh::getNodesByVertex(const TopoDS_Vertex& vertex) const
@@ -24,7 +24,9 @@
 #define FEM_FEMMESH_H
 
 #include <list>
+#include <map>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include <SMDSAbs_ElementType.hxx>
@@ -156,6 +158,29 @@ public:
     std::set<int> getFacesOnly() const;
     //@}
 
+    /** @name batch search and retrieval
+     *  Classify the mesh nodes against many shapes at once. If the mesh has been computed
+     *  from a shape the nodes are taken from its sub-meshes, otherwise they are looked up
+     *  in a spatial index and tested by projection onto the shape.
+     *  The results are in the order of the given shapes.
+     */
+    //@{
+    /// retrieving by faces
+    std::vector<std::set<int>> getNodesByFaces(const std::vector<TopoDS_Face>& faces) const;
+    /// retrieving by edges
+    std::vector<std::set<int>> getNodesByEdges(const std::vector<TopoDS_Edge>& edges) const;
+    /// retrieving face IDs number by faces
+    std::vector<std::list<int>> getFacesByFaces(const std::vector<TopoDS_Face>& faces) const;
+    /// retrieving volume IDs and face IDs number by faces
+    std::vector<std::list<std::pair<int, int>>> getVolumesByFaces(
+        const std::vector<TopoDS_Face>& faces
+    ) const;
+    /// retrieving volume IDs and CalculiX face number by faces
+    std::vector<std::map<int, int>> getccxVolumesByFaces(
+        const std::vector<TopoDS_Face>& faces
+    ) const;
+    //@}
+
     /** @name Placement control */
     //@{
     /// set the transformation
@@ -221,6 +246,7 @@ public:
 
 private:
     void copyMeshData(const FemMesh&);
+    bool getNodesBySubMesh(const TopoDS_Shape& shape, std::set<int>& nodes) const;
     void readNastran(const std::string& Filename);
     void readNastran95(const std::string& Filename);
     void readZ88(const std::string& Filename);
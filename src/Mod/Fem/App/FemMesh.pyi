@@ -210,6 +210,31 @@ class FemMesh(ComplexGeoData):
         """Return a list of node IDs which belong to a TopoEdge"""
         ...
 
+    @constmethod
+    def getNodesByFaces(self, faces: list[TopoShapeFace], /) -> list[list[int]]:
+        """Return for each TopoFace a list of node IDs which belong to it"""
+        ...
+
+    @constmethod
+    def getNodesByEdges(self, edges: list[TopoShapeEdge], /) -> list[list[int]]:
+        """Return for each TopoEdge a list of node IDs which belong to it"""
+        ...
+
+    @constmethod
+    def getFacesByFaces(self, faces: list[TopoShapeFace], /) -> list[list[int]]:
+        """Return for each TopoFace a list of face IDs which belong to it"""
+        ...
+
+    @constmethod
+    def getVolumesByFaces(self, faces: list[TopoShapeFace], /) -> list[list[tuple[int, int]]]:
+        """Return for each TopoFace a list of tuples of volume IDs and face IDs"""
+        ...
+
+    @constmethod
+    def getccxVolumesByFaces(self, faces: list[TopoShapeFace], /) -> list[list[tuple[int, int]]]:
+        """Return for each TopoFace a list of tuples of volume IDs and ccx face numbers"""
+        ...
+
     @constmethod
     def getNodesByVertex(self, vertex: TopoShapeVertex, /) -> list[int]:
         """Return a list of node IDs which belong to a TopoVertex"""
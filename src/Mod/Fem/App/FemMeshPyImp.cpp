@@ -29,6 +29,7 @@
 #include <SMESH_Group.hxx>
 #include <SMESH_Mesh.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
 #include <algorithm>
@@ -1514,6 +1515,168 @@ PyObject* FemMeshPy::getNodesByEdge(PyObject* args) const
     }
 }
 
+namespace
+{
+template<typename ShapeT>
+std::vector<ShapeT> getShapesFromSequence(
+    PyObject* seq,
+    PyTypeObject* type,
+    const char* typeName,
+    const ShapeT& (*cast)(const TopoDS_Shape&)
+)
+{
+    std::vector<ShapeT> shapes;
+    Py::Sequence list(seq);
+    for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+        PyObject* item = (*it).ptr();
+        if (!PyObject_TypeCheck(item, type)) {
+            std::string error = std::string("type must be '") + typeName + "', not ";
+            error += Py_TYPE(item)->tp_name;
+            throw Py::TypeError(error);
+        }
+
+        const TopoDS_Shape& sh
+            = static_cast<Part::TopoShapePy*>(item)->getTopoShapePtr()->getShape();
+        if (sh.IsNull()) {
+            throw Py::ValueError(std::string(typeName) + " is empty");
+        }
+        shapes.push_back(cast(sh));
+    }
+
+    return shapes;
+}
+
+template<typename IdSet>
+Py::List idSetsToList(const std::vector<IdSet>& resultSets)
+{
+    Py::List ret;
+    for (const auto& resultSet : resultSets) {
+        Py::List ids;
+        for (int it : resultSet) {
+            ids.append(Py::Long(it));
+        }
+        ret.append(ids);
+    }
+
+    return ret;
+}
+
+template<typename VolumeFaces>
+Py::List volumeSetsToList(const std::vector<VolumeFaces>& resultSets)
+{
+    Py::List ret;
+    for (const auto& resultSet : resultSets) {
+        Py::List volumes;
+        for (const auto& it : resultSet) {
+            Py::Tuple vol_face(2);
+            vol_face.setItem(0, Py::Long(it.first));
+            vol_face.setItem(1, Py::Long(it.second));
+            volumes.append(vol_face);
+        }
+        ret.append(volumes);
+    }
+
+    return ret;
+}
+
+/*! Calls \a func with the shapes of the sequence \a args and converts its result
+ * with \a toList.
+ */
+template<typename ShapeT, typename Func, typename ToList>
+PyObject* callByShapes(
+    PyObject* args,
+    PyTypeObject* type,
+    const char* typeName,
+    const ShapeT& (*cast)(const TopoDS_Shape&),
+    Func func,
+    ToList toList
+)
+{
+    PyObject* pW;
+    if (!PyArg_ParseTuple(args, "O", &pW)) {
+        return nullptr;
+    }
+
+    try {
+        std::vector<ShapeT> shapes = getShapesFromSequence<ShapeT>(pW, type, typeName, cast);
+        return Py::new_reference_to(toList(func(shapes)));
+    }
+    catch (const Py::Exception&) {
+        return nullptr;
+    }
+    catch (Standard_Failure& e) {
+        PyErr_SetString(Base::PyExc_FC_CADKernelError, e.GetMessageString());
+        return nullptr;
+    }
+}
+
+template<typename Func, typename ToList>
+PyObject* callByFaces(PyObject* args, Func func, ToList toList)
+{
+    return callByShapes<TopoDS_Face>(
+        args,
+        &(Part::TopoShapeFacePy::Type),
+        "Face",
+        &TopoDS::Face,
+        func,
+        toList
+    );
+}
+}  // namespace
+
+PyObject* FemMeshPy::getNodesByFaces(PyObject* args) const
+{
+    const FemMesh* mesh = getFemMeshPtr();
+    return callByFaces(
+        args,
+        [mesh](const std::vector<TopoDS_Face>& faces) { return mesh->getNodesByFaces(faces); },
+        idSetsToList<std::set<int>>
+    );
+}
+
+PyObject* FemMeshPy::getNodesByEdges(PyObject* args) const
+{
+    const FemMesh* mesh = getFemMeshPtr();
+    return callByShapes<TopoDS_Edge>(
+        args,
+        &(Part::TopoShapeEdgePy::Type),
+        "Edge",
+        &TopoDS::Edge,
+        [mesh](const std::vector<TopoDS_Edge>& edges) { return mesh->getNodesByEdges(edges); },
+        idSetsToList<std::set<int>>
+    );
+}
+
+PyObject* FemMeshPy::getFacesByFaces(PyObject* args) const
+{
+    const FemMesh* mesh = getFemMeshPtr();
+    return callByFaces(
+        args,
+        [mesh](const std::vector<TopoDS_Face>& faces) { return mesh->getFacesByFaces(faces); },
+        idSetsToList<std::list<int>>
+    );
+}
+
+PyObject* FemMeshPy::getVolumesByFaces(PyObject* args) const
+{
+    const FemMesh* mesh = getFemMeshPtr();
+    return callByFaces(
+        args,
+        [mesh](const std::vector<TopoDS_Face>& faces) { return mesh->getVolumesByFaces(faces); },
+        volumeSetsToList<std::list<std::pair<int, int>>>
+    );
+}
+
+PyObject* FemMeshPy::getccxVolumesByFaces(PyObject* args) const
+{
+    const FemMesh* mesh = getFemMeshPtr();
+    return callByFaces(
+        args,
+        [mesh](const std::vector<TopoDS_Face>& faces) { return mesh->getccxVolumesByFaces(faces); },
+        volumeSetsToList<std::map<int, int>>
+    );
+}
+
 PyObject* FemMeshPy::getNodesByVertex(PyObject* args) const
 {
     PyObject* pW;
@@ -23,11 +23,16 @@
 
 
 #include <Python.h>
+#include <algorithm>
+#include <array>
 #include <charconv>
 #include <cmath>
 #include <cstdlib>
 #include <map>
 #include <memory>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
 
 #include <SMESHDS_Mesh.hxx>
 #include <SMESH_Mesh.hxx>
@@ -52,6 +57,7 @@
 #include <vtkQuadraticTetra.h>
 #include <vtkQuadraticTriangle.h>
 #include <vtkQuadraticWedge.h>
+#include <vtkSMPTools.h>
 #include <vtkStringArray.h>
 #include <vtkTetra.h>
 #include <vtkTriangle.h>
@@ -68,6 +74,7 @@
 #include <App/DocumentObject.h>
 #include <Base/Console.h>
 #include <Base/FileInfo.h>
+#include <Base/MappedFile.h>
 #include <Base/TimeInfo.h>
 #include <Base/Type.h>
 
@@ -1153,28 +1160,135 @@ size_t getFirstNotBlankPos(const std::string_view& view)
     return pos;
 }
 
-// get n-digits value from string_view
-// not used until libc++ std::from_chars supports double values
-// template<typename T>
-// void valueFromLine(const std::string_view::const_iterator& it, int digits, T& value)
-//{
-//    std::string_view sub(it, digits);
-//    auto pos = getFirstNotBlankPos(sub);
-//    std::from_chars(sub.data() + pos, sub.data() + digits, value, 10);
-//}
+// get the field of n digits at pos, clipped to the end of the line
+std::string_view fieldFromLine(std::string_view view, size_t pos, size_t digits)
+{
+    if (pos >= view.size()) {
+        return {};
+    }
+
+    return view.substr(pos, digits);
+}
+
+// get n-digits value from line
 template<typename T>
-void valueFromLine(const std::string_view::iterator& it, int digits, T& value)
+void valueFromLine(std::string_view view, size_t pos, size_t digits, T& value)
 {
-    std::string_view sub(&*it, digits);
-    value = std::strtol(sub.data(), nullptr, 10);
+    std::string_view sub = fieldFromLine(view, pos, digits);
+    sub.remove_prefix(getFirstNotBlankPos(sub));
+    value = 0;
+    std::from_chars(sub.data(), sub.data() + sub.size(), value, 10);
 }
+// std::from_chars is not supported for double values by all standard libraries, so copy
+// the field into a terminated buffer for std::strtod
 template<>
-void valueFromLine<double>(const std::string_view::iterator& it, int digits, double& value)
+void valueFromLine<double>(std::string_view view, size_t pos, size_t digits, double& value)
 {
-    std::string_view sub(&*it, digits);
-    value = std::strtof(sub.data(), nullptr);
+    std::string_view sub = fieldFromLine(view, pos, digits);
+    std::array<char, 32> buffer {};
+    std::copy_n(sub.data(), std::min(sub.size(), buffer.size() - 1), buffer.data());
+    value = std::strtod(buffer.data(), nullptr);
 }
 
+// iterate over the lines of a memory block, handles '\n' and "\r\n" line endings
+class LineCursor
+{
+public:
+    explicit LineCursor(std::string_view data)
+        : data(data)
+    {}
+
+    bool getline(std::string_view& line)
+    {
+        if (data.empty()) {
+            return false;
+        }
+
+        size_t eol = data.find('\n');
+        size_t next = eol == std::string_view::npos ? data.size() : eol + 1;
+        line = data.substr(0, std::min(eol, data.size()));
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+
+        data.remove_prefix(next);
+        return true;
+    }
+
+    // position of the next line
+    const char* position() const
+    {
+        return data.data();
+    }
+
+private:
+    std::string_view data;
+};
+
+// frd file might have nodes that are not numbered starting from zero.
+// The map identifies them by their point id
+class NodeMap
+{
+public:
+    void build(const std::vector<int>& nodes)
+    {
+        count = nodes.size();
+        dense.clear();
+        sparse.clear();
+        if (nodes.empty()) {
+            return;
+        }
+
+        auto [minNode, maxNode] = std::ranges::minmax(nodes);
+        // use a lookup table unless the numbering is very sparse
+        if (minNode >= 0 && static_cast<size_t>(maxNode) < 4 * nodes.size() + 1024) {
+            dense.assign(static_cast<size_t>(maxNode) + 1, -1);
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                dense[nodes[i]] = static_cast<int>(i);
+            }
+        }
+        else {
+            sparse.reserve(nodes.size());
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                sparse[nodes[i]] = static_cast<int>(i);
+            }
+        }
+    }
+
+    // get the point id of the node or -1 if it does not exist
+    int find(int node) const
+    {
+        if (!dense.empty()) {
+            if (node < 0 || static_cast<size_t>(node) >= dense.size()) {
+                return -1;
+            }
+            return dense[node];
+        }
+
+        auto it = sparse.find(node);
+        return it != sparse.end() ? it->second : -1;
+    }
+
+    int at(int node) const
+    {
+        int id = find(node);
+        if (id < 0) {
+            throw std::out_of_range("Invalid node");
+        }
+        return id;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+private:
+    size_t count {0};
+    std::vector<int> dense;
+    std::unordered_map<int, int> sparse;
+};
+
 // add cell from sorted nodes
 template<typename T>
 void addCell(vtkSmartPointer<vtkCellArray>& cellArray, const std::vector<int>& topoElem)
@@ -1306,106 +1420,125 @@ std::vector<size_t> identifyScalarEntities(const std::vector<std::vector<int>> e
     return pos;
 }
 
-// read nodes and fill vtkPoints object
-std::map<int, int> readNodes(
-    std::ifstream& ifstr,
-    const std::string& lines,
-    vtkSmartPointer<vtkPoints>& points
-)
+// block of a frd file
+struct FRDBlock
 {
-    std::string keyCode = "    2C";
-    std::string keyCodeCoord = " -1";
-    long numNodes {0};
-    int indicator {0};
-    int node {0};
-    long nodeID = 0;
+    // key line of the block
+    std::string_view header;
+    // lines between the key line and the end of the block
+    std::string_view data;
+};
+
+struct FRDResultBlock: FRDBlock
+{
+    FRDResultInfo info;
+};
 
-    // frd file might have nodes that are not numbered starting from zero.
-    // Use the map to identify them
-    std::map<int, int> mapNodes;
+// offsets of the blocks of a frd file
+struct FRDIndex
+{
+    FRDBlock nodes;
+    FRDBlock elements;
+    std::vector<FRDResultBlock> results;
+};
 
-    std::string_view view {lines};
-    std::string_view sub = view.substr(keyCode.length() + 18);
+// nodes read from a part of the nodes block
+struct FRDNodeChunk
+{
+    std::vector<int> nodes;
+    std::vector<double> coords;
+};
 
-    valueFromLine(sub.begin(), 12, numNodes);
+// read nodes and fill vtkPoints object
+NodeMap readNodes(const FRDBlock& block, vtkSmartPointer<vtkPoints>& points)
+{
+    std::string_view keyCode = "    2C";
+    std::string_view keyCodeCoord = " -1";
+    int indicator {0};
+    NodeMap mapNodes;
 
-    sub = sub.substr(12 + 37);
-    valueFromLine(sub.begin(), 1, indicator);
+    valueFromLine(block.header, keyCode.length() + 18 + 12 + 37, 1, indicator);
     int digits = getDigits(static_cast<Indicator>(indicator));
 
-    points->SetNumberOfPoints(numNodes);
-
-    std::string line;
-    while (nodeID < numNodes && std::getline(ifstr, line)) {
-        std::vector<double> coords;
-        std::string_view view {line};
-        if (view.rfind(keyCodeCoord, 0) == 0) {
-            std::string_view v(line.data() + keyCodeCoord.length(), digits);
-            valueFromLine(v.begin(), digits, node);
-
-            std::string_view vi = view.substr(keyCodeCoord.length() + digits);
-            double value;
-            for (auto it = vi.begin(); it != vi.end(); it += 12) {
-                valueFromLine(it, 12, value);
-                coords.emplace_back(value);
+    // the node lines are independent of each other, so parse parts of the block in parallel
+    const size_t chunkSize = 1 << 20;
+    std::vector<std::string_view> chunks = Base::splitAtLines(block.data, chunkSize);
+    std::vector<FRDNodeChunk> results(chunks.size());
+    auto parseChunks = [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i) {
+            FRDNodeChunk& result = results[i];
+            LineCursor cursor(chunks[i]);
+            std::string_view line;
+            while (cursor.getline(line)) {
+                if (!line.starts_with(keyCodeCoord)) {
+                    continue;
+                }
+
+                int node {0};
+                valueFromLine(line, keyCodeCoord.length(), digits, node);
+                result.nodes.emplace_back(node);
+
+                size_t pos = keyCodeCoord.length() + digits;
+                for (int j = 0; j < 3; ++j, pos += 12) {
+                    double value {0.0};
+                    valueFromLine(line, pos, 12, value);
+                    result.coords.emplace_back(value);
+                }
             }
         }
+    };
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), parseChunks);
+
+    // concatenate the chunks in file order
+    std::vector<int> nodes;
+    for (const auto& result : results) {
+        nodes.insert(nodes.end(), result.nodes.begin(), result.nodes.end());
+    }
 
-        points->SetPoint(nodeID, coords.data());
-        mapNodes[node] = nodeID++;
+    points->SetNumberOfPoints(static_cast<vtkIdType>(nodes.size()));
+    vtkIdType nodeID = 0;
+    for (const auto& result : results) {
+        for (size_t i = 0; i < result.nodes.size(); ++i) {
+            points->SetPoint(nodeID++, &result.coords[3 * i]);
+        }
     }
 
+    mapNodes.build(nodes);
     return mapNodes;
 }
 
 // fill elements and fill cell array
 std::vector<int> readElements(
-    std::ifstream& ifstr,
-    const std::string& lines,
-    const std::map<int, int>& mapNodes,
+    const FRDBlock& block,
+    const NodeMap& mapNodes,
     vtkSmartPointer<vtkCellArray>& cellArray
 )
 {
-    std::string line;
-    std::string keyCode = "    3C";
-    std::string keyCodeType = " -1";
-    std::string keyCodeNodes = " -2";
-    long numElem;
-    int indicator;
-    int elem;
-    long elemID = 0;
+    std::string_view keyCode = "    3C";
+    std::string_view keyCodeType = " -1";
+    std::string_view keyCodeNodes = " -2";
+    int indicator {0};
     // element info: {type, group, material}
     std::vector<int> info(3);
-    std::map<int, int> mapElem;
     std::vector<int> topoElem;
     std::vector<int> vtkType;
 
-    std::string_view view {lines};
-
-    std::string_view sub = view.substr(keyCode.length() + 18);
-    valueFromLine(sub.begin(), 12, numElem);
-
-    sub = sub.substr(12 + 37);
-    valueFromLine(sub.begin(), 1, indicator);
+    valueFromLine(block.header, keyCode.length() + 18 + 12 + 37, 1, indicator);
     int digits = getDigits(static_cast<Indicator>(indicator));
-    while (elemID < numElem && std::getline(ifstr, line)) {
-        std::string_view view {line};
-        if (view.rfind(keyCodeType, 0) == 0) {
-            std::string_view v(line.data() + keyCodeType.length());
-            valueFromLine(v.begin(), digits, elem);
-            v = v.substr(digits);
-            std::string_view::iterator it1;
-            std::vector<int>::iterator it2;
-            for (it1 = v.begin(), it2 = info.begin(); it1 != v.end() && it2 != info.end();
-                 it1 += 5, ++it2) {
-                valueFromLine(it1, 5, *it2);
+
+    LineCursor cursor(block.data);
+    std::string_view line;
+    while (cursor.getline(line)) {
+        if (line.starts_with(keyCodeType)) {
+            size_t pos = keyCodeType.length() + digits;
+            for (auto it = info.begin(); it != info.end(); ++it, pos += 5) {
+                valueFromLine(line, pos, 5, *it);
             }
         }
-        if (view.rfind(keyCodeNodes, 0) == 0) {
-            std::string_view vi = view.substr(keyCodeNodes.length());
-            int node;
-            for (auto it = vi.begin(); it != vi.end(); it += digits) {
-                valueFromLine(it, digits, node);
+        if (line.starts_with(keyCodeNodes)) {
+            for (size_t pos = keyCodeNodes.length(); pos < line.size(); pos += digits) {
+                int node {0};
+                valueFromLine(line, pos, digits, node);
                 topoElem.emplace_back(mapNodes.at(node));
             }
 
@@ -1413,225 +1546,286 @@ std::vector<int> readElements(
             if (topoElem.size() == mapCcxTypeNodes[static_cast<ElementType>(info[0])]) {
                 fillCell(cellArray, topoElem, vtkType, static_cast<ElementType>(info[0]));
                 topoElem.clear();
-                mapElem[elem] = elemID++;
             }
         }
     }
     return vtkType;
 }
 
-// read parameter header (not used)
-void readParameter(std::ifstream& ifstr, const std::string& line)
-{
-    // do nothing
-    (void)ifstr;
-    (void)line;
-}
-
 // read first header from nodal result block
-void readResultInfo(std::ifstream& ifstr, const std::string& lines, FRDResultInfo& info)
+void readResultInfo(std::string_view line, FRDResultInfo& info)
 {
-    (void)ifstr;
-
-    std::string keyCode = "  100C";
+    std::string_view keyCode = "  100C";
 
-    std::string_view view {lines};
-    std::string_view sub = view.substr(keyCode.length() + 6);
-    valueFromLine(sub.begin(), 12, info.value);
+    size_t pos = keyCode.length() + 6;
+    valueFromLine(line, pos, 12, info.value);
 
-    sub = sub.substr(12);
-    valueFromLine(sub.begin(), 12, info.numNodes);
+    pos += 12;
+    valueFromLine(line, pos, 12, info.numNodes);
 
-    sub = sub.substr(12 + 20);
-    int anType;
-    valueFromLine(sub.begin(), 2, anType);
+    pos += 12 + 20;
+    int anType {0};
+    valueFromLine(line, pos, 2, anType);
     info.analysisType = static_cast<AnalysisType>(anType);
 
-    sub = sub.substr(2);
-    valueFromLine(sub.begin(), 5, info.step);
+    pos += 2;
+    valueFromLine(line, pos, 5, info.step);
 
-    sub = sub.substr(5 + 10);
-    int ind;
-    valueFromLine(sub.begin(), 2, ind);
+    pos += 5 + 10;
+    int ind {0};
+    valueFromLine(line, pos, 2, ind);
     info.indicator = static_cast<Indicator>(ind);
 }
 
-// read result from nodal result block and add result array to grid
-void readResults(
-    std::ifstream& ifstr,
-    const std::string& lines,
-    const std::map<int, int>& mapNodes,
-    const FRDResultInfo& info,
-    vtkSmartPointer<vtkUnstructuredGrid>& grid
-)
+// index the blocks of a frd file in one pass without decoding the values
+FRDIndex indexFRD(std::string_view data)
 {
-    int digits = getDigits(info.indicator);
-    (void)lines;
+    enum class Kind
+    {
+        None,
+        Nodes,
+        Elements,
+        Result
+    };
+
+    FRDIndex index;
+    FRDResultBlock current;
+    Kind kind = Kind::None;
+    const char* begin = nullptr;
+
+    auto finish = [&](const char* end) {
+        current.data = std::string_view(begin, end - begin);
+        switch (kind) {
+            case Kind::Nodes:
+                index.nodes = current;
+                break;
+            case Kind::Elements:
+                index.elements = current;
+                break;
+            case Kind::Result:
+                index.results.emplace_back(current);
+                break;
+            case Kind::None:
+                break;
+        }
+        kind = Kind::None;
+    };
+    auto start = [&](Kind k, std::string_view line, const char* pos) {
+        finish(line.data());
+        kind = k;
+        current.header = line;
+        begin = pos;
+    };
+
+    LineCursor cursor(data);
+    std::string_view line;
+    while (cursor.getline(line)) {
+        if (line.starts_with("    2C")) {
+            start(Kind::Nodes, line, cursor.position());
+        }
+        else if (line.starts_with("    3C")) {
+            start(Kind::Elements, line, cursor.position());
+        }
+        else if (line.starts_with("  100C")) {
+            start(Kind::Result, line, cursor.position());
+            readResultInfo(line, current.info);
+        }
+        else if (line.starts_with(" -3")) {
+            // end of block
+            finish(line.data());
+        }
+    }
+    finish(data.data() + data.size());
 
-    // get dataset info, start with " -4"
-    std::string line;
-    std::string keyDataSet = " -4";
-    unsigned int numComps;
-    std::getline(ifstr, line);
-    std::string_view view = line;
-    std::string_view sub = view.substr(keyDataSet.length() + 2);
-    std::string dataSetName {sub.substr(0, 8)};
-    // remove trailing spaces
-    dataSetName.erase(dataSetName.find_last_not_of(" ") + 1);
-    sub = sub.substr(8);
-    valueFromLine(sub.begin(), 5, numComps);
+    return index;
+}
 
-    // get entity info
-    std::string keyEntity = " -5";
+// dataset and entities of a nodal result block
+struct FRDResultLayout
+{
+    std::string dataSetName;
     std::vector<std::string> entityNames;
     // type: 1: scalar; 2: vector; 4: matrix; 12: vector (3 amp - 3 phase); 14: tensor (6 amp - 6
     // phase) {type, row, col, exist}
     std::vector<std::vector<int>> entityTypes;
+    // position of scalar entities in line result vector
+    std::vector<size_t> scalarPos;
+    // node values lines
+    std::string_view values;
+};
+
+// read the dataset and entity header lines of a nodal result block
+FRDResultLayout readResultLayout(const FRDResultBlock& block)
+{
+    FRDResultLayout layout;
+    LineCursor cursor(block.data);
+    std::string_view line;
+
+    // get dataset info, start with " -4"
+    std::string_view keyDataSet = " -4";
+    unsigned int numComps {0};
+    cursor.getline(line);
+    std::string_view sub = fieldFromLine(line, keyDataSet.length() + 2, 8);
+    layout.dataSetName = sub;
+    // remove trailing spaces
+    layout.dataSetName.erase(layout.dataSetName.find_last_not_of(" ") + 1);
+    valueFromLine(line, keyDataSet.length() + 2 + 8, 5, numComps);
+
+    // get entity info
+    std::string_view keyEntity = " -5";
     unsigned int countComp = 0;
-    while (countComp < numComps && std::getline(ifstr, line)) {
-        std::string_view view {line};
-        if (view.rfind(keyEntity, 0) == 0) {
-            sub = view.substr(keyEntity.length() + 2);
-            std::string en {sub.substr(0, 8)};
+    while (countComp < numComps && cursor.getline(line)) {
+        if (line.starts_with(keyEntity)) {
+            std::string en {fieldFromLine(line, keyEntity.length() + 2, 8)};
             // remove trailing spaces
             en.erase(en.find_last_not_of(" ") + 1);
             std::vector<int> et = {0, 0, 0, 0};
             // fill entityType, ignore MENU: "    1"
-            sub = sub.substr(8 + 5, 4 * 5);
-            std::string_view::iterator it1;
-            std::vector<int>::iterator it2;
-            for (it1 = sub.begin(), it2 = et.begin(); it1 != sub.end() && it2 != et.end();
-                 (it1 += 5), ++it2) {
-                valueFromLine(it1, digits, *it2);
+            size_t pos = keyEntity.length() + 2 + 8 + 5;
+            for (auto it = et.begin(); it != et.end(); ++it, pos += 5) {
+                valueFromLine(line, pos, 5, *it);
             }
 
             if (et[3] == 0) {
                 // ignore predefined entity
-                entityNames.emplace_back(en);
-                entityTypes.emplace_back(et);
+                layout.entityNames.emplace_back(en);
+                layout.entityTypes.emplace_back(et);
             }
             ++countComp;
         }
     }
 
-    // used components
-    numComps = entityNames.size();
+    const char* end = block.data.data() + block.data.size();
+    layout.values = std::string_view(cursor.position(), end - cursor.position());
+    layout.scalarPos = identifyScalarEntities(layout.entityTypes);
+    return layout;
+}
 
-    // enter in node values block
-    std::string code1 = " -1";
-    std::string code2 = " -2";
-    int node {-1};
-    double value {0.0};
-    std::vector<double> vecValues;
-    std::vector<double> scaValues;
-    std::vector<int> nodes;
-    int countNodes = 0;
-    size_t countScaPos {0};
-    // result block could have both vector/matrix and scalar components
-    // save each scalars entity in his own array
-    auto scalarPos = identifyScalarEntities(entityTypes);
+// arrays of a nodal result block
+struct FRDResultArrays
+{
     // array for vector entities (if needed)
-    vtkSmartPointer<vtkDoubleArray> vecArray = vtkSmartPointer<vtkDoubleArray>::New();
+    vtkSmartPointer<vtkDoubleArray> vecArray;
     // arrays for scalar entities (if needed)
     std::vector<vtkSmartPointer<vtkDoubleArray>> scaArrays;
-    for (size_t i = 0; i < scalarPos.size(); ++i) {
-        scaArrays.emplace_back(vtkSmartPointer<vtkDoubleArray>::New());
-    }
-
-    vecArray->SetNumberOfComponents(numComps - scalarPos.size());
-    vecArray->SetNumberOfTuples(mapNodes.size());
-    vecArray->SetName(dataSetName.c_str());
-    // set all values to zero
-    for (int i = 0; i < vecArray->GetNumberOfComponents(); ++i) {
-        vecArray->FillComponent(i, 0.0);
-    }
-    //    vecArray->Fill(0.0);
-    for (size_t i = 0; i < scaArrays.size(); ++i) {
-        scaArrays[i]->SetNumberOfComponents(1);
-        scaArrays[i]->SetNumberOfTuples(mapNodes.size());
-        std::string name = entityNames[scalarPos[i]];
-        scaArrays[i]->SetName(name.c_str());
-        //        scaArrays[i]->Fill(0.0);
-        for (int j = 0; j < scaArrays[i]->GetNumberOfComponents(); ++j) {
-            scaArrays[i]->FillComponent(j, 0.0);
-        }
-    }
-
-    while (countNodes < info.numNodes && std::getline(ifstr, line)) {
-        std::string_view view {line};
-        if (view.rfind(code1, 0) == 0) {
-            sub = view.substr(code1.length());
-            valueFromLine(sub.begin(), digits, node);
+};
+
+// create the zero initialized result arrays and add them to the grid
+FRDResultArrays createResultArrays(
+    const FRDResultLayout& layout,
+    vtkSmartPointer<vtkUnstructuredGrid>& grid
+)
+{
+    FRDResultArrays arrays;
+    vtkIdType numPoints = grid->GetNumberOfPoints();
+    // result block could have both vector/matrix and scalar components
+    // save each scalars entity in his own array
+    size_t numComps = layout.entityNames.size();
+    if (numComps != layout.scalarPos.size()) {
+        arrays.vecArray = vtkSmartPointer<vtkDoubleArray>::New();
+        int vecComps = static_cast<int>(numComps - layout.scalarPos.size());
+        arrays.vecArray->SetNumberOfComponents(vecComps);
+        arrays.vecArray->SetNumberOfTuples(numPoints);
+        arrays.vecArray->SetName(layout.dataSetName.c_str());
+        // set all values to zero
+        for (int i = 0; i < arrays.vecArray->GetNumberOfComponents(); ++i) {
+            arrays.vecArray->FillComponent(i, 0.0);
+        }
+        grid->GetPointData()->AddArray(arrays.vecArray);
+    }
+    for (size_t pos : layout.scalarPos) {
+        auto scaArray = vtkSmartPointer<vtkDoubleArray>::New();
+        scaArray->SetNumberOfComponents(1);
+        scaArray->SetNumberOfTuples(numPoints);
+        scaArray->SetName(layout.entityNames[pos].c_str());
+        scaArray->FillComponent(0, 0.0);
+        grid->GetPointData()->AddArray(scaArray);
+        arrays.scaArrays.emplace_back(scaArray);
+    }
+
+    return arrays;
+}
+
+// read the node values of a nodal result block into its arrays. Only the memory of the
+// given arrays is written, so several blocks can be read in parallel.
+// Returns the number of values of nodes which do not exist
+size_t readResultValues(
+    const FRDResultLayout& layout,
+    const NodeMap& mapNodes,
+    const FRDResultInfo& info,
+    FRDResultArrays& arrays
+)
+{
+    int digits = getDigits(info.indicator);
+    size_t numComps = layout.entityNames.size();
+    size_t vecComps = arrays.vecArray ? arrays.vecArray->GetNumberOfComponents() : 0;
+    double* vecData = arrays.vecArray ? arrays.vecArray->GetPointer(0) : nullptr;
+    std::vector<double*> scaData;
+    for (auto& scaArray : arrays.scaArrays) {
+        scaData.emplace_back(scaArray->GetPointer(0));
+    }
+
+    // enter in node values block
+    std::string_view code1 = " -1";
+    std::string_view code2 = " -2";
+    int point {-1};
+    size_t invalid {0};
+    size_t countScaPos {0};
+    std::vector<double> vecValues;
+    std::vector<double> scaValues;
+
+    LineCursor cursor(layout.values);
+    std::string_view line;
+    while (cursor.getline(line)) {
+        size_t pos = code1.length() + digits;
+        if (line.starts_with(code1)) {
+            int node {-1};
+            valueFromLine(line, code1.length(), digits, node);
             // clear values vector for each node result block
             vecValues.clear();
             scaValues.clear();
             countScaPos = 0;
-            try {
-                // result nodes could not exist in .frd file due to element expansion
-                // so mapNodes.at() could throw an exception
-                nodes.emplace_back(mapNodes.at(node));
-                sub = sub.substr(digits);
-                for (auto it = sub.begin(); it != sub.end(); it += 12, ++countScaPos) {
-                    valueFromLine(it, 12, value);
-                    // search if value is scalar or vector/matrix component
-                    auto pos = std::ranges::find(scalarPos, countScaPos);
-                    if (pos == scalarPos.end()) {
-                        vecValues.emplace_back(value);
-                    }
-                    else {
-                        scaValues.emplace_back(value);
-                    }
-                }
+            // result nodes could not exist in .frd file due to element expansion
+            point = mapNodes.find(node);
+            if (point < 0) {
+                ++invalid;
+                continue;
             }
-            catch (const std::out_of_range&) {
-                Base::Console().warning("Invalid node: %d\n", node);
+        }
+        else if (!line.starts_with(code2) || point < 0) {
+            continue;
+        }
+
+        for (; pos < line.size(); pos += 12, ++countScaPos) {
+            double value {0.0};
+            valueFromLine(line, pos, 12, value);
+            // search if value is scalar or vector/matrix component
+            auto it = std::ranges::find(layout.scalarPos, countScaPos);
+            if (it == layout.scalarPos.end()) {
+                vecValues.emplace_back(value);
             }
-            ++countNodes;
-        }
-        else if (view.rfind(code2, 0) == 0) {
-            sub = view.substr(code2.length() + digits);
-            for (auto it = sub.begin(); it != sub.end(); it += 12) {
-                valueFromLine(it, 12, value);
-                // search if value is scalar or vector/matrix component
-                auto pos = std::ranges::find(scalarPos, countScaPos);
-                if (pos == scalarPos.end()) {
-                    vecValues.emplace_back(value);
-                }
-                else {
-                    scaValues.emplace_back(value);
-                }
+            else {
+                scaValues.emplace_back(value);
             }
         }
+
         if ((vecValues.size() + scaValues.size()) == numComps) {
-            if (!vecValues.empty()) {
-                if (node == -1) {
-                    throw Base::FileException("File to load not readable");
-                }
-                vecArray->SetTuple(mapNodes.at(node), vecValues.data());
+            if (vecData) {
+                std::copy_n(
+                    vecValues.begin(),
+                    std::min(vecValues.size(), vecComps),
+                    vecData + point * vecComps
+                );
             }
-            if (!scaValues.empty()) {
-                if (node == -1) {
-                    throw Base::FileException("File to load not readable");
-                }
-                std::vector<vtkSmartPointer<vtkDoubleArray>>::iterator it1;
-                std::vector<double>::iterator it2;
-                for (it1 = scaArrays.begin(), it2 = scaValues.begin();
-                     it1 != scaArrays.end() && it2 != scaValues.end();
-                     ++it1, ++it2) {
-                    (*it1)->SetTuple1(mapNodes.at(node), *it2);
-                }
+            for (size_t i = 0; i < std::min(scaData.size(), scaValues.size()); ++i) {
+                scaData[i][point] = scaValues[i];
             }
         }
     }
 
-    // add vecArray only if not all scalars
-    if (numComps != scalarPos.size()) {
-        grid->GetPointData()->AddArray(vecArray);
-    }
-    for (auto& s : scaArrays) {
-        grid->GetPointData()->AddArray(s);
-    }
+    return invalid;
 }
+
 vtkSmartPointer<vtkStringArray> createTimeInfo(const std::string& type)
 {
     auto timeInfo = vtkSmartPointer<vtkStringArray>::New();
@@ -1652,7 +1846,8 @@ vtkSmartPointer<vtkFloatArray> createTimeValue(const double& value)
     return stepValue;
 }
 
-vtkSmartPointer<vtkMultiBlockDataSet> readFRD(std::ifstream& ifstr)
+// read the frd file content, the file is indexed once and all result blocks are decoded
+vtkSmartPointer<vtkMultiBlockDataSet> readFRD(std::string_view data)
 {
     auto points = vtkSmartPointer<vtkPoints>::New();
     auto cells = vtkSmartPointer<vtkCellArray>::New();
@@ -1661,69 +1856,77 @@ vtkSmartPointer<vtkMultiBlockDataSet> readFRD(std::ifstream& ifstr)
     vtkSmartPointer<vtkMultiBlockDataSet> block;
     std::map<FRDResultInfo, vtkSmartPointer<vtkUnstructuredGrid>> grids;
     std::map<AnalysisType, vtkSmartPointer<vtkMultiBlockDataSet>> blocks;
-    std::string line;
-    std::map<int, int> mapNodes;
+    NodeMap mapNodes;
     std::vector<int> cellTypes;
 
-    while (std::getline(ifstr, line)) {
-        std::string keyCode = "    2C";
-        std::string_view view = line;
-
-        if (view.rfind(keyCode, 0) == 0) {
-            // read nodes block
-            mapNodes = readNodes(ifstr, line, points);
-        }
-        keyCode = "    3C";
-        if (view.rfind(keyCode, 0) == 0) {
-            // read elements block
-            cellTypes = readElements(ifstr, line, mapNodes, cells);
-        }
-        keyCode = "    1P";
-        if (view.rfind(keyCode, 0) == 0) {
-            // read parameter
-            readParameter(ifstr, line);
-        }
-        keyCode = "  100C";
-        if (view.rfind(keyCode, 0) == 0) {
-            // read result info block
-            FRDResultInfo info;
-            readResultInfo(ifstr, line, info);
-            auto it = grids.find(info);
-            if (it == grids.end()) {
-                // create TimeInfo metadata
-                auto timeInfo = createTimeInfo(mapAnalysisTypeToStr[info.analysisType]);
-                // search analysis type block and create it if necessary
-                auto it2 = blocks.find(info.analysisType);
-                if (it2 == blocks.end()) {
-                    block = vtkSmartPointer<vtkMultiBlockDataSet>::New();
-                    block->GetFieldData()->AddArray(timeInfo);
-                    blocks[info.analysisType] = block;
-                }
-                else {
-                    block = it2->second;
-                }
-                // create unstructured grid
-                grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
-                grid->SetPoints(points);
-                grid->SetCells(cellTypes.data(), cells);
-
-                // create TimeValue metadata
-                auto stepValue = createTimeValue(info.value);
-
-                grid->GetFieldData()->AddArray(stepValue);
-                grid->GetFieldData()->AddArray(timeInfo);
-
-                grids[info] = grid;
-                unsigned int nb = block->GetNumberOfBlocks();
-                block->SetBlock(nb, grid);
+    FRDIndex index = indexFRD(data);
+    if (!index.nodes.header.empty()) {
+        // read nodes block
+        mapNodes = readNodes(index.nodes, points);
+    }
+    if (!index.elements.header.empty()) {
+        // read elements block
+        cellTypes = readElements(index.elements, mapNodes, cells);
+    }
+
+    std::vector<const FRDResultBlock*> results;
+    std::vector<FRDResultLayout> layouts;
+    std::vector<FRDResultArrays> arrays;
+    for (const auto& result : index.results) {
+        const FRDResultInfo& info = result.info;
+        auto it = grids.find(info);
+        if (it == grids.end()) {
+            // create TimeInfo metadata
+            auto timeInfo = createTimeInfo(mapAnalysisTypeToStr[info.analysisType]);
+            // search analysis type block and create it if necessary
+            auto it2 = blocks.find(info.analysisType);
+            if (it2 == blocks.end()) {
+                block = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+                block->GetFieldData()->AddArray(timeInfo);
+                blocks[info.analysisType] = block;
             }
             else {
-                grid = (*it).second;
+                block = it2->second;
             }
-            // read result entries and node results
-            readResults(ifstr, line, mapNodes, info, grid);
+            // create unstructured grid
+            grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+            grid->SetPoints(points);
+            grid->SetCells(cellTypes.data(), cells);
+
+            // create TimeValue metadata
+            auto stepValue = createTimeValue(info.value);
+
+            grid->GetFieldData()->AddArray(stepValue);
+            grid->GetFieldData()->AddArray(timeInfo);
+
+            grids[info] = grid;
+            unsigned int nb = block->GetNumberOfBlocks();
+            block->SetBlock(nb, grid);
+        }
+        else {
+            grid = (*it).second;
+        }
+
+        // read result entries and create the result arrays
+        results.emplace_back(&result);
+        layouts.emplace_back(readResultLayout(result));
+        arrays.emplace_back(createResultArrays(layouts.back(), grid));
+    }
+
+    // read node results, each result block only fills its own arrays
+    std::vector<size_t> invalid(results.size(), 0);
+    auto readValues = [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i) {
+            invalid[i] = readResultValues(layouts[i], mapNodes, results[i]->info, arrays[i]);
         }
+    };
+    vtkSMPTools::For(0, static_cast<vtkIdType>(results.size()), readValues);
+
+    size_t numInvalid = std::accumulate(invalid.begin(), invalid.end(), size_t(0));
+    if (numInvalid > 0) {
+        Base::Console().warning("Results of %zu invalid nodes ignored\n", numInvalid);
     }
+
     int i = 0;
 
     for (const auto& b : blocks) {
@@ -1760,9 +1963,9 @@ void FemVTKTools::frdToVTK(const char* filename, bool binary)
         throw Base::FileException("File to load not existing or not readable", filename);
     }
 
-    std::ifstream ifstr(filename, std::ios::in | std::ios::binary);
+    Base::MappedFile file(fi.filePath());
 
-    vtkSmartPointer<vtkMultiBlockDataSet> multiBlock = FRDReader::readFRD(ifstr);
+    vtkSmartPointer<vtkMultiBlockDataSet> multiBlock = FRDReader::readFRD(file.view());
 
     std::string dir = fi.dirPath();
 
@@ -71,6 +71,8 @@ public:
     // write FemResult (activeObject if res= NULL) to vtkUnstructuredGrid dataset file
     static void writeResult(const char* filename, const App::DocumentObject* res = nullptr);
 
+    // convert a CalculiX .frd result file to one VTK multiblock file per analysis type, all
+    // frames of the file are decoded and written, there is no loading of single frames
     static void frdToVTK(const char* filename, bool binary = true);
 };
 }  // namespace Fem
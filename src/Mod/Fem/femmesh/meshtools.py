@@ -96,6 +96,9 @@ def get_femnodes_by_references(femmesh, references):
 
 def get_femnodes_by_refshape(femmesh, ref):
     nodes = []
+    # edges and faces are collected to look up their nodes in one batch
+    edges = []
+    faces = []
     for refelement in ref[1]:
         r = sub_shape_at_global_placement(ref[0], refelement)
         FreeCAD.Console.PrintMessage(
@@ -108,9 +111,9 @@ def get_femnodes_by_refshape(femmesh, ref):
         if r.ShapeType == "Vertex":
             nodes += femmesh.getNodesByVertex(r)
         elif r.ShapeType == "Edge":
-            nodes += femmesh.getNodesByEdge(r)
+            edges.append(r)
         elif r.ShapeType == "Face":
-            nodes += femmesh.getNodesByFace(r)
+            faces.append(r)
         elif r.ShapeType == "Solid":
             nodes += femmesh.getNodesBySolid(r)
         elif r.ShapeType == "Compound":
@@ -118,6 +121,12 @@ def get_femnodes_by_refshape(femmesh, ref):
                 nodes += femmesh.getNodesBySolid(s)
         else:
             FreeCAD.Console.PrintMessage("  No Vertice, Edge, Face or Solid as reference shapes!\n")
+    if edges:
+        for edge_nodes in femmesh.getNodesByEdges(edges):
+            nodes += edge_nodes
+    if faces:
+        for face_nodes in femmesh.getNodesByFaces(faces):
+            nodes += face_nodes
     return nodes
 
 
@@ -566,10 +575,11 @@ def get_femelement_directions_theshape(femmesh, femelement_table, theshape):
     # see get_femelement_direction1D_set
     rotations_ids = []
     # add directions and all ids for each direction
-    for e in theshape.Shape.Edges:
+    edges = theshape.Shape.Edges
+    # femnodes for each edge
+    for e, edge_femnodes in zip(edges, femmesh.getNodesByEdges(edges)):
         the_edge = {}
         the_edge["direction"] = e.Vertexes[1].Point - e.Vertexes[0].Point
-        edge_femnodes = femmesh.getNodesByEdge(e)  # femnodes for the current edge
         # femelements for this edge
         the_edge["ids"] = get_femelements_by_femnodes_std(femelement_table, edge_femnodes)
         for rot in rotations_ids:
@@ -1043,9 +1053,11 @@ def get_force_obj_face_nodeload_table(femmesh, femelement_table, femnodes_mesh,
     sum_ref_face_area = 0
     sum_ref_face_node_area = 0  # for debugging
     sum_node_load = 0  # for debugging
+    ref_faces = []  # [ (refshape, elemname, ref_face), ... ]
     for o, elem_tup in frc_obj.References:
         for elem in elem_tup:
             ref_face = sub_shape_at_global_placement(o, elem)
+            ref_faces.append((o, elem, ref_face))
             FreeCAD.Console.PrintMessage(
                 "    "
                 "ReferenceShape ... Type: {}, "
@@ -1057,43 +1069,42 @@ def get_force_obj_face_nodeload_table(femmesh, femelement_table, femnodes_mesh,
     if sum_ref_face_area != 0:
         force_quantity = FreeCAD.Units.Quantity(frc_obj.Force.getValueAs("N"))
         force_per_sum_ref_face_area = force_quantity / sum_ref_face_area
-    for o, elem_tup in frc_obj.References:
-        for elem in elem_tup:
-            ref_face = sub_shape_at_global_placement(o, elem)
-
-            # face_table:
-            #    { meshfaceID : ( nodeID, ... , nodeID ) }
-            face_table = get_ref_facenodes_table(femmesh, femelement_table, ref_face)
 
-            # node_area_table:
-            #    [ (nodeID, Area), ... , (nodeID, Area) ]
-            # some nodes will have more than one entry
-            node_area_table = get_ref_facenodes_areas(femnodes_mesh, face_table)
-
-            # node_sum_area_table:
-            #    { nodeID : Area, ... , nodeID : Area }
-            # AreaSum for each node, one entry for each node
-            node_sum_area_table = get_ref_shape_node_sum_geom_table(node_area_table)
-
-            # node_load_table:
-            #    { nodeID : NodeLoad, ... , nodeID : NodeLoad }
-            # NodeLoad for each node, one entry for each node
-            node_load_table = {}
-            sum_node_areas = 0  # for debugging
-            for node in node_sum_area_table:
-                sum_node_areas += node_sum_area_table[node]  # for debugging
-                node_load_table[node] = node_sum_area_table[node] * force_per_sum_ref_face_area
-            ratio_refface_areas = sum_node_areas / ref_face.Area
-            if ratio_refface_areas < 0.99 or ratio_refface_areas > 1.01:
-                FreeCAD.Console.PrintError(
-                    "Error on: " + frc_obj.Name + " --> " + o.Name + "." + elem + "\n"
-                )
-                FreeCAD.Console.PrintMessage(f"  sum_node_areas: {sum_node_areas}\n")
-                FreeCAD.Console.PrintMessage(f"  ref_face_area:  {ref_face.Area}\n")
-            sum_ref_face_node_area += sum_node_areas
+    # face_tables:
+    #    [ { meshfaceID : ( nodeID, ... , nodeID ) }, ... ] one for each ref_face
+    face_tables = get_ref_facenodes_tables(
+        femmesh, femelement_table, [ref_face for o, elem, ref_face in ref_faces]
+    )
+    for (o, elem, ref_face), face_table in zip(ref_faces, face_tables):
+        # node_area_table:
+        #    [ (nodeID, Area), ... , (nodeID, Area) ]
+        # some nodes will have more than one entry
+        node_area_table = get_ref_facenodes_areas(femnodes_mesh, face_table)
+
+        # node_sum_area_table:
+        #    { nodeID : Area, ... , nodeID : Area }
+        # AreaSum for each node, one entry for each node
+        node_sum_area_table = get_ref_shape_node_sum_geom_table(node_area_table)
+
+        # node_load_table:
+        #    { nodeID : NodeLoad, ... , nodeID : NodeLoad }
+        # NodeLoad for each node, one entry for each node
+        node_load_table = {}
+        sum_node_areas = 0  # for debugging
+        for node in node_sum_area_table:
+            sum_node_areas += node_sum_area_table[node]  # for debugging
+            node_load_table[node] = node_sum_area_table[node] * force_per_sum_ref_face_area
+        ratio_refface_areas = sum_node_areas / ref_face.Area
+        if ratio_refface_areas < 0.99 or ratio_refface_areas > 1.01:
+            FreeCAD.Console.PrintError(
+                "Error on: " + frc_obj.Name + " --> " + o.Name + "." + elem + "\n"
+            )
+            FreeCAD.Console.PrintMessage(f"  sum_node_areas: {sum_node_areas}\n")
+            FreeCAD.Console.PrintMessage(f"  ref_face_area:  {ref_face.Area}\n")
+        sum_ref_face_node_area += sum_node_areas
 
-            elem_info_string = "node loads on shape: " + o.Name + ":" + elem
-            force_obj_node_load_table.append((elem_info_string, node_load_table))
+        elem_info_string = "node loads on shape: " + o.Name + ":" + elem
+        force_obj_node_load_table.append((elem_info_string, node_load_table))
 
     for ref_shape in force_obj_node_load_table:
         for node in ref_shape[1]:
@@ -1121,12 +1132,20 @@ def get_force_obj_face_nodeload_table(femmesh, femelement_table, femnodes_mesh,
 
 # ************************************************************************************************
 def get_ref_facenodes_table(femmesh, femelement_table, ref_face):
-    face_table = {}  # { meshfaceID : ( nodeID, ... , nodeID ) }
+    return get_ref_facenodes_tables(femmesh, femelement_table, [ref_face])[0]
+
+
+def get_ref_facenodes_tables(femmesh, femelement_table, ref_faces):
+    # returns one face_table for each ref_face
+    # all ref_faces are looked up at once, thus the mesh nodes are only indexed once
+    face_tables = [{} for ref_face in ref_faces]  # { meshfaceID : ( nodeID, ... , nodeID ) }
+    if not ref_faces:
+        return face_tables
     if is_solid_femmesh(femmesh):
         if has_no_face_data(femmesh):
             FreeCAD.Console.PrintMessage(
                 "  No face data in finite volume element mesh. "
-                "FreeCAD uses getccxVolumesByFace() "
+                "FreeCAD uses getccxVolumesByFaces() "
                 "to retrieve the volume elements of the ref_face.\n"
             )
             # there is no face data
@@ -1134,55 +1153,60 @@ def get_ref_facenodes_table(femmesh, femelement_table, ref_face):
             # they are not sorted, we just have the nodes.
             # We need to sort them according to the
             # shell mesh notation of tria3, tria6, quad4, quad8
-            ref_face_nodes = femmesh.getNodesByFace(ref_face)
-            # try to use getccxVolumesByFace() to get the volume ids
+            all_ref_face_nodes = femmesh.getNodesByFaces(ref_faces)
+            # try to use getccxVolumesByFaces() to get the volume ids
             # of element with elementfaces on the ref_face
             # --> should work for tetra4 and tetra10
             # list of tuples (mv, ccx_face_nr)
-            ref_face_volume_elements = femmesh.getccxVolumesByFace(ref_face)
-            if ref_face_volume_elements:  # mesh with tetras
-                FreeCAD.Console.PrintLog(
-                    "  Use of getccxVolumesByFace() has "
-                    "returned volume elements of the ref_face.\n"
-                )
-                for ve in ref_face_volume_elements:
-                    veID = ve[0]
-                    ve_ref_face_nodes = []
-                    for nodeID in femelement_table[veID]:
-                        if nodeID in ref_face_nodes:
-                            ve_ref_face_nodes.append(nodeID)
-                    # { volumeID : ( facenodeID, ... , facenodeID ) } only the ref_face nodes
-                    face_table[veID] = ve_ref_face_nodes
-            else:  # mesh with hexa or penta
-                FreeCAD.Console.PrintLog(
-                    "  The use of getccxVolumesByFace() has NOT returned "
-                    "volume elements of the ref_face. "
-                    "FreeCAD tries to use get_femvolumeelements_by_femfacenodes().\n"
-                )
-                # list of integer [mv]
-                ref_face_volume_elements = get_femvolumeelements_by_femfacenodes(
-                    femelement_table, ref_face_nodes
-                )
-                for veID in ref_face_volume_elements:
-                    ve_ref_face_nodes = []
-                    for nodeID in femelement_table[veID]:
-                        if nodeID in ref_face_nodes:
-                            ve_ref_face_nodes.append(nodeID)
-                    # { volumeID : ( facenodeID, ... , facenodeID ) } only the ref_face nodes
-                    face_table[veID] = ve_ref_face_nodes
-                # we need to resort the nodes to make them build an element face
-                face_table = build_mesh_faces_of_volume_elements(face_table, femelement_table)
+            all_ref_face_volume_elements = femmesh.getccxVolumesByFaces(ref_faces)
+            for face_table, ref_face_nodes, ref_face_volume_elements in zip(
+                face_tables, all_ref_face_nodes, all_ref_face_volume_elements
+            ):
+                ref_face_nodes = set(ref_face_nodes)
+                if ref_face_volume_elements:  # mesh with tetras
+                    FreeCAD.Console.PrintLog(
+                        "  Use of getccxVolumesByFaces() has "
+                        "returned volume elements of the ref_face.\n"
+                    )
+                    for ve in ref_face_volume_elements:
+                        veID = ve[0]
+                        ve_ref_face_nodes = []
+                        for nodeID in femelement_table[veID]:
+                            if nodeID in ref_face_nodes:
+                                ve_ref_face_nodes.append(nodeID)
+                        # { volumeID : ( facenodeID, ... , facenodeID ) } only the ref_face nodes
+                        face_table[veID] = ve_ref_face_nodes
+                else:  # mesh with hexa or penta
+                    FreeCAD.Console.PrintLog(
+                        "  The use of getccxVolumesByFaces() has NOT returned "
+                        "volume elements of the ref_face. "
+                        "FreeCAD tries to use get_femvolumeelements_by_femfacenodes().\n"
+                    )
+                    # list of integer [mv]
+                    ref_face_volume_elements = get_femvolumeelements_by_femfacenodes(
+                        femelement_table, ref_face_nodes
+                    )
+                    for veID in ref_face_volume_elements:
+                        ve_ref_face_nodes = []
+                        for nodeID in femelement_table[veID]:
+                            if nodeID in ref_face_nodes:
+                                ve_ref_face_nodes.append(nodeID)
+                        # { volumeID : ( facenodeID, ... , facenodeID ) } only the ref_face nodes
+                        face_table[veID] = ve_ref_face_nodes
+                    # we need to resort the nodes to make them build an element face
+                    # (the face_table is updated in place)
+                    build_mesh_faces_of_volume_elements(face_table, femelement_table)
         else:  # the femmesh has face_data
-            faces = femmesh.getFacesByFace(ref_face)  # (mv, mf)
-            for mf in faces:
-                face_table[mf] = femmesh.getElementNodes(mf)
+            for face_table, faces in zip(face_tables, femmesh.getFacesByFaces(ref_faces)):
+                for mf in faces:
+                    face_table[mf] = femmesh.getElementNodes(mf)
     elif is_face_femmesh(femmesh):
-        ref_face_nodes = femmesh.getNodesByFace(ref_face)
-        ref_face_elements = get_femelements_by_femnodes_std(femelement_table, ref_face_nodes)
-        for mf in ref_face_elements:
-            face_table[mf] = femelement_table[mf]
-    # FreeCAD.Console.PrintMessage("{}\n".format(face_table))
-    return face_table
+        for face_table, ref_face_nodes in zip(face_tables, femmesh.getNodesByFaces(ref_faces)):
+            ref_face_elements = get_femelements_by_femnodes_std(femelement_table, ref_face_nodes)
+            for mf in ref_face_elements:
+                face_table[mf] = femelement_table[mf]
+    # FreeCAD.Console.PrintMessage("{}\n".format(face_tables))
+    return face_tables
 
 
 # ************************************************************************************************
@@ -1670,12 +1694,13 @@ def get_pressure_obj_faces(femmesh, femelement_table, femnodes_ele_table, femobj
                     # How to find the orientation of a FEM mesh face?
                     # https://forum.freecad.org/viewtopic.php?f=18&t=51898
         else:
+            ref_faces = []
             for obj, elems in femobj["Object"].References:
                 for e in elems:
-                    ref_face = sub_shape_at_global_placement(obj, e)
-                    meshfaces = femmesh.getFacesByFace(ref_face)
-                    for mf in meshfaces:
-                        pressure_faces.append([mf, -1])
+                    ref_faces.append(sub_shape_at_global_placement(obj, e))
+            for meshfaces in femmesh.getFacesByFaces(ref_faces):
+                for mf in meshfaces:
+                    pressure_faces.append([mf, -1])
 
     return pressure_faces
 
@@ -1686,15 +1711,16 @@ def get_pressure_obj_faces(femmesh, femelement_table, femnodes_ele_table, femobj
 # because of performance and the support of all solid elements
 # see get_ccxelement_faces_from_binary_search for more information
 def get_pressure_obj_faces_depreciated(femmesh, femobj):
-    pressure_faces = []
+    elem_info_strings, ref_faces = [], []
     for o, elem_tup in femobj["Object"].References:
         for elem in elem_tup:
             ref_shape = o.Shape.getElement(elem)
             elem_info_string = "face load on shape: " + o.Name + ":" + elem
             FreeCAD.Console.PrintMessage(f"{elem_info_string}\n")
             if ref_shape.ShapeType == "Face":
-                pressure_faces.append((elem_info_string, femmesh.getccxVolumesByFace(ref_shape)))
-    return pressure_faces
+                elem_info_strings.append(elem_info_string)
+                ref_faces.append(ref_shape)
+    return list(zip(elem_info_strings, femmesh.getccxVolumesByFaces(ref_faces)))
 
 
 # ***** contact faces ****************************************************************************
@@ -1769,8 +1795,9 @@ def get_contact_obj_faces(femmesh, femelement_table, femnodes_ele_table, femobj)
         master_ref_shape = master_ref[0].Shape.getElement(master_ref[1][0])
 
         FreeCAD.Console.PrintLog("    Get the FaceIDs.\n")
-        slave_face_ids = femmesh.getFacesByFace(slave_ref_shape)
-        master_face_ids = femmesh.getFacesByFace(master_ref_shape)
+        slave_face_ids, master_face_ids = femmesh.getFacesByFaces(
+            [slave_ref_shape, master_ref_shape]
+        )
 
         # build slave_faces and master_faces
         # face 2 for tria6 element
@@ -25,12 +25,14 @@ __title__ = "Mesh FEM unit tests"
 __author__ = "Bernd Hahnebach"
 __url__ = "https://www.freecad.org"
 
+import math
 import unittest
 from os.path import join
 
 import FreeCAD
 
 import Fem
+import Part
 from . import support_utils as testtools
 from .support_utils import fcc_print
 
@@ -192,6 +194,67 @@ class TestMeshCommon(unittest.TestCase):
             f"Problem in test_writeAbaqus_precision, \n{read_node_line}\n{expected}",
         )
 
+    # ********************************************************************************************
+    def test_nodes_by_faces_batch(self):
+        # a triangle shell mesh on a cylinder of radius 10 and height 10
+        # without a shape to mesh, thus the nodes are found by projection
+        radius, height, n_around, n_up = 10.0, 10.0, 16, 5
+        mesh = Fem.FemMesh()
+
+        def node_id(i, j):
+            return (j % n_around) + i * n_around + 1
+
+        for i in range(n_up):
+            for j in range(n_around):
+                angle = 2.0 * math.pi * j / n_around
+                z = height * i / (n_up - 1)
+                mesh.addNode(radius * math.cos(angle), radius * math.sin(angle), z, node_id(i, j))
+        for i in range(n_up - 1):
+            for j in range(n_around):
+                mesh.addFace([node_id(i, j), node_id(i, j + 1), node_id(i + 1, j + 1)])
+                mesh.addFace([node_id(i, j), node_id(i + 1, j + 1), node_id(i + 1, j)])
+        # a tetra with a triangle on the bottom plane
+        center = n_around * n_up + 1
+        apex = center + 1
+        mesh.addNode(0, 0, 0, center)
+        mesh.addNode(0, 0, 5, apex)
+        mesh.addFace([center, node_id(0, 1), node_id(0, 0)])
+        mesh.addVolume([center, node_id(0, 0), node_id(0, 1), apex])
+
+        # the parameter range of the half cylinder crosses the seam of the surface
+        cylinder = Part.Cylinder()
+        cylinder.Radius = radius
+        half = cylinder.toShape(-math.pi / 2, math.pi / 2, 0, height)
+        full = Part.makeCylinder(radius, height).Faces[0]
+        bottom = Part.makePlane(2 * radius, 2 * radius, FreeCAD.Vector(-radius, -radius, 0))
+        faces = [half, full, bottom]
+
+        expected_half = set()
+        for i in range(n_up):
+            for j in range(n_around):
+                if j <= n_around // 4 or j >= 3 * n_around // 4:
+                    expected_half.add(node_id(i, j))
+        expected_full = set(range(1, n_around * n_up + 1))
+        expected_bottom = {node_id(0, j) for j in range(n_around)} | {center}
+
+        nodes = mesh.getNodesByFaces(faces)
+        self.assertEqual(set(nodes[0]), expected_half, "Nodes of the half cylinder unexpected")
+        self.assertEqual(set(nodes[1]), expected_full, "Nodes of the full cylinder unexpected")
+        self.assertEqual(set(nodes[2]), expected_bottom, "Nodes of the bottom plane unexpected")
+
+        mesh_faces = mesh.getFacesByFaces(faces)
+        volumes = mesh.getVolumesByFaces(faces)
+        ccx_volumes = mesh.getccxVolumesByFaces(faces)
+        self.assertEqual(len(mesh_faces[0]), 2 * (n_up - 1) * n_around // 2)
+        self.assertEqual(len(mesh_faces[1]), 2 * (n_up - 1) * n_around)
+        self.assertEqual(len(mesh_faces[2]), 1)
+        self.assertEqual(ccx_volumes[2], [(n_around * (n_up - 1) * 2 + 2, 1)])
+        for index, face in enumerate(faces):
+            self.assertEqual(nodes[index], mesh.getNodesByFace(face))
+            self.assertEqual(mesh_faces[index], mesh.getFacesByFace(face))
+            self.assertEqual(volumes[index], mesh.getVolumesByFace(face))
+            self.assertEqual(ccx_volumes[index], mesh.getccxVolumesByFace(face))
+
 
 # ************************************************************************************************
 # ************************************************************************************************
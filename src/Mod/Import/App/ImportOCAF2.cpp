@@ -43,6 +43,8 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 
+#include <QtConcurrentMap>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObject.h>
@@ -292,81 +294,37 @@ bool ImportOCAF2::createObject(
     }
 
     getColor(shape, info);
-    bool hasFaceColors = false;
-    bool hasEdgeColors = false;
 
-    Part::TopoShape tshape(shape);
+    PreparedShape prepared;
+    auto it = myPreparedShapes.find(shape);
+    if (it != myPreparedShapes.end()) {
+        prepared = std::move(it->second);
+        myPreparedShapes.erase(it);
+    }
+    else {
+        prepared.shape = shape;
+        prepared.subColors = getSubShapeColors(label);
+        prepareShape(prepared);
+    }
+
+    const Part::TopoShape& tshape = prepared.tshape;
     std::vector<Base::Color> faceColors;
     std::vector<Base::Color> edgeColors;
-
-    TDF_LabelSequence seq;
-    if (!label.IsNull() && aShapeTool->GetSubShapes(label, seq)) {
-
-        TopTools_IndexedMapOfShape faceMap, edgeMap;
-        TopExp::MapShapes(tshape.getShape(), TopAbs_FACE, faceMap);
-        TopExp::MapShapes(tshape.getShape(), TopAbs_EDGE, edgeMap);
-
-        faceColors.assign(faceMap.Extent(), info.faceColor);
-        edgeColors.assign(edgeMap.Extent(), info.edgeColor);
-        // Two passes to get sub shape colors. First pass, look for solid, and
-        // second pass look for face and edges. This allows lower level
-        // subshape to override color of higher level ones.
-        for (int j = 0; j < 2; ++j) {
-            for (int i = 1; i <= seq.Length(); ++i) {
-                TDF_Label l = seq.Value(i);
-                TopoDS_Shape subShape = aShapeTool->GetShape(l);
-                if (subShape.IsNull()) {
-                    continue;
-                }
-                if (subShape.ShapeType() == TopAbs_FACE || subShape.ShapeType() == TopAbs_EDGE) {
-                    if (j == 0) {
-                        continue;
-                    }
-                }
-                else if (j != 0) {
-                    continue;
-                }
-
-                bool foundFaceColor = false, foundEdgeColor = false;
-                Base::Color faceColor, edgeColor;
-                Quantity_ColorRGBA aColor;
-                if (aColorTool->GetColor(l, XCAFDoc_ColorSurf, aColor)
-                    || aColorTool->GetColor(l, XCAFDoc_ColorGen, aColor)) {
-                    faceColor = Tools::convertColor(aColor);
-                    foundFaceColor = true;
-                }
-                if (aColorTool->GetColor(l, XCAFDoc_ColorCurv, aColor)) {
-                    edgeColor = Tools::convertColor(aColor);
-                    foundEdgeColor = true;
-                    if (j == 0 && foundFaceColor && !faceColors.empty() && edgeColor == faceColor) {
-                        // Do not set edge the same color as face
-                        foundEdgeColor = false;
-                    }
-                }
-
-                if (foundFaceColor) {
-                    for (TopExp_Explorer exp(subShape, TopAbs_FACE); exp.More(); exp.Next()) {
-                        int idx = faceMap.FindIndex(exp.Current()) - 1;
-                        if (idx >= 0 && idx < (int)faceColors.size()) {
-                            faceColors[idx] = faceColor;
-                            hasFaceColors = true;
-                            info.hasFaceColor = true;
-                        }
-                    }
-                }
-                if (foundEdgeColor) {
-                    for (TopExp_Explorer exp(subShape, TopAbs_EDGE); exp.More(); exp.Next()) {
-                        int idx = edgeMap.FindIndex(exp.Current()) - 1;
-                        if (idx >= 0 && idx < (int)edgeColors.size()) {
-                            edgeColors[idx] = edgeColor;
-                            hasEdgeColors = true;
-                            info.hasEdgeColor = true;
-                        }
-                    }
-                }
-            }
-        }
-    }
+    auto resolveColors = [](const std::vector<std::optional<Base::Color>>& colors,
+                            const Base::Color& defaultColor,
+                            std::vector<Base::Color>& result) {
+        bool found = false;
+        result.reserve(colors.size());
+        for (const auto& color : colors) {
+            found = found || color.has_value();
+            result.push_back(color.value_or(defaultColor));
+        }
+        return found;
+    };
+    bool hasFaceColors = resolveColors(prepared.faceColors, info.faceColor, faceColors);
+    bool hasEdgeColors = resolveColors(prepared.edgeColors, info.edgeColor, edgeColors);
+    info.hasFaceColor = info.hasFaceColor || hasFaceColors;
+    info.hasEdgeColor = info.hasEdgeColor || hasEdgeColors;
 
     Part::Feature* feature;
 
@@ -375,14 +333,14 @@ bool ImportOCAF2::createObject(
     }
 
     if (options.expandCompound
-        && (tshape.countSubShapes(TopAbs_SOLID) > 1
-            || (!tshape.countSubShapes(TopAbs_SOLID) && tshape.countSubShapes(TopAbs_SHELL) > 1))) {
+        && (prepared.solidCount > 1 || (!prepared.solidCount && prepared.shellCount > 1))) {
         feature = dynamic_cast<Part::Feature*>(expandShape(doc, label, shape));
         assert(feature);
     }
     else {
         feature = doc->addObject<Part::Feature>(tshape.shapeName().c_str());
-        feature->Shape.setValue(shape);
+        // keeps the sub-shape cache built by prepareShape()
+        feature->Shape.setValue(tshape);
     }
     applyFaceColors(feature, {info.faceColor});
     applyEdgeColors(feature, {info.edgeColor});
@@ -398,6 +356,148 @@ bool ImportOCAF2::createObject(
     return true;
 }
 
+std::vector<ImportOCAF2::SubShapeColor> ImportOCAF2::getSubShapeColors(TDF_Label label)
+{
+    std::vector<SubShapeColor> result;
+    TDF_LabelSequence seq;
+    if (label.IsNull() || !aShapeTool->GetSubShapes(label, seq)) {
+        return result;
+    }
+
+    // Two passes to get sub shape colors. First pass, look for solid, and
+    // second pass look for face and edges. This allows lower level
+    // subshape to override color of higher level ones.
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 1; i <= seq.Length(); ++i) {
+            TDF_Label l = seq.Value(i);
+            TopoDS_Shape subShape = aShapeTool->GetShape(l);
+            if (subShape.IsNull()) {
+                continue;
+            }
+            if (subShape.ShapeType() == TopAbs_FACE || subShape.ShapeType() == TopAbs_EDGE) {
+                if (j == 0) {
+                    continue;
+                }
+            }
+            else if (j != 0) {
+                continue;
+            }
+
+            SubShapeColor color;
+            Quantity_ColorRGBA aColor;
+            if (aColorTool->GetColor(l, XCAFDoc_ColorSurf, aColor)
+                || aColorTool->GetColor(l, XCAFDoc_ColorGen, aColor)) {
+                color.faceColor = Tools::convertColor(aColor);
+            }
+            if (aColorTool->GetColor(l, XCAFDoc_ColorCurv, aColor)) {
+                color.edgeColor = Tools::convertColor(aColor);
+            }
+            if (color.faceColor || color.edgeColor) {
+                color.shape = subShape;
+                result.push_back(color);
+            }
+        }
+    }
+    return result;
+}
+
+void ImportOCAF2::prepareShape(PreparedShape& prepared)
+{
+    // Only touches the shape, never the document, as it runs on a worker thread
+    Part::TopoShape& tshape = prepared.tshape;
+    tshape.setShape(prepared.shape);
+    tshape.initCache();
+    prepared.solidCount = tshape.countSubShapes(TopAbs_SOLID);
+    prepared.shellCount = tshape.countSubShapes(TopAbs_SHELL);
+
+    // also fills the sub-shape cache which is used later to look up faces and edges by name
+    std::size_t faceCount = tshape.getSubShapes(TopAbs_FACE).size();
+    std::size_t edgeCount = tshape.getSubShapes(TopAbs_EDGE).size();
+    if (prepared.subColors.empty()) {
+        return;
+    }
+
+    prepared.faceColors.assign(faceCount, std::nullopt);
+    prepared.edgeColors.assign(edgeCount, std::nullopt);
+    auto assign = [&tshape](
+                      const TopoDS_Shape& subShape,
+                      TopAbs_ShapeEnum type,
+                      const Base::Color& color,
+                      std::vector<std::optional<Base::Color>>& colors
+                  ) {
+        for (TopExp_Explorer exp(subShape, type); exp.More(); exp.Next()) {
+            int idx = tshape.findShape(exp.Current()) - 1;
+            if (idx >= 0 && idx < (int)colors.size()) {
+                colors[idx] = color;
+            }
+        }
+    };
+
+    for (const auto& sub : prepared.subColors) {
+        bool isElement = sub.shape.ShapeType() == TopAbs_FACE
+            || sub.shape.ShapeType() == TopAbs_EDGE;
+        if (sub.faceColor) {
+            assign(sub.shape, TopAbs_FACE, *sub.faceColor, prepared.faceColors);
+        }
+        if (sub.edgeColor) {
+            // Some STEP files give solids a curve color equal to the face color. Do not set
+            // the edges to the same color as the faces then.
+            if (!isElement && sub.faceColor && faceCount > 0 && *sub.edgeColor == *sub.faceColor) {
+                continue;
+            }
+            assign(sub.shape, TopAbs_EDGE, *sub.edgeColor, prepared.edgeColors);
+        }
+    }
+}
+
+void ImportOCAF2::prepareShapes(const TDF_LabelSequence& labels)
+{
+    myPreparedShapes.clear();
+
+    // The XCAF document is read on this thread only, the shapes are then processed in
+    // parallel. The objects are created afterwards from the results.
+    std::vector<PreparedShape*> shapes;
+    for (Standard_Integer i = 1; i <= labels.Length(); i++) {
+        auto label = labels.Value(i);
+        if (aShapeTool->IsAssembly(label)) {
+            continue;
+        }
+        if (!options.importHidden && !aColorTool->IsVisible(label)) {
+            continue;
+        }
+        TopoDS_Shape shape = aShapeTool->GetShape(label).Located(TopLoc_Location());
+        if (shape.IsNull() || !TopExp_Explorer(shape, TopAbs_VERTEX).More()) {
+            continue;
+        }
+        auto res = myPreparedShapes.emplace(shape, PreparedShape());
+        if (!res.second) {
+            continue;
+        }
+        res.first->second.shape = shape;
+        res.first->second.subColors = getSubShapeColors(label);
+        shapes.push_back(&res.first->second);
+    }
+
+    QtConcurrent::blockingMap(shapes, [](PreparedShape* prepared) {
+        try {
+            prepareShape(*prepared);
+        }
+        catch (...) {
+            prepared->tshape = Part::TopoShape();
+        }
+    });
+
+    // a failed shape is prepared again when its object is created to report the error
+    for (auto it = myPreparedShapes.begin(); it != myPreparedShapes.end();) {
+        if (it->second.tshape.isNull()) {
+            it = myPreparedShapes.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
 App::Document* ImportOCAF2::getDocument(App::Document* doc, TDF_Label label)
 {
     if (filePath.empty() || options.mode == SingleDoc || options.merge) {
@@ -522,6 +622,7 @@ App::DocumentObject* ImportOCAF2::loadShapes()
     FC_LOG("free shape count " << labels.Length());
     sequencer = options.showProgress ? &seq : nullptr;
 
+    prepareShapes(labels);
     labels.Clear();
     myShapes.clear();
     myNames.clear();
@@ -583,6 +684,7 @@ App::DocumentObject* ImportOCAF2::loadShapes()
         ret = feature;
         ret->recomputeFeature(true);
     }
+    myPreparedShapes.clear();
     sequencer = nullptr;
     return ret;
 }
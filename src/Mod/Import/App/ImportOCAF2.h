@@ -26,6 +26,7 @@
 #define IMPORT_IMPORTOCAF2_H
 
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -138,6 +139,27 @@ private:
         int free = true;
     };
 
+    // The colors that the XCAF document assigns to a sub-shape of a part
+    struct SubShapeColor
+    {
+        TopoDS_Shape shape;
+        std::optional<Base::Color> faceColor;
+        std::optional<Base::Color> edgeColor;
+    };
+
+    // The shape data of a part that doesn't need the document, so it can be prepared
+    // on a worker thread before the object is created
+    struct PreparedShape
+    {
+        TopoDS_Shape shape;
+        std::vector<SubShapeColor> subColors;
+        Part::TopoShape tshape;
+        std::vector<std::optional<Base::Color>> faceColors;
+        std::vector<std::optional<Base::Color>> edgeColors;
+        unsigned long solidCount = 0;
+        unsigned long shellCount = 0;
+    };
+
     App::DocumentObject* loadShape(
         App::Document* doc,
         TDF_Label label,
@@ -173,6 +195,9 @@ private:
     void setObjectName(Info& info, TDF_Label label);
     std::string getLabelName(TDF_Label label);
     App::DocumentObject* expandShape(App::Document* doc, TDF_Label label, const TopoDS_Shape& shape);
+    std::vector<SubShapeColor> getSubShapeColors(TDF_Label label);
+    void prepareShapes(const TDF_LabelSequence& labels);
+    static void prepareShape(PreparedShape& prepared);
 
     virtual void applyEdgeColors(Part::Feature*, const std::vector<Base::Color>&)
     {}
@@ -214,6 +239,7 @@ private:
     std::unordered_map<TopoDS_Shape, Info, ShapeHasher> myShapes;
     std::unordered_map<TDF_Label, std::string, LabelHasher> myNames;
     std::unordered_map<App::DocumentObject*, App::PropertyPlacement*> myCollapsedObjects;
+    std::unordered_map<TopoDS_Shape, PreparedShape, ShapeHasher> myPreparedShapes;
 
     Base::SequencerLauncher* sequencer {nullptr};
 };
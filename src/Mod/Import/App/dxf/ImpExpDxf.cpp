@@ -71,7 +71,9 @@
 #include <App/DocumentObjectPy.h>
 #include <App/FeaturePythonPyImp.h>
 #include <Base/Console.h>
+#include <Base/Exception.h>
 #include <Base/Interpreter.h>
+#include <Base/MappedFile.h>
 #include <Base/Matrix.h>
 #include <Base/Parameter.h>
 #include <Base/Vector3D.h>
@@ -411,24 +413,34 @@ void ImpExpDxfRead::CreateParametricPolyline(const TopoDS_Wire& wire, const char
 std::map<std::string, int> ImpExpDxfRead::PreScan(const std::string& filepath)
 {
     std::map<std::string, int> counts;
-    std::ifstream ifs(filepath);
-    if (!ifs) {
+    Base::MappedFile file;
+    try {
+        file.open(filepath);
+    }
+    catch (const Base::FileException&) {
         // Could throw an exception or log an error
         return counts;
     }
 
-    std::string line;
+    std::string_view text = file.view();
     bool next_is_entity_name = false;
 
-    while (std::getline(ifs, line)) {
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        std::size_t next = text.find('\n', pos);
+        if (next == std::string_view::npos) {
+            next = text.size();
+        }
+        std::string_view line = text.substr(pos, next - pos);
+        pos = next + 1;
         // Simple trim for Windows-style carriage returns
         if (!line.empty() && line.back() == '\r') {
-            line.pop_back();
+            line.remove_suffix(1);
         }
 
         if (next_is_entity_name) {
             // The line after a "  0" group code is the entity type
-            counts[line]++;
+            counts[std::string(line)]++;
             next_is_entity_name = false;
         }
         else if (line == "  0") {
@@ -6,13 +6,18 @@
 // modified 2018 wandererfan
 
 
+#include <cctype>
+#include <charconv>
 #include <cmath>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <exception>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 #include "dxf.h"
 #include <App/Application.h>
@@ -80,6 +85,44 @@ std::string DxfUnitToString(DxfUnits::eDxfUnits_t unit)
     }
 }
 
+// Parses a number like reading it from a stream in the "C" locale would do, but without the
+// overhead of a stream. Leading white space is skipped and trailing characters are ignored.
+template<typename T>
+bool parseNumber(std::string_view text, T& value)
+{
+    const char* pos = text.data();
+    const char* end = pos + text.size();
+    while (pos != end && std::isspace(static_cast<unsigned char>(*pos))) {
+        ++pos;
+    }
+    // std::from_chars doesn't accept a leading plus sign
+    if (pos != end && *pos == '+') {
+        ++pos;
+    }
+
+    if constexpr (std::is_same_v<T, bool>) {
+        int number = 0;
+        if (!parseNumber(std::string_view(pos, end - pos), number) || number < 0 || number > 1) {
+            return false;
+        }
+        value = number != 0;
+        return true;
+    }
+    else if constexpr (std::is_integral_v<T>) {
+        return std::from_chars(pos, end, value).ec == std::errc();
+    }
+    else {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        return std::from_chars(pos, end, value).ec == std::errc();
+#else
+        std::string buf(pos, end);
+        char* last = nullptr;
+        value = std::strtod(buf.c_str(), &last);
+        return last != buf.c_str();
+#endif
+    }
+}
+
 }  // namespace
 
 static Base::Vector3d MakeVector3d(const double coordinates[3])
@@ -1880,19 +1923,18 @@ void CDxfWrite::writeObjectsSection()
 const DxfUnits DxfUnits::Instance;
 
 CDxfRead::CDxfRead(const std::string& filepath)
-    : m_ifs(new ifstream(filepath))
 {
-    if (!(*m_ifs)) {
+    try {
+        m_file.open(filepath);
+    }
+    catch (const Base::FileException&) {
         m_fail = true;
         ImportError("DXF file didn't load\n");
-        return;
     }
-    m_ifs->imbue(std::locale("C"));
 }
 
 CDxfRead::~CDxfRead()
 {
-    delete m_ifs;
     // Delete the Layer objects which are referenced by pointer from the Layers table.
     for (auto& pair : Layers) {
         delete pair.second;
@@ -1954,13 +1996,8 @@ void CDxfRead::SetupValueAttribute(eDXFGroupCode_t record_type, T& destination)
 // Static processing helpers for ProcessCommonEntityAttribute
 void CDxfRead::ProcessScaledDouble(CDxfRead* object, void* target)
 {
-    std::istringstream ss;
-    ss.imbue(std::locale("C"));
-
-    ss.str(object->m_record_data);
     double value = 0;
-    ss >> value;
-    if (ss.fail()) {
+    if (!parseNumber(object->m_record_data, value)) {
         object->ImportError(
             "Unable to parse value '%s', using zero as its value\n",
             object->m_record_data
@@ -1970,13 +2007,8 @@ void CDxfRead::ProcessScaledDouble(CDxfRead* object, void* target)
 }
 void CDxfRead::ProcessScaledDoubleIntoList(CDxfRead* object, void* target)
 {
-    std::istringstream ss;
-    ss.imbue(std::locale("C"));
-
-    ss.str(object->m_record_data);
     double value = 0;
-    ss >> value;
-    if (ss.fail()) {
+    if (!parseNumber(object->m_record_data, value)) {
         object->ImportError(
             "Unable to parse value '%s', using zero as its value\n",
             object->m_record_data
@@ -1987,12 +2019,7 @@ void CDxfRead::ProcessScaledDoubleIntoList(CDxfRead* object, void* target)
 template<typename T>
 bool CDxfRead::ParseValue(CDxfRead* object, void* target)
 {
-    std::istringstream ss;
-    ss.imbue(std::locale("C"));
-
-    ss.str(object->m_record_data);
-    ss >> *static_cast<T*>(target);
-    if (ss.fail()) {
+    if (!parseNumber(object->m_record_data, *static_cast<T*>(target))) {
         object->ImportError(
             "Unable to parse value '%s', using zero as its value\n",
             object->m_record_data
@@ -2000,7 +2027,7 @@ bool CDxfRead::ParseValue(CDxfRead* object, void* target)
         *static_cast<T*>(target) = 0;
         return false;
     }
-    // TODO: Verify nothing it left but whitespace in ss.
+    // TODO: Verify nothing is left but whitespace after the value.
     return true;
 }
 void CDxfRead::ProcessStdString(CDxfRead* object, void* target)
@@ -2451,13 +2478,11 @@ bool CDxfRead::get_next_record()
     }
 
     do {
-        if ((*m_ifs).eof()) {
+        if (!get_next_line()) {
             m_not_eof = false;
             return false;
         }
 
-        std::getline(*m_ifs, m_record_data);
-        ++m_line;
         int temp = 0;
         if (!ParseValue<int>(this, &temp)) {
             ImportError(
@@ -2467,12 +2492,9 @@ bool CDxfRead::get_next_record()
             return false;
         }
         m_record_type = (eDXFGroupCode_t)temp;
-        if ((*m_ifs).eof()) {
+        if (!get_next_line()) {
             return false;
         }
-
-        std::getline(*m_ifs, m_record_data);
-        ++m_line;
     } while (m_record_type == eComment);
 
     // Remove any carriage return at the end of m_str which may occur because of inconsistent
@@ -2488,6 +2510,23 @@ bool CDxfRead::get_next_record()
     return true;
 }
 
+bool CDxfRead::get_next_line()
+{
+    std::string_view text = m_file.view();
+    if (m_file_pos >= text.size()) {
+        return false;
+    }
+
+    std::size_t next = text.find('\n', m_file_pos);
+    if (next == std::string_view::npos) {
+        next = text.size();
+    }
+    m_record_data.assign(text.substr(m_file_pos, next - m_file_pos));
+    m_file_pos = next + 1;
+    ++m_line;
+    return true;
+}
+
 void CDxfRead::repeat_last_record()
 {
     m_repeat_last_record = true;
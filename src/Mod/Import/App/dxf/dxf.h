@@ -24,6 +24,7 @@
 #include <vector>
 
 #include <Base/Interpreter.h>
+#include <Base/MappedFile.h>
 #include <Base/Matrix.h>
 #include <Base/Vector3D.h>
 #include <Base/Console.h>
@@ -487,7 +488,9 @@ class ImportExport CDxfRead
 {
 private:
     // Low-level reader members
-    std::ifstream* m_ifs;  // TODO: gsl::owner<ifstream>
+    // The file is mapped into memory and the records are read from it without copying it
+    Base::MappedFile m_file;
+    std::size_t m_file_pos = 0;
     // https://stackoverflow.com/questions/41167119/how-to-fix-a-wsubobject-linkage-warning
     eDXFGroupCode_t m_record_type = eObjectType;
     std::string m_record_data;
@@ -723,6 +726,7 @@ private:
     bool ResolveEncoding();
 
     bool get_next_record();
+    bool get_next_line();
     void repeat_last_record();
 
     bool (CDxfRead::*stringToUTF8)(std::string&) const = &CDxfRead::UTF8ToUTF8;
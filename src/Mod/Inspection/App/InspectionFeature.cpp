@@ -23,15 +23,23 @@
  ***************************************************************************/
 
 #include <boost/core/ignore_unused.hpp>
+#include <algorithm>
 #include <numeric>
 #include <limits>
+#include <set>
 
+#include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <Bnd_Box.hxx>
+#include <Poly_Triangle.hxx>
 #include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <gp_Pnt.hxx>
 
 #include <QEventLoop>
@@ -50,6 +58,7 @@
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/Tools.h>
 #include <Mod/Points/App/PointsFeature.h>
 #include <Mod/Points/App/PointsGrid.h>
 
@@ -474,52 +483,292 @@ float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
-InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
+namespace Inspection
+{
+/**
+ * Tessellation of a shape whose triangles are kept in a bounding volume hierarchy. It gives
+ * a fast approximation of the distance to the shape and the faces near a point. It is not
+ * modified after construction, so it can be used by several threads at the same time.
+ */
+class TessellatedShape
+{
+public:
+    struct Triangle
+    {
+        MeshCore::MeshGeomFacet facet;
+        int face;
+    };
+
+    TessellatedShape(const TopoDS_Shape& shape, double deflection)
+    {
+        BRepMesh_IncrementalMesh(shape, deflection, Standard_False, 0.5, Standard_True);
+
+        TopTools_IndexedMapOfShape mapOfFaces;
+        TopExp::MapShapes(shape, TopAbs_FACE, mapOfFaces);
+        for (int i = 1; i <= mapOfFaces.Extent(); i++) {
+            const TopoDS_Face& face = TopoDS::Face(mapOfFaces(i));
+            std::vector<gp_Pnt> points;
+            std::vector<Poly_Triangle> facets;
+            if (!Part::Tools::getTriangulation(face, points, facets)) {
+                continue;
+            }
+
+            int index = int(faces.size());
+            faces.push_back(face);
+            for (const auto& it : facets) {
+                Standard_Integer n1, n2, n3;
+                it.Get(n1, n2, n3);
+                MeshCore::MeshGeomFacet facet(
+                    toVector(points[n1]),
+                    toVector(points[n2]),
+                    toVector(points[n3])
+                );
+                triangles.push_back({facet, index});
+            }
+        }
+
+        if (!triangles.empty()) {
+            nodes.reserve(4 * triangles.size() / leafSize + 1);
+            nodes.emplace_back();
+            build(0, 0, triangles.size());
+        }
+    }
+
+    bool isEmpty() const
+    {
+        return triangles.empty();
+    }
+
+    const Triangle& getTriangle(std::size_t index) const
+    {
+        return triangles[index];
+    }
+
+    const TopoDS_Face& getFace(int index) const
+    {
+        return faces[index];
+    }
+
+    /// Returns the index of the triangle nearest to the point and its distance
+    std::pair<std::size_t, float> nearest(const Base::Vector3f& pnt) const
+    {
+        std::size_t best = 0;
+        float minDist = std::numeric_limits<float>::max();
+
+        std::vector<std::size_t> stack {0};
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+            if (distance(node.box, pnt) >= minDist) {
+                continue;
+            }
+
+            if (node.count > 0) {
+                for (std::size_t i = node.first; i < node.first + node.count; i++) {
+                    float dist = triangles[i].facet.DistanceToPoint(pnt);
+                    if (dist < minDist) {
+                        minDist = dist;
+                        best = i;
+                    }
+                }
+            }
+            else {
+                // visit the nearer child first
+                std::size_t left = node.first;
+                std::size_t right = node.first + 1;
+                if (distance(nodes[left].box, pnt) < distance(nodes[right].box, pnt)) {
+                    std::swap(left, right);
+                }
+                stack.push_back(left);
+                stack.push_back(right);
+            }
+        }
+
+        return {best, minDist};
+    }
+
+    /// Collects the faces of all triangles closer to the point than \a maxDist
+    void facesInside(const Base::Vector3f& pnt, float maxDist, std::set<int>& result) const
+    {
+        std::vector<std::size_t> stack {0};
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+            if (distance(node.box, pnt) > maxDist) {
+                continue;
+            }
+
+            if (node.count > 0) {
+                for (std::size_t i = node.first; i < node.first + node.count; i++) {
+                    if (triangles[i].facet.DistanceToPoint(pnt) <= maxDist) {
+                        result.insert(triangles[i].face);
+                    }
+                }
+            }
+            else {
+                stack.push_back(node.first);
+                stack.push_back(node.first + 1);
+            }
+        }
+    }
+
+private:
+    // For a leaf 'first' is the index of its first triangle, otherwise of its first child
+    struct Node
+    {
+        Base::BoundBox3f box;
+        std::size_t first {0};
+        std::size_t count {0};
+    };
+
+    static constexpr std::size_t leafSize = 8;
+
+    static Base::Vector3f toVector(const gp_Pnt& pnt)
+    {
+        return Base::Vector3f(float(pnt.X()), float(pnt.Y()), float(pnt.Z()));
+    }
+
+    static float distance(const Base::BoundBox3f& box, const Base::Vector3f& pnt)
+    {
+        float dx = std::max({box.MinX - pnt.x, 0.0F, pnt.x - box.MaxX});
+        float dy = std::max({box.MinY - pnt.y, 0.0F, pnt.y - box.MaxY});
+        float dz = std::max({box.MinZ - pnt.z, 0.0F, pnt.z - box.MaxZ});
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    // Builds the node at 'index' for the triangles in [first, last)
+    void build(std::size_t index, std::size_t first, std::size_t last)
+    {
+        Base::BoundBox3f box;
+        Base::BoundBox3f centers;
+        for (std::size_t i = first; i < last; i++) {
+            const MeshCore::MeshGeomFacet& facet = triangles[i].facet;
+            for (const auto& pnt : facet._aclPoints) {
+                box.Add(pnt);
+            }
+            centers.Add(facet.GetGravityPoint());
+        }
+        nodes[index].box = box;
+
+        if (last - first <= leafSize) {
+            nodes[index].first = first;
+            nodes[index].count = last - first;
+            return;
+        }
+
+        // split at the median of the longest axis
+        unsigned short axis = 0;
+        if (centers.LengthY() > centers.LengthX()) {
+            axis = 1;
+        }
+        if (centers.LengthZ() > std::max(centers.LengthX(), centers.LengthY())) {
+            axis = 2;
+        }
+        std::size_t mid = first + (last - first) / 2;
+        std::nth_element(
+            triangles.begin() + std::ptrdiff_t(first),
+            triangles.begin() + std::ptrdiff_t(mid),
+            triangles.begin() + std::ptrdiff_t(last),
+            [axis](const Triangle& t1, const Triangle& t2) {
+                return t1.facet.GetGravityPoint()[axis] < t2.facet.GetGravityPoint()[axis];
+            }
+        );
+
+        // the children are stored next to each other
+        std::size_t left = nodes.size();
+        nodes.emplace_back();
+        nodes.emplace_back();
+        nodes[index].first = left;
+        build(left, first, mid);
+        build(left + 1, mid, last);
+    }
+
+private:
+    std::vector<TopoDS_Face> faces;
+    std::vector<Triangle> triangles;
+    std::vector<Node> nodes;
+};
+}  // namespace Inspection
+
+InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float radius)
     : _rShape(shape)
+    , searchRadius(radius)
 {
-    distss = new BRepExtrema_DistShapeShape();
-    distss->LoadS1(_rShape);
+    if (_rShape.IsNull()) {
+        return;
+    }
 
-    // When having a solid then use its shell because otherwise the distance
-    // for inner points will always be zero
-    if (!_rShape.IsNull() && _rShape.ShapeType() == TopAbs_SOLID) {
+    // When having a solid then use the classifier for points whose nearest point
+    // is not inside a face
+    if (_rShape.ShapeType() == TopAbs_SOLID) {
         TopExp_Explorer xp;
         xp.Init(_rShape, TopAbs_SHELL);
-        if (xp.More()) {
-            distss->LoadS1(xp.Current());
-            isSolid = true;
-        }
+        isSolid = xp.More();
     }
-    // distss->SetDeflection(radius);
-}
 
-InspectNominalShape::~InspectNominalShape()
-{
-    delete distss;
+    // The distance to the tessellation differs at most by the deflection from the exact
+    // distance. So, a fine tessellation rejects more points without an exact computation.
+    Bnd_Box bounds;
+    BRepBndLib::Add(_rShape, bounds);
+    if (bounds.IsVoid()) {
+        return;
+    }
+    double diagonal = std::sqrt(bounds.SquareExtent());
+    deflection = std::max(0.2 * double(radius), 0.0005 * diagonal);
+    tessellation = std::make_unique<TessellatedShape>(_rShape, deflection);
 }
 
+InspectNominalShape::~InspectNominalShape() = default;
+
 float InspectNominalShape::getDistance(const Base::Vector3f& point) const
 {
+    if (!tessellation || tessellation->isEmpty()) {
+        return std::numeric_limits<float>::max();
+    }
+
+    // approximate signed distance from the tessellation
+    auto [index, approxDist] = tessellation->nearest(point);
+    const MeshCore::MeshGeomFacet& facet = tessellation->getTriangle(index).facet;
+    if (point.DistanceToPlane(facet._aclPoints[0], facet.GetNormal()) < 0) {
+        approxDist = -approxDist;
+    }
+
+    // points outside the search radius don't need the exact distance
+    float tolerance = float(deflection);
+    if (std::fabs(approxDist) - tolerance > searchRadius) {
+        return approxDist;
+    }
+
+    // compute the exact distance to all faces that can be the nearest one
+    std::set<int> faces;
+    tessellation->facesInside(point, std::fabs(approxDist) + 2.0F * tolerance, faces);
+
     gp_Pnt pnt3d(point.x, point.y, point.z);
     BRepBuilderAPI_MakeVertex mkVert(pnt3d);
-    distss->LoadS2(mkVert.Vertex());
-
     float fMinDist = std::numeric_limits<float>::max();
-    if (distss->Perform() && distss->NbSolution() > 0) {
-        fMinDist = (float)distss->Value();
-        // the shape is a solid, check if the vertex is inside
-        if (isSolid) {
-            if (isInsideSolid(pnt3d)) {
-                fMinDist = -fMinDist;
-            }
+    std::optional<bool> below;
+    for (int face : faces) {
+        BRepExtrema_DistShapeShape distss(tessellation->getFace(face), mkVert.Vertex());
+        if (distss.IsDone() && distss.NbSolution() > 0 && distss.Value() < fMinDist) {
+            fMinDist = float(distss.Value());
+            below = isBelowFace(distss, pnt3d);
         }
-        else if (fMinDist > 0) {
-            // check if the distance was computed from a face
-            if (isBelowFace(pnt3d)) {
-                fMinDist = -fMinDist;
-            }
+    }
+
+    if (fMinDist == std::numeric_limits<float>::max()) {
+        return approxDist;
+    }
+
+    if (isSolid) {
+        // the shape is a solid, check if the vertex is inside
+        bool inside = below.has_value() ? below.value() : isInsideSolid(pnt3d);
+        if (inside) {
+            fMinDist = -fMinDist;
         }
     }
+    else if (fMinDist > 0 && below.value_or(false)) {
+        fMinDist = -fMinDist;
+    }
     return fMinDist;
 }
 
@@ -531,29 +780,28 @@ bool InspectNominalShape::isInsideSolid(const gp_Pnt& pnt3d) const
     return (classifier.State() == TopAbs_IN);
 }
 
-bool InspectNominalShape::isBelowFace(const gp_Pnt& pnt3d) const
+std::optional<bool> InspectNominalShape::isBelowFace(
+    const BRepExtrema_DistShapeShape& distss,
+    const gp_Pnt& pnt3d
+)
 {
     // check if the distance was computed from a face
-    for (Standard_Integer index = 1; index <= distss->NbSolution(); index++) {
-        if (distss->SupportTypeShape1(index) == BRepExtrema_IsInFace) {
-            TopoDS_Shape face = distss->SupportOnShape1(index);
+    for (Standard_Integer index = 1; index <= distss.NbSolution(); index++) {
+        if (distss.SupportTypeShape1(index) == BRepExtrema_IsInFace) {
+            TopoDS_Shape face = distss.SupportOnShape1(index);
             Standard_Real u, v;
-            distss->ParOnFaceS1(index, u, v);
-            // gp_Pnt pnt = distss->PointOnShape1(index);
+            distss.ParOnFaceS1(index, u, v);
             BRepGProp_Face props(TopoDS::Face(face));
             gp_Vec normal;
             gp_Pnt center;
             props.Normal(u, v, center, normal);
             gp_Vec dir(center, pnt3d);
             Standard_Real scalar = normal.Dot(dir);
-            if (scalar < 0) {
-                return true;
-            }
-            break;
+            return scalar < 0;
         }
     }
 
-    return false;
+    return std::nullopt;
 }
 
 // ----------------------------------------------------------------
@@ -833,7 +1081,6 @@ App::DocumentObjectExecReturn* Feature::execute()
             nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
         }
         else if (it->isDerivedFrom<Part::Feature>()) {
-            useMultithreading = false;
             Part::Feature* part = static_cast<Part::Feature*>(it);
             nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
         }
@@ -25,6 +25,9 @@
 #ifndef INSPECTION_FEATURE_H
 #define INSPECTION_FEATURE_H
 
+#include <memory>
+#include <optional>
+
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectGroup.h>
 
@@ -57,6 +60,7 @@ class TopoShape;
 
 namespace Inspection
 {
+class TessellatedShape;
 
 /** Delivers the number of points to be checked and returns the appropriate point to an index. */
 class InspectionExport InspectActualGeometry
@@ -161,6 +165,10 @@ private:
     Points::PointsGrid* _pGrid;
 };
 
+/** Calculates the signed distance to a shape. The tessellation of the shape gives an
+ * approximate distance, which is refined exactly only for points near the surface. The
+ * distance can be computed from several threads at the same time.
+ */
 class InspectionExport InspectNominalShape: public InspectNominalGeometry
 {
 public:
@@ -168,13 +176,18 @@ public:
     ~InspectNominalShape() override;
     float getDistance(const Base::Vector3f&) const override;
 
+    InspectNominalShape(const InspectNominalShape&) = delete;
+    InspectNominalShape& operator=(const InspectNominalShape&) = delete;
+
 private:
     bool isInsideSolid(const gp_Pnt&) const;
-    bool isBelowFace(const gp_Pnt&) const;
+    static std::optional<bool> isBelowFace(const BRepExtrema_DistShapeShape&, const gp_Pnt&);
 
 private:
-    BRepExtrema_DistShapeShape* distss;
     const TopoDS_Shape& _rShape;
+    std::unique_ptr<TessellatedShape> tessellation;
+    float searchRadius;
+    double deflection {0.0};
     bool isSolid {false};
 };
 
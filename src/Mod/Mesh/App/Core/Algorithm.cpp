@@ -24,8 +24,11 @@
 
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 
+#include <QtConcurrentMap>
+
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
 
@@ -713,8 +716,8 @@ bool MeshAlgorithm::FillupHole(
     PointIndex refPoint0 = *(boundary.begin());
     PointIndex refPoint1 = *(boundary.begin() + 1);
     if (pP2FStructure) {
-        const std::set<FacetIndex>& ring1 = (*pP2FStructure)[refPoint0];
-        const std::set<FacetIndex>& ring2 = (*pP2FStructure)[refPoint1];
+        MeshIndexRange ring1 = (*pP2FStructure)[refPoint0];
+        MeshIndexRange ring2 = (*pP2FStructure)[refPoint1];
         std::vector<FacetIndex> f_int;
         std::set_intersection(
             ring1.begin(),
@@ -1893,25 +1896,144 @@ float MeshAlgorithm::CalculateMinimumGridLength(
 
 // ----------------------------------------------------
 
-void MeshRefPointToFacets::Rebuild()
+namespace
 {
-    _map.clear();
+// Splits the range [0, count) into blocks to process them in parallel
+std::vector<std::pair<std::size_t, std::size_t>> makeBlocks(std::size_t count)
+{
+    const std::size_t blockSize = 0x10000;
+    std::vector<std::pair<std::size_t, std::size_t>> blocks;
+    for (std::size_t i = 0; i < count; i += blockSize) {
+        blocks.emplace_back(i, std::min(count, i + blockSize));
+    }
+    return blocks;
+}
+}  // namespace
 
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rPoints.size());
+void MeshIndexTable::Clear()
+{
+    _rows.clear();
+    _indices.clear();
+}
+
+template<typename Func>
+void MeshIndexTable::Build(std::size_t rows, std::size_t items, Func&& emit)
+{
+    Clear();
+
+    // first pass: count the entries of each list
+    std::vector<std::atomic<std::size_t>> cursor(rows);
+    std::vector<std::pair<std::size_t, std::size_t>> blocks = makeBlocks(items);
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        auto count = [&cursor](ElementIndex row, ElementIndex) {
+            cursor[row].fetch_add(1, std::memory_order_relaxed);
+        };
+        for (std::size_t i = block.first; i < block.second; i++) {
+            emit(i, count);
+        }
+    });
+
+    _rows.resize(rows);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < rows; i++) {
+        _rows[i].start = total;
+        total += cursor[i].exchange(total, std::memory_order_relaxed);
+    }
+
+    // second pass: store the entries
+    _indices.resize(total);
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        auto store = [this, &cursor](ElementIndex row, ElementIndex index) {
+            _indices[cursor[row].fetch_add(1, std::memory_order_relaxed)] = index;
+        };
+        for (std::size_t i = block.first; i < block.second; i++) {
+            emit(i, store);
+        }
+    });
+
+    // sort the lists and remove duplicates
+    std::vector<std::pair<std::size_t, std::size_t>> rowBlocks = makeBlocks(rows);
+    QtConcurrent::blockingMap(rowBlocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++) {
+            auto first = _indices.begin() + static_cast<std::ptrdiff_t>(_rows[i].start);
+            auto last = _indices.begin() + static_cast<std::ptrdiff_t>(cursor[i].load());
+            std::sort(first, last);
+            _rows[i].size = static_cast<std::uint32_t>(std::unique(first, last) - first);
+        }
+    });
 
-    auto pFBegin = rFacets.begin();
-    for (auto pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
-        _map[pFIter->_aulPoints[0]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[1]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[2]].insert(pFIter - pFBegin);
+    // close the gaps left by the duplicates
+    std::size_t pos = 0;
+    for (Row& row : _rows) {
+        auto first = _indices.begin() + static_cast<std::ptrdiff_t>(row.start);
+        std::copy(first, first + row.size, _indices.begin() + static_cast<std::ptrdiff_t>(pos));
+        row.start = pos;
+        row.capacity = row.size;
+        pos += row.size;
     }
+    _indices.resize(pos);
+    _indices.shrink_to_fit();
+}
+
+void MeshIndexTable::Insert(ElementIndex row, ElementIndex index)
+{
+    MeshIndexRange range = (*this)[row];
+    auto it = std::lower_bound(range.begin(), range.end(), index);
+    if (it != range.end() && *it == index) {
+        return;
+    }
+
+    Row& r = _rows[row];
+    auto pos = static_cast<std::size_t>(it - range.begin());
+    if (r.size == r.capacity) {
+        // make room for more entries at the end of the array
+        std::uint32_t capacity = std::max<std::uint32_t>(4, 2 * r.capacity);
+        if (r.start + r.capacity == _indices.size()) {
+            _indices.resize(r.start + capacity);
+        }
+        else {
+            std::size_t start = _indices.size();
+            _indices.resize(start + capacity);
+            auto first = _indices.begin() + static_cast<std::ptrdiff_t>(r.start);
+            std::copy(first, first + r.size, _indices.begin() + static_cast<std::ptrdiff_t>(start));
+            r.start = start;
+        }
+        r.capacity = capacity;
+    }
+
+    auto first = _indices.begin() + static_cast<std::ptrdiff_t>(r.start);
+    std::copy_backward(first + pos, first + r.size, first + r.size + 1);
+    first[pos] = index;
+    r.size++;
+}
+
+void MeshIndexTable::Erase(ElementIndex row, ElementIndex index)
+{
+    Row& r = _rows[row];
+    auto first = _indices.begin() + static_cast<std::ptrdiff_t>(r.start);
+    auto last = first + r.size;
+    auto it = std::lower_bound(first, last, index);
+    if (it != last && *it == index) {
+        std::copy(it + 1, last, it);
+        r.size--;
+    }
+}
+
+// ----------------------------------------------------
+
+void MeshRefPointToFacets::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    _map.Build(_rclMesh.CountPoints(), rFacets.size(), [&rFacets](std::size_t index, auto&& add) {
+        for (PointIndex ptIndex : rFacets[index]._aulPoints) {
+            add(ptIndex, index);
+        }
+    });
 }
 
 Base::Vector3f MeshRefPointToFacets::GetNormal(PointIndex pos) const
 {
-    const std::set<FacetIndex>& n = _map[pos];
+    MeshIndexRange n = _map[pos];
     Base::Vector3f normal;
     MeshGeomFacet f;
     for (FacetIndex it : n) {
@@ -1935,7 +2057,7 @@ std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(
     for (int i = 0; i < level; i++) {
         std::set<PointIndex> cur;
         for (PointIndex it : lp) {
-            const std::set<FacetIndex>& ft = (*this)[it];
+            MeshIndexRange ft = (*this)[it];
             for (FacetIndex jt : ft) {
                 for (PointIndex index : f_it[jt]._aulPoints) {
                     if (cp.find(index) == cp.end() && nb.find(index) == nb.end()) {
@@ -1957,7 +2079,7 @@ std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(
 std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(PointIndex pos) const
 {
     std::set<PointIndex> p;
-    const std::set<FacetIndex>& vf = _map[pos];
+    MeshIndexRange vf = _map[pos];
     for (FacetIndex it : vf) {
         PointIndex p1 {}, p2 {}, p3 {};
         _rclMesh.GetFacetPoints(it, p1, p2, p3);
@@ -2005,7 +2127,7 @@ void MeshRefPointToFacets::SearchNeighbours(
     visited.insert(index);
     collect.Append(_rclMesh, index);
     for (PointIndex ptIndex : face._aulPoints) {
-        const std::set<FacetIndex>& f = (*this)[ptIndex];
+        MeshIndexRange f = (*this)[ptIndex];
 
         for (FacetIndex j : f) {
             SearchNeighbours(rFacets, j, rclCenter, fMaxDist2, visited, collect);
@@ -2018,7 +2140,7 @@ MeshFacetArray::_TConstIterator MeshRefPointToFacets::GetFacet(FacetIndex index)
     return _rclMesh.GetFacets().begin() + index;
 }
 
-const std::set<FacetIndex>& MeshRefPointToFacets::operator[](PointIndex pos) const
+MeshIndexRange MeshRefPointToFacets::operator[](PointIndex pos) const
 {
     return _map[pos];
 }
@@ -2027,8 +2149,8 @@ std::vector<FacetIndex> MeshRefPointToFacets::GetIndices(PointIndex pos1, PointI
 {
     std::vector<FacetIndex> intersection;
     std::back_insert_iterator<std::vector<FacetIndex>> result(intersection);
-    const std::set<FacetIndex>& set1 = _map[pos1];
-    const std::set<FacetIndex>& set2 = _map[pos2];
+    MeshIndexRange set1 = _map[pos1];
+    MeshIndexRange set2 = _map[pos2];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
@@ -2042,19 +2164,19 @@ std::vector<FacetIndex> MeshRefPointToFacets::GetIndices(
     std::vector<FacetIndex> intersection;
     std::back_insert_iterator<std::vector<FacetIndex>> result(intersection);
     std::vector<FacetIndex> set1 = GetIndices(pos1, pos2);
-    const std::set<FacetIndex>& set2 = _map[pos3];
+    MeshIndexRange set2 = _map[pos3];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
 
 void MeshRefPointToFacets::AddNeighbour(PointIndex pos, FacetIndex facet)
 {
-    _map[pos].insert(facet);
+    _map.Insert(pos, facet);
 }
 
 void MeshRefPointToFacets::RemoveNeighbour(PointIndex pos, FacetIndex facet)
 {
-    _map[pos].erase(facet);
+    _map.Erase(pos, facet);
 }
 
 void MeshRefPointToFacets::RemoveFacet(FacetIndex facetIndex)
@@ -2062,33 +2184,27 @@ void MeshRefPointToFacets::RemoveFacet(FacetIndex facetIndex)
     PointIndex p0 {}, p1 {}, p2 {};
     _rclMesh.GetFacetPoints(facetIndex, p0, p1, p2);
 
-    _map[p0].erase(facetIndex);
-    _map[p1].erase(facetIndex);
-    _map[p2].erase(facetIndex);
+    _map.Erase(p0, facetIndex);
+    _map.Erase(p1, facetIndex);
+    _map.Erase(p2, facetIndex);
 }
 
 //----------------------------------------------------------------------------
 
 void MeshRefFacetToFacets::Rebuild()
 {
-    _map.clear();
-
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rFacets.size());
-
     MeshRefPointToFacets vertexFace(_rclMesh);
-    auto pFBegin = rFacets.begin();
-    for (auto pFIter = pFBegin; pFIter != rFacets.end(); ++pFIter) {
-        for (PointIndex ptIndex : pFIter->_aulPoints) {
-            const std::set<FacetIndex>& faces = vertexFace[ptIndex];
-            for (FacetIndex face : faces) {
-                _map[pFIter - pFBegin].insert(face);
+    _map.Build(rFacets.size(), rFacets.size(), [&](std::size_t index, auto&& add) {
+        for (PointIndex ptIndex : rFacets[index]._aulPoints) {
+            for (FacetIndex face : vertexFace[ptIndex]) {
+                add(index, face);
             }
         }
-    }
+    });
 }
 
-const std::set<FacetIndex>& MeshRefFacetToFacets::operator[](FacetIndex pos) const
+MeshIndexRange MeshRefFacetToFacets::operator[](FacetIndex pos) const
 {
     return _map[pos];
 }
@@ -2097,8 +2213,8 @@ std::vector<FacetIndex> MeshRefFacetToFacets::GetIndices(FacetIndex pos1, FacetI
 {
     std::vector<FacetIndex> intersection;
     std::back_insert_iterator<std::vector<FacetIndex>> result(intersection);
-    const std::set<FacetIndex>& set1 = _map[pos1];
-    const std::set<FacetIndex>& set2 = _map[pos2];
+    MeshIndexRange set1 = _map[pos1];
+    MeshIndexRange set2 = _map[pos2];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
@@ -2107,24 +2223,19 @@ std::vector<FacetIndex> MeshRefFacetToFacets::GetIndices(FacetIndex pos1, FacetI
 
 void MeshRefPointToPoints::Rebuild()
 {
-    _map.clear();
-
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    _map.resize(rPoints.size());
-
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    for (const auto& rFacet : rFacets) {
-        PointIndex ulP0 = rFacet._aulPoints[0];
-        PointIndex ulP1 = rFacet._aulPoints[1];
-        PointIndex ulP2 = rFacet._aulPoints[2];
+    _map.Build(_rclMesh.CountPoints(), rFacets.size(), [&rFacets](std::size_t index, auto&& add) {
+        PointIndex ulP0 = rFacets[index]._aulPoints[0];
+        PointIndex ulP1 = rFacets[index]._aulPoints[1];
+        PointIndex ulP2 = rFacets[index]._aulPoints[2];
 
-        _map[ulP0].insert(ulP1);
-        _map[ulP0].insert(ulP2);
-        _map[ulP1].insert(ulP0);
-        _map[ulP1].insert(ulP2);
-        _map[ulP2].insert(ulP0);
-        _map[ulP2].insert(ulP1);
-    }
+        add(ulP0, ulP1);
+        add(ulP0, ulP2);
+        add(ulP1, ulP0);
+        add(ulP1, ulP2);
+        add(ulP2, ulP0);
+        add(ulP2, ulP1);
+    });
 }
 
 Base::Vector3f MeshRefPointToPoints::GetNormal(PointIndex pos) const
@@ -2133,7 +2244,7 @@ Base::Vector3f MeshRefPointToPoints::GetNormal(PointIndex pos) const
     MeshCore::PlaneFit pf;
     pf.AddPoint(rPoints[pos]);
     MeshCore::MeshPoint center = rPoints[pos];
-    const std::set<PointIndex>& cv = _map[pos];
+    MeshIndexRange cv = _map[pos];
     for (PointIndex cv_it : cv) {
         pf.AddPoint(rPoints[cv_it]);
         center += rPoints[cv_it];
@@ -2150,7 +2261,7 @@ float MeshRefPointToPoints::GetAverageEdgeLength(PointIndex index) const
 {
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     float len = 0.0F;
-    const std::set<PointIndex>& n = (*this)[index];
+    MeshIndexRange n = (*this)[index];
     const Base::Vector3f& p = rPoints[index];
     for (PointIndex it : n) {
         len += Base::Distance(p, rPoints[it]);
@@ -2158,19 +2269,19 @@ float MeshRefPointToPoints::GetAverageEdgeLength(PointIndex index) const
     return (len / n.size());
 }
 
-const std::set<PointIndex>& MeshRefPointToPoints::operator[](PointIndex pos) const
+MeshIndexRange MeshRefPointToPoints::operator[](PointIndex pos) const
 {
     return _map[pos];
 }
 
 void MeshRefPointToPoints::AddNeighbour(PointIndex pos, PointIndex facet)
 {
-    _map[pos].insert(facet);
+    _map.Insert(pos, facet);
 }
 
 void MeshRefPointToPoints::RemoveNeighbour(PointIndex pos, PointIndex facet)
 {
-    _map[pos].erase(facet);
+    _map.Erase(pos, facet);
 }
 
 //----------------------------------------------------------------------------
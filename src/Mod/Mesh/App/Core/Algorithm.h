@@ -25,6 +25,8 @@
 #ifndef MESHALGORITHM_H
 #define MESHALGORITHM_H
 
+#include <algorithm>
+#include <cstdint>
 #include <map>
 #include <set>
 #include <vector>
@@ -530,6 +532,102 @@ private:
     std::vector<FacetIndex>& indices;
 };
 
+/**
+ * A read-only view to one sorted list of indices of a MeshIndexTable. It provides the
+ * queries of a std::set, so the neighbourhood of an element can be inspected the same way.
+ * \note The view becomes invalid when the table is modified.
+ */
+class MeshIndexRange
+{
+public:
+    using value_type = ElementIndex;
+    using const_iterator = const ElementIndex*;
+    using iterator = const_iterator;
+
+    MeshIndexRange() = default;
+    MeshIndexRange(const ElementIndex* first, const ElementIndex* last)
+        : _first(first)
+        , _last(last)
+    {}
+
+    const_iterator begin() const
+    {
+        return _first;
+    }
+    const_iterator end() const
+    {
+        return _last;
+    }
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(_last - _first);
+    }
+    bool empty() const
+    {
+        return _first == _last;
+    }
+    /// Returns the position of \a index or end() if it is not part of the list
+    const_iterator find(ElementIndex index) const
+    {
+        const_iterator it = std::lower_bound(_first, _last, index);
+        return (it != _last && *it == index) ? it : _last;
+    }
+    std::size_t count(ElementIndex index) const
+    {
+        return find(index) != _last ? 1 : 0;
+    }
+
+private:
+    const ElementIndex* _first {nullptr};
+    const ElementIndex* _last {nullptr};
+};
+
+/**
+ * The MeshIndexTable keeps a sorted list of indices for each point or facet of a mesh in
+ * one flat array (compressed sparse rows). Compared to a std::set per element this needs
+ * only a fraction of the memory, and the lists can be built in parallel.
+ * A list that grows beyond its reserved space is moved to the end of the array.
+ */
+class MeshExport MeshIndexTable
+{
+public:
+    /// Removes all lists
+    void Clear();
+    /// Returns the number of lists
+    std::size_t Size() const
+    {
+        return _rows.size();
+    }
+    MeshIndexRange operator[](ElementIndex row) const
+    {
+        const Row& r = _rows[row];
+        const ElementIndex* first = _indices.data() + r.start;
+        return {first, first + r.size};
+    }
+    /// Adds \a index to the list \a row if not already there
+    void Insert(ElementIndex row, ElementIndex index);
+    /// Removes \a index from the list \a row
+    void Erase(ElementIndex row, ElementIndex index);
+    /**
+     * Rebuilds the table with \a rows lists. \a emit is called for each of the \a items
+     * with the item index and a function to add an index to a list. It is called twice per
+     * item, to count and then to store the indices, from several threads at a time.
+     */
+    template<typename Func>
+    void Build(std::size_t rows, std::size_t items, Func&& emit);
+
+private:
+    struct Row
+    {
+        std::size_t start {0};
+        std::uint32_t size {0};
+        std::uint32_t capacity {0};
+    };
+
+    std::vector<Row> _rows;
+    std::vector<ElementIndex> _indices;
+};
+
 /**
  * The MeshRefPointToFacets builds up a structure to have access to all facets indexing
  * a point.
@@ -548,7 +646,7 @@ public:
 
     /// Rebuilds up data structure
     void Rebuild();
-    const std::set<FacetIndex>& operator[](PointIndex) const;
+    MeshIndexRange operator[](PointIndex) const;
     std::vector<FacetIndex> GetIndices(PointIndex, PointIndex) const;
     std::vector<FacetIndex> GetIndices(PointIndex, PointIndex, PointIndex) const;
     MeshFacetArray::_TConstIterator GetFacet(FacetIndex) const;
@@ -572,7 +670,7 @@ protected:
 
 private:
     const MeshKernel& _rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<FacetIndex>> _map;
+    MeshIndexTable _map;
 };
 
 /**
@@ -595,13 +693,13 @@ public:
 
     /// Returns a set of facets sharing one or more points with the facet with
     /// index \a ulFacetIndex.
-    const std::set<FacetIndex>& operator[](FacetIndex) const;
+    MeshIndexRange operator[](FacetIndex) const;
     /// Returns an array of common facets of the passed facet indexes.
     std::vector<FacetIndex> GetIndices(FacetIndex, FacetIndex) const;
 
 private:
     const MeshKernel& _rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<FacetIndex>> _map;
+    MeshIndexTable _map;
 };
 
 /**
@@ -622,7 +720,7 @@ public:
 
     /// Rebuilds up data structure
     void Rebuild();
-    const std::set<PointIndex>& operator[](PointIndex) const;
+    MeshIndexRange operator[](PointIndex) const;
     Base::Vector3f GetNormal(PointIndex) const;
     float GetAverageEdgeLength(PointIndex) const;
     void AddNeighbour(PointIndex, PointIndex);
@@ -630,7 +728,7 @@ public:
 
 private:
     const MeshKernel& _rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<PointIndex>> _map;
+    MeshIndexTable _map;
 };
 
 /**
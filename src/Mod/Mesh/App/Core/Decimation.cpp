@@ -22,8 +22,19 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <limits>
 
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrentMap>
+
+#include <Base/Exception.h>
+#include <Base/Sequencer.h>
+#include <Base/Tools.h>
+
 #include "Decimation.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
@@ -31,26 +42,73 @@
 
 using namespace MeshCore;
 
-MeshSimplify::MeshSimplify(MeshKernel& mesh)
-    : myKernel(mesh)
-{}
+namespace
+{
+// Meshes with at least twice this number of facets are decimated in parts
+constexpr std::size_t partSize = 50000;
 
-void MeshSimplify::simplify(float tolerance, float reduction)
+// Weight of the planes that keep the points on boundary and sharp edges
+constexpr double featureWeight = 10.0;
+
+// A part of the mesh that is decimated independently of the others. Its points that are
+// shared with other parts are fixed, so that the decimated parts still fit together.
+struct MeshPart
 {
+    std::vector<FacetIndex> facets;
     Simplify alg;
+};
 
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
+Base::Vector3f facetNormal(const MeshPointArray& points, const MeshFacet& facet)
+{
+    const Base::Vector3f& p0 = points[facet._aulPoints[0]];
+    const Base::Vector3f& p1 = points[facet._aulPoints[1]];
+    const Base::Vector3f& p2 = points[facet._aulPoints[2]];
+    Base::Vector3f normal = (p1 - p0) % (p2 - p0);
+    normal.Normalize();
+    return normal;
+}
+
+// Sets up the algorithm with the given facets. Points with the flag set in 'shared' are not
+// moved or removed.
+void initAlgorithm(
+    Simplify& alg,
+    const MeshKernel& kernel,
+    const std::vector<FacetIndex>& indices,
+    const std::vector<bool>& shared,
+    float featureAngle
+)
+{
+    const MeshPointArray& points = kernel.GetPoints();
+    const MeshFacetArray& facets = kernel.GetFacets();
+
+    std::vector<PointIndex> pointIndices;
+    pointIndices.reserve(3 * indices.size());
+    for (FacetIndex index : indices) {
+        const MeshFacet& facet = facets[index];
+        pointIndices.insert(pointIndices.end(), facet._aulPoints, facet._aulPoints + 3);
+    }
+    std::sort(pointIndices.begin(), pointIndices.end());
+    pointIndices.erase(std::unique(pointIndices.begin(), pointIndices.end()), pointIndices.end());
+
+    auto localIndex = [&pointIndices](PointIndex index) {
+        auto it = std::lower_bound(pointIndices.begin(), pointIndices.end(), index);
+        return static_cast<int>(it - pointIndices.begin());
+    };
+
+    alg.vertices.reserve(pointIndices.size());
+    for (PointIndex index : pointIndices) {
         Simplify::Vertex v;
         v.tstart = 0;
         v.tcount = 0;
         v.border = 0;
-        v.p = points[i];
+        v.locked = shared.empty() ? 0 : static_cast<int>(shared[index]);
+        v.id = static_cast<int>(index);
+        v.p = points[index];
         alg.vertices.push_back(v);
     }
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
+    alg.triangles.reserve(indices.size());
+    for (FacetIndex index : indices) {
         Simplify::Triangle t;
         t.deleted = 0;
         t.dirty = 0;
@@ -58,99 +116,274 @@ void MeshSimplify::simplify(float tolerance, float reduction)
             j = 0.0;
         }
         for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
+            t.v[j] = localIndex(facets[index]._aulPoints[j]);
         }
         alg.triangles.push_back(t);
     }
 
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0F - reduction));
+    // For boundary and sharp edges add the planes through the edge that are perpendicular to
+    // the adjacent facets. Moving a point away from the edge then gives a high error.
+    float minCosine = std::cos(featureAngle);
+    auto addPlane = [&](int v0, int v1, const Base::Vector3f& normal) {
+        const Base::Vector3f& p0 = alg.vertices[v0].p;
+        Base::Vector3f dir = (alg.vertices[v1].p - p0) % normal;
+        if (dir.Length() == 0.0F) {
+            return;
+        }
+        dir.Normalize();
+        double a = featureWeight * dir.x;
+        double b = featureWeight * dir.y;
+        double c = featureWeight * dir.z;
+        double d = -featureWeight * (dir * p0);
+        SymmetricMatrix plane(a, b, c, d);
+        alg.vertices[v0].q += plane;
+        alg.vertices[v1].q += plane;
+    };
 
-    // Simplification starts
-    alg.simplify_mesh(target_count, tolerance);
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        const MeshFacet& facet = facets[indices[i]];
+        Base::Vector3f normal = facetNormal(points, facet);
+        for (int j = 0; j < 3; j++) {
+            // handle each inner edge only once
+            FacetIndex neighbour = facet._aulNeighbours[j];
+            if (neighbour != FACET_INDEX_MAX && neighbour < indices[i]) {
+                continue;
+            }
 
-    // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (const auto& vertex : alg.vertices) {
-        new_points.push_back(vertex.p);
+            int v0 = alg.triangles[i].v[j];
+            int v1 = alg.triangles[i].v[(j + 1) % 3];
+            if (neighbour == FACET_INDEX_MAX) {
+                addPlane(v0, v1, normal);
+            }
+            else {
+                Base::Vector3f other = facetNormal(points, facets[neighbour]);
+                if (normal * other < minCosine) {
+                    addPlane(v0, v1, normal);
+                    addPlane(v0, v1, other);
+                }
+            }
+        }
     }
+}
 
-    std::size_t numFacets = 0;
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            numFacets++;
+// Splits the facets in [first, last) at the median of their centers along the longest axis
+// until each part has at most 'partSize' facets
+void splitFacets(
+    std::vector<FacetIndex>& indices,
+    const std::vector<Base::Vector3f>& centers,
+    std::size_t first,
+    std::size_t last,
+    std::vector<std::pair<std::size_t, std::size_t>>& ranges
+)
+{
+    if (last - first <= partSize) {
+        ranges.emplace_back(first, last);
+        return;
+    }
+
+    Base::BoundBox3f box;
+    for (std::size_t i = first; i < last; i++) {
+        box.Add(centers[indices[i]]);
+    }
+
+    unsigned short axis = 0;
+    if (box.LengthY() > box.LengthX()) {
+        axis = 1;
+    }
+    if (box.LengthZ() > std::max(box.LengthX(), box.LengthY())) {
+        axis = 2;
+    }
+
+    std::size_t mid = first + (last - first) / 2;
+    std::nth_element(
+        indices.begin() + std::ptrdiff_t(first),
+        indices.begin() + std::ptrdiff_t(mid),
+        indices.begin() + std::ptrdiff_t(last),
+        [&centers, axis](FacetIndex f1, FacetIndex f2) {
+            return centers[f1][axis] < centers[f2][axis];
+        }
+    );
+
+    splitFacets(indices, centers, first, mid, ranges);
+    splitFacets(indices, centers, mid, last, ranges);
+}
+
+// Appends the result of the algorithm to the arrays. The fixed points are added only once
+// for all parts.
+void appendResult(
+    const Simplify& alg,
+    MeshPointArray& points,
+    MeshFacetArray& facets,
+    std::vector<PointIndex>& sharedIndex
+)
+{
+    std::vector<PointIndex> pointIndex;
+    pointIndex.reserve(alg.vertices.size());
+    for (const auto& vertex : alg.vertices) {
+        if (vertex.locked) {
+            PointIndex& index = sharedIndex[vertex.id];
+            if (index == POINT_INDEX_MAX) {
+                index = points.size();
+                points.push_back(vertex.p);
+            }
+            pointIndex.push_back(index);
+        }
+        else {
+            pointIndex.push_back(points.size());
+            points.push_back(vertex.p);
         }
     }
-    MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
+
     for (const auto& triangle : alg.triangles) {
         if (!triangle.deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = triangle.v[0];
-            face._aulPoints[1] = triangle.v[1];
-            face._aulPoints[2] = triangle.v[2];
-            new_facets.push_back(face);
+            facets.emplace_back(
+                pointIndex[triangle.v[0]],
+                pointIndex[triangle.v[1]],
+                pointIndex[triangle.v[2]]
+            );
         }
     }
+}
+}  // namespace
 
-    myKernel.Adopt(new_points, new_facets, true);
+MeshSimplify::MeshSimplify(MeshKernel& mesh)
+    : myKernel(mesh)
+    , featureAngle(Base::toRadians(60.0F))
+{}
+
+void MeshSimplify::simplify(float tolerance, float reduction)
+{
+    float numFacets = static_cast<float>(myKernel.CountFacets());
+    int target_count = static_cast<int>(numFacets * (1.0F - reduction));
+    decimate(target_count, tolerance);
 }
 
 void MeshSimplify::simplify(int targetSize)
 {
+    decimate(targetSize, std::numeric_limits<float>::max());
+}
+
+void MeshSimplify::decimate(int targetSize, double tolerance)
+{
+    if (myKernel.CountFacets() >= 2 * partSize) {
+        decimateParts(targetSize, tolerance);
+    }
+
+    // Simplification of the whole mesh. After the decimation of the parts this mainly
+    // removes the points at their seams.
+    std::vector<FacetIndex> indices(myKernel.CountFacets());
+    std::generate(indices.begin(), indices.end(), Base::iotaGen<FacetIndex>(0));
+
     Simplify alg;
+    initAlgorithm(alg, myKernel, indices, {}, featureAngle);
+    alg.simplify_mesh(targetSize, tolerance);
 
+    MeshPointArray new_points;
+    MeshFacetArray new_facets;
+    std::vector<PointIndex> sharedIndex;
+    new_points.reserve(alg.vertices.size());
+    new_facets.reserve(alg.triangles.size());
+    appendResult(alg, new_points, new_facets, sharedIndex);
+    myKernel.Adopt(new_points, new_facets, true);
+}
+
+void MeshSimplify::decimateParts(int targetSize, double tolerance)
+{
     const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+    const MeshFacetArray& facets = myKernel.GetFacets();
+
+    std::vector<Base::Vector3f> centers;
+    centers.reserve(facets.size());
+    for (const auto& facet : facets) {
+        const Base::Vector3f& p0 = points[facet._aulPoints[0]];
+        const Base::Vector3f& p1 = points[facet._aulPoints[1]];
+        const Base::Vector3f& p2 = points[facet._aulPoints[2]];
+        centers.push_back((p0 + p1 + p2) / 3.0F);
     }
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (double& j : t.err) {
-            j = 0.0;
-        }
-        for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
+    std::vector<FacetIndex> indices(facets.size());
+    std::generate(indices.begin(), indices.end(), Base::iotaGen<FacetIndex>(0));
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    splitFacets(indices, centers, 0, indices.size(), ranges);
+    centers.clear();
+    centers.shrink_to_fit();
+
+    // mark the points used by more than one part
+    std::vector<MeshPart> parts(ranges.size());
+    std::vector<std::size_t> owner(points.size(), ranges.size());
+    std::vector<bool> shared(points.size());
+    for (std::size_t i = 0; i < ranges.size(); i++) {
+        auto begin = indices.begin() + std::ptrdiff_t(ranges[i].first);
+        auto end = indices.begin() + std::ptrdiff_t(ranges[i].second);
+        parts[i].facets.assign(begin, end);
+        for (auto it = begin; it != end; ++it) {
+            for (PointIndex index : facets[*it]._aulPoints) {
+                if (owner[index] == ranges.size()) {
+                    owner[index] = i;
+                }
+                else if (owner[index] != i) {
+                    shared[index] = true;
+                }
+            }
         }
-        alg.triangles.push_back(t);
     }
 
-    // Simplification starts
-    alg.simplify_mesh(targetSize, std::numeric_limits<float>::max());
+    indices.clear();
+    indices.shrink_to_fit();
 
-    // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (const auto& vertex : alg.vertices) {
-        new_points.push_back(vertex.p);
-    }
+    // each part is reduced by the same ratio
+    double ratio = static_cast<double>(targetSize) / static_cast<double>(facets.size());
+    float angle = featureAngle;
+    auto decimatePart = [&](MeshPart& part) {
+        initAlgorithm(part.alg, myKernel, part.facets, shared, angle);
+        int target = static_cast<int>(ratio * static_cast<double>(part.facets.size()));
+        part.facets.clear();
+        part.facets.shrink_to_fit();
+        part.alg.simplify_mesh(target, tolerance);
+    };
 
-    std::size_t numFacets = 0;
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            numFacets++;
+    QFuture<void> future = QtConcurrent::map(parts, decimatePart);
+    QFutureWatcher<void> watcher;
+
+    // Keep the UI responsive and allow to abort the decimation. The exception of the
+    // sequencer must not be thrown through the event loop.
+    Base::SequencerLauncher seq("Decimating mesh...", parts.size());
+    int progress = 0;
+    bool aborted = false;
+    QObject::connect(&watcher, &QFutureWatcher<void>::progressValueChanged, [&](int value) {
+        try {
+            for (; progress < value; progress++) {
+                seq.next(true);
+            }
         }
+        catch (const Base::AbortException&) {
+            aborted = true;
+            watcher.cancel();
+        }
+    });
+
+    // Without an application object (e.g. in console mode) there is no event loop to
+    // deliver the signals of the watcher
+    if (QCoreApplication::instance()) {
+        QEventLoop loop;
+        QObject::connect(&watcher, &QFutureWatcher<void>::finished, &loop, &QEventLoop::quit);
+        watcher.setFuture(future);
+        loop.exec();
+    }
+    future.waitForFinished();
+
+    if (aborted) {
+        throw Base::AbortException();
     }
+
+    // Stitch the parts together
+    MeshPointArray new_points;
     MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = triangle.v[0];
-            face._aulPoints[1] = triangle.v[1];
-            face._aulPoints[2] = triangle.v[2];
-            new_facets.push_back(face);
-        }
+    std::vector<PointIndex> sharedIndex(points.size(), POINT_INDEX_MAX);
+    for (const auto& part : parts) {
+        appendResult(part.alg, new_points, new_facets, sharedIndex);
     }
 
+    parts.clear();
     myKernel.Adopt(new_points, new_facets, true);
 }
@@ -32,15 +32,38 @@ namespace MeshCore
 {
 class MeshKernel;
 
+/**
+ * Quadric based decimation of a mesh. Large meshes are split into parts that are decimated in
+ * parallel. The points at the seams of the parts are kept at first and removed by a final pass
+ * over the already reduced mesh. Boundary edges and sharp edges are kept as far as possible.
+ * The decimation of the parts shows its progress and can be aborted by the user, in which case
+ * a Base::AbortException is thrown and the mesh is left unchanged.
+ *
+ * @note To keep boundary and sharp edges weighted planes are added to the error quadrics of
+ * their points. This is done for every mesh, so the result differs from a plain quadric
+ * decimation even for small meshes. Boundary edges are always weighted, sharp edges can be
+ * ignored with a feature angle of pi.
+ */
 class MeshExport MeshSimplify
 {
 public:
     explicit MeshSimplify(MeshKernel&);
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /// Edges whose adjacent facets have normals with a larger angle (in radians) are preserved.
+    /// The default is 60 degree.
+    void setFeatureAngle(float angle)
+    {
+        featureAngle = angle;
+    }
+
+private:
+    void decimate(int targetSize, double tolerance);
+    void decimateParts(int targetSize, double tolerance);
 
 private:
     MeshKernel& myKernel;
+    float featureAngle;
 };
 
 }  // namespace MeshCore
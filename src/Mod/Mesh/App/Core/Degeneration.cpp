@@ -597,7 +597,8 @@ bool MeshRemoveNeedles::Fixup()
             ce._removeFacets.push_back(neighbour);
         }
 
-        std::set<FacetIndex> vf = vf_it[ce._fromPoint];
+        MeshIndexRange range = vf_it[ce._fromPoint];
+        std::set<FacetIndex> vf(range.begin(), range.end());
         vf.erase(faceedge.first);
         if (neighbour != FACET_INDEX_MAX) {
             vf.erase(neighbour);
@@ -831,9 +832,9 @@ bool MeshFixMergeFacets::Fixup()
         if (vv_it[i].size() == 3 && vf_it[i].size() == 3) {
             VertexCollapse vc;
             vc._point = i;
-            const std::set<PointIndex>& adjPts = vv_it[i];
+            MeshIndexRange adjPts = vv_it[i];
             vc._circumPoints.insert(vc._circumPoints.begin(), adjPts.begin(), adjPts.end());
-            const std::set<FacetIndex>& adjFts = vf_it[i];
+            MeshIndexRange adjFts = vf_it[i];
             vc._circumFacets.insert(vc._circumFacets.begin(), adjFts.begin(), adjFts.end());
             topAlg.CollapseVertex(vc);
         }
@@ -861,7 +862,7 @@ bool MeshEvalDentsOnSurface::Evaluate()
 
         // get the local neighbourhood of the point
         std::set<PointIndex> nb = clPt2Facets.NeighbourPoints(point, 1);
-        const std::set<FacetIndex>& faces = clPt2Facets[index];
+        MeshIndexRange faces = clPt2Facets[index];
 
         for (PointIndex pt : nb) {
             const MeshPoint& mp = rPntAry[pt];
@@ -879,7 +880,7 @@ bool MeshEvalDentsOnSurface::Evaluate()
                 // is the point projectable onto the facet?
                 rTriangle = _rclMesh.GetFacet(f_beg[ft]);
                 if (rTriangle.IntersectWithLine(mp, rTriangle.GetNormal(), tmp)) {
-                    const std::set<FacetIndex>& f = clPt2Facets[pt];
+                    MeshIndexRange f = clPt2Facets[pt];
                     this->indices.insert(this->indices.end(), f.begin(), f.end());
                     break;
                 }
@@ -484,8 +484,8 @@ bool MeshEvalPointManifolds::Evaluate()
     unsigned long ctPoints = _rclMesh.CountPoints();
     for (PointIndex index = 0; index < ctPoints; index++) {
         // get the local neighbourhood of the point
-        const std::set<FacetIndex>& nf = vf_it[index];
-        const std::set<PointIndex>& np = vv_it[index];
+        MeshIndexRange nf = vf_it[index];
+        MeshIndexRange np = vv_it[index];
 
         std::set<unsigned long>::size_type sp {}, sf {};
         sp = np.size();
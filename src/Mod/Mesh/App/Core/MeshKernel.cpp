@@ -901,18 +901,24 @@ void MeshKernel::Write(std::ostream& rclOut) const
     // write the number of points and facets
     str << static_cast<uint32_t>(CountPoints()) << static_cast<uint32_t>(CountFacets());
 
-    // write the data
-    for (const auto& it : _aclPointArray) {
-        str << it.x << it.y << it.z;
-    }
-
-    for (const auto& it : _aclFacetArray) {
-        str << static_cast<uint32_t>(it._aulPoints[0]) << static_cast<uint32_t>(it._aulPoints[1])
-            << static_cast<uint32_t>(it._aulPoints[2]);
-        str << static_cast<uint32_t>(it._aulNeighbours[0])
-            << static_cast<uint32_t>(it._aulNeighbours[1])
-            << static_cast<uint32_t>(it._aulNeighbours[2]);
-    }
+    // write the data as contiguous arrays
+    auto appendPoint = [](std::vector<float>& block, const MeshPoint& pnt) {
+        block.insert(block.end(), {pnt.x, pnt.y, pnt.z});
+    };
+    str.writeBlocks<float>(_aclPointArray.begin(), _aclPointArray.end(), appendPoint);
+
+    auto appendFacet = [](std::vector<uint32_t>& block, const MeshFacet& face) {
+        block.insert(
+            block.end(),
+            {static_cast<uint32_t>(face._aulPoints[0]),
+             static_cast<uint32_t>(face._aulPoints[1]),
+             static_cast<uint32_t>(face._aulPoints[2]),
+             static_cast<uint32_t>(face._aulNeighbours[0]),
+             static_cast<uint32_t>(face._aulNeighbours[1]),
+             static_cast<uint32_t>(face._aulNeighbours[2])}
+        );
+    };
+    str.writeBlocks<uint32_t>(_aclFacetArray.begin(), _aclFacetArray.end(), appendFacet);
 
     str << _clBoundBox.MinX << _clBoundBox.MaxX;
     str << _clBoundBox.MinY << _clBoundBox.MaxY;
@@ -959,16 +965,19 @@ void MeshKernel::Read(std::istream& rclIn)
             // read the data
             MeshPointArray pointArray;
             pointArray.resize(uCtPts);
-            for (auto& it : pointArray) {
-                str >> it.x >> it.y >> it.z;
-            }
+            auto assignPoint = [&pointArray](std::size_t index, const float* data) {
+                pointArray[index].Set(data[0], data[1], data[2]);
+            };
+            str.readBlocks<float>(pointArray.size(), 3, assignPoint);
 
             MeshFacetArray facetArray;
             facetArray.resize(uCtFts);
 
-            uint32_t v1 {}, v2 {}, v3 {};
-            for (auto& it : facetArray) {
-                str >> v1 >> v2 >> v3;
+            auto assignFacet = [&](std::size_t index, const uint32_t* data) {
+                MeshFacet& it = facetArray[index];
+                uint32_t v1 = data[0];
+                uint32_t v2 = data[1];
+                uint32_t v3 = data[2];
 
                 // make sure to have valid indices
                 if (v1 >= uCtPts || v2 >= uCtPts || v3 >= uCtPts) {
@@ -983,7 +992,9 @@ void MeshKernel::Read(std::istream& rclIn)
                 // the empty neighbour must be explicitly set to 'FACET_INDEX_MAX'
                 // because in algorithms this value is always used to check
                 // for open edges.
-                str >> v1 >> v2 >> v3;
+                v1 = data[3];
+                v2 = data[4];
+                v3 = data[5];
 
                 // make sure to have valid indices
                 if (v1 >= uCtFts && v1 < open_edge) {
@@ -1016,7 +1027,8 @@ void MeshKernel::Read(std::istream& rclIn)
                 else {
                     it._aulNeighbours[2] = FACET_INDEX_MAX;
                 }
-            }
+            };
+            str.readBlocks<uint32_t>(facetArray.size(), 6, assignFacet);
 
             str >> _clBoundBox.MinX >> _clBoundBox.MaxX;
             str >> _clBoundBox.MinY >> _clBoundBox.MaxY;
@@ -23,12 +23,17 @@
  ***************************************************************************/
 
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <fstream>
 #include <ios>
 
+#include <QtConcurrentMap>
 
 #include <Base/Builder3D.h>
 #include <Base/Sequencer.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Query3Filtered.h>
 
 #include "Algorithm.h"
 #include "Builder.h"
@@ -44,6 +49,57 @@
 using namespace Base;
 using namespace MeshCore;
 
+namespace
+{
+// Intersection of a facet of each mesh. If both points are equal the facets only touch.
+struct FacetCut
+{
+    FacetIndex facet0;
+    FacetIndex facet1;
+    MeshPoint pt0;
+    MeshPoint pt1;
+};
+
+// Replaces the points of a cut line by a corner of the facet if it's closer than the current
+// minimum distance
+void snapToCorners(
+    const MeshGeomFacet& facet,
+    const Base::Vector3f& p0,
+    const Base::Vector3f& p1,
+    float& minDist0,
+    float& minDist1,
+    MeshPoint& np0,
+    MeshPoint& np1
+)
+{
+    for (const auto& corner : facet._aclPoints) {
+        float d0 = (corner - p0).Length();
+        float d1 = (corner - p1).Length();
+        if (d0 < minDist0) {
+            minDist0 = d0;
+            np0 = corner;
+        }
+        if (d1 < minDist1) {
+            minDist1 = d1;
+            np1 = corner;
+        }
+    }
+}
+
+// Returns the side of the point relative to the plane of the facet. Close to the plane the
+// sign is computed with exact rational arithmetic.
+int orientation(const MeshGeomFacet& facet, const Base::Vector3f& pnt)
+{
+    std::array<Wm4::Vector3d, 3> corners;
+    for (std::size_t i = 0; i < corners.size(); i++) {
+        const Base::Vector3f& corner = facet._aclPoints[i];
+        corners[i] = Wm4::Vector3d(corner.x, corner.y, corner.z);
+    }
+
+    Wm4::Query3Filteredd query(static_cast<int>(corners.size()), corners.data(), 0.1);
+    return query.ToPlane(Wm4::Vector3d(pnt.x, pnt.y, pnt.z), 0, 1, 2);
+}
+}  // namespace
 
 SetOperations::SetOperations(
     const MeshKernel& cutMesh1,
@@ -165,6 +221,8 @@ void SetOperations::Do()
         facets.push_back(*itf);
     }
 
+    // MeshBuilder merges points within MeshDefinitions::_fMinPointDistanceD1, which closes
+    // the tiny gaps along the cut lines
     _resultMesh = facets;
 
     // Base::Sequencer().stop();
@@ -175,239 +233,126 @@ void SetOperations::Do()
 
 void SetOperations::Cut(std::set<FacetIndex>& facetsCuttingEdge0, std::set<FacetIndex>& facetsCuttingEdge1)
 {
-    MeshFacetGrid grid1(_cutMesh0, 20);
-    MeshFacetGrid grid2(_cutMesh1, 20);
-
-    unsigned long ctGx1 {}, ctGy1 {}, ctGz1 {};
-    grid1.GetCtGrids(ctGx1, ctGy1, ctGz1);
-
-    for (auto gx1 = 0UL; gx1 < ctGx1; gx1++) {
-        for (auto gy1 = 0UL; gy1 < ctGy1; gy1++) {
-            for (auto gz1 = 0UL; gz1 < ctGz1; gz1++) {
-                if (grid1.GetCtElements(gx1, gy1, gz1) > 0) {
-                    std::vector<FacetIndex> vecFacets2;
-                    grid2.Inside(grid1.GetBoundBox(gx1, gy1, gz1), vecFacets2);
-
-                    if (!vecFacets2.empty()) {
-                        std::set<FacetIndex> vecFacets1;
-                        grid1.GetElements(gx1, gy1, gz1, vecFacets1);
-
-                        std::set<FacetIndex>::iterator it1;
-                        for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1) {
-                            FacetIndex fidx1 = *it1;
-                            MeshGeomFacet f1 = _cutMesh0.GetFacet(*it1);
-
-                            std::vector<FacetIndex>::iterator it2;
-                            for (it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2) {
-                                FacetIndex fidx2 = *it2;
-                                MeshGeomFacet f2 = _cutMesh1.GetFacet(fidx2);
-
-                                MeshPoint p0, p1;
-
-                                int isect = f1.IntersectWithFacet(f2, p0, p1);
-                                if (isect > 0) {
-                                    // optimize cut line if distance to nearest point is too small
-                                    float minDist1 = _minDistanceToPoint,
-                                          minDist2 = _minDistanceToPoint;
-                                    MeshPoint np0 = p0, np1 = p1;
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f1._aclPoints[i] - p0).Length();
-                                        float d2 = (f1._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f1._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            p1 = f1._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    // optimize cut line if distance to nearest point is too small
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f2._aclPoints[i] - p0).Length();
-                                        float d2 = (f2._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f2._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            np1 = f2._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    MeshPoint mp0 = np0;
-                                    MeshPoint mp1 = np1;
-
-                                    if (mp0 != mp1) {
-                                        facetsCuttingEdge0.insert(fidx1);
-                                        facetsCuttingEdge1.insert(fidx2);
-
-                                        _cutPoints.insert(mp0);
-                                        _cutPoints.insert(mp1);
-
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit0
-                                            = _cutPoints.insert(mp0);
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit1
-                                            = _cutPoints.insert(mp1);
-
-                                        _edges[Edge(mp0, mp1)] = EdgeInfo();
-
-                                        _facet2points[0][fidx1].push_back(pit0.first);
-                                        _facet2points[0][fidx1].push_back(pit1.first);
-                                        _facet2points[1][fidx2].push_back(pit0.first);
-                                        _facet2points[1][fidx2].push_back(pit1.first);
-                                    }
-                                    else {
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit
-                                            = _cutPoints.insert(mp0);
-
-                                        // do not insert a facet when only one corner point cuts the
-                                        // edge if (!((mp0 == f1._aclPoints[0]) || (mp0 ==
-                                        // f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge0.insert(fidx1);
-                                            _facet2points[0][fidx1].push_back(pit.first);
-                                        }
-
-                                        // if (!((mp0 == f2._aclPoints[0]) || (mp0 ==
-                                        // f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge1.insert(fidx2);
-                                            _facet2points[1][fidx2].push_back(pit.first);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+    // For each facet of the first mesh the facets of the second mesh are looked up by its
+    // bounding box. So, each pair of facets is tested only once.
+    std::size_t numFacets = _cutMesh1.CountFacets();
+    int gridsPerAxis = std::clamp(
+        static_cast<int>(std::cbrt(static_cast<double>(numFacets)) / 2.0),
+        MESH_CT_GRID_PER_AXIS,
+        100
+    );
+    MeshFacetGrid grid(_cutMesh1, gridsPerAxis);
+    Base::BoundBox3f bbox1 = _cutMesh1.GetBoundBox();
+
+    // The facets are intersected in parallel. The cuts are added afterwards in the order of
+    // the facets, so that the result doesn't depend on the number of threads.
+    struct Block
+    {
+        FacetIndex first;
+        FacetIndex last;
+        std::vector<FacetCut> cuts;
+    };
+
+    std::vector<Block> blocks;
+    const FacetIndex blockSize = 1024;
+    FacetIndex count = _cutMesh0.CountFacets();
+    for (FacetIndex first = 0; first < count; first += blockSize) {
+        blocks.push_back({first, std::min(count, first + blockSize), {}});
     }
-}
-
-void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
-{
-    // Triangulate Mesh
-    std::map<FacetIndex, std::list<std::set<MeshPoint>::iterator>>::iterator it1;
-    for (it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1) {
-        std::vector<Vector3f> points;
-        std::set<MeshPoint> pointsSet;
 
-        FacetIndex fidx = it1->first;
-        MeshGeomFacet f = cutMesh.GetFacet(fidx);
+    QtConcurrent::blockingMap(blocks, [&](Block& block) {
+        std::vector<FacetIndex> candidates;
+        for (FacetIndex fidx1 = block.first; fidx1 < block.last; fidx1++) {
+            MeshGeomFacet f1 = _cutMesh0.GetFacet(fidx1);
+            Base::BoundBox3f box = f1.GetBoundBox();
+            box.Enlarge(std::max(_minDistanceToPoint, 0.001F * box.CalcDiagonalLength()));
+            if (!(box && bbox1)) {
+                continue;
+            }
 
-        // if (side == 1)
-        //     _builder.addSingleTriangle(f._aclPoints[0], f._aclPoints[1], f._aclPoints[2], 3, 0,
-        //     1, 1);
-
-        // facet corner points
-        // const MeshFacet& mf = cutMesh._aclFacetArray[fidx];
-        for (int i = 0; i < 3; i++)  // NOLINT
-        {
-            pointsSet.insert(f._aclPoints[i]);
-            points.push_back(f._aclPoints[i]);
-        }
+            grid.Inside(box, candidates);
+            for (FacetIndex fidx2 : candidates) {
+                MeshGeomFacet f2 = _cutMesh1.GetFacet(fidx2);
+                if (!(box && f2.GetBoundBox())) {
+                    continue;
+                }
 
-        // triangulated facets
-        std::list<std::set<MeshPoint>::iterator>::iterator it2;
-        for (it2 = it1->second.begin(); it2 != it1->second.end(); ++it2) {
-            if (pointsSet.find(*(*it2)) == pointsSet.end()) {
-                pointsSet.insert(*(*it2));
-                points.push_back(*(*it2));
+                MeshPoint p0, p1;
+                if (f1.IntersectWithFacet(f2, p0, p1) > 0) {
+                    // optimize cut line if distance to nearest point is too small
+                    float minDist0 = _minDistanceToPoint;
+                    float minDist1 = _minDistanceToPoint;
+                    MeshPoint np0 = p0, np1 = p1;
+                    snapToCorners(f1, p0, p1, minDist0, minDist1, np0, np1);
+                    snapToCorners(f2, p0, p1, minDist0, minDist1, np0, np1);
+                    block.cuts.push_back({fidx1, fidx2, np0, np1});
+                }
             }
         }
+    });
 
-        Vector3f normal = f.GetNormal();
-        Vector3f base = points[0];
-        Vector3f dirX = points[1] - points[0];
-        dirX.Normalize();
-        Vector3f dirY = dirX % normal;
-
-        // project points to 2D plane
-        std::vector<Vector3f>::iterator it;
-        std::vector<Vector3f> vertices;
-        for (it = points.begin(); it != points.end(); ++it) {
-            Vector3f pv = *it;
-            pv.TransformToCoordinateSystem(base, dirX, dirY);
-            vertices.push_back(pv);
-        }
+    for (const auto& block : blocks) {
+        for (const auto& cut : block.cuts) {
+            const MeshPoint& mp0 = cut.pt0;
+            const MeshPoint& mp1 = cut.pt1;
 
-        DelaunayTriangulator tria;
-        tria.SetPolygon(vertices);
-        tria.TriangulatePolygon();
+            if (mp0 != mp1) {
+                facetsCuttingEdge0.insert(cut.facet0);
+                facetsCuttingEdge1.insert(cut.facet1);
 
-        std::vector<MeshFacet> facets = tria.GetFacets();
-        for (auto& it : facets) {
-            if ((it._aulPoints[0] == it._aulPoints[1]) || (it._aulPoints[1] == it._aulPoints[2])
-                || (it._aulPoints[2] == it._aulPoints[0])) {  // two same triangle corner points
-                continue;
-            }
+                std::pair<std::set<MeshPoint>::iterator, bool> pit0 = _cutPoints.insert(mp0);
+                std::pair<std::set<MeshPoint>::iterator, bool> pit1 = _cutPoints.insert(mp1);
 
-            MeshGeomFacet facet(
-                points[it._aulPoints[0]],
-                points[it._aulPoints[1]],
-                points[it._aulPoints[2]]
-            );
-
-            // if (side == 1)
-            //  _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1],
-            //  facet._aclPoints[2], true, 3, 0, 1, 1);
-
-            // if (facet.Area() < 0.0001f)
-            //{ // too small facet
-            //   continue;
-            // }
-
-            float dist0 = facet._aclPoints[0].DistanceToLine(
-                facet._aclPoints[1],
-                facet._aclPoints[1] - facet._aclPoints[2]
-            );
-            float dist1 = facet._aclPoints[1].DistanceToLine(
-                facet._aclPoints[0],
-                facet._aclPoints[0] - facet._aclPoints[2]
-            );
-            float dist2 = facet._aclPoints[2].DistanceToLine(
-                facet._aclPoints[0],
-                facet._aclPoints[0] - facet._aclPoints[1]
-            );
-
-            if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint)
-                || (dist2 < _minDistanceToPoint)) {
-                continue;
-            }
+                _edges[Edge(mp0, mp1)] = EdgeInfo();
 
-            // dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
-            // dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
-            // dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
+                _facet2points[0][cut.facet0].push_back(pit0.first);
+                _facet2points[0][cut.facet0].push_back(pit1.first);
+                _facet2points[1][cut.facet1].push_back(pit0.first);
+                _facet2points[1][cut.facet1].push_back(pit1.first);
+            }
+            else {
+                std::pair<std::set<MeshPoint>::iterator, bool> pit = _cutPoints.insert(mp0);
 
-            // if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 <
-            // _minDistanceToPoint))
-            //{
-            //   continue;
-            // }
+                facetsCuttingEdge0.insert(cut.facet0);
+                _facet2points[0][cut.facet0].push_back(pit.first);
 
-            facet.CalcNormal();
-            if ((facet.GetNormal() * f.GetNormal()) < 0.0F) {  // adjust normal
-                std::swap(facet._aclPoints[0], facet._aclPoints[1]);
-                facet.CalcNormal();
+                facetsCuttingEdge1.insert(cut.facet1);
+                _facet2points[1][cut.facet1].push_back(pit.first);
             }
+        }
+    }
+}
+
+void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
+{
+    // The facets are triangulated in parallel and then connected to the cut edges
+    using CutPoints = std::list<std::set<MeshPoint>::iterator>;
+    struct CutFacet
+    {
+        FacetIndex index;
+        const CutPoints* points;
+        std::vector<MeshGeomFacet> facets;
+    };
+
+    std::vector<CutFacet> cutFacets;
+    cutFacets.reserve(_facet2points[side].size());
+    for (const auto& it : _facet2points[side]) {
+        cutFacets.push_back({it.first, &it.second, {}});
+    }
 
+    QtConcurrent::blockingMap(cutFacets, [this, &cutMesh](CutFacet& cutFacet) {
+        cutFacet.facets = TriangulateFacet(cutMesh.GetFacet(cutFacet.index), *cutFacet.points);
+    });
 
+    for (auto& cutFacet : cutFacets) {
+        FacetIndex fidx = cutFacet.index;
+        for (auto& facet : cutFacet.facets) {
             for (int j = 0; j < 3; j++) {
                 auto eit = _edges.find(Edge(facet._aclPoints[j], facet._aclPoints[(j + 1) % 3]));
 
                 if (eit != _edges.end()) {
 
                     if (eit->second.fcounter[side] < 2) {
-                        // if (side == 0)
-                        //    _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1],
-                        //    facet._aclPoints[2], true, 3, 0, 1, 1);
-
                         eit->second.facet[side] = fidx;
                         eit->second.facets[side][eit->second.fcounter[side]] = facet;
                         eit->second.fcounter[side]++;
@@ -421,6 +366,111 @@ void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
     }
 }
 
+std::vector<MeshGeomFacet> SetOperations::TriangulateFacet(
+    const MeshGeomFacet& f,
+    const std::list<std::set<MeshPoint>::iterator>& cutPoints
+) const
+{
+    std::vector<Vector3f> points;
+    std::set<MeshPoint> pointsSet;
+
+    // facet corner points
+    for (int i = 0; i < 3; i++)  // NOLINT
+    {
+        pointsSet.insert(f._aclPoints[i]);
+        points.push_back(f._aclPoints[i]);
+    }
+
+    // triangulated facets
+    for (const auto& it : cutPoints) {
+        if (pointsSet.find(*it) == pointsSet.end()) {
+            pointsSet.insert(*it);
+            points.push_back(*it);
+        }
+    }
+
+    Vector3f normal = f.GetNormal();
+    Vector3f base = points[0];
+    Vector3f dirX = points[1] - points[0];
+    dirX.Normalize();
+    Vector3f dirY = dirX % normal;
+
+    // project points to 2D plane
+    std::vector<Vector3f>::iterator it;
+    std::vector<Vector3f> vertices;
+    for (it = points.begin(); it != points.end(); ++it) {
+        Vector3f pv = *it;
+        pv.TransformToCoordinateSystem(base, dirX, dirY);
+        vertices.push_back(pv);
+    }
+
+    DelaunayTriangulator tria;
+    tria.SetPolygon(vertices);
+    tria.TriangulatePolygon();
+
+    std::vector<MeshGeomFacet> result;
+    std::vector<MeshFacet> facets = tria.GetFacets();
+    for (auto& it : facets) {
+        if ((it._aulPoints[0] == it._aulPoints[1]) || (it._aulPoints[1] == it._aulPoints[2])
+            || (it._aulPoints[2] == it._aulPoints[0])) {  // two same triangle corner points
+            continue;
+        }
+
+        MeshGeomFacet facet(
+            points[it._aulPoints[0]],
+            points[it._aulPoints[1]],
+            points[it._aulPoints[2]]
+        );
+
+        // if (side == 1)
+        //  _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1],
+        //  facet._aclPoints[2], true, 3, 0, 1, 1);
+
+        // if (facet.Area() < 0.0001f)
+        //{ // too small facet
+        //   continue;
+        // }
+
+        float dist0 = facet._aclPoints[0].DistanceToLine(
+            facet._aclPoints[1],
+            facet._aclPoints[1] - facet._aclPoints[2]
+        );
+        float dist1 = facet._aclPoints[1].DistanceToLine(
+            facet._aclPoints[0],
+            facet._aclPoints[0] - facet._aclPoints[2]
+        );
+        float dist2 = facet._aclPoints[2].DistanceToLine(
+            facet._aclPoints[0],
+            facet._aclPoints[0] - facet._aclPoints[1]
+        );
+
+        if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint)
+            || (dist2 < _minDistanceToPoint)) {
+            continue;
+        }
+
+        // dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
+        // dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
+        // dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
+
+        // if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 <
+        // _minDistanceToPoint))
+        //{
+        //   continue;
+        // }
+
+        facet.CalcNormal();
+        if ((facet.GetNormal() * f.GetNormal()) < 0.0F) {  // adjust normal
+            std::swap(facet._aclPoints[0], facet._aclPoints[1]);
+            facet.CalcNormal();
+        }
+
+        result.push_back(facet);
+    }
+
+    return result;
+}
+
 void SetOperations::CollectFacets(int side, float mult)
 {
     // float distSave = MeshDefinitions::_fMinPointDistance;
@@ -429,14 +479,8 @@ void SetOperations::CollectFacets(int side, float mult)
     MeshKernel mesh;
     MeshBuilder mb(mesh);
     mb.Initialize(_newMeshFacets[side].size());
-    std::vector<MeshGeomFacet>::iterator it;
-    for (it = _newMeshFacets[side].begin(); it != _newMeshFacets[side].end(); ++it) {
-        // if (it->IsFlag(MeshFacet::MARKED))
-        //{
-        //   _builder.addSingleTriangle(it->_aclPoints[0], it->_aclPoints[1], it->_aclPoints[2],
-        //   true, 3.0, 0.0, 1.0, 1.0);
-        // }
-        mb.AddFacet(*it, true);
+    for (const auto& it : _newMeshFacets[side]) {
+        mb.AddFacet(it, true);
     }
     mb.Finish();
 
@@ -526,20 +570,22 @@ bool SetOperations::CollectFacetVisitor::AllowVisit(
                 MeshGeomFacet facetOther = it->second.facets[1 - _side][0];  // triangulated facet
                                                                              // from same edge and
                                                                              // other mesh
-                Vector3f normalOther = facetOther.GetNormal();
-                // Vector3f normal = facet.GetNormal();
 
+                // The corner of the facet opposite to the edge must be on the requested side
+                // of the other facet
                 Vector3f edgeDir = it->first.pt1 - it->first.pt2;
-                Vector3f ocDir = (edgeDir % (facet.GetGravityPoint() - it->first.pt1)) % edgeDir;
-                ocDir.Normalize();
-                Vector3f ocDirOther = (edgeDir % (facetOther.GetGravityPoint() - it->first.pt1))
-                    % edgeDir;
-                ocDirOther.Normalize();
-
-                // Vector3f dir = ocDir % normal;
-                // Vector3f dirOther = ocDirOther % normalOther;
+                Vector3f corner = facet._aclPoints[0];
+                float maxDist = 0.0F;
+                for (const auto& pnt : facet._aclPoints) {
+                    float dist = pnt.DistanceToLine(it->first.pt1, edgeDir);
+                    if (dist > maxDist) {
+                        maxDist = dist;
+                        corner = pnt;
+                    }
+                }
 
-                bool match = ((ocDir * normalOther) * _mult) < 0.0F;
+                int side = orientation(facetOther, corner);
+                bool match = (static_cast<float>(side) * _mult) < 0.0F;
 
                 // if (matchCounter == 1)
                 //{
@@ -22,8 +22,10 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <cmath>
 
+#include <QtConcurrentMap>
 
 #include <Base/Tools.h>
 
@@ -49,90 +51,117 @@ void AbstractSmoothing::initialize(Component comp, Continuity cont)
     this->continuity = cont;
 }
 
-PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
-    : AbstractSmoothing(m)
-{}
-
-void PlaneFitSmoothing::Smooth(unsigned int iterations)
+namespace
+{
+// Point coordinates stored as separate arrays. The smoothing loops read the coordinates of
+// the neighbours from contiguous memory.
+struct PointCoords
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
+    std::vector<float> x, y, z;
+
+    explicit PointCoords(const MeshPointArray& points)
+    {
+        x.reserve(points.size());
+        y.reserve(points.size());
+        z.reserve(points.size());
+        for (const auto& pnt : points) {
+            x.push_back(pnt.x);
+            y.push_back(pnt.y);
+            z.push_back(pnt.z);
+        }
+    }
 
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+    Base::Vector3f Get(PointIndex pos) const
+    {
+        return Base::Vector3f(x[pos], y[pos], z[pos]);
+    }
 
-    for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (v_it.Begin(); v_it.More(); v_it.Next()) {
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3) {
-                continue;
-            }
+    void Set(PointIndex pos, const Base::Vector3f& pnt)
+    {
+        x[pos] = pnt.x;
+        y[pos] = pnt.y;
+        z[pos] = pnt.z;
+    }
+};
 
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
+// Calls func(i) for each i in [0, count) on several threads. func must only write data
+// that belongs to index i.
+template<typename Func>
+void parallelFor(std::size_t count, const Func& func)
+{
+    const std::size_t blockSize = 0x1000;
+    std::vector<std::pair<std::size_t, std::size_t>> blocks;
+    for (std::size_t start = 0; start < count; start += blockSize) {
+        blocks.emplace_back(start, std::min(count, start + blockSize));
+    }
 
-            float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
-            center.Scale(scale, scale, scale);
+    QtConcurrent::blockingMap(blocks, [&func](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++) {
+            func(i);
+        }
+    });
+}
 
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
+// Returns the sorted indices without duplicates of the points that can be moved
+template<typename Pred>
+std::vector<PointIndex> filterPoints(const std::vector<PointIndex>& point_indices, Pred&& pred)
+{
+    std::vector<PointIndex> moved;
+    moved.reserve(point_indices.size());
+    for (PointIndex pos : point_indices) {
+        if (pred(pos)) {
+            moved.push_back(pos);
+        }
+    }
 
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N * L < 0.0F) {
-                N.Scale(-1.0, -1.0, -1.0);
-            }
+    std::sort(moved.begin(), moved.end());
+    moved.erase(std::unique(moved.begin(), moved.end()), moved.end());
+    return moved;
+}
 
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(std::fabs(this->maximum), fabs(N * L));
-            N.Scale(d, d, d);
+std::vector<PointIndex> allPoints(const MeshKernel& kernel)
+{
+    std::vector<PointIndex> point_indices(kernel.CountPoints());
+    std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<PointIndex>(0));
+    return point_indices;
+}
+}  // namespace
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
+PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
+    : AbstractSmoothing(m)
+{}
 
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
-    }
+void PlaneFitSmoothing::Smooth(unsigned int iterations)
+{
+    SmoothPoints(iterations, allPoints(kernel));
 }
 
 void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
     MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+    std::vector<PointIndex> moved = filterPoints(point_indices, [&vv_it](PointIndex pos) {
+        return vv_it[pos].size() >= 3;
+    });
+
+    // All points of an iteration are computed from the result of the previous iteration.
+    // So, they can be computed in parallel and don't depend on the order of the points.
+    PointCoords src(kernel.GetPoints());
+    PointCoords dst(src);
+    float maxMove = std::fabs(this->maximum);
 
     for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (PointIndex it : point_indices) {
-            v_it.Set(it);
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3) {
-                continue;
-            }
+        parallelFor(moved.size(), [&](std::size_t index) {
+            PointIndex pos = moved[index];
+            Base::Vector3f pnt = src.Get(pos);
+            MeshIndexRange cv = vv_it[pos];
 
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
+            MeshCore::PlaneFit pf;
+            pf.AddPoint(pnt);
+            Base::Vector3f center = pnt;
+            for (PointIndex nb : cv) {
+                Base::Vector3f neighbour = src.Get(nb);
+                pf.AddPoint(neighbour);
+                center += neighbour;
             }
 
             float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
@@ -140,27 +169,27 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<
 
             // get the mean plane of the current vertex with the surrounding vertices
             pf.Fit();
-            N = pf.GetNormal();
+            Base::Vector3f N = pf.GetNormal();
             N.Normalize();
 
             // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
+            Base::Vector3f L = pnt - center;
             if (N * L < 0.0F) {
                 N.Scale(-1.0, -1.0, -1.0);
             }
 
             // maximum value to move is distance to mean plane
-            float d = std::min<float>(std::fabs(this->maximum), fabs(N * L));
+            float d = std::min<float>(maxMove, std::fabs(N * L));
             N.Scale(d, d, d);
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
+            dst.Set(pos, pnt - N);
+        });
 
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
+        std::swap(src, dst);
+    }
+
+    for (PointIndex pos : moved) {
+        kernel.SetPoint(pos, src.Get(pos));
     }
 }
 
@@ -169,101 +198,64 @@ LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
 {}
 
 void LaplaceSmoothing::Umbrella(
-    const MeshRefPointToPoints& vv_it,
-    const MeshRefPointToFacets& vf_it,
-    double stepsize
+    unsigned int iterations,
+    const std::vector<double>& stepsizes,
+    const std::vector<PointIndex>& point_indices
 )
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it, v_beg = points.begin(), v_end = points.end();
-
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it, ++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
-
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - v_it->x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - v_it->y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - v_it->z);
-        }
+    MeshCore::MeshRefPointToPoints vv_it(kernel);
+    MeshCore::MeshRefPointToFacets vf_it(kernel);
 
-        float x = static_cast<float>(static_cast<double>(v_it->x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z) + stepsize * delz);
-        kernel.SetPoint(pos, x, y, z);
-    }
-}
+    // do nothing for border points
+    std::vector<PointIndex> moved = filterPoints(point_indices, [&](PointIndex pos) {
+        std::size_t n_count = vv_it[pos].size();
+        return n_count >= 3 && n_count == vf_it[pos].size();
+    });
 
-void LaplaceSmoothing::Umbrella(
-    const MeshRefPointToPoints& vv_it,
-    const MeshRefPointToFacets& vf_it,
-    double stepsize,
-    const std::vector<PointIndex>& point_indices
-)
-{
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
+    // Each step computes the new coordinates only from the coordinates of the previous
+    // step, so that the points can be moved in parallel
+    PointCoords src(kernel.GetPoints());
+    PointCoords dst(src);
 
-    for (PointIndex it : point_indices) {
-        const std::set<PointIndex>& cv = vv_it[it];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[it].size()) {
-            // do nothing for border points
-            continue;
-        }
+    for (unsigned int i = 0; i < iterations; i++) {
+        for (double stepsize : stepsizes) {
+            parallelFor(moved.size(), [&](std::size_t index) {
+                PointIndex pos = moved[index];
+                MeshIndexRange cv = vv_it[pos];
+                double w = 1.0 / double(cv.size());
+
+                double px = src.x[pos];
+                double py = src.y[pos];
+                double pz = src.z[pos];
+                double delx = 0.0, dely = 0.0, delz = 0.0;
+                for (PointIndex nb : cv) {
+                    delx += static_cast<double>(src.x[nb]) - px;
+                    dely += static_cast<double>(src.y[nb]) - py;
+                    delz += static_cast<double>(src.z[nb]) - pz;
+                }
 
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
+                dst.x[pos] = static_cast<float>(px + stepsize * w * delx);
+                dst.y[pos] = static_cast<float>(py + stepsize * w * dely);
+                dst.z[pos] = static_cast<float>(pz + stepsize * w * delz);
+            });
 
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - (v_beg[it]).x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - (v_beg[it]).y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - (v_beg[it]).z);
+            std::swap(src, dst);
         }
+    }
 
-        float x = static_cast<float>(static_cast<double>((v_beg[it]).x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[it]).y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[it]).z) + stepsize * delz);
-        kernel.SetPoint(it, x, y, z);
+    for (PointIndex pos : moved) {
+        kernel.SetPoint(pos, src.x[pos], src.y[pos], src.z[pos]);
     }
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-    }
+    Umbrella(iterations, {lambda}, allPoints(kernel));
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-    }
+    Umbrella(iterations, {lambda}, point_indices);
 }
 
 TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
@@ -272,28 +264,14 @@ TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    // Theoretically Taubin does not shrink the surface
-    iterations = (iterations + 1) / 2;  // two steps per iteration
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda());
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro));
-    }
+    SmoothPoints(iterations, allPoints(kernel));
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda(), point_indices);
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro), point_indices);
-    }
+    Umbrella(iterations, {GetLambda(), -(GetLambda() + micro)}, point_indices);
 }
 
 namespace
@@ -369,7 +347,7 @@ void MedianFilterSmoothing::UpdatePoints(
     for (FacetIndex pos = 0; pos < facets.size(); pos++) {
         iter.Set(pos);
         Base::Vector3d refNormal = Base::toVector<double>(iter->GetNormal());
-        const std::set<FacetIndex>& cv = ff_it[pos];
+        MeshIndexRange cv = ff_it[pos];
         const MeshCore::MeshFacet& facet = facets[pos];
 
         std::vector<AngleNormal> anglesWithFaces;
@@ -398,7 +376,7 @@ void MedianFilterSmoothing::UpdatePoints(
     // Step 2: move vertices
     for (auto pos : point_indices) {
         Base::Vector3d P = Base::toVector<double>(points[pos]);
-        const std::set<FacetIndex>& cv = vf_it[pos];
+        MeshIndexRange cv = vf_it[pos];
 
         double totalArea = 0.0;
         Base::Vector3d totalvT;
@@ -109,12 +109,12 @@ public:
     }
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&, const MeshRefPointToFacets&, double);
+    /** Moves the given inner points \a iterations times by the umbrella operator. Each
+     * iteration makes one step for each entry of \a stepsizes. */
     void Umbrella(
-        const MeshRefPointToPoints&,
-        const MeshRefPointToFacets&,
-        double,
-        const std::vector<PointIndex>&
+        unsigned int iterations,
+        const std::vector<double>& stepsizes,
+        const std::vector<PointIndex>& point_indices
     );
 
 private:
@@ -86,7 +86,7 @@ unsigned long MeshSearchNeighbours::NeighboursFromFacet(
         std::set<PointIndex> aclTmp;
         aclTmp.swap(_aclOuter);
         for (PointIndex pI : aclTmp) {
-            const std::set<FacetIndex>& rclISet = _clPt2Fa[pI];
+            MeshIndexRange rclISet = _clPt2Fa[pI];
             // search all facets hanging on this point
             for (FacetIndex pJ : rclISet) {
                 const MeshFacet& rclF = f_beg[pJ];
@@ -187,7 +187,7 @@ unsigned long MeshSearchNeighbours::NeighboursFromSampledFacets(
         std::set<PointIndex> aclTmp;
         aclTmp.swap(_aclOuter);
         for (PointIndex pI : aclTmp) {
-            const std::set<FacetIndex>& rclISet = _clPt2Fa[pI];
+            MeshIndexRange rclISet = _clPt2Fa[pI];
             // search all facets hanging on this point
             for (FacetIndex pJ : rclISet) {
                 const MeshFacet& rclF = f_beg[pJ];
@@ -312,7 +312,7 @@ unsigned long MeshSearchNeighbours::NeighboursFacetFromFacet(
         std::set<PointIndex> aclTmp;
         aclTmp.swap(_aclOuter);
         for (PointIndex pI : aclTmp) {
-            const std::set<FacetIndex>& rclISet = _clPt2Fa[pI];
+            MeshIndexRange rclISet = _clPt2Fa[pI];
             // search all facets hanging on this point
             for (FacetIndex pJ : rclISet) {
                 const MeshFacet& rclF = f_beg[pJ];
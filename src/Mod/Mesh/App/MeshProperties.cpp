@@ -149,9 +149,10 @@ void PropertyNormalList::SaveDocFile(Base::Writer& writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (auto it : _lValueList) {
-        str << it.x << it.y << it.z;
-    }
+    auto append = [](std::vector<float>& block, const Base::Vector3f& vec) {
+        block.insert(block.end(), {vec.x, vec.y, vec.z});
+    };
+    str.writeBlocks<float>(_lValueList.begin(), _lValueList.end(), append);
 }
 
 void PropertyNormalList::RestoreDocFile(Base::Reader& reader)
@@ -160,9 +161,9 @@ void PropertyNormalList::RestoreDocFile(Base::Reader& reader)
     uint32_t uCt = 0;
     str >> uCt;
     std::vector<Base::Vector3f> values(uCt);
-    for (auto& it : values) {
-        str >> it.x >> it.y >> it.z;
-    }
+    str.readBlocks<float>(values.size(), 3, [&values](std::size_t index, const float* it) {
+        values[index].Set(it[0], it[1], it[2]);
+    });
     setValues(values);
 }
 
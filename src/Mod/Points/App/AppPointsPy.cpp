@@ -22,6 +22,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <memory>
 
 
@@ -34,6 +35,7 @@
 #include <Base/FileInfo.h>
 #include <Base/Interpreter.h>
 
+#include "PointTiles.h"
 #include "Points.h"
 #include "PointsAlgos.h"
 #include "PointsPy.h"
@@ -58,6 +60,19 @@ public:
             "show(points,[string]) -- Add the points to the active document or "
             "create one if no document exists.  Returns document object."
         );
+        add_varargs_method(
+            "buildTiles",
+            &Module::buildTiles,
+            "buildTiles(string,string,[int]) -- Convert a point cloud file into a tile file "
+            "that can be accessed without loading all points into memory.\n"
+            "The optional number is the maximum number of points per tile."
+        );
+        add_varargs_method(
+            "readTiles",
+            &Module::readTiles,
+            "readTiles(string,[int]) -- Read an evenly distributed sample of a tile file "
+            "with at most the given number of points.  Returns a points object."
+        );
         initialize("This module is the Points module.");  // register with Python
     }
 
@@ -75,6 +90,31 @@ private:
 
         return std::make_tuple(useColor, checkState, minDistance);
     }
+    std::unique_ptr<Reader> createReader(const Base::FileInfo& file) const
+    {
+        std::unique_ptr<Reader> reader;
+        if (file.hasExtension("asc")) {
+            reader = std::make_unique<AscReader>();
+        }
+        else if (file.hasExtension("e57")) {
+            auto setting = readE57Settings();
+            reader = std::make_unique<E57Reader>(
+                std::get<0>(setting),
+                std::get<1>(setting),
+                std::get<2>(setting)
+            );
+        }
+        else if (file.hasExtension("ply")) {
+            reader = std::make_unique<PlyReader>();
+        }
+        else if (file.hasExtension("pcd")) {
+            reader = std::make_unique<PcdReader>();
+        }
+        else {
+            throw Py::RuntimeError("Unsupported file extension");
+        }
+        return reader;
+    }
     Py::Object open(const Py::Tuple& args)
     {
         char* Name {};
@@ -93,27 +133,7 @@ private:
                 throw Py::RuntimeError("No file extension");
             }
 
-            std::unique_ptr<Reader> reader;
-            if (file.hasExtension("asc")) {
-                reader = std::make_unique<AscReader>();
-            }
-            else if (file.hasExtension("e57")) {
-                auto setting = readE57Settings();
-                reader = std::make_unique<E57Reader>(
-                    std::get<0>(setting),
-                    std::get<1>(setting),
-                    std::get<2>(setting)
-                );
-            }
-            else if (file.hasExtension("ply")) {
-                reader = std::make_unique<PlyReader>();
-            }
-            else if (file.hasExtension("pcd")) {
-                reader = std::make_unique<PcdReader>();
-            }
-            else {
-                throw Py::RuntimeError("Unsupported file extension");
-            }
+            std::unique_ptr<Reader> reader = createReader(file);
 
             reader->read(EncodedName);
 
@@ -220,27 +240,7 @@ private:
                 throw Py::RuntimeError("No file extension");
             }
 
-            std::unique_ptr<Reader> reader;
-            if (file.hasExtension("asc")) {
-                reader = std::make_unique<AscReader>();
-            }
-            else if (file.hasExtension("e57")) {
-                auto setting = readE57Settings();
-                reader = std::make_unique<E57Reader>(
-                    std::get<0>(setting),
-                    std::get<1>(setting),
-                    std::get<2>(setting)
-                );
-            }
-            else if (file.hasExtension("ply")) {
-                reader = std::make_unique<PlyReader>();
-            }
-            else if (file.hasExtension("pcd")) {
-                reader = std::make_unique<PcdReader>();
-            }
-            else {
-                throw Py::RuntimeError("Unsupported file extension");
-            }
+            std::unique_ptr<Reader> reader = createReader(file);
 
             reader->read(EncodedName);
 
@@ -417,6 +417,63 @@ private:
         return Py::None();
     }
 
+    Py::Object buildTiles(const Py::Tuple& args)
+    {
+        char* Name {};
+        char* TileName {};
+        int pointsPerTile = 1000000;
+        if (!PyArg_ParseTuple(
+                args.ptr(),
+                "etet|i",
+                "utf-8",
+                &Name,
+                "utf-8",
+                &TileName,
+                &pointsPerTile
+            )) {
+            throw Py::Exception();
+        }
+        std::string EncodedName = std::string(Name);
+        PyMem_Free(Name);
+        std::string EncodedTileName = std::string(TileName);
+        PyMem_Free(TileName);
+
+        try {
+            Base::FileInfo file(EncodedName.c_str());
+            std::unique_ptr<Reader> reader = createReader(file);
+            // the points are streamed without keeping them in memory
+            PointTilesWriter tiles(EncodedTileName, std::max(pointsPerTile, 1));
+            reader->readTiles(EncodedName, tiles);
+            tiles.finish();
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
+
+    Py::Object readTiles(const Py::Tuple& args)
+    {
+        char* Name {};
+        int maxPoints = 1000000;
+        if (!PyArg_ParseTuple(args.ptr(), "et|i", "utf-8", &Name, &maxPoints)) {
+            throw Py::Exception();
+        }
+        std::string EncodedName = std::string(Name);
+        PyMem_Free(Name);
+
+        try {
+            PointTiles tiles(EncodedName);
+            std::unique_ptr<PointKernel> kernel = std::make_unique<PointKernel>();
+            tiles.readSample(std::max(maxPoints, 0), *kernel);
+            return Py::asObject(new PointsPy(kernel.release()));
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+    }
+
     Py::Object show(const Py::Tuple& args)
     {
         PyObject* pcObj {};
@@ -0,0 +1,561 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <random>
+
+#include <Base/Exception.h>
+
+#include "PointTiles.h"
+
+
+using namespace Points;
+
+namespace
+{
+
+// Layout of a tile file:
+// FileHeader | TileEntry * numTiles | x,y,z as float * numPoints
+// Each tile is a consecutive range of points.
+constexpr std::array<char, 8> tileMagic {'F', 'C', 'P', 'T', 'I', 'L', 'E', 'S'};
+constexpr std::uint32_t tileVersion = 1;
+
+struct FileHeader
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::array<float, 6> box;
+    std::uint64_t numPoints;
+    std::uint64_t numTiles;
+};
+
+struct TileEntry
+{
+    std::array<float, 6> box;
+    std::uint64_t offset;
+    std::uint64_t count;
+};
+
+static_assert(sizeof(FileHeader) == 56, "Unexpected padding in tile file header");
+static_assert(sizeof(TileEntry) == 40, "Unexpected padding in tile entry");
+
+constexpr std::size_t pointSize = 3 * sizeof(float);
+
+// The points are counted on the finest level of the octree. Its cells are enumerated in
+// Morton order so that every octree node covers a consecutive range of cells.
+constexpr int octreeDepth = 7;
+constexpr std::uint32_t cellsPerAxis = 1U << octreeDepth;
+constexpr std::size_t numCells = std::size_t(1) << (3 * octreeDepth);
+
+std::array<float, 6> toArray(const Base::BoundBox3f& box)
+{
+    return {box.MinX, box.MinY, box.MinZ, box.MaxX, box.MaxY, box.MaxZ};
+}
+
+Base::BoundBox3f toBoundBox(const std::array<float, 6>& box)
+{
+    return Base::BoundBox3f(box[0], box[1], box[2], box[3], box[4], box[5]);
+}
+
+class CellIndex
+{
+public:
+    explicit CellIndex(const Base::BoundBox3f& box)
+        : min {box.MinX, box.MinY, box.MinZ}
+        , scale {toScale(box.LengthX()), toScale(box.LengthY()), toScale(box.LengthZ())}
+    {}
+
+    std::size_t operator()(const float* pnt) const
+    {
+        std::size_t index = 0;
+        for (int i = 0; i < 3; i++) {
+            index |= spreadBits(toCell(pnt[i], i)) << i;
+        }
+        return index;
+    }
+
+private:
+    static float toScale(float length)
+    {
+        return length > 0.0F ? float(cellsPerAxis) / length : 0.0F;
+    }
+
+    std::uint32_t toCell(float value, int axis) const
+    {
+        float cell = (value - min[axis]) * scale[axis];
+        // also maps NaN to the first cell, whose conversion is undefined
+        if (!(cell > 0.0F)) {
+            return 0;
+        }
+        return static_cast<std::uint32_t>(std::min(cell, float(cellsPerAxis - 1)));
+    }
+
+    static std::size_t spreadBits(std::uint32_t value)
+    {
+        std::size_t bits = 0;
+        for (int i = 0; i < octreeDepth; i++) {
+            bits |= std::size_t((value >> i) & 1U) << (3 * i);
+        }
+        return bits;
+    }
+
+private:
+    std::array<float, 3> min;
+    std::array<float, 3> scale;
+};
+
+struct CellRange
+{
+    std::size_t begin;
+    std::size_t end;
+};
+
+// Subdivides the octree node starting at cell 'begin' with 'size' cells until each node
+// holds at most 'limit' points. 'first' contains the prefix sums of the cell counts.
+void subdivide(
+    const std::vector<std::uint64_t>& first,
+    std::size_t begin,
+    std::size_t size,
+    std::uint64_t limit,
+    std::vector<CellRange>& ranges
+)
+{
+    std::uint64_t count = first[begin + size] - first[begin];
+    if (count == 0) {
+        return;
+    }
+    if (count <= limit || size == 1) {
+        ranges.push_back({begin, begin + size});
+        return;
+    }
+
+    std::size_t child = size / 8;
+    for (std::size_t i = 0; i < 8; i++) {
+        subdivide(first, begin + i * child, child, limit, ranges);
+    }
+}
+
+// Shuffles the first 'limit' points of a tile of 'count' points stored at 'pos' with a
+// partial Fisher-Yates shuffle, so that they are a uniform sample of the whole tile.
+// Only these points and the points swapped with them are kept in memory, which bounds
+// the memory consumption also for tiles that couldn't be subdivided further.
+void shuffleTile(
+    std::istream& inp,
+    std::ostream& out,
+    std::streamoff pos,
+    std::uint64_t count,
+    std::uint64_t limit,
+    std::mt19937& gen
+)
+{
+    std::uint64_t head = std::min(count, limit);
+    if (head < 2) {
+        return;
+    }
+
+    std::vector<std::array<float, 3>> points(head);
+    inp.seekg(pos);
+    inp.read(reinterpret_cast<char*>(points.data()), std::streamsize(head * pointSize));
+
+    // the swap partners don't depend on the data, so the points behind the shuffled
+    // head that are needed can be read at once in file order
+    std::vector<std::uint64_t> partners(head);
+    for (std::uint64_t i = 0; i < head; i++) {
+        std::uniform_int_distribution<std::uint64_t> dist(i, count - 1);
+        partners[i] = dist(gen);
+    }
+
+    std::vector<std::uint64_t> tailIndices;
+    for (std::uint64_t j : partners) {
+        if (j >= head) {
+            tailIndices.push_back(j);
+        }
+    }
+    std::ranges::sort(tailIndices);
+    auto [first, last] = std::ranges::unique(tailIndices);
+    tailIndices.erase(first, last);
+
+    std::vector<std::array<float, 3>> tail(tailIndices.size());
+    for (std::size_t k = 0; k < tailIndices.size(); k++) {
+        inp.seekg(pos + std::streamoff(tailIndices[k] * pointSize));
+        inp.read(reinterpret_cast<char*>(tail[k].data()), std::streamsize(pointSize));
+    }
+
+    auto pointAt = [&](std::uint64_t j) -> std::array<float, 3>& {
+        if (j < head) {
+            return points[j];
+        }
+        auto it = std::ranges::lower_bound(tailIndices, j);
+        return tail[std::size_t(it - tailIndices.begin())];
+    };
+    for (std::uint64_t i = 0; i < head; i++) {
+        std::swap(points[i], pointAt(partners[i]));
+    }
+
+    out.seekp(pos);
+    out.write(reinterpret_cast<const char*>(points.data()), std::streamsize(head * pointSize));
+    for (std::size_t k = 0; k < tailIndices.size(); k++) {
+        out.seekp(pos + std::streamoff(tailIndices[k] * pointSize));
+        out.write(reinterpret_cast<const char*>(tail[k].data()), std::streamsize(pointSize));
+    }
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+
+PointTilesWriter::PointTilesWriter(const std::string& fileName, std::size_t pointsPerTile)
+    : file(fileName)
+    , spillFile(fileName + ".part")
+    , spill(spillFile, std::ios::out | std::ios::binary | std::ios::trunc)
+    , pointsPerTile(std::max<std::size_t>(pointsPerTile, 1))
+{
+    if (!spill) {
+        throw Base::FileException("Cannot create temporary file", spillFile);
+    }
+    buffer.reserve(65536);
+}
+
+PointTilesWriter::~PointTilesWriter()
+{
+    // removes the temporary file if finish() wasn't called or failed
+    spill.close();
+    spillFile.deleteFile();
+}
+
+void PointTilesWriter::add(const Base::Vector3f& point)
+{
+    // e.g. the invalid points of structured point clouds, they have no cell
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+        return;
+    }
+
+    buffer.push_back(point);
+    if (buffer.size() == buffer.capacity()) {
+        flush();
+    }
+}
+
+void PointTilesWriter::add(const std::vector<Base::Vector3f>& points)
+{
+    for (const auto& it : points) {
+        add(it);
+    }
+}
+
+void PointTilesWriter::flush()
+{
+    std::vector<float> data;
+    data.reserve(3 * buffer.size());
+    for (const auto& it : buffer) {
+        bbox.Add(it);
+        data.push_back(it.x);
+        data.push_back(it.y);
+        data.push_back(it.z);
+    }
+
+    std::streamsize len = std::streamsize(data.size() * sizeof(float));
+    spill.write(reinterpret_cast<const char*>(data.data()), len);
+    if (!spill) {
+        throw Base::FileException("Failed to write temporary file", spillFile);
+    }
+    numPoints += buffer.size();
+    buffer.clear();
+}
+
+void PointTilesWriter::finish()
+{
+    flush();
+    spill.close();
+
+    Base::MappedFile source;
+    std::vector<std::uint64_t> first(numCells + 1, 0);
+    if (numPoints > 0) {
+        source.open(spillFile.filePath());
+        CellIndex cellIndex(bbox);
+        for (std::uint64_t i = 0; i < numPoints; i++) {
+            std::array<float, 3> pnt {};
+            std::memcpy(pnt.data(), source.data() + i * pointSize, pointSize);
+            first[cellIndex(pnt.data()) + 1]++;
+        }
+        std::partial_sum(first.begin(), first.end(), first.begin());
+    }
+
+    std::vector<CellRange> ranges;
+    subdivide(first, 0, numCells, pointsPerTile, ranges);
+
+    std::vector<std::uint32_t> cellToTile(numCells, 0);
+    std::vector<TileEntry> tiles(ranges.size());
+    std::vector<Base::BoundBox3f> boxes(ranges.size());
+    for (std::size_t i = 0; i < ranges.size(); i++) {
+        std::fill(
+            cellToTile.begin() + std::ptrdiff_t(ranges[i].begin),
+            cellToTile.begin() + std::ptrdiff_t(ranges[i].end),
+            std::uint32_t(i)
+        );
+        tiles[i].offset = first[ranges[i].begin];
+        tiles[i].count = first[ranges[i].end] - first[ranges[i].begin];
+    }
+
+    const std::uint64_t dataStart = sizeof(FileHeader) + tiles.size() * sizeof(TileEntry);
+
+    // create the file before opening it for random access
+    {
+        Base::ofstream create(file, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!create) {
+            throw Base::FileException("Cannot create file", file);
+        }
+    }
+    Base::ofstream out(file, std::ios::in | std::ios::out | std::ios::binary);
+    if (!out) {
+        throw Base::FileException("Cannot open file for writing", file);
+    }
+
+    // distribute the points to their tiles, writing in blocks to keep the seeks rare
+    constexpr std::size_t blockSize = 4096;
+    std::vector<std::vector<float>> blocks(tiles.size());
+    std::vector<std::uint64_t> written(tiles.size(), 0);
+    auto writeBlock = [&](std::size_t tile) {
+        std::vector<float>& block = blocks[tile];
+        out.seekp(std::streamoff(dataStart + (tiles[tile].offset + written[tile]) * pointSize));
+        std::streamsize len = std::streamsize(block.size() * sizeof(float));
+        out.write(reinterpret_cast<const char*>(block.data()), len);
+        written[tile] += block.size() / 3;
+        block.clear();
+    };
+
+    CellIndex cellIndex(bbox);
+    for (std::uint64_t i = 0; i < numPoints; i++) {
+        std::array<float, 3> pnt {};
+        std::memcpy(pnt.data(), source.data() + i * pointSize, pointSize);
+        std::uint32_t tile = cellToTile[cellIndex(pnt.data())];
+        boxes[tile].Add(Base::Vector3f(pnt[0], pnt[1], pnt[2]));
+        std::vector<float>& block = blocks[tile];
+        block.insert(block.end(), pnt.begin(), pnt.end());
+        if (block.size() == 3 * blockSize) {
+            writeBlock(tile);
+        }
+    }
+    for (std::size_t i = 0; i < tiles.size(); i++) {
+        if (!blocks[i].empty()) {
+            writeBlock(i);
+        }
+        tiles[i].box = toArray(boxes[i]);
+    }
+    blocks.clear();
+    source.close();
+    spillFile.deleteFile();
+
+    out.flush();
+    if (!out) {
+        throw Base::FileException("Failed to write file", file);
+    }
+
+    // shuffle the points of each tile so that any prefix is a uniform sample
+    Base::ifstream inp(file, std::ios::in | std::ios::binary);
+    for (std::size_t i = 0; i < tiles.size(); i++) {
+        std::streamoff pos = std::streamoff(dataStart + tiles[i].offset * pointSize);
+        std::mt19937 gen(static_cast<std::mt19937::result_type>(i));
+        shuffleTile(inp, out, pos, tiles[i].count, pointsPerTile, gen);
+    }
+
+    FileHeader header {};
+    header.magic = tileMagic;
+    header.version = tileVersion;
+    header.box = toArray(bbox);
+    header.numPoints = numPoints;
+    header.numTiles = tiles.size();
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::streamsize len = std::streamsize(tiles.size() * sizeof(TileEntry));
+    out.write(reinterpret_cast<const char*>(tiles.data()), len);
+    out.close();
+    if (!inp || !out) {
+        throw Base::FileException("Failed to write file", file);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+PointTiles::PointTiles(const std::string& fileName, std::size_t residentPoints)
+    : mapped(fileName)
+    , maxResident(residentPoints)
+{
+    FileHeader header {};
+    if (mapped.size() < sizeof(header)) {
+        throw Base::BadFormatError("Not a point tile file");
+    }
+    std::memcpy(&header, mapped.data(), sizeof(header));
+    if (header.magic != tileMagic) {
+        throw Base::BadFormatError("Not a point tile file");
+    }
+    if (header.version != tileVersion) {
+        throw Base::BadFormatError("Unsupported version of point tile file");
+    }
+
+    const std::uint64_t dataStart = sizeof(FileHeader) + header.numTiles * sizeof(TileEntry);
+    if (header.numTiles > mapped.size() / sizeof(TileEntry)
+        || dataStart + header.numPoints * pointSize > mapped.size()) {
+        throw Base::BadFormatError("Truncated point tile file");
+    }
+
+    bbox = toBoundBox(header.box);
+    numPoints = header.numPoints;
+    tiles.reserve(header.numTiles);
+    for (std::uint64_t i = 0; i < header.numTiles; i++) {
+        TileEntry entry {};
+        const char* data = mapped.data() + sizeof(FileHeader) + i * sizeof(TileEntry);
+        std::memcpy(&entry, data, sizeof(entry));
+        if (entry.offset + entry.count > numPoints) {
+            throw Base::BadFormatError("Invalid tile in point tile file");
+        }
+        tiles.push_back({toBoundBox(entry.box), entry.offset, entry.count});
+    }
+    pointData = mapped.data() + dataStart;
+}
+
+std::vector<std::size_t> PointTiles::getTilesInside(const Base::BoundBox3f& box) const
+{
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < tiles.size(); i++) {
+        if (tiles[i].box.Intersect(box)) {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+void PointTiles::appendPoints(
+    const Tile& tile,
+    std::uint64_t count,
+    std::vector<Base::Vector3f>& pts
+) const
+{
+    const char* data = pointData + tile.offset * pointSize;
+    for (std::uint64_t i = 0; i < count; i++) {
+        std::array<float, 3> pnt {};
+        std::memcpy(pnt.data(), data + i * pointSize, pointSize);
+        pts.emplace_back(pnt[0], pnt[1], pnt[2]);
+    }
+}
+
+std::shared_ptr<const PointKernel> PointTiles::getTilePoints(std::size_t index) const
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = resident.find(index);
+        if (it != resident.end()) {
+            recent.splice(recent.begin(), recent, it->second.pos);
+            return it->second.kernel;
+        }
+    }
+
+    // load the tile without holding the lock
+    const Tile& tile = tiles.at(index);
+    std::vector<Base::Vector3f> pts;
+    pts.reserve(tile.count);
+    appendPoints(tile, tile.count, pts);
+    auto kernel = std::make_shared<PointKernel>();
+    kernel->swap(pts);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = resident.find(index);
+    if (it != resident.end()) {
+        return it->second.kernel;
+    }
+
+    recent.push_front(index);
+    resident[index] = Resident {kernel, recent.begin()};
+    numResident += tile.count;
+    while (numResident > maxResident && recent.size() > 1) {
+        std::size_t last = recent.back();
+        recent.pop_back();
+        numResident -= tiles[last].count;
+        resident.erase(last);
+    }
+
+    return kernel;
+}
+
+void PointTiles::readPoints(const Base::BoundBox3f& box, PointKernel& kernel) const
+{
+    std::vector<Base::Vector3f>& pts = kernel.getBasicPoints();
+    for (std::size_t index : getTilesInside(box)) {
+        const Tile& tile = tiles[index];
+        if (box.IsInBox(tile.box)) {
+            appendPoints(tile, tile.count, pts);
+            continue;
+        }
+
+        const char* data = pointData + tile.offset * pointSize;
+        for (std::uint64_t i = 0; i < tile.count; i++) {
+            std::array<float, 3> pnt {};
+            std::memcpy(pnt.data(), data + i * pointSize, pointSize);
+            Base::Vector3f vec(pnt[0], pnt[1], pnt[2]);
+            if (box.IsInBox(vec)) {
+                pts.push_back(vec);
+            }
+        }
+    }
+}
+
+void PointTiles::readSample(std::size_t maxPoints, PointKernel& kernel) const
+{
+    readSample(maxPoints, bbox, kernel);
+}
+
+void PointTiles::readSample(
+    std::size_t maxPoints,
+    const Base::BoundBox3f& box,
+    PointKernel& kernel
+) const
+{
+    std::vector<std::size_t> indices = getTilesInside(box);
+    std::uint64_t total = 0;
+    for (std::size_t index : indices) {
+        total += tiles[index].count;
+    }
+
+    // as the points of a tile are shuffled, a prefix of each tile is a uniform sample
+    std::vector<Base::Vector3f>& pts = kernel.getBasicPoints();
+    pts.reserve(pts.size() + std::min<std::uint64_t>(total, maxPoints));
+    std::uint64_t sum = 0;
+    std::uint64_t taken = 0;
+    for (std::size_t index : indices) {
+        const Tile& tile = tiles[index];
+        std::uint64_t count = tile.count;
+        if (total > maxPoints) {
+            // distribute the rounding errors so that exactly maxPoints are taken
+            sum += tile.count;
+            count = sum * maxPoints / total - taken;
+            taken += count;
+        }
+        appendPoints(tile, count, pts);
+    }
+}
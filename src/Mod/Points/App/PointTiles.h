@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef POINTS_POINTTILES_H
+#define POINTS_POINTTILES_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/FileInfo.h>
+#include <Base/MappedFile.h>
+#include <Base/Stream.h>
+
+#include "Points.h"
+
+
+namespace Points
+{
+
+/** Writes a point cloud of arbitrary size into a tile file
+ * The points are passed in batches and spilled to a temporary file so that the memory
+ * consumption doesn't depend on the size of the point cloud. When finishing, the points
+ * are sorted into the cells of an octree which is subdivided until each cell holds at most
+ * the requested number of points. The non-empty cells become the tiles of the file.
+ * The points of a tile are stored in random order so that any prefix of a tile is a
+ * uniform sample of it, which is used to build coarse overviews with little I/O.
+ * A tile can only exceed the requested size if its points fall into the same cell of the
+ * finest octree level. Then only its first pointsPerTile points are shuffled, so that
+ * finishing never holds more than about twice that number of points in memory.
+ */
+class PointsExport PointTilesWriter
+{
+public:
+    explicit PointTilesWriter(const std::string& fileName, std::size_t pointsPerTile = 1000000);
+    ~PointTilesWriter();
+
+    PointTilesWriter(const PointTilesWriter&) = delete;
+    PointTilesWriter(PointTilesWriter&&) = delete;
+    PointTilesWriter& operator=(const PointTilesWriter&) = delete;
+    PointTilesWriter& operator=(PointTilesWriter&&) = delete;
+
+    /// Adds points, points with NaN or infinite coordinates are skipped
+    void add(const Base::Vector3f& point);
+    void add(const std::vector<Base::Vector3f>& points);
+    /// Sorts the points into tiles and writes the tile file
+    void finish();
+
+private:
+    void flush();
+
+private:
+    Base::FileInfo file;
+    Base::FileInfo spillFile;
+    Base::ofstream spill;
+    std::vector<Base::Vector3f> buffer;
+    Base::BoundBox3f bbox;
+    std::uint64_t numPoints = 0;
+    std::size_t pointsPerTile;
+};
+
+/** Read access to a tile file written by PointTilesWriter
+ * The file is memory-mapped so that only the accessed tiles are loaded by the operating
+ * system. Tiles that are requested as point kernels are kept in a least-recently-used
+ * cache whose size is limited by the number of resident points.
+ * The methods of this class can be called from several threads.
+ */
+class PointsExport PointTiles
+{
+public:
+    struct Tile
+    {
+        Base::BoundBox3f box;
+        std::uint64_t offset = 0;
+        std::uint64_t count = 0;
+    };
+
+    explicit PointTiles(const std::string& fileName, std::size_t residentPoints = 20000000);
+
+    PointTiles(const PointTiles&) = delete;
+    PointTiles(PointTiles&&) = delete;
+    PointTiles& operator=(const PointTiles&) = delete;
+    PointTiles& operator=(PointTiles&&) = delete;
+
+    std::size_t countTiles() const
+    {
+        return tiles.size();
+    }
+    std::uint64_t countPoints() const
+    {
+        return numPoints;
+    }
+    const Tile& getTile(std::size_t index) const
+    {
+        return tiles[index];
+    }
+    Base::BoundBox3f getBoundBox() const
+    {
+        return bbox;
+    }
+    /// Returns the indices of all tiles whose bounding box intersects \a box
+    std::vector<std::size_t> getTilesInside(const Base::BoundBox3f& box) const;
+
+    /** Returns the points of a tile. The kernel is kept resident until it falls out of the
+     * cache, so that repeated access to neighbouring tiles doesn't touch the file again.
+     */
+    std::shared_ptr<const PointKernel> getTilePoints(std::size_t index) const;
+    /// Appends all points inside \a box to \a kernel
+    void readPoints(const Base::BoundBox3f& box, PointKernel& kernel) const;
+    /** Appends about \a maxPoints points to \a kernel which are evenly distributed over
+     * the whole point cloud.
+     */
+    void readSample(std::size_t maxPoints, PointKernel& kernel) const;
+    /// Same as above but restricted to the tiles intersecting \a box
+    void readSample(std::size_t maxPoints, const Base::BoundBox3f& box, PointKernel& kernel) const;
+
+private:
+    void appendPoints(const Tile& tile, std::uint64_t count, std::vector<Base::Vector3f>&) const;
+
+private:
+    Base::MappedFile mapped;
+    const char* pointData = nullptr;
+    std::vector<Tile> tiles;
+    Base::BoundBox3f bbox;
+    std::uint64_t numPoints = 0;
+
+    // least-recently-used cache of resident tiles
+    using TileList = std::list<std::size_t>;
+    struct Resident
+    {
+        std::shared_ptr<const PointKernel> kernel;
+        TileList::iterator pos;
+    };
+    mutable std::mutex mutex;
+    mutable TileList recent;
+    mutable std::unordered_map<std::size_t, Resident> resident;
+    mutable std::size_t numResident = 0;
+    std::size_t maxResident;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_POINTTILES_H
@@ -202,9 +202,10 @@ void PointKernel::SaveDocFile(Base::Writer& writer) const
     uint32_t uCt = (uint32_t)size();
     str << uCt;
     // store the data without transforming it
-    for (const auto& pnt : _Points) {
-        str << pnt.x << pnt.y << pnt.z;
-    }
+    auto append = [](std::vector<float>& block, const value_type& pnt) {
+        block.insert(block.end(), {pnt.x, pnt.y, pnt.z});
+    };
+    str.writeBlocks<float>(_Points.begin(), _Points.end(), append);
 }
 
 void PointKernel::Restore(Base::XMLReader& reader)
@@ -230,13 +231,9 @@ void PointKernel::RestoreDocFile(Base::Reader& reader)
     uint32_t uCt = 0;
     str >> uCt;
     _Points.resize(uCt);
-    for (unsigned long i = 0; i < uCt; i++) {
-        float x {};
-        float y {};
-        float z {};
-        str >> x >> y >> z;
-        _Points[i].Set(x, y, z);
-    }
+    str.readBlocks<float>(_Points.size(), 3, [this](std::size_t index, const float* it) {
+        _Points[index].Set(it[0], it[1], it[2]);
+    });
 }
 
 void PointKernel::save(const char* file) const
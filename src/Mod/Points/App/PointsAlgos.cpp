@@ -27,27 +27,490 @@
 #ifdef FC_OS_LINUX
 # include <unistd.h>
 #endif
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <sstream>
+#include <string_view>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>  // needed for compilation on some systems
-#include <boost/regex.hpp>
+#include <QThread>
+#include <QtConcurrentMap>
 
 #include <Base/Console.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/MappedFile.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
 
+#include "PointTiles.h"
 #include "PointsAlgos.h"
 #include <E57Format.h>
 
 
 using namespace Points;
 
+namespace
+{
+
+// Size of the pieces of an ASCII file that are parsed in parallel
+constexpr std::size_t asciiChunkSize = 4 * 1024 * 1024;
+// Size of the parts of an ASCII file that are parsed at once when streaming into tiles
+constexpr std::size_t asciiPartSize = 64 * asciiChunkSize;
+// Number of records of a binary file that are converted at once
+constexpr Eigen::Index binaryBatchSize = 65536;
+
+bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Parses the next number of a line and advances 'pos' behind it. Returns false if the
+// line has no further token or if the token is not a number.
+bool parseNumber(const char*& pos, const char* end, double& value)
+{
+    while (pos != end && isBlank(*pos)) {
+        ++pos;
+    }
+    if (pos == end) {
+        return false;
+    }
+
+    const char* start = pos;
+    // std::from_chars doesn't accept a leading plus sign
+    if (*start == '+') {
+        ++start;
+    }
+    if (start == end) {
+        return false;
+    }
+    // besides digits a number may start with a sign, a dot or be 'nan' or 'inf'
+    const char first = static_cast<char>(std::tolower(static_cast<unsigned char>(*start)));
+    if (!std::isdigit(static_cast<unsigned char>(first)) && first != '-' && first != '.'
+        && first != 'n' && first != 'i') {
+        return false;
+    }
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto [ptr, ec] = std::from_chars(start, end, value);
+    if (ec != std::errc()) {
+        return false;
+    }
+    pos = ptr;
+#else
+    std::array<char, 64> buf {};
+    std::size_t len = 0;
+    while (start + len != end && !isBlank(start[len]) && len + 1 < buf.size()) {
+        buf[len] = start[len];
+        ++len;
+    }
+    char* last = nullptr;
+    value = std::strtod(buf.data(), &last);
+    if (last == buf.data()) {
+        return false;
+    }
+    pos = start + (last - buf.data());
+#endif
+
+    return pos == end || isBlank(*pos);
+}
+
+// Calls 'func' for each non-empty line of 'text' without the line break
+template<typename Func>
+void forEachLine(std::string_view text, Func&& func)
+{
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        std::size_t next = text.find('\n', pos);
+        if (next == std::string_view::npos) {
+            next = text.size();
+        }
+        std::string_view line = text.substr(pos, next - pos);
+        if (!line.empty() && line != "\r") {
+            func(line);
+        }
+        pos = next + 1;
+    }
+}
+
+// Removes the first 'count' non-empty lines
+std::string_view skipLines(std::string_view text, std::size_t count)
+{
+    std::size_t pos = 0;
+    while (count > 0 && pos < text.size()) {
+        std::size_t next = text.find('\n', pos);
+        if (next == std::string_view::npos) {
+            next = text.size();
+        }
+        if (next > pos && text.substr(pos, next - pos) != "\r") {
+            --count;
+        }
+        pos = next + 1;
+    }
+    return text.substr(std::min(pos, text.size()));
+}
+
+// The per-point data read from a file
+struct PointRecords
+{
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> normals;
+    std::vector<float> intensity;
+    std::vector<Base::Color> colors;
+
+    void append(PointRecords&& other, std::size_t count)
+    {
+        auto move = [count](auto& dst, auto& src) {
+            std::size_t num = std::min(count, src.size());
+            dst.insert(dst.end(), src.begin(), src.begin() + std::ptrdiff_t(num));
+            src.clear();
+            src.shrink_to_fit();
+        };
+        move(points, other.points);
+        move(normals, other.normals);
+        move(intensity, other.intensity);
+        move(colors, other.colors);
+    }
+};
+
+static_assert(sizeof(float) == sizeof(uint32_t), "float and uint32_t have different sizes");
+
+// Maps the fields of a record to the per-point data
+class FieldLayout
+{
+public:
+    static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+    explicit FieldLayout(const std::vector<std::string>& fields)
+        : fields(fields)
+    {
+        x = find({"x"});
+        y = find({"y"});
+        z = find({"z"});
+        normal_x = find({"normal_x", "nx"});
+        normal_y = find({"normal_y", "ny"});
+        normal_z = find({"normal_z", "nz"});
+        greyvalue = find({"intensity"});
+    }
+
+    /// Colors given as separate red, green, blue and alpha fields
+    void setSeparateColors(const std::vector<std::string>& types)
+    {
+        red = find({"red"});
+        green = find({"green"});
+        blue = find({"blue"});
+        alpha = find({"alpha"});
+        if (red != none && green != none && blue != none) {
+            if (types[red] == "uchar") {
+                color = ColorType::Bytes;
+            }
+            else if (types[red] == "float") {
+                color = ColorType::Floats;
+            }
+        }
+    }
+
+    /// Colors given as one packed ARGB value
+    void setPackedColors(const std::vector<std::string>& types)
+    {
+        rgba = find({"rgb", "rgba"});
+        if (rgba != none) {
+            if (types[rgba] == "U") {
+                color = ColorType::PackedInt;
+            }
+            else if (types[rgba] == "F") {
+                color = ColorType::PackedFloat;
+            }
+        }
+    }
+
+    bool hasData() const
+    {
+        return x != none && y != none && z != none;
+    }
+
+    void append(const double* record, PointRecords& out) const
+    {
+        if (!hasData()) {
+            return;
+        }
+
+        out.points.emplace_back(
+            static_cast<float>(record[x]),
+            static_cast<float>(record[y]),
+            static_cast<float>(record[z])
+        );
+        if (normal_x != none && normal_y != none && normal_z != none) {
+            out.normals.emplace_back(
+                static_cast<float>(record[normal_x]),
+                static_cast<float>(record[normal_y]),
+                static_cast<float>(record[normal_z])
+            );
+        }
+        if (greyvalue != none) {
+            out.intensity.push_back(static_cast<float>(record[greyvalue]));
+        }
+        if (color != ColorType::None) {
+            out.colors.push_back(toColor(record));
+        }
+    }
+
+private:
+    enum class ColorType
+    {
+        None,
+        Bytes,
+        Floats,
+        PackedInt,
+        PackedFloat
+    };
+
+    std::size_t find(std::initializer_list<const char*> names) const
+    {
+        for (const char* name : names) {
+            auto it = std::ranges::find(fields, name);
+            if (it != fields.end()) {
+                return std::distance(fields.begin(), it);
+            }
+        }
+        return none;
+    }
+
+    Base::Color toColor(const double* record) const
+    {
+        Base::Color col;
+        switch (color) {
+            case ColorType::Bytes: {
+                float a = alpha != none ? static_cast<float>(record[alpha]) : 1.0F;
+                col.set(
+                    static_cast<float>(record[red]) / 255.0F,
+                    static_cast<float>(record[green]) / 255.0F,
+                    static_cast<float>(record[blue]) / 255.0F,
+                    a / 255.0F
+                );
+            } break;
+            case ColorType::Floats: {
+                float a = alpha != none ? static_cast<float>(record[alpha]) : 1.0F;
+                col.set(
+                    static_cast<float>(record[red]),
+                    static_cast<float>(record[green]),
+                    static_cast<float>(record[blue]),
+                    a
+                );
+            } break;
+            case ColorType::PackedInt:
+                col.setPackedARGB(static_cast<uint32_t>(record[rgba]));
+                break;
+            case ColorType::PackedFloat: {
+                float f = static_cast<float>(record[rgba]);
+                uint32_t packed {};
+                std::memcpy(&packed, &f, sizeof(packed));
+                col.setPackedARGB(packed);
+            } break;
+            default:
+                break;
+        }
+        return col;
+    }
+
+private:
+    const std::vector<std::string>& fields;
+    std::size_t x, y, z;
+    std::size_t normal_x, normal_y, normal_z;
+    std::size_t greyvalue;
+    std::size_t red {none}, green {none}, blue {none}, alpha {none};
+    std::size_t rgba {none};
+    ColorType color {ColorType::None};
+};
+
+struct AsciiChunk
+{
+    std::string_view text;
+    PointRecords records;
+    bool failed {false};
+};
+
+// Splits 'text' into chunks at line boundaries and parses them in parallel. 'parse' is
+// called for each chunk and must not throw. The chunks are parsed in groups so that the
+// progress can be reported from the calling thread.
+template<typename Func>
+std::vector<AsciiChunk> parseAsciiChunks(std::string_view text, Func&& parse)
+{
+    std::vector<AsciiChunk> chunks;
+    for (std::string_view it : Base::splitAtLines(text, asciiChunkSize)) {
+        chunks.push_back({it, {}, false});
+    }
+
+    const std::size_t group = 2 * std::size_t(std::max(QThread::idealThreadCount(), 1));
+    Base::SequencerLauncher seq("Loading points…", chunks.size());
+    for (std::size_t first = 0; first < chunks.size(); first += group) {
+        std::size_t last = std::min(first + group, chunks.size());
+        QtConcurrent::blockingMap(
+            chunks.begin() + std::ptrdiff_t(first),
+            chunks.begin() + std::ptrdiff_t(last),
+            parse
+        );
+        seq.setProgress(last);
+    }
+    return chunks;
+}
+
+// Parses the points of an ASCII file with one point per line. Lines that don't consist of
+// exactly three numbers, like comments, are skipped.
+void parseAsciiPoints(AsciiChunk& chunk)
+{
+    forEachLine(chunk.text, [&chunk](std::string_view line) {
+        const char* pos = line.data();
+        const char* end = pos + line.size();
+        std::array<double, 3> pnt {};
+        for (double& value : pnt) {
+            if (!parseNumber(pos, end, value)) {
+                return;
+            }
+        }
+        while (pos != end && isBlank(*pos)) {
+            ++pos;
+        }
+        if (pos == end) {
+            chunk.records.points.emplace_back(
+                static_cast<float>(pnt[0]),
+                static_cast<float>(pnt[1]),
+                static_cast<float>(pnt[2])
+            );
+        }
+    });
+}
+
+// Appends the results of the chunks in their order, at most 'maxRecords' of them
+void mergeChunks(std::vector<AsciiChunk>& chunks, std::size_t maxRecords, PointRecords& out)
+{
+    std::size_t total = 0;
+    for (const auto& it : chunks) {
+        if (it.failed) {
+            throw Base::BadFormatError("Invalid number in point cloud file");
+        }
+        total += it.records.points.size();
+    }
+    total = std::min(total, maxRecords);
+
+    std::size_t start = out.points.size();
+    out.points.reserve(start + total);
+    for (auto& it : chunks) {
+        std::size_t count = std::min(it.records.points.size(), start + total - out.points.size());
+        out.append(std::move(it.records), count);
+    }
+}
+
+// Parses the records of an ASCII file with up to 'numFields' numbers per line
+void readAsciiRecords(
+    std::string_view text,
+    std::size_t numFields,
+    std::size_t maxRecords,
+    const FieldLayout& layout,
+    PointRecords& out
+)
+{
+    std::vector<AsciiChunk> chunks = parseAsciiChunks(text, [&](AsciiChunk& chunk) {
+        std::vector<double> record(numFields);
+        forEachLine(chunk.text, [&](std::string_view line) {
+            if (chunk.failed) {
+                return;
+            }
+            const char* pos = line.data();
+            const char* end = pos + line.size();
+            std::ranges::fill(record, 0.0);
+            std::size_t col = 0;
+            for (; col < numFields; col++) {
+                if (!parseNumber(pos, end, record[col])) {
+                    break;
+                }
+            }
+            while (pos != end && isBlank(*pos)) {
+                ++pos;
+            }
+            // an invalid token
+            if (col < numFields && pos != end) {
+                chunk.failed = true;
+                return;
+            }
+            layout.append(record.data(), chunk.records);
+        });
+    });
+
+    mergeChunks(chunks, maxRecords, out);
+}
+
+// Parses the records of an ASCII file part by part. If there is a tile writer the points
+// of each part are passed to it, otherwise all records are kept.
+void readAsciiRecords(
+    std::string_view text,
+    std::size_t numFields,
+    std::size_t maxRecords,
+    const FieldLayout& layout,
+    PointRecords& out,
+    PointTilesWriter* tiles
+)
+{
+    for (std::string_view part : Base::splitAtLines(text, asciiPartSize)) {
+        if (maxRecords == 0) {
+            break;
+        }
+        std::size_t count = out.points.size();
+        readAsciiRecords(part, numFields, maxRecords, layout, out);
+        maxRecords -= out.points.size() - count;
+        if (tiles) {
+            tiles->add(out.points);
+            out = PointRecords();
+        }
+    }
+}
+
+// Transfers the records read from a binary file
+void appendRecords(const Eigen::MatrixXd& data, const FieldLayout& layout, PointRecords& out)
+{
+    std::vector<double> record(data.cols());
+    for (Eigen::Index i = 0; i < data.rows(); i++) {
+        for (Eigen::Index j = 0; j < data.cols(); j++) {
+            record[j] = data(i, j);
+        }
+        layout.append(record.data(), out);
+    }
+}
+
+// Reads the records of a binary file in batches by calling 'read' with the matrix for the
+// next batch. If there is a tile writer the points of each batch are passed to it.
+template<typename Func>
+void readBinaryRecords(
+    Eigen::Index numPoints,
+    Eigen::Index numFields,
+    const FieldLayout& layout,
+    PointRecords& out,
+    PointTilesWriter* tiles,
+    Func&& read
+)
+{
+    for (Eigen::Index first = 0; first < numPoints; first += binaryBatchSize) {
+        Eigen::MatrixXd data(std::min(binaryBatchSize, numPoints - first), numFields);
+        read(data);
+        appendRecords(data, layout, out);
+        if (tiles) {
+            tiles->add(out.points);
+            out = PointRecords();
+        }
+    }
+}
+
+}  // namespace
+
 void PointsAlgos::Load(PointKernel& points, const char* FileName)
 {
     Base::FileInfo File(FileName);
@@ -67,61 +530,33 @@ void PointsAlgos::Load(PointKernel& points, const char* FileName)
 
 void PointsAlgos::LoadAscii(PointKernel& points, const char* FileName)
 {
-    boost::regex rx(
-        "^\\s*([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$"
-    );
-    // boost::regex rx("(\\b[0-9]+\\.([0-9]+\\b)?|\\.[0-9]+\\b)");
-    // boost::regex
-    // rx("^\\s*(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s*$");
-    boost::cmatch what;
-
-    Base::Vector3d pt;
-    int LineCnt = 0;
-    std::string line;
-    Base::FileInfo fi(FileName);
+    Base::MappedFile file(FileName);
+    std::vector<AsciiChunk> chunks = parseAsciiChunks(file.view(), parseAsciiPoints);
 
-    Base::ifstream tmp_str(fi, std::ios::in);
+    PointRecords records;
+    mergeChunks(chunks, std::numeric_limits<std::size_t>::max(), records);
 
-    // estimating size
-    while (std::getline(tmp_str, line)) {
-        LineCnt++;
+    points.clear();
+    if (points.getTransform() == Base::Matrix4D()) {
+        points.swap(records.points);
     }
-
-    // resize the PointKernel
-    points.resize(LineCnt);
-
-    Base::SequencerLauncher seq("Loading points…", LineCnt);
-
-    // again to the beginning
-    Base::ifstream file(fi, std::ios::in);
-    LineCnt = 0;
-
-    try {
-        // read file
-        while (std::getline(file, line)) {
-            if (boost::regex_match(line.c_str(), what, rx)) {
-                pt.x = std::atof(what[1].first);
-                pt.y = std::atof(what[4].first);
-                pt.z = std::atof(what[7].first);
-
-                points.setPoint(LineCnt, pt);
-                seq.next();
-                LineCnt++;
-            }
+    else {
+        points.reserve(records.points.size());
+        for (const auto& it : records.points) {
+            points.push_back(Base::convertTo<Base::Vector3d>(it));
         }
     }
-    catch (...) {
-        points.clear();
-        throw Base::BadFormatError("Reading in points failed.");
-    }
+}
 
-    // now remove the last points from the kernel
-    // Note: first we allocate memory corresponding to the number of lines (points and comments)
-    //       and read in the file twice. But then the size of the kernel is too high
-    if (LineCnt < (int)points.size()) {
-        points.erase(LineCnt, points.size());
+void PointsAlgos::LoadAscii(PointTilesWriter& tiles, const char* FileName)
+{
+    // parse the file in larger parts to limit the memory usage
+    Base::MappedFile file(FileName);
+    for (std::string_view part : Base::splitAtLines(file.view(), asciiPartSize)) {
+        std::vector<AsciiChunk> chunks = parseAsciiChunks(part, parseAsciiPoints);
+        for (const auto& it : chunks) {
+            tiles.add(it.records.points);
+        }
     }
 }
 
@@ -131,6 +566,14 @@ Reader::Reader() = default;
 
 Reader::~Reader() = default;
 
+void Reader::readTiles(const std::string& filename, PointTilesWriter& tiles)
+{
+    read(filename);
+    tiles.add(points.getBasicPoints());
+    points.clear();
+    clear();
+}
+
 void Reader::clear()
 {
     intensity.clear();
@@ -204,6 +647,11 @@ void AscReader::read(const std::string& filename)
     this->width = points.size();
 }
 
+void AscReader::readTiles(const std::string& filename, PointTilesWriter& tiles)
+{
+    PointsAlgos::LoadAscii(tiles, filename.c_str());
+}
+
 // ----------------------------------------------------------------------------
 
 namespace Points
@@ -557,6 +1005,16 @@ unsigned int lzfDecompress(
 PlyReader::PlyReader() = default;
 
 void PlyReader::read(const std::string& filename)
+{
+    readRecords(filename, nullptr);
+}
+
+void PlyReader::readTiles(const std::string& filename, PointTilesWriter& tiles)
+{
+    readRecords(filename, &tiles);
+}
+
+void PlyReader::readRecords(const std::string& filename, PointTilesWriter* tiles)
 {
     clear();
 
@@ -573,161 +1031,33 @@ void PlyReader::read(const std::string& filename)
     this->width = numPoints;
     this->height = 1;
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
-    }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
-    }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
-    }
-
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
-
-    // x field
-    Eigen::Index x = max_size;
-    it = std::ranges::find(fields, "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
-    }
-
-    // y field
-    Eigen::Index y = max_size;
-    it = std::ranges::find(fields, "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
-    }
-
-    // z field
-    Eigen::Index z = max_size;
-    it = std::ranges::find(fields, "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
-
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::ranges::find(fields, "normal_x");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nx");
-    }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
-    }
-
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::ranges::find(fields, "normal_y");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "ny");
-    }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
-    }
-
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::ranges::find(fields, "normal_z");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nz");
-    }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
-    }
-
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::ranges::find(fields, "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
-    }
-
-    // rgb(a) field
-    Eigen::Index red = max_size;
-    Eigen::Index green = max_size;
-    Eigen::Index blue = max_size;
-    Eigen::Index alpha = max_size;
-    it = std::ranges::find(fields, "red");
-    if (it != fields.end()) {
-        red = std::distance(fields.begin(), it);
-    }
-
-    it = std::ranges::find(fields, "green");
-    if (it != fields.end()) {
-        green = std::distance(fields.begin(), it);
-    }
-
-    it = std::ranges::find(fields, "blue");
-    if (it != fields.end()) {
-        blue = std::distance(fields.begin(), it);
-    }
-
-    it = std::ranges::find(fields, "alpha");
-    if (it != fields.end()) {
-        alpha = std::distance(fields.begin(), it);
-    }
-
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (red != max_size && green != max_size && blue != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
-        }
-    }
-
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
-        }
-    }
-
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(static_cast<float>(data(i, greyvalue)));
-        }
-    }
+    FieldLayout layout(fields);
+    layout.setSeparateColors(types);
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(
-                    static_cast<float>(r) / 255.0F,
-                    static_cast<float>(g) / 255.0F,
-                    static_cast<float>(b) / 255.0F,
-                    static_cast<float>(a) / 255.0F
-                );
-            }
-        }
-        else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(r, g, b, a);
-            }
-        }
-    }
+    PointRecords records;
+    if (format == "ascii") {
+        std::size_t start = static_cast<std::size_t>(inp.tellg());
+        inp.close();
+
+        Base::MappedFile file(filename);
+        std::string_view text = file.view().substr(std::min(start, file.size()));
+        text = skipLines(text, offset);
+        readAsciiRecords(text, fields.size(), numPoints, layout, records, tiles);
+    }
+    else if (format == "binary_little_endian" || format == "binary_big_endian") {
+        bool swapByteOrder = format == "binary_big_endian";
+        auto read = [&](Eigen::MatrixXd& data) {
+            readBinary(swapByteOrder, inp, offset, types, sizes, data);
+            // the other elements are only in front of the first batch
+            offset = 0;
+        };
+        readBinaryRecords(numPoints, Eigen::Index(fields.size()), layout, records, tiles, read);
+    }
+
+    points.swap(records.points);
+    normals.swap(records.normals);
+    intensity.swap(records.intensity);
+    colors.swap(records.colors);
 }
 
 std::size_t PlyReader::readHeader(
@@ -902,39 +1232,6 @@ std::size_t PlyReader::readHeader(
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = Eigen::Index(data.rows());
-    Eigen::Index numFields = Eigen::Index(data.cols());
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
 void PlyReader::readBinary(
     bool swapByteOrder,
     std::istream& inp,
@@ -1039,6 +1336,16 @@ void PlyReader::readBinary(
 PcdReader::PcdReader() = default;
 
 void PcdReader::read(const std::string& filename)
+{
+    readRecords(filename, nullptr);
+}
+
+void PcdReader::readTiles(const std::string& filename, PointTilesWriter& tiles)
+{
+    readRecords(filename, &tiles);
+}
+
+void PcdReader::readRecords(const std::string& filename, PointTilesWriter* tiles)
 {
     clear();
     this->width = 0;
@@ -1053,12 +1360,23 @@ void PcdReader::read(const std::string& filename)
     std::vector<int> sizes;
     Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
 
-    Eigen::MatrixXd data(numPoints, fields.size());
+    FieldLayout layout(fields);
+    layout.setPackedColors(types);
+
+    PointRecords records;
     if (format == "ascii") {
-        readAscii(inp, data);
+        std::size_t start = static_cast<std::size_t>(inp.tellg());
+        inp.close();
+
+        Base::MappedFile file(filename);
+        std::string_view text = file.view().substr(std::min(start, file.size()));
+        readAsciiRecords(text, fields.size(), numPoints, layout, records, tiles);
     }
     else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
+        auto read = [&](Eigen::MatrixXd& data) {
+            readBinary(inp, types, sizes, data);
+        };
+        readBinaryRecords(numPoints, Eigen::Index(fields.size()), layout, records, tiles, read);
     }
     else if (format == "binary_compressed") {
         unsigned int c {};
@@ -1069,137 +1387,49 @@ void PcdReader::read(const std::string& filename)
         std::vector<char> compressed(c);
         inp.read(compressed.data(), c);
         std::vector<char> uncompressed(u);
-        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(nullptr);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
-        }
-        else {
+        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) != u) {
             throw Base::BadFormatError("Failed to decompress binary data");
         }
-    }
-
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
-
-    // x field
-    Eigen::Index x = max_size;
-    it = std::ranges::find(fields, "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
-    }
-
-    // y field
-    Eigen::Index y = max_size;
-    it = std::ranges::find(fields, "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
-    }
-
-    // z field
-    Eigen::Index z = max_size;
-    it = std::ranges::find(fields, "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
-
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::ranges::find(fields, "normal_x");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nx");
-    }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
-    }
-
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::ranges::find(fields, "normal_y");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "ny");
-    }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
-    }
-
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::ranges::find(fields, "normal_z");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nz");
-    }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
-    }
-
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::ranges::find(fields, "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
-    }
-
-    // rgb(a) field
-    Eigen::Index rgba = max_size;
-    it = std::ranges::find(fields, "rgb");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "rgba");
-    }
-    if (it != fields.end()) {
-        rgba = std::distance(fields.begin(), it);
-    }
-
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (rgba != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
-        }
-    }
-
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
-        }
-    }
-
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(data(i, greyvalue));
-        }
-    }
+        compressed.clear();
+        compressed.shrink_to_fit();
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i, rgba));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
-            }
+        // the data is stored field by field, reorder it to records to read it in batches
+        std::size_t recordSize = std::accumulate(sizes.begin(), sizes.end(), std::size_t(0));
+        std::size_t count = static_cast<std::size_t>(numPoints);
+        if (recordSize * count > uncompressed.size()) {
+            throw Base::BadFormatError("File expects too many elements");
         }
-        else if (types[rgba] == "F") {
-            static_assert(sizeof(float) == sizeof(uint32_t), "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float f = static_cast<float>(data(i, rgba));
-                uint32_t packed {};
-                std::memcpy(&packed, &f, sizeof(packed));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
+        std::vector<char> interleaved(uncompressed.size());
+        std::size_t fieldStart = 0;
+        std::size_t fieldOffset = 0;
+        for (int size : sizes) {
+            for (std::size_t i = 0; i < count; i++) {
+                std::memcpy(
+                    interleaved.data() + i * recordSize + fieldOffset,
+                    uncompressed.data() + fieldStart + i * size,
+                    size
+                );
             }
-        }
-    }
+            fieldStart += count * size;
+            fieldOffset += size;
+        }
+        uncompressed.swap(interleaved);
+        interleaved.clear();
+        interleaved.shrink_to_fit();
+
+        DataStreambuf ibuf(uncompressed);
+        std::istream istr(nullptr);
+        istr.rdbuf(&ibuf);
+        auto read = [&](Eigen::MatrixXd& data) {
+            readBinary(istr, types, sizes, data);
+        };
+        readBinaryRecords(numPoints, Eigen::Index(fields.size()), layout, records, tiles, read);
+    }
+
+    points.swap(records.points);
+    normals.swap(records.normals);
+    intensity.swap(records.intensity);
+    colors.swap(records.colors);
 }
 
 std::size_t PcdReader::readHeader(
@@ -1275,36 +1505,7 @@ std::size_t PcdReader::readHeader(
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
 void PcdReader::readBinary(
-    bool transpose,
     std::istream& inp,
     const std::vector<std::string>& types,
     const std::vector<int>& sizes,
@@ -1392,20 +1593,10 @@ void PcdReader::readBinary(
     }
 
     Base::InputStream str(inp);
-    if (transpose) {
+    for (Eigen::Index i = 0; i < numPoints; i++) {
         for (Eigen::Index j = 0; j < numFields; j++) {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            for (Eigen::Index j = 0; j < numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
+            double value = converters[j]->toDouble(str);
+            data(i, j) = value;
         }
     }
 }
@@ -1424,6 +1615,12 @@ public:
         , minDistance {distance}
     {}
 
+    /// Passes the points to \a writer instead of keeping them and their data
+    void setTiles(PointTilesWriter* writer)
+    {
+        tiles = writer;
+    }
+
     void read()
     {
         e57::StructureNode root = imfi.root();
@@ -1749,7 +1946,12 @@ private:
                         filter = true;
                     }
                 }
-                if (!filter) {
+                if (!filter && tiles) {
+                    cnt_pts++;
+                    tiles->add(Base::convertTo<Base::Vector3f>(pt));
+                    last = pt;
+                }
+                else if (!filter) {
                     cnt_pts++;
                     points.push_back(pt);
                     last = pt;
@@ -1869,6 +2071,7 @@ private:
     std::vector<float> intensity;
     PointKernel points;
     std::vector<Base::Vector3f> normals;
+    PointTilesWriter* tiles {nullptr};
 };
 }  // namespace
 
@@ -1898,6 +2101,21 @@ void E57Reader::read(const std::string& filename)
     }
 }
 
+void E57Reader::readTiles(const std::string& filename, PointTilesWriter& tiles)
+{
+    try {
+        E57ReaderImp reader(filename, false, checkState, minDistance);
+        reader.setTiles(&tiles);
+        reader.read();
+    }
+    catch (const Base::Exception&) {
+        throw;
+    }
+    catch (...) {
+        throw Base::BadFormatError("Reading E57 file failed");
+    }
+}
+
 // ----------------------------------------------------------------------------
 
 Writer::Writer(const PointKernel& p)
@@ -33,6 +33,7 @@
 
 namespace Points
 {
+class PointTilesWriter;
 
 /** The Points algorithms container class
  */
@@ -45,6 +46,10 @@ public:
     /** Load a point cloud
      */
     static void LoadAscii(PointKernel&, const char* FileName);
+    /** Pass the points of an ASCII file to a tile writer
+     * The file is read in parts so that point clouds of any size can be converted.
+     */
+    static void LoadAscii(PointTilesWriter&, const char* FileName);
 };
 
 class PointsExport Reader
@@ -53,6 +58,10 @@ public:
     Reader();
     virtual ~Reader();
     virtual void read(const std::string& filename) = 0;
+    /** Passes the points of the file in batches to \a tiles instead of keeping them, so
+     * that files of any size can be converted. The other per-point data is not read.
+     */
+    virtual void readTiles(const std::string& filename, PointTilesWriter& tiles);
 
     void clear();
     const PointKernel& getPoints() const;
@@ -88,6 +97,7 @@ class PointsExport AscReader: public Reader
 public:
     AscReader();
     void read(const std::string& filename) override;
+    void readTiles(const std::string& filename, PointTilesWriter& tiles) override;
 };
 
 class PointsExport PlyReader: public Reader
@@ -95,8 +105,10 @@ class PointsExport PlyReader: public Reader
 public:
     PlyReader();
     void read(const std::string& filename) override;
+    void readTiles(const std::string& filename, PointTilesWriter& tiles) override;
 
 private:
+    void readRecords(const std::string& filename, PointTilesWriter* tiles);
     std::size_t readHeader(
         std::istream&,
         std::string& format,
@@ -105,7 +117,6 @@ private:
         std::vector<std::string>& types,
         std::vector<int>& sizes
     );
-    void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
     void readBinary(
         bool swapByteOrder,
         std::istream&,
@@ -121,8 +132,10 @@ class PointsExport PcdReader: public Reader
 public:
     PcdReader();
     void read(const std::string& filename) override;
+    void readTiles(const std::string& filename, PointTilesWriter& tiles) override;
 
 private:
+    void readRecords(const std::string& filename, PointTilesWriter* tiles);
     std::size_t readHeader(
         std::istream&,
         std::string& format,
@@ -130,9 +143,7 @@ private:
         std::vector<std::string>& types,
         std::vector<int>& sizes
     );
-    void readAscii(std::istream&, Eigen::MatrixXd& data);
     void readBinary(
-        bool transpose,
         std::istream&,
         const std::vector<std::string>& types,
         const std::vector<int>& sizes,
@@ -145,6 +156,7 @@ class PointsExport E57Reader: public Reader
 public:
     E57Reader(bool Color, bool State, double Distance);
     void read(const std::string& filename) override;
+    void readTiles(const std::string& filename, PointTilesWriter& tiles) override;
 
 protected:
     bool useColor, checkState;
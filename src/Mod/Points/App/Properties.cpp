@@ -150,9 +150,7 @@ void PropertyGreyValueList::SaveDocFile(Base::Writer& writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (float it : _lValueList) {
-        str << it;
-    }
+    str.write(_lValueList.data(), _lValueList.size());
 }
 
 void PropertyGreyValueList::RestoreDocFile(Base::Reader& reader)
@@ -161,9 +159,7 @@ void PropertyGreyValueList::RestoreDocFile(Base::Reader& reader)
     uint32_t uCt = 0;
     str >> uCt;
     std::vector<float> values(uCt);
-    for (float& value : values) {
-        str >> value;
-    }
+    str.read(values.data(), values.size());
     setValues(values);
 }
 
@@ -322,9 +318,10 @@ void PropertyNormalList::SaveDocFile(Base::Writer& writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (const auto& it : _lValueList) {
-        str << it.x << it.y << it.z;
-    }
+    auto append = [](std::vector<float>& block, const Base::Vector3f& vec) {
+        block.insert(block.end(), {vec.x, vec.y, vec.z});
+    };
+    str.writeBlocks<float>(_lValueList.begin(), _lValueList.end(), append);
 }
 
 void PropertyNormalList::RestoreDocFile(Base::Reader& reader)
@@ -333,9 +330,9 @@ void PropertyNormalList::RestoreDocFile(Base::Reader& reader)
     uint32_t uCt = 0;
     str >> uCt;
     std::vector<Base::Vector3f> values(uCt);
-    for (auto& value : values) {
-        str >> value.x >> value.y >> value.z;
-    }
+    str.readBlocks<float>(values.size(), 3, [&values](std::size_t index, const float* it) {
+        values[index].Set(it[0], it[1], it[2]);
+    });
     setValues(values);
 }
 
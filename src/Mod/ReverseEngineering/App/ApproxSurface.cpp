@@ -22,24 +22,95 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <vector>
+#include <Eigen/Eigenvalues>
+#include <Eigen/SparseCholesky>
+
+#include <QCoreApplication>
+#include <QEventLoop>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QThread>
 #include <QtConcurrentMap>
 
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
 
 #include <Base/Sequencer.h>
-#include <Base/Tools.h>
-#include <Mod/Mesh/App/Core/Approximation.h>
 
 #include "ApproxSurface.h"
 
 
 using namespace Reen;
-namespace sp = std::placeholders;
+
+namespace
+{
+using IndexRange = std::pair<int, int>;
+
+// Splits the index range [lower, upper] into consecutive blocks for parallel processing
+std::vector<IndexRange> makeBlocks(int lower, int upper, int blockSize)
+{
+    std::vector<IndexRange> blocks;
+    for (int i = lower; i <= upper; i += blockSize) {
+        blocks.emplace_back(i, std::min(i + blockSize - 1, upper));
+    }
+    return blocks;
+}
+
+// A block of points that is corrected in parallel with the others
+struct CorrectionBlock
+{
+    IndexRange range;
+    double maxDiff {0.0};
+    double maxScalar {1.0};
+};
+
+// The part of the normal equations given by a block of points. A basis function has only a
+// local support, so a control point only interacts with the control points whose indices
+// differ by less than the order in both directions. These entries of a row are kept in a band.
+struct NormalEquations
+{
+    std::vector<double> band;
+    std::vector<double> rhs;
+};
+
+// A pivot of the factorization that is tiny compared to the largest one means that the
+// system is singular
+bool hasZeroPivot(const Eigen::VectorXd& pivots)
+{
+    double maxPivot = pivots.cwiseAbs().maxCoeff();
+    return pivots.cwiseAbs().minCoeff() <= 1e-10 * maxPivot;
+}
+
+// The membrane energy of the control net, i.e. the sum of the squared differences of
+// neighbouring control points, weighted with fWeight
+Eigen::SparseMatrix<double> membraneMatrix(int numU, int numV, double fWeight)
+{
+    std::vector<Eigen::Triplet<double>> triplets;
+    auto addEdge = [&triplets, fWeight](int i, int j) {
+        triplets.emplace_back(i, i, fWeight);
+        triplets.emplace_back(j, j, fWeight);
+        triplets.emplace_back(i, j, -fWeight);
+        triplets.emplace_back(j, i, -fWeight);
+    };
+    for (int j = 0; j < numU; j++) {
+        for (int k = 0; k < numV; k++) {
+            int row = j * numV + k;
+            if (j + 1 < numU) {
+                addEdge(row, row + numV);
+            }
+            if (k + 1 < numV) {
+                addEdge(row, row + 1);
+            }
+        }
+    }
+
+    Eigen::SparseMatrix<double> matrix(numU * numV, numU * numV);
+    matrix.setFromTriplets(triplets.begin(), triplets.end());
+    return matrix;
+}
+}  // namespace
 
 // SplineBasisfunction
 
@@ -661,16 +732,34 @@ ParameterCorrection::ParameterCorrection(
 
 void ParameterCorrection::CalcEigenvectors()
 {
-    MeshCore::PlaneFit planeFit;
-    for (int i = _pvcPoints->Lower(); i <= _pvcPoints->Upper(); i++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(i);
-        planeFit.AddPoint(Base::Vector3f((float)pnt.X(), (float)pnt.Y(), (float)pnt.Z()));
-    }
-
-    planeFit.Fit();
-    _clU = Base::toVector<double>(planeFit.GetDirU());
-    _clV = Base::toVector<double>(planeFit.GetDirV());
-    _clW = Base::toVector<double>(planeFit.GetNormal());
+    // sum up the covariance matrix in parallel blocks
+    Base::Vector3d mean = GetGravityPoint();
+    auto covariance = [this, &mean](const IndexRange& block) {
+        Eigen::Matrix3d cov = Eigen::Matrix3d::Zero();
+        for (int i = block.first; i <= block.second; i++) {
+            const gp_Pnt& pnt = (*_pvcPoints)(i);
+            Eigen::Vector3d diff(pnt.X() - mean.x, pnt.Y() - mean.y, pnt.Z() - mean.z);
+            cov += diff * diff.transpose();
+        }
+        return cov;
+    };
+
+    std::vector<IndexRange> blocks = makeBlocks(_pvcPoints->Lower(), _pvcPoints->Upper(), 0x4000);
+    std::vector<Eigen::Matrix3d> parts
+        = QtConcurrent::blockingMapped<std::vector<Eigen::Matrix3d>>(blocks, covariance);
+    Eigen::Matrix3d covMat = Eigen::Matrix3d::Zero();
+    for (const auto& it : parts) {
+        covMat += it;
+    }
+
+    // the eigenvalues are sorted in increasing order, so the normal comes first
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eig(covMat);
+    Eigen::Vector3d u = eig.eigenvectors().col(1);
+    Eigen::Vector3d v = eig.eigenvectors().col(2);
+    Eigen::Vector3d w = eig.eigenvectors().col(0);
+    _clU.Set(u.x(), u.y(), u.z());
+    _clV.Set(v.x(), v.y(), v.z());
+    _clW.Set(w.x(), w.y(), w.z());
 }
 
 bool ParameterCorrection::DoInitialParameterCorrection(double fSizeFactor)
@@ -972,15 +1061,18 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
     double fMaxDiff = 0.0, fMaxScalar = 1.0;
     double fWeight = _fSmoothInfluence;
 
+    const int blockSize = 0x1000;
+    std::vector<CorrectionBlock> blocks;
+    for (const auto& it : makeBlocks(_pvcPoints->Lower(), _pvcPoints->Upper(), blockSize)) {
+        blocks.push_back({it});
+    }
+
     Base::SequencerLauncher seq(
         "Calc surface...",
         static_cast<size_t>(iIter) * static_cast<size_t>(_pvcPoints->Length())
     );
 
     do {
-        fMaxScalar = 1.0;
-        fMaxDiff = 0.0;
-
         Handle(Geom_BSplineSurface) pclBSplineSurf = new Geom_BSplineSurface(
             _vCtrlPntsOfSurf,
             _vUKnots,
@@ -991,49 +1083,82 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
             _usVOrder - 1
         );
 
-        for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-            double fDeltaU, fDeltaV, fU, fV;
-            const gp_Pnt& pnt = (*_pvcPoints)(ii);
-            gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
-            gp_Pnt PntX;
-            gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
-            // Calculate the first two derivatives and point at (u,v)
-            gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
-            pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
-            gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
-            gp_Vec ErrorVec = X - P;
-
-            // Calculate Xu x Xv the normal in X(u,v)
-            gp_Dir clNormal = Xu ^ Xv;
-
-            // Check, if X = P
-            if (!(X.IsEqual(P, 0.001, 0.001))) {
-                ErrorVec.Normalize();
-                if (fabs(clNormal * ErrorVec) < fMaxScalar) {
-                    fMaxScalar = fabs(clNormal * ErrorVec);
+        // The points are independent of each other, so they are corrected in parallel
+        auto correctBlock = [this, &pclBSplineSurf](CorrectionBlock& block) {
+            block.maxScalar = 1.0;
+            block.maxDiff = 0.0;
+
+            for (int ii = block.range.first; ii <= block.range.second; ii++) {
+                double fDeltaU, fDeltaV, fU, fV;
+                const gp_Pnt& pnt = (*_pvcPoints)(ii);
+                gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
+                gp_Pnt PntX;
+                gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
+                // Calculate the first two derivatives and point at (u,v)
+                gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
+                pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
+                gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
+                gp_Vec ErrorVec = X - P;
+
+                // Calculate Xu x Xv the normal in X(u,v)
+                gp_Dir clNormal = Xu ^ Xv;
+
+                // Check, if X = P
+                if (!(X.IsEqual(P, 0.001, 0.001))) {
+                    ErrorVec.Normalize();
+                    if (fabs(clNormal * ErrorVec) < block.maxScalar) {
+                        block.maxScalar = fabs(clNormal * ErrorVec);
+                    }
                 }
-            }
 
-            fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
-            if (fabs(fDeltaU) < Precision::Confusion()) {
-                fDeltaU = 0.0;
-            }
-            fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
-            if (fabs(fDeltaV) < Precision::Confusion()) {
-                fDeltaV = 0.0;
-            }
+                fDeltaU = ((P - X) * Xu) / ((P - X) * Xuu - Xu * Xu);
+                if (fabs(fDeltaU) < Precision::Confusion()) {
+                    fDeltaU = 0.0;
+                }
+                fDeltaV = ((P - X) * Xv) / ((P - X) * Xvv - Xv * Xv);
+                if (fabs(fDeltaV) < Precision::Confusion()) {
+                    fDeltaV = 0.0;
+                }
 
-            // Replace old u/v values with new ones
-            fU = uvValue.X() - fDeltaU;
-            fV = uvValue.Y() - fDeltaV;
-            if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
-                uvValue.SetX(fU);
-                uvValue.SetY(fV);
-                fMaxDiff = std::max<double>(fabs(fDeltaU), fMaxDiff);
-                fMaxDiff = std::max<double>(fabs(fDeltaV), fMaxDiff);
+                // Replace old u/v values with new ones
+                fU = uvValue.X() - fDeltaU;
+                fV = uvValue.Y() - fDeltaV;
+                if (fU <= 1.0 && fU >= 0.0 && fV <= 1.0 && fV >= 0.0) {
+                    uvValue.SetX(fU);
+                    uvValue.SetY(fV);
+                    block.maxDiff = std::max<double>(fabs(fDeltaU), block.maxDiff);
+                    block.maxDiff = std::max<double>(fabs(fDeltaV), block.maxDiff);
+                }
+            }
+        };
+
+        QFuture<void> future = QtConcurrent::map(blocks, correctBlock);
+        QFutureWatcher<void> watcher;
+
+        // the progress value is the number of finished blocks
+        std::size_t numPoints = static_cast<std::size_t>(_pvcPoints->Length());
+        std::size_t progress = 0;
+        QObject::connect(&watcher, &QFutureWatcher<void>::progressValueChanged, [&](int value) {
+            std::size_t done = std::min(static_cast<std::size_t>(value) * blockSize, numPoints);
+            for (; progress < done; progress++) {
+                seq.next();
             }
+        });
+
+        watcher.setFuture(future);
+        // the progress is only delivered if an application runs an event loop
+        if (QCoreApplication::instance()) {
+            QEventLoop loop;
+            QObject::connect(&watcher, &QFutureWatcher<void>::finished, &loop, &QEventLoop::quit);
+            loop.exec();
+        }
+        future.waitForFinished();
 
-            seq.next();
+        fMaxScalar = 1.0;
+        fMaxDiff = 0.0;
+        for (const auto& it : blocks) {
+            fMaxScalar = std::min(fMaxScalar, it.maxScalar);
+            fMaxDiff = std::max(fMaxDiff, it.maxDiff);
         }
 
         if (_bSmoothing) {
@@ -1050,227 +1175,159 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
 
 bool BSplineParameterCorrection::SolveWithoutSmoothing()
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Matrix Xx(0, ulDim - 1, 0, 0);
-    math_Matrix Xy(0, ulDim - 1, 0, 0);
-    math_Matrix Xz(0, ulDim - 1, 0, 0);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        unsigned ulIdx = 0;
-
-        // Pre-calculation of the values of the base functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
-        }
+    return SolveLeastSquares(0.0);
+}
 
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
-                }
+bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+{
+    return SolveLeastSquares(fWeight);
+}
+
+bool BSplineParameterCorrection::SolveLeastSquares(double fWeight)
+{
+    const int orderU = static_cast<int>(_usUOrder);
+    const int orderV = static_cast<int>(_usVOrder);
+    const int numU = static_cast<int>(_usUCtrlpoints);
+    const int numV = static_cast<int>(_usVCtrlpoints);
+    const int dim = numU * numV;
+    const int bandU = 2 * orderU - 1;
+    const int bandV = 2 * orderV - 1;
+    const std::size_t bandSize = static_cast<std::size_t>(bandU) * bandV;
+
+    // the basis functions vanish outside of the knot range
+    const double minU = _vUKnots(_vUKnots.Lower());
+    const double maxU = _vUKnots(_vUKnots.Upper());
+    const double minV = _vVKnots(_vVKnots.Lower());
+    const double maxV = _vVKnots(_vVKnots.Upper());
+
+    // Assemble the normal equations M^T*M*X = M^T*b of the over-determined system M*X = b
+    // directly. Each point only contributes to the products of the few basis functions
+    // that don't vanish at its parameters.
+    auto assemble = [&](const IndexRange& block) {
+        NormalEquations eq;
+        eq.band.resize(bandSize * dim);
+        eq.rhs.resize(3 * static_cast<std::size_t>(dim));
+
+        TColStd_Array1OfReal basisU(0, orderU - 1);
+        TColStd_Array1OfReal basisV(0, orderV - 1);
+        for (int i = block.first; i <= block.second; i++) {
+            const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
+            double fU = uvValue.X();
+            double fV = uvValue.Y();
+            if (fU < minU || fU > maxU || fV < minV || fV > maxV) {
+                continue;
             }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+
+            int firstU = _clUSpline.FindSpan(fU) - orderU + 1;
+            int firstV = _clVSpline.FindSpan(fV) - orderV + 1;
+            _clUSpline.AllBasisFunctions(fU, basisU);
+            _clVSpline.AllBasisFunctions(fV, basisV);
+
+            const gp_Pnt& pnt = (*_pvcPoints)(i);
+            for (int j = 0; j < orderU; j++) {
+                for (int k = 0; k < orderV; k++) {
+                    double value = basisU(j) * basisV(k);
+                    if (value == 0.0) {
+                        continue;
+                    }
+
+                    std::size_t row = static_cast<std::size_t>((firstU + j) * numV + firstV + k);
+                    eq.rhs[3 * row] += value * pnt.X();
+                    eq.rhs[3 * row + 1] += value * pnt.Y();
+                    eq.rhs[3 * row + 2] += value * pnt.Z();
+
+                    double* band = &eq.band[row * bandSize];
+                    for (int m = 0; m < orderU; m++) {
+                        double* bandRow = band + (m - j + orderU - 1) * bandV + orderV - 1 - k;
+                        for (int n = 0; n < orderV; n++) {
+                            bandRow[n] += value * basisU(m) * basisV(n);
+                        }
+                    }
                 }
             }
         }
-    }
-
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
-    }
-
-    // Solve the over-determined LGS with Householder-Transformation
-    math_Householder hhX(M, bx);
-    math_Householder hhY(M, by);
-    math_Householder hhZ(M, bz);
-
-    if (!(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone())) {
-        // LGS could not be solved
+        return eq;
+    };
+
+    // use one block per thread to keep the memory of the partial sums low
+    int numThreads = std::max(1, QThread::idealThreadCount());
+    int blockSize = std::max(1, (_pvcPoints->Length() + numThreads - 1) / numThreads);
+    int lower = _pvcPoints->Lower();
+    int upper = _pvcPoints->Upper();
+    std::vector<IndexRange> blocks = makeBlocks(lower, upper, blockSize);
+    std::vector<NormalEquations> parts
+        = QtConcurrent::blockingMapped<std::vector<NormalEquations>>(blocks, assemble);
+    if (parts.empty()) {
         return false;
     }
-    Xx = hhX.AllValues();
-    Xy = hhY.AllValues();
-    Xz = hhZ.AllValues();
-
-    unsigned ulIdx = 0;
-    for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            _vCtrlPntsOfSurf(j, k) = gp_Pnt(Xx(ulIdx, 0), Xy(ulIdx, 0), Xz(ulIdx, 0));
-            ulIdx++;
-        }
-    }
-
-    return true;
-}
-
-namespace Reen
-{
-class ScalarProduct
-{
-public:
-    explicit ScalarProduct(const math_Matrix& mat)
-        : mat(mat)
-    {}
-    std::vector<double> multiply(int col) const
-    {
-        math_Vector vec = mat.Col(col);
-        std::vector<double> out(mat.ColNumber());
-        for (int n = mat.LowerCol(); n <= mat.UpperCol(); n++) {
-            out[n] = vec * mat.Col(n);
-        }
-        return out;
-    }
 
-private:
-    const math_Matrix& mat;
-};
-}  // namespace Reen
-
-bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
-{
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Vector Xx(0, ulDim - 1);
-    math_Vector Xy(0, ulDim - 1);
-    math_Vector Xz(0, ulDim - 1);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-    math_Vector Mbx(0, ulDim - 1);
-    math_Vector Mby(0, ulDim - 1);
-    math_Vector Mbz(0, ulDim - 1);
-
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        int ulIdx = 0;
-
-        // Pre-calculation of the values of the basis functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
+    NormalEquations& sum = parts.front();
+    for (auto it = parts.begin() + 1; it != parts.end(); ++it) {
+        for (std::size_t i = 0; i < sum.band.size(); i++) {
+            sum.band[i] += it->band[i];
         }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
+        for (std::size_t i = 0; i < sum.rhs.size(); i++) {
+            sum.rhs[i] += it->rhs[i];
         }
-
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+        *it = NormalEquations();
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(bandSize * dim);
+    for (int row = 0; row < dim; row++) {
+        int j = row / numV;
+        int k = row % numV;
+        const double* band = &sum.band[row * bandSize];
+        for (int m = std::max(0, j - orderU + 1); m < std::min(numU, j + orderU); m++) {
+            for (int n = std::max(0, k - orderV + 1); n < std::min(numV, k + orderV); n++) {
+                double value = band[(m - j + orderU - 1) * bandV + n - k + orderV - 1];
+                if (value != 0.0) {
+                    triplets.emplace_back(row, m * numV + n, value);
                 }
             }
         }
     }
 
-    // The product of its transform and itself results in the quadratic
-    // system matrix (slowly)
-#if 0
-    math_Matrix MTM = M.TMultiply(M);
-#elif 0
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    for (unsigned m = 0; m < ulDim; m++) {
-        math_Vector Mm = M.Col(m);
-        for (unsigned n = m; n < ulDim; n++) {
-            MTM(m, n) = MTM(n, m) = Mm * M.Col(n);
-        }
-    }
-#else  // multi-threaded
-    std::vector<int> columns(ulDim);
-    std::generate(columns.begin(), columns.end(), Base::iotaGen<int>(0));
-    ScalarProduct scalar(M);
-    // NOLINTBEGIN
-    QFuture<std::vector<double>> future
-        = QtConcurrent::mapped(columns, std::bind(&ScalarProduct::multiply, &scalar, sp::_1));
-    // NOLINTEND
-    QFutureWatcher<std::vector<double>> watcher;
-    watcher.setFuture(future);
-    watcher.waitForFinished();
-
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    int rowIndex = 0;
-    for (const auto& it : future) {
-        int colIndex = 0;
-        for (std::vector<double>::const_iterator jt = it.begin(); jt != it.end(); ++jt, colIndex++) {
-            MTM(rowIndex, colIndex) = *jt;
+    // Depending on the weighting, smoothing terms are included
+    if (fWeight != 0.0) {
+        for (int m = 0; m < dim; m++) {
+            for (int n = 0; n < dim; n++) {
+                double value = _clSmoothMatrix(m, n);
+                if (value != 0.0) {
+                    triplets.emplace_back(m, n, fWeight * value);
+                }
+            }
         }
-        rowIndex++;
     }
-#endif
 
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
-    }
-    for (unsigned i = 0; i < ulDim; i++) {
-        math_Vector Mi = M.Col(i);
-        Mbx(i) = Mi * bx;
-        Mby(i) = Mi * by;
-        Mbz(i) = Mi * bz;
-    }
-
-    // Solve the LGS with the LU decomposition
-    math_Gauss mgGaussX(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussY(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussZ(MTM + fWeight * _clSmoothMatrix);
-
-    mgGaussX.Solve(Mbx, Xx);
-    if (!mgGaussX.IsDone()) {
-        return false;
-    }
-
-    mgGaussY.Solve(Mby, Xy);
-    if (!mgGaussY.IsDone()) {
-        return false;
+    Eigen::SparseMatrix<double> matrix(dim, dim);
+    matrix.setFromTriplets(triplets.begin(), triplets.end());
+    using RowMatrixX3d = Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>;
+    Eigen::Map<RowMatrixX3d> rhs(sum.rhs.data(), dim, 3);
+
+    // The system matrix is symmetric and positive definite if the system is solvable
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(matrix);
+    if (solver.info() != Eigen::Success || hasZeroPivot(solver.vectorD())) {
+        // Control points whose support holds no or too few points make the system singular.
+        // A weak membrane term ties them to their neighbours in the control net and hardly
+        // changes the control points that are determined by the points.
+        double maxDiagonal = matrix.diagonal().cwiseAbs().maxCoeff();
+        matrix += membraneMatrix(numU, numV, 1e-8 * maxDiagonal);
+        solver.compute(matrix);
+        if (solver.info() != Eigen::Success) {
+            return false;
+        }
     }
-
-    mgGaussZ.Solve(Mbz, Xz);
-    if (!mgGaussZ.IsDone()) {
+    Eigen::MatrixX3d solution = solver.solve(rhs);
+    if (solver.info() != Eigen::Success || !solution.allFinite()) {
         return false;
     }
 
     unsigned ulIdx = 0;
     for (unsigned j = 0; j < _usUCtrlpoints; j++) {
         for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            _vCtrlPntsOfSurf(j, k) = gp_Pnt(Xx(ulIdx), Xy(ulIdx), Xz(ulIdx));
+            _vCtrlPntsOfSurf(j, k)
+                = gp_Pnt(solution(ulIdx, 0), solution(ulIdx, 1), solution(ulIdx, 2));
             ulIdx++;
         }
     }
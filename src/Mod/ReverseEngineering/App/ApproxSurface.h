@@ -414,16 +414,22 @@ protected:
     void DoParameterCorrection(int iIter) override;
 
     /**
-     * Solve an overdetermined LGS with the help of the Householder-Tansformation
+     * Solve an overdetermined LGS in the least-squares sense
      */
     bool SolveWithoutSmoothing() override;
 
     /**
-     * Solve a regular system of equations by LU decomposition. Depending on the weighting,
+     * Solve the overdetermined LGS in the least-squares sense. Depending on the weighting,
      * smoothing terms are included
      */
     bool SolveWithSmoothing(double fWeight) override;
 
+    /**
+     * Assembles the sparse normal equations in parallel and solves them by a sparse
+     * Cholesky decomposition. Smoothing terms are included if \a fWeight is not zero.
+     */
+    bool SolveLeastSquares(double fWeight);
+
 public:
     /**
      * Setting the knot vector
@@ -263,6 +263,18 @@ int Sketch::setUpSketch(
     clearTemporaryConstraints();
     GCSsys.declareUnknowns(Parameters);
     GCSsys.declareDrivenParams(DrivenParameters);
+
+    // Diagnosing is the most expensive part of setting up a big sketch. If only the values of
+    // dimensional constraints changed, e.g. by an expression, the last diagnosis is still valid.
+    std::vector<double> structure;
+    bool diagnosisRestored = false;
+    if (!doesBlockAffectOtherConstraints) {
+        structure = getStructure(GeoList, ConstraintList, extGeoCount);
+        if (hasSavedDiagnosis && structure == diagnosedStructure) {
+            diagnosisRestored = GCSsys.restoreDiagnosis(savedDiagnosis);
+        }
+    }
+
     GCSsys.initSolution(defaultSolverRedundant);
 
     // Post-analysis
@@ -322,6 +334,12 @@ int Sketch::setUpSketch(
 #endif  // DEBUG_BLOCK_CONSTRAINT
     }
 
+    // the diagnosis with blocked parameters depends on the post-analysis above
+    hasSavedDiagnosis = !doesBlockAffectOtherConstraints && GCSsys.saveDiagnosis(savedDiagnosis);
+    if (hasSavedDiagnosis) {
+        diagnosedStructure = std::move(structure);
+    }
+
     // Now we set the Sketch status with the latest solver information
     GCSsys.getConflicting(Conflicting);
     GCSsys.getRedundant(Redundant);
@@ -334,14 +352,64 @@ int Sketch::setUpSketch(
         Base::TimeElapsed end_time;
 
         Base::Console().log(
-            "Sketcher::setUpSketch()-T:%s\n",
-            Base::TimeElapsed::diffTime(start_time, end_time).c_str()
+            "Sketcher::setUpSketch()-T:%s%s\n",
+            Base::TimeElapsed::diffTime(start_time, end_time).c_str(),
+            diagnosisRestored ? " (reused diagnosis)" : ""
         );
     }
 
     return GCSsys.dofsNumber();
 }
 
+std::vector<double> Sketch::getStructure(
+    const std::vector<Part::Geometry*>& geoList,
+    const std::vector<Constraint*>& constraintList,
+    int extGeoCount
+)
+{
+    std::vector<double> structure {double(geoList.size()), double(extGeoCount)};
+    structure.reserve(8 * geoList.size() + 12 * constraintList.size());
+
+    int intGeoCount = int(geoList.size()) - extGeoCount;
+    for (int i = 0; i < int(geoList.size()); i++) {
+        const Part::Geometry* geo = geoList[i];
+        structure.push_back(double(geo->getTypeId().getKey()));
+        if (i < intGeoCount) {
+            structure.push_back(GeometryFacade::getBlocked(geo) ? 1 : 0);
+        }
+
+        // the number of parameters of a B-spline depends on its poles and knots
+        if (geo->is<GeomBSplineCurve>()) {
+            const auto* bsp = static_cast<const GeomBSplineCurve*>(geo);
+            structure.push_back(bsp->getDegree());
+            structure.push_back(bsp->countPoles());
+            structure.push_back(bsp->isPeriodic() ? 1 : 0);
+            for (int mult : bsp->getMultiplicities()) {
+                structure.push_back(mult);
+            }
+        }
+    }
+
+    for (const auto* constr : constraintList) {
+        structure.push_back(constr->Type);
+        structure.push_back(constr->First);
+        structure.push_back(int(constr->FirstPos));
+        structure.push_back(constr->Second);
+        structure.push_back(int(constr->SecondPos));
+        structure.push_back(constr->Third);
+        structure.push_back(int(constr->ThirdPos));
+        structure.push_back(constr->AlignmentType);
+        structure.push_back(constr->InternalAlignmentIndex);
+        structure.push_back(constr->isDriving ? 1 : 0);
+        structure.push_back(constr->isActive ? 1 : 0);
+        // e.g. the value of a tangency decides between an endpoint and an angle-via-point
+        // tangency, only the values of dimensions can change without changing the equations
+        structure.push_back(constr->isDimensional() ? 0 : constr->getValue());
+    }
+
+    return structure;
+}
+
 void Sketch::buildInternalAlignmentGeometryMap(const std::vector<Constraint*>& constraintList)
 {
     for (auto* c : constraintList) {
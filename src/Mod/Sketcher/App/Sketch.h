@@ -595,6 +595,12 @@ private:
     // to be assigned to the SketchObject
     std::vector<std::shared_ptr<SolverGeometryExtension>> solverExtensions;
 
+    // the diagnosis of the last set up sketch, it is reused as long as the structure of the sketch
+    // doesn't change (see getStructure)
+    std::vector<double> diagnosedStructure;
+    GCS::SavedDiagnosis savedDiagnosis;
+    bool hasSavedDiagnosis = false;
+
     // maps a geoid corresponding to an internalgeometry (focus,knot,pole) to the geometry it
     // defines (ellipse, hyperbola, B-Spline)
     std::map<int, int> internalAlignmentGeometryMap;
@@ -841,6 +847,16 @@ private:
 
     /// utility function refactoring fixing the provided parameters and running a new diagnose
     void fixParametersAndDiagnose(std::vector<double*>& params_to_block);
+
+    /** Returns everything the solver parameters and constraints are built from, except the values
+     * of the geometry and of dimensional constraints. Two sketches with the same structure result
+     * in the same system of equations, just with other values.
+     */
+    static std::vector<double> getStructure(
+        const std::vector<Part::Geometry*>& geoList,
+        const std::vector<Constraint*>& constraintList,
+        int extGeoCount
+    );
 };
 
 }  // namespace Sketcher
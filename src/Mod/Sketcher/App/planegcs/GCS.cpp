@@ -547,6 +547,81 @@ void System::invalidatedDiagnosis()
     pDependentParametersGroups.clear();
 }
 
+bool System::saveDiagnosis(SavedDiagnosis& saved) const
+{
+    // whether a constraint is conflicting or redundant depends on the values of the constraints
+    if (!hasDiagnosis || !hasUnknowns || !conflictingTags.empty() || !redundantTags.empty()
+        || !partiallyRedundantTags.empty() || !redundant.empty()) {
+        return false;
+    }
+
+    auto toIndices = [this](const VEC_pD& params, VEC_I& indices) {
+        indices.clear();
+        indices.reserve(params.size());
+        for (const auto param : params) {
+            auto it = pIndex.find(param);
+            if (it == pIndex.end()) {
+                return false;
+            }
+            indices.push_back(it->second);
+        }
+        return true;
+    };
+
+    if (!toIndices(pDependentParameters, saved.dependentParameters)) {
+        return false;
+    }
+
+    saved.dependentParametersGroups.resize(pDependentParametersGroups.size());
+    for (std::size_t i = 0; i < pDependentParametersGroups.size(); ++i) {
+        if (!toIndices(pDependentParametersGroups[i], saved.dependentParametersGroups[i])) {
+            return false;
+        }
+    }
+
+    saved.paramCount = plist.size();
+    saved.drivenParamCount = pdrivenlist.size();
+    saved.constraintCount = clist.size();
+    saved.qrAlgorithm = qrAlgorithm;
+    saved.qrPivotThreshold = qrpivotThreshold;
+    saved.dofs = dofs;
+    saved.emptyDiagnoseMatrix = emptyDiagnoseMatrix;
+    return true;
+}
+
+bool System::restoreDiagnosis(const SavedDiagnosis& saved)
+{
+    if (!hasUnknowns || saved.paramCount != plist.size()
+        || saved.drivenParamCount != pdrivenlist.size() || saved.constraintCount != clist.size()
+        || saved.qrAlgorithm != qrAlgorithm || saved.qrPivotThreshold != qrpivotThreshold) {
+        return false;
+    }
+
+    auto toParams = [this](const VEC_I& indices) {
+        VEC_pD params;
+        params.reserve(indices.size());
+        for (const auto index : indices) {
+            params.push_back(plist[index]);
+        }
+        return params;
+    };
+
+    pDependentParameters = toParams(saved.dependentParameters);
+    pDependentParametersGroups.clear();
+    for (const auto& group : saved.dependentParametersGroups) {
+        pDependentParametersGroups.push_back(toParams(group));
+    }
+
+    redundant.clear();
+    conflictingTags.clear();
+    redundantTags.clear();
+    partiallyRedundantTags.clear();
+    dofs = saved.dofs;
+    emptyDiagnoseMatrix = saved.emptyDiagnoseMatrix;
+    hasDiagnosis = true;
+    return true;
+}
+
 void System::clearByTag(int tagId)
 {
     std::vector<Constraint*> constrvec;
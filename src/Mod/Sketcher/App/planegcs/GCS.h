@@ -104,6 +104,22 @@ enum SpecialTag
     DefaultTemporaryConstraint = -1
 };
 
+// The result of System::diagnose() with the parameters and constraints given by their position
+// in the system. As long as a system is set up again with the same parameters and constraints,
+// e.g. if only the values of driving constraints changed, the diagnosis stays valid.
+struct SavedDiagnosis
+{
+    std::size_t paramCount = 0;
+    std::size_t drivenParamCount = 0;
+    std::size_t constraintCount = 0;
+    QRAlgorithm qrAlgorithm = EigenSparseQR;
+    double qrPivotThreshold = 0;
+    int dofs = 0;
+    bool emptyDiagnoseMatrix = true;
+    VEC_I dependentParameters;
+    std::vector<VEC_I> dependentParametersGroups;
+};
+
 class SketcherExport System
 {
     // This is the main class. It holds all constraints and information
@@ -652,6 +668,13 @@ public:
 
     void invalidatedDiagnosis();
 
+    // Saves the diagnosis if it cannot depend on the values of the constraints, i.e. if there are
+    // no conflicting or redundant constraints.
+    bool saveDiagnosis(SavedDiagnosis& saved) const;
+    // Takes over a saved diagnosis instead of diagnosing the system again. This must be called
+    // after declaring the unknowns and before initSolution().
+    bool restoreDiagnosis(const SavedDiagnosis& saved);
+
     // Unit testing interface - not intended for use by production code
 protected:
     size_t _getNumberOfConstraints(int tagID = -1)
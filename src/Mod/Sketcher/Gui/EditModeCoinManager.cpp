@@ -782,7 +782,8 @@ SoGroup* EditModeCoinManager::getSelectedConstraints()
 
 void EditModeCoinManager::processGeometryConstraintsInformationOverlay(
     const GeoListFacade& geolistfacade,
-    bool rebuildinformationlayer
+    bool rebuildinformationlayer,
+    bool incremental
 )
 {
     overlayParameters.rebuildInformationLayer = rebuildinformationlayer;
@@ -793,7 +794,10 @@ void EditModeCoinManager::processGeometryConstraintsInformationOverlay(
 
     processGeometryInformationOverlay(geolistfacade);
 
-    pEditModeConstraintCoinManager->processConstraints(geolistfacade);
+    pEditModeConstraintCoinManager->processConstraints(
+        geolistfacade,
+        incremental ? &analysisResults.changedGeoIds : nullptr
+    );
 }
 
 void EditModeCoinManager::updateOverlayParameters()
@@ -228,9 +228,12 @@ public:
     //@}
 
     /** @name update coin nodes*/
+    // if incremental, the nodes of constraints that neither changed nor refer to changed geometry
+    // are kept, which saves a lot of time when dragging in a big sketch
     void processGeometryConstraintsInformationOverlay(
         const GeoListFacade& geolistfacade,
-        bool rebuildinformationlayer
+        bool rebuildinformationlayer,
+        bool incremental = false
     );
 
     void updateVirtualSpace();
@@ -26,6 +26,7 @@
 #define SKETCHERGUI_EditModeCoinManagerParameters_H
 
 #include <map>
+#include <set>
 #include <vector>
 
 #include <QString>
@@ -364,6 +365,7 @@ struct AnalysisResults
     float boundingBoxMagnitudeOrder = 0;  // used for grid extension
     std::vector<int> bsplineGeoIds;       // used for information overlay
     std::vector<int> arcGeoIds;
+    std::set<int> changedGeoIds;  // geometry changed since the last update of the coin nodes
 };
 
 /** @brief      Struct adapted to store the parameters necessary to create and update
@@ -119,7 +119,29 @@ void EditModeConstraintCoinManager::updateVirtualSpace()
     }
 }
 
-void EditModeConstraintCoinManager::processConstraints(const GeoListFacade& geolistfacade)
+EditModeConstraintCoinManager::ConstraintState::ConstraintState(const Sketcher::Constraint* constr)
+{
+    if (constr) {
+        type = constr->Type;
+        first = constr->First;
+        second = constr->Second;
+        third = constr->Third;
+        firstPos = constr->FirstPos;
+        secondPos = constr->SecondPos;
+        thirdPos = constr->ThirdPos;
+        value = constr->getValue();
+        labelDistance = constr->LabelDistance;
+        labelPosition = constr->LabelPosition;
+        name = constr->Name;
+        isDriving = constr->isDriving;
+        isActive = constr->isActive;
+    }
+}
+
+void EditModeConstraintCoinManager::processConstraints(
+    const GeoListFacade& geolistfacade,
+    const std::set<int>* changedGeoIds
+)
 {
     using std::numbers::pi;
 
@@ -147,6 +169,16 @@ Restart:
     assert(int(constrlist.size()) == editModeScenegraphNodes.constrGroup->getNumChildren());
     assert(int(vConstrType.size()) == editModeScenegraphNodes.constrGroup->getNumChildren());
 
+    // constraints are only skipped if their nodes are up to date with their last state
+    bool incremental = changedGeoIds && constraintStates.size() == constrlist.size()
+        && constraintStatesZ == zConstrH;
+    constraintStates.resize(constrlist.size());
+    constraintStatesZ = zConstrH;
+
+    auto isChanged = [changedGeoIds](int geoId) {
+        return geoId != GeoEnum::GeoUndef && changedGeoIds->count(geoId) > 0;
+    };
+
     // update the virtual space
     updateVirtualSpace();
 
@@ -205,6 +237,14 @@ Restart:
                 continue;
             }
 
+            ConstraintState state(Constr);
+            if (incremental && state == constraintStates[i] && !isChanged(Constr->First)
+                && !isChanged(Constr->Second) && !isChanged(Constr->Third)) {
+                continue;
+            }
+            // set again when the nodes were updated without an error
+            constraintStates[i] = ConstraintState();
+
             // distinguish different constraint types to build up
             switch (Constr->Type) {
                 case Block:
@@ -1647,6 +1687,8 @@ Restart:
                 case NumConstraintTypes:
                     break;
             }
+
+            constraintStates[i] = state;
         }
         catch (Base::Exception& e) {
             Base::Console().developerError(
@@ -1910,6 +1952,8 @@ void EditModeConstraintCoinManager::rebuildConstraintNodes(const GeoListFacade&
     Gui::coinRemoveAllChildren(editModeScenegraphNodes.constrGroup);
 
     vConstrType.clear();
+    constraintStates.clear();
+    renderedIcons.clear();
 
     // Get sketch normal
     Base::Vector3d RN(0, 0, 1);
@@ -2499,9 +2543,17 @@ void EditModeConstraintCoinManager::combineConstraintIcons(IconQueue iconQueue)
     float scale = ViewProviderSketchCoinAttorney::getScaleFactor(viewProvider);
     float maxDistSquared = pow(scale, 2);
 
-    // There's room for optimisation here; we could reuse the combined icons...
     combinedConstrBoxes.clear();
 
+    // icons are reused as long as they look the same, see iconSignature()
+    QFont font = ViewProviderSketchCoinAttorney::getApplicationFont(viewProvider);
+    QString iconStyle = font.key() + QLatin1Char('\n')
+        + QString::number(drawingParameters.constraintIconSize);
+    if (iconStyle != renderedIconStyle) {
+        renderedIcons.clear();
+        renderedIconStyle = iconStyle;
+    }
+
     // Grid size needs to be slightly larger than the max merge distance to ensure
     // we catch neighbors.
     float gridSize = std::max(1.0f, std::abs(scale) * 1.1f);
@@ -2605,14 +2657,25 @@ void EditModeConstraintCoinManager::combineConstraintIcons(IconQueue iconQueue)
 
 void EditModeConstraintCoinManager::drawMergedConstraintIcons(IconQueue iconQueue)
 {
-    for (IconQueue::iterator i = iconQueue.begin(); i != iconQueue.end(); ++i) {
-        clearCoinImage(i->destination);
-    }
-
     QImage compositeIcon;
     SoImage* thisDest = iconQueue[0].destination;
     SoInfo* thisInfo = iconQueue[0].infoPtr;
 
+    // the first image shows the combined icon, the others are cleared
+    QString signature;
+    for (IconQueue::iterator i = iconQueue.begin(); i != iconQueue.end(); ++i) {
+        signature += iconSignature(*i, constrColor(i->constraintId));
+        if (i->destination != thisDest) {
+            clearCoinImage(i->destination);
+        }
+    }
+
+    RenderedIcon& rendered = renderedIcons[thisDest];
+    if (rendered.signature == signature) {
+        combinedConstrBoxes[rendered.idString] = rendered.boundingBoxes;
+        return;
+    }
+
     // Tracks all constraint IDs that are combined into this icon
     QString idString;
     int lastVPad = 0;
@@ -2747,6 +2810,10 @@ void EditModeConstraintCoinManager::drawMergedConstraintIcons(IconQueue iconQueu
     combinedConstrBoxes[idString] = boundingBoxes;
     thisInfo->string.setValue(idString.toLatin1().data());
     sendConstraintIconToCoin(compositeIcon, thisDest);
+
+    rendered.signature = signature;
+    rendered.idString = idString;
+    rendered.boundingBoxes = boundingBoxes;
 }
 
 
@@ -2860,6 +2927,16 @@ void EditModeConstraintCoinManager::drawTypicalConstraintIcon(const constrIconQu
 {
     QColor color = constrColor(i.constraintId);
 
+    QString signature = iconSignature(i, color);
+    RenderedIcon& rendered = renderedIcons[i.destination];
+    if (rendered.signature == signature) {
+        return;
+    }
+
+    rendered.signature = signature;
+    rendered.idString.clear();
+    rendered.boundingBoxes.clear();
+
     QImage image
         = renderConstrIcon(i.type, color, QStringList(i.label), QList<QColor>() << color, i.iconRotation);
 
@@ -2919,7 +2996,24 @@ void EditModeConstraintCoinManager::sendConstraintIconToCoin(const QImage& icon,
 
 void EditModeConstraintCoinManager::clearCoinImage(SoImage* soImagePtr)
 {
+    // avoid notifying coin again for an image that is already cleared
+    auto it = renderedIcons.find(soImagePtr);
+    if (it != renderedIcons.end() && it->second.signature.isEmpty()) {
+        return;
+    }
+
     soImagePtr->setToDefaults();
+    renderedIcons[soImagePtr] = RenderedIcon();
+}
+
+QString EditModeConstraintCoinManager::iconSignature(
+    const constrIconQueueItem& item,
+    const QColor& color
+) const
+{
+    QChar sep = QLatin1Char('\n');
+    return item.type + sep + color.name(QColor::HexArgb) + sep + item.label + sep
+        + QString::number(item.iconRotation) + sep + QString::number(item.constraintId) + sep;
 }
 
 QColor EditModeConstraintCoinManager::constrColor(int constraintId)
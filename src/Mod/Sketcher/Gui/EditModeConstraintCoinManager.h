@@ -108,8 +108,13 @@ public:
 
 
     /** @name update coin nodes*/
-    // geometry list to be used for constraints, which may be a temporal geometry
-    void processConstraints(const GeoListFacade& geolistfacade);
+    // geometry list to be used for constraints, which may be a temporal geometry. If the changed
+    // geometry is given, constraints that didn't change and only refer to unchanged geometry are
+    // not updated.
+    void processConstraints(
+        const GeoListFacade& geolistfacade,
+        const std::set<int>* changedGeoIds = nullptr
+    );
 
     void updateVirtualSpace();
 
@@ -185,6 +190,31 @@ private:
     // helper data structures for the constraint rendering
     std::vector<Sketcher::ConstraintType> vConstrType;
 
+    /// The properties of a constraint its coin nodes are computed from
+    struct ConstraintState
+    {
+        explicit ConstraintState(const Sketcher::Constraint* constr = nullptr);
+        bool operator==(const ConstraintState&) const = default;
+
+        Sketcher::ConstraintType type {Sketcher::None};
+        int first {Sketcher::GeoEnum::GeoUndef};
+        int second {Sketcher::GeoEnum::GeoUndef};
+        int third {Sketcher::GeoEnum::GeoUndef};
+        Sketcher::PointPos firstPos {Sketcher::PointPos::none};
+        Sketcher::PointPos secondPos {Sketcher::PointPos::none};
+        Sketcher::PointPos thirdPos {Sketcher::PointPos::none};
+        double value {0};
+        float labelDistance {0};
+        float labelPosition {0};
+        std::string name;
+        bool isDriving {true};
+        bool isActive {true};
+    };
+
+    // state of the constraints when their coin nodes were last updated
+    std::vector<ConstraintState> constraintStates;
+    float constraintStatesZ {0};
+
     // For each of the combined constraint icons drawn, also create a vector
     // of bounding boxes and associated constraint IDs, to go from the icon's
     // pixel coordinates to the relevant constraint IDs.
@@ -199,6 +229,17 @@ private:
 
     std::map<QString, ConstrIconBBVec> combinedConstrBoxes;
 
+    /// The icon last sent to a SoImage, to only render icons that changed
+    struct RenderedIcon
+    {
+        QString signature;  // empty for a cleared image
+        QString idString;
+        ConstrIconBBVec boundingBoxes;
+    };
+
+    std::map<SoImage*, RenderedIcon> renderedIcons;
+    QString renderedIconStyle;
+
 
     /// Internal type used for drawing constraint icons
     struct constrIconQueueItem
@@ -261,6 +302,9 @@ private:
     /// Essentially a version of sendConstraintIconToCoin, with a blank icon
     void clearCoinImage(SoImage* soImagePtr);
 
+    /// Returns a string that differs if the rendered icon of the item would differ
+    QString iconSignature(const constrIconQueueItem& item, const QColor& color) const;
+
     /// Find helper angle for radius/diameter constraint
     void findHelperAngles(
         double& helperStartAngle,
@@ -24,6 +24,8 @@
 
 #include <FCConfig.h>
 
+#include <algorithm>
+
 #include <Base/Console.h>
 #include <Base/Exception.h>
 
@@ -41,13 +43,15 @@ EditModeGeometryCoinConverter::EditModeGeometryCoinConverter(
     GeometryLayerNodes& geometrylayernodes,
     DrawingParameters& drawingparameters,
     GeometryLayerParameters& geometryLayerParams,
-    CoinMapping& coinMap
+    CoinMapping& coinMap,
+    GeometryCoinCache& cache
 )
     : viewProvider(vp)
     , geometryLayerNodes(geometrylayernodes)
     , drawingParameters(drawingparameters)
     , geometryLayerParameters(geometryLayerParams)
     , coinMapping(coinMap)
+    , geometryCache(cache)
 {}
 
 void EditModeGeometryCoinConverter::convert(const Sketcher::GeoListFacade& geolistfacade)
@@ -56,6 +60,7 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeoListFacade& geoli
     // measurements
     bsplineGeoIds.clear();
     arcGeoIds.clear();
+    changedGeoIds.clear();
 
     // end information layer
     Points.clear();
@@ -84,6 +89,12 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeoListFacade& geoli
 
     pointCounter.resize(geometryLayerParameters.getCoinLayerCount(), 0);
 
+    pointLayerChanged.assign(geometryLayerParameters.getCoinLayerCount(), false);
+    curveLayerChanged.assign(
+        geometryLayerParameters.getCoinLayerCount(),
+        std::vector<bool>(geometryLayerParameters.getSubLayerCount(), false)
+    );
+
     auto setTracking = [this](
                            int geoId,
                            int coinLayer,
@@ -277,12 +288,35 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeoListFacade& geoli
         }
     }
 
+    // forget the geometry that was removed
+    for (auto it = geometryCache.entries.begin(); it != geometryCache.entries.end();) {
+        if (it->second.used) {
+            it->second.used = false;
+            ++it;
+        }
+        else {
+            changedGeoIds.insert(it->first);
+            it = geometryCache.entries.erase(it);
+        }
+    }
+
     // Coin Nodes Editing
     int vOrFactor = ViewProviderSketchCoinAttorney::getViewOrientationFactor(viewProvider);
     double linez = vOrFactor * static_cast<double>(drawingParameters.zLowLines);  // NOLINT
     double pointz = vOrFactor * static_cast<double>(drawingParameters.zLowPoints);
 
+    // a node only needs to be rewritten if it gets other geometry or some of its geometry changed
+    bool reuseNodes = geometryCache.nodesValid && geometryCache.pointZ == pointz
+        && geometryCache.lineZ == linez
+        && geometryCache.pointGeoIds.size() == coinMapping.PointIdToGeoId.size()
+        && geometryCache.curveGeoIds.size() == coinMapping.CurvIdToGeoId.size();
+
     for (auto l = 0; l < geometryLayerParameters.getCoinLayerCount(); l++) {
+        if (reuseNodes && !pointLayerChanged[l]
+            && geometryCache.pointGeoIds[l] == coinMapping.PointIdToGeoId[l]) {
+            continue;
+        }
+
         geometryLayerNodes.PointsCoordinate[l]->point.setNum(Points[l].size());
         geometryLayerNodes.PointsMaterials[l]->diffuseColor.setNum(Points[l].size());
         SbVec3f* pverts = geometryLayerNodes.PointsCoordinate[l]->point.startEditing();
@@ -292,8 +326,16 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeoListFacade& geoli
             pverts[i++].setValue(point.x, point.y, pointz);
         }
         geometryLayerNodes.PointsCoordinate[l]->point.finishEditing();
+    }
 
+    for (auto l = 0; l < geometryLayerParameters.getCoinLayerCount(); l++) {
         for (auto t = 0; t < geometryLayerParameters.getSubLayerCount(); t++) {
+            if (reuseNodes && !curveLayerChanged[l][t]
+                && geometryCache.curveGeoIds[l].size() == coinMapping.CurvIdToGeoId[l].size()
+                && geometryCache.curveGeoIds[l][t] == coinMapping.CurvIdToGeoId[l][t]) {
+                continue;
+            }
+
             geometryLayerNodes.CurvesCoordinate[l][t]->point.setNum(Coords[l][t].size());
             geometryLayerNodes.CurveSet[l][t]->numVertices.setNum(Index[l][t].size());
             geometryLayerNodes.CurvesMaterials[l][t]->diffuseColor.setNum(Index[l][t].size());
@@ -301,7 +343,7 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeoListFacade& geoli
             SbVec3f* verts = geometryLayerNodes.CurvesCoordinate[l][t]->point.startEditing();
             int32_t* index = geometryLayerNodes.CurveSet[l][t]->numVertices.startEditing();
 
-            i = 0;  // setting up the line set
+            int i = 0;  // setting up the line set
             for (auto& coord : Coords[l][t]) {
                 verts[i++].setValue(coord.x, coord.y, linez);  // NOLINT
             }
@@ -315,6 +357,12 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeoListFacade& geoli
             geometryLayerNodes.CurveSet[l][t]->numVertices.finishEditing();
         }
     }
+
+    geometryCache.nodesValid = true;
+    geometryCache.pointZ = pointz;
+    geometryCache.lineZ = linez;
+    geometryCache.pointGeoIds = coinMapping.PointIdToGeoId;
+    geometryCache.curveGeoIds = coinMapping.CurvIdToGeoId;
 }
 
 template<
@@ -333,7 +381,22 @@ void EditModeGeometryCoinConverter::convert(
 
     auto coinLayer = geometryLayerParameters.getSafeCoinLayer(layerId);
 
-    auto addPoint = [&dMg = boundingBoxMaxMagnitude](auto& pushvector, Base::Vector3d point) {
+    // curves are only tessellated again if they changed, points and lines are cheap to compute
+    constexpr bool tessellated = curvemode == CurveMode::ClosedCurve
+        || curvemode == CurveMode::OpenCurve;
+    if constexpr (tessellated) {
+        if (restoreFromCache(geoid, geo, coinLayer, subLayer)) {
+            return;
+        }
+    }
+
+    std::size_t firstPoint = Points[coinLayer].size();
+    std::size_t firstCoord = Coords[coinLayer][subLayer].size();
+    std::size_t firstIndex = Index[coinLayer][subLayer].size();
+    float magnitude = 0;
+    [[maybe_unused]] double combScale = 0;
+
+    auto addPoint = [&dMg = magnitude](auto& pushvector, Base::Vector3d point) {
         if constexpr (analysemode == AnalyseMode::BoundingBoxMagnitude
                       || analysemode == AnalyseMode::BoundingBoxMagnitudeAndBSplineCurvature) {
             dMg = dMg > std::abs(point.x) ? dMg : std::abs(point.x);
@@ -467,9 +530,119 @@ void EditModeGeometryCoinConverter::convert(
                     / maxcurv;  // just a factor to make a comb reasonably visible
             }
 
-            if (temprepscale > combrepscale) {
-                combrepscale = temprepscale;
-            }
+            combScale = temprepscale;
+        }
+    }
+
+    storeInCache(
+        geoid,
+        tessellated ? geo : nullptr,
+        coinLayer,
+        subLayer,
+        firstPoint,
+        firstCoord,
+        firstIndex,
+        magnitude,
+        combScale
+    );
+}
+
+bool EditModeGeometryCoinConverter::restoreFromCache(
+    int geoId,
+    const Part::Geometry* geo,
+    int coinLayer,
+    int subLayer
+)
+{
+    auto it = geometryCache.entries.find(geoId);
+    if (it == geometryCache.entries.end()) {
+        return false;
+    }
+
+    auto& entry = it->second;
+    if (!entry.geometry || entry.coinLayer != coinLayer || entry.subLayer != subLayer
+        || entry.segments != drawingParameters.curvedEdgeCountSegments
+        || !entry.geometry->isSame(*geo, 0.0, 0.0)) {
+        return false;
+    }
+
+    Points[coinLayer].insert(Points[coinLayer].end(), entry.points.begin(), entry.points.end());
+    auto& coords = Coords[coinLayer][subLayer];
+    coords.insert(coords.end(), entry.coords.begin(), entry.coords.end());
+    auto& index = Index[coinLayer][subLayer];
+    index.insert(index.end(), entry.index.begin(), entry.index.end());
+
+    boundingBoxMaxMagnitude = std::max(boundingBoxMaxMagnitude, entry.boundingBoxMaxMagnitude);
+    combrepscale = std::max(combrepscale, entry.combRepresentationScale);
+    entry.used = true;
+    return true;
+}
+
+void EditModeGeometryCoinConverter::storeInCache(
+    int geoId,
+    const Part::Geometry* geo,
+    int coinLayer,
+    int subLayer,
+    std::size_t firstPoint,
+    std::size_t firstCoord,
+    std::size_t firstIndex,
+    float magnitude,
+    double combScale
+)
+{
+    boundingBoxMaxMagnitude = std::max(boundingBoxMaxMagnitude, magnitude);
+    combrepscale = std::max(combrepscale, combScale);
+
+    auto& entry = geometryCache.entries[geoId];
+    auto pointsBegin = Points[coinLayer].begin() + std::ptrdiff_t(firstPoint);
+    auto coordsBegin = Coords[coinLayer][subLayer].begin() + std::ptrdiff_t(firstCoord);
+    auto indexBegin = Index[coinLayer][subLayer].begin() + std::ptrdiff_t(firstIndex);
+
+    // a tessellated curve that is not restored from the cache has changed
+    bool changed = geo || entry.geometry || entry.coinLayer != coinLayer
+        || entry.subLayer != subLayer
+        || !std::equal(
+            pointsBegin,
+            Points[coinLayer].end(),
+            entry.points.begin(),
+            entry.points.end()
+        )
+        || !std::equal(
+            coordsBegin,
+            Coords[coinLayer][subLayer].end(),
+            entry.coords.begin(),
+            entry.coords.end()
+        );
+
+    entry.used = true;
+    if (!changed) {
+        return;
+    }
+
+    // the layers of the old and the new position need to be rewritten
+    if (!entry.points.empty() || !entry.coords.empty()) {
+        markChanged(geoId, entry.coinLayer, entry.subLayer);
+    }
+    markChanged(geoId, coinLayer, subLayer);
+
+    entry.geometry.reset(geo ? geo->clone() : nullptr);
+    entry.coinLayer = coinLayer;
+    entry.subLayer = subLayer;
+    entry.segments = drawingParameters.curvedEdgeCountSegments;
+    entry.points.assign(pointsBegin, Points[coinLayer].end());
+    entry.coords.assign(coordsBegin, Coords[coinLayer][subLayer].end());
+    entry.index.assign(indexBegin, Index[coinLayer][subLayer].end());
+    entry.boundingBoxMaxMagnitude = magnitude;
+    entry.combRepresentationScale = combScale;
+}
+
+void EditModeGeometryCoinConverter::markChanged(int geoId, int coinLayer, int subLayer)
+{
+    changedGeoIds.insert(geoId);
+    if (coinLayer < int(pointLayerChanged.size())) {
+        pointLayerChanged[coinLayer] = true;
+        if (subLayer < int(curveLayerChanged[coinLayer].size())) {
+            curveLayerChanged[coinLayer][subLayer] = true;
         }
     }
 }
@@ -25,6 +25,9 @@
 #ifndef SKETCHERGUI_GeometryCoinConverter_H
 #define SKETCHERGUI_GeometryCoinConverter_H
 
+#include <map>
+#include <memory>
+#include <set>
 #include <vector>
 
 #include "ViewProviderSketch.h"
@@ -57,6 +60,41 @@ struct DrawingParameters;
 class GeometryLayerParameters;
 struct CoinMapping;
 
+/** @brief      Struct storing the result of the last conversion of the geometry
+ *  @details
+ * It is kept by the owner of the coin nodes from one conversion to the next, so that only the
+ * geometry that changed since the last conversion is tessellated again and only the coin nodes
+ * whose content changed are rewritten. This matters when dragging in a big sketch, where most of
+ * the geometry does not move.
+ */
+struct GeometryCoinCache
+{
+    /// The drawing elements of a single geometry
+    struct Entry
+    {
+        // copy of a tessellated curve to detect changes, not set for points and lines
+        std::unique_ptr<Part::Geometry> geometry;
+        int coinLayer = 0;
+        int subLayer = 0;
+        int segments = 0;
+        std::vector<Base::Vector3d> points;
+        std::vector<Base::Vector3d> coords;
+        std::vector<unsigned int> index;
+        float boundingBoxMaxMagnitude = 0;
+        double combRepresentationScale = 0;
+        bool used = false;
+    };
+
+    std::map<int, Entry> entries;
+
+    // content of the coin nodes written by the last conversion
+    bool nodesValid = false;
+    double pointZ = 0;
+    double lineZ = 0;
+    std::vector<std::vector<int>> pointGeoIds;
+    std::vector<std::vector<std::vector<int>>> curveGeoIds;
+};
+
 /** @brief      Class for creating the Geometry layer into coin nodes
  *  @details
  * Responsibility:
@@ -110,13 +148,16 @@ public:
      * the geometry
      *
      * @param drawingparameters: Parameters for drawing the overlay information
+     *
+     * @param cache: The result of the last conversion into the same coin nodes
      */
     EditModeGeometryCoinConverter(
         ViewProviderSketch& vp,
         GeometryLayerNodes& geometrylayernodes,
         DrawingParameters& drawingparameters,
         GeometryLayerParameters& geometryLayerParams,
-        CoinMapping& coinMap
+        CoinMapping& coinMap,
+        GeometryCoinCache& cache
     );
 
     /**
@@ -154,6 +195,14 @@ public:
         return std::move(arcGeoIds);
     }
 
+    /**
+     * returns the GeoIds of geometries that changed since the last conversion
+     */
+    auto getChangedGeoIds()
+    {
+        return std::move(changedGeoIds);
+    }
+
 private:
     template<typename GeoType, PointsMode pointmode, CurveMode curvemode, AnalyseMode analysemode>
     void convert(
@@ -162,6 +211,24 @@ private:
         [[maybe_unused]] int subLayerId = 0
     );
 
+    /// appends the drawing elements of the last conversion if the curve didn't change
+    bool restoreFromCache(int geoId, const Part::Geometry* geo, int coinLayer, int subLayer);
+
+    /// stores the drawing elements appended for a geometry starting at the given positions
+    void storeInCache(
+        int geoId,
+        const Part::Geometry* geo,
+        int coinLayer,
+        int subLayer,
+        std::size_t firstPoint,
+        std::size_t firstCoord,
+        std::size_t firstIndex,
+        float magnitude,
+        double combScale
+    );
+
+    void markChanged(int geoId, int coinLayer, int subLayer);
+
 private:
     /// Reference to ViewProviderSketch in order to access the public and the Attorney Interface
     ViewProviderSketch& viewProvider;
@@ -190,6 +257,12 @@ private:
                               // calculation.
     std::vector<int> bsplineGeoIds;
     std::vector<int> arcGeoIds;
+
+    // incremental update
+    GeometryCoinCache& geometryCache;
+    std::set<int> changedGeoIds;
+    std::vector<bool> pointLayerChanged;
+    std::vector<std::vector<bool>> curveLayerChanged;
 };
 
 
@@ -67,6 +67,7 @@ EditModeGeometryCoinManager::EditModeGeometryCoinManager(
     , analysisResults(analysisResultStruct)
     , editModeScenegraphNodes(editModeScenegraph)
     , coinMapping(coinMap)
+    , geometryCache(std::make_unique<GeometryCoinCache>())
 {}
 
 EditModeGeometryCoinManager::~EditModeGeometryCoinManager()
@@ -112,7 +113,8 @@ void EditModeGeometryCoinManager::processGeometry(const GeoListFacade& geolistfa
         geometrylayernodes,
         drawingParameters,
         geometryLayerParameters,
-        coinMapping
+        coinMapping,
+        *geometryCache
     );
 
     gcconv.convert(geolistfacade);
@@ -127,6 +129,7 @@ void EditModeGeometryCoinManager::processGeometry(const GeoListFacade& geolistfa
     );
     analysisResults.bsplineGeoIds = gcconv.getBSplineGeoIds();
     analysisResults.arcGeoIds = gcconv.getArcGeoIds();
+    analysisResults.changedGeoIds = gcconv.getChangedGeoIds();
 }
 
 void EditModeGeometryCoinManager::updateGeometryColor(
@@ -596,6 +599,8 @@ void EditModeGeometryCoinManager::updateGeometryLayersConfiguration()
     emptyGeometryRootNodes();
     createEditModePointInventorNodes();
     createEditModeCurveInventorNodes();
+
+    geometryCache->nodesValid = false;
 }
 
 auto concat(std::string string, int i)
@@ -613,6 +618,8 @@ void EditModeGeometryCoinManager::createEditModeInventorNodes()
     createEditModePointInventorNodes();
 
     createEditModeCurveInventorNodes();
+
+    geometryCache->nodesValid = false;
 }
 
 void EditModeGeometryCoinManager::createGeometryRootNodes()
@@ -26,6 +26,7 @@
 #define SKETCHERGUI_EditModeGeometryCoinManager_H
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include <Mod/Sketcher/App/GeoList.h>
@@ -64,6 +65,7 @@ namespace SketcherGui
 
 class ViewProviderSketch;
 class EditModeConstraintCoinManager;
+struct GeometryCoinCache;
 
 using GeoList = Sketcher::GeoList;
 using GeoListFacade = Sketcher::GeoListFacade;
@@ -126,6 +128,9 @@ private:
     EditModeScenegraphNodes& editModeScenegraphNodes;
 
     CoinMapping& coinMapping;
+
+    // result of the last conversion, to only update the changed geometry
+    std::unique_ptr<GeometryCoinCache> geometryCache;
 };
 
 
@@ -3149,8 +3149,10 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationoverl
     // ============== Render geometry, constraints and geometry information overlays
     // ==================================
 
+    // while dragging only the constraints of the moved geometry need an update
     editCoinManager->processGeometryConstraintsInformationOverlay(geolistfacade,
-                                                                  rebuildinformationoverlay);
+                                                                  rebuildinformationoverlay,
+                                                                  temp);
 
     // Avoids unneeded calls to pixmapFromSvg
     if (Mode == STATUS_NONE || Mode == STATUS_SKETCH_UseHandler) {
@@ -22,7 +22,9 @@
 
 
 # include <algorithm>
+# include <cmath>
 # include <limits>
+# include <numeric>
 # include <sstream>
 #include <Bnd_Box.hxx>
 #include <BRep_Tool.hxx>
@@ -44,6 +46,8 @@
 
 #include <BOPAlgo_Builder.hxx>
 
+#include <QtConcurrentMap>
+
 #include <Base/Console.h>
 #include <Base/Parameter.h>
 
@@ -249,6 +253,58 @@ std::vector<TopoDS_Edge> DrawProjectSplit::split1Edge(TopoDS_Edge e, std::vector
     return result;
 }
 
+//find the points where an end of an edge touches the interior of another edge.  HLR does not
+//provide all of these intersections.  The splits are ordered by the edge that touches.
+std::vector<splitPoint> DrawProjectSplit::findSplitPoints(const std::vector<TopoDS_Edge>& edges)
+{
+    edgeBoxIndex index(edges);
+
+    //the edges are only read, so they can be checked in parallel
+    std::vector<int> edgeIndexes(edges.size());
+    std::iota(edgeIndexes.begin(), edgeIndexes.end(), 0);
+    std::vector<Bnd_Box> optimalBoxes(edges.size());
+    std::vector<char> zeroEdges(edges.size());
+    QtConcurrent::blockingMap(edgeIndexes, [&](int iEdge) {
+        BRepBndLib::AddOptimal(edges[iEdge], optimalBoxes[iEdge]);
+        optimalBoxes[iEdge].SetGap(0.1);
+        zeroEdges[iEdge] = DrawUtil::isZeroEdge(edges[iEdge]);
+    });
+
+    std::vector<std::vector<splitPoint>> splitsPerEdge(edges.size());
+    QtConcurrent::blockingMap(edgeIndexes, [&](int iOuter) {
+        const Bnd_Box& sOuter = optimalBoxes[iOuter];
+        if (sOuter.IsVoid() || zeroEdges[iOuter]) {
+            return;
+        }
+        TopoDS_Vertex v1 = TopExp::FirstVertex(edges[iOuter]);
+        TopoDS_Vertex v2 = TopExp::LastVertex(edges[iOuter]);
+        for (int iInner : index.findNear(iOuter)) {
+            const Bnd_Box& sInner = optimalBoxes[iInner];
+            if (zeroEdges[iInner] || sInner.IsVoid() || sOuter.IsOut(sInner)) {
+                continue;
+            }
+
+            double param = -1;
+            for (const auto& v : {v1, v2}) {
+                if (isOnEdge(edges[iInner], v, param, false)) {
+                    gp_Pnt pnt = BRep_Tool::Pnt(v);
+                    splitPoint s;
+                    s.i = iInner;
+                    s.v = Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z());
+                    s.param = param;
+                    splitsPerEdge[iOuter].push_back(s);
+                }
+            }
+        }
+    });
+
+    std::vector<splitPoint> result;
+    for (auto& splits : splitsPerEdge) {
+        result.insert(result.end(), splits.begin(), splits.end());
+    }
+    return result;
+}
+
 std::vector<splitPoint> DrawProjectSplit::sortSplits(std::vector<splitPoint>& s, bool ascend)
 {
     std::vector<splitPoint> sorted = s;
@@ -588,48 +644,74 @@ bool DrawProjectSplit::sameEndPoints(const TopoDS_Edge &e1, const TopoDS_Edge &e
 std::vector<TopoDS_Edge> DrawProjectSplit::removeOverlapEdges(const std::vector<TopoDS_Edge> &inEdges)
 {
 //    Base::Console().message("DPS::removeOverlapEdges() - %d edges in\n", inEdges.size());
-    std::vector<TopoDS_Edge> outEdges;
-    std::vector<TopoDS_Edge> overlapEdges;
-    std::vector<bool> skipThisEdge(inEdges.size(), false);
     int edgeCount = inEdges.size();
-    int ie0 = 0;
-    for (; ie0 < edgeCount; ie0++) {
-        if (skipThisEdge.at(ie0)) {
-            continue;
+
+    //only edges with intersecting boxes can overlap.  Edges that are connected through such
+    //pairs form a bucket, and the buckets are independent of each other.
+    edgeBoxIndex index(inEdges);
+    std::vector<std::vector<int>> nearEdges(edgeCount);
+    std::vector<int> bucketOf(edgeCount);
+    std::iota(bucketOf.begin(), bucketOf.end(), 0);
+    auto findBucket = [&bucketOf](int ie) {
+        while (bucketOf[ie] != ie) {
+            bucketOf[ie] = bucketOf[bucketOf[ie]];
+            ie = bucketOf[ie];
         }
-        int ie1 = ie0 + 1;
-        for (; ie1 < edgeCount; ie1++) {
-            if (skipThisEdge.at(ie1)) {
+        return ie;
+    };
+    for (int ie0 = 0; ie0 < edgeCount; ie0++) {
+        for (int ie1 : index.findNear(ie0)) {
+            if (ie1 > ie0) {
+                nearEdges[ie0].push_back(ie1);
+                bucketOf[findBucket(ie1)] = findBucket(ie0);
+            }
+        }
+    }
+
+    std::vector<std::vector<int>> buckets(edgeCount);
+    for (int ie = 0; ie < edgeCount; ie++) {
+        buckets[findBucket(ie)].push_back(ie);
+    }
+    auto isSingle = [](const std::vector<int>& bucket) { return bucket.size() < 2; };
+    buckets.erase(std::remove_if(buckets.begin(), buckets.end(), isSingle), buckets.end());
+
+    //not a vector<bool> since the buckets write to it concurrently
+    std::vector<char> skipThisEdge(edgeCount, false);
+    std::vector<std::vector<TopoDS_Edge>> overlapEdges(edgeCount);
+    QtConcurrent::blockingMap(buckets, [&](const std::vector<int>& bucket) {
+        for (int ie0 : bucket) {
+            if (skipThisEdge[ie0]) {
                 continue;
             }
-            int rc = isSubset(inEdges.at(ie0), inEdges.at(ie1));
-            if (rc == e0ISSUBSET) {
-                skipThisEdge.at(ie0) = true;
-                break;      //stop checking ie0
-            } else if (rc == e1ISSUBSET) {
-                skipThisEdge.at(ie1) = true;
-            } else if (rc == EDGEOVERLAP) {
-                skipThisEdge.at(ie0) = true;
-                skipThisEdge.at(ie1) = true;
-                std::vector<TopoDS_Edge> olap = fuseEdges(inEdges.at(ie0), inEdges.at(ie1));
-                if (!olap.empty()) {
-                    overlapEdges.insert(overlapEdges.end(), olap.begin(), olap.end());
+            for (int ie1 : nearEdges[ie0]) {
+                if (skipThisEdge[ie1]) {
+                    continue;
                 }
-                break;      //stop checking ie0
-            }
-        } //inner loop
-    } //outer loop
+                int rc = isSubset(inEdges[ie0], inEdges[ie1]);
+                if (rc == e0ISSUBSET) {
+                    skipThisEdge[ie0] = true;
+                    break;      //stop checking ie0
+                } else if (rc == e1ISSUBSET) {
+                    skipThisEdge[ie1] = true;
+                } else if (rc == EDGEOVERLAP) {
+                    skipThisEdge[ie0] = true;
+                    skipThisEdge[ie1] = true;
+                    overlapEdges[ie0] = fuseEdges(inEdges[ie0], inEdges[ie1]);
+                    break;      //stop checking ie0
+                }
+            } //inner loop
+        } //outer loop
+    });
 
-    int iOut = 0;
-    for (auto& e: inEdges) {
-        if (!skipThisEdge.at(iOut)) {
-            outEdges.push_back(e);
+    std::vector<TopoDS_Edge> outEdges;
+    for (int iOut = 0; iOut < edgeCount; iOut++) {
+        if (!skipThisEdge[iOut]) {
+            outEdges.push_back(inEdges[iOut]);
         }
-        iOut++;
     }
 
-    if (!overlapEdges.empty()) {
-        outEdges.insert(outEdges.end(), overlapEdges.begin(), overlapEdges.end());
+    for (auto& olap : overlapEdges) {
+        outEdges.insert(outEdges.end(), olap.begin(), olap.end());
     }
 
 //    Base::Console().message("DPS::removeOverlapEdges() - %d edges out\n", outEdges.size());
@@ -647,6 +729,8 @@ int DrawProjectSplit::isSubset(const TopoDS_Edge &edge0, const TopoDS_Edge &edge
     //bboxes of edges intersect
     FCBRepAlgoAPI_Common anOp;
     anOp.SetFuzzyValue (FUZZYADJUST * EWTOLERANCE);
+    //the edges may be shared with other threads
+    anOp.SetNonDestructive(Standard_True);
     TopTools_ListOfShape anArg1, anArg2;
     anArg1.Append (edge0);
     anArg2.Append (edge1);
@@ -685,6 +769,7 @@ std::vector<TopoDS_Edge> DrawProjectSplit::fuseEdges(const TopoDS_Edge &edge0, c
     std::vector<TopoDS_Edge> edgeList;
     FCBRepAlgoAPI_Fuse anOp;
     anOp.SetFuzzyValue (FUZZYADJUST * EWTOLERANCE);
+    anOp.SetNonDestructive(Standard_True);
     TopTools_ListOfShape anArg1, anArg2;
     anArg1.Append (edge0);
     anArg2.Append (edge1);
@@ -715,6 +800,95 @@ bool DrawProjectSplit::boxesIntersect(const TopoDS_Edge &edge0, const TopoDS_Edg
     return true;
 }
 
+//*************************
+//* edgeBoxIndex Methods
+//*************************
+edgeBoxIndex::edgeBoxIndex(const std::vector<TopoDS_Edge>& edges)
+{
+    //use the same generous boxes as DrawProjectSplit::boxesIntersect
+    Bnd_Box all;
+    boxes.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        BRepBndLib::Add(edges[i], boxes[i]);
+        if (!boxes[i].IsVoid()) {
+            boxes[i].SetGap(0.1);
+            all.Add(boxes[i]);
+        }
+    }
+    if (all.IsVoid()) {
+        return;
+    }
+
+    //the projected edges are in the XY plane.  Use about one cell per edge.
+    double xMax, yMax, zMin, zMax;
+    all.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    double width = xMax - xMin;
+    double height = yMax - yMin;
+    double count = static_cast<double>(edges.size());
+    cellSize = std::max({std::sqrt(width * height / count),
+                         std::max(width, height) / count,
+                         Precision::Confusion()});
+    constexpr int maxCells = 4096;     //per direction
+    columns = std::min(static_cast<int>(width / cellSize) + 1, maxCells);
+    rows = std::min(static_cast<int>(height / cellSize) + 1, maxCells);
+    cellSize = std::max(width / columns, height / rows);
+    if (cellSize <= 0.0) {
+        cellSize = 1.0;
+    }
+
+    cells.resize(static_cast<size_t>(columns) * rows);
+    for (size_t index = 0; index < boxes.size(); index++) {
+        if (boxes[index].IsVoid()) {
+            continue;
+        }
+        int iMin, jMin, iMax, jMax;
+        getCells(boxes[index], iMin, jMin, iMax, jMax);
+        for (int j = jMin; j <= jMax; j++) {
+            for (int i = iMin; i <= iMax; i++) {
+                cells[static_cast<size_t>(j) * columns + i].push_back(static_cast<int>(index));
+            }
+        }
+    }
+}
+
+void edgeBoxIndex::getCells(const Bnd_Box& box, int& iMin, int& jMin, int& iMax, int& jMax) const
+{
+    double x0, y0, z0, x1, y1, z1;
+    box.Get(x0, y0, z0, x1, y1, z1);
+    auto toCell = [this](double value, double origin, int count) {
+        int cell = static_cast<int>((value - origin) / cellSize);
+        return std::clamp(cell, 0, count - 1);
+    };
+    iMin = toCell(x0, xMin, columns);
+    iMax = toCell(x1, xMin, columns);
+    jMin = toCell(y0, yMin, rows);
+    jMax = toCell(y1, yMin, rows);
+}
+
+std::vector<int> edgeBoxIndex::findNear(int index) const
+{
+    std::vector<int> result;
+    const Bnd_Box& box = boxes.at(index);
+    if (box.IsVoid() || cells.empty()) {
+        return result;
+    }
+
+    int iMin, jMin, iMax, jMax;
+    getCells(box, iMin, jMin, iMax, jMax);
+    for (int j = jMin; j <= jMax; j++) {
+        for (int i = iMin; i <= iMax; i++) {
+            const std::vector<int>& cell = cells[static_cast<size_t>(j) * columns + i];
+            result.insert(result.end(), cell.begin(), cell.end());
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    auto isFar = [&](int other) { return other == index || box.IsOut(boxes[other]); };
+    result.erase(std::remove_if(result.begin(), result.end(), isFar), result.end());
+    return result;
+}
+
 //this is an aid to debugging and isn't used in normal processing.
 void DrawProjectSplit::dumpVertexMap(vertexMap verts)
 {
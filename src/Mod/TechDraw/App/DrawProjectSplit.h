@@ -23,6 +23,7 @@
 #ifndef DrawProjectSplit_h_
 #define DrawProjectSplit_h_
 
+#include <Bnd_Box.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Vertex.hxx>
 
@@ -91,6 +92,30 @@ public:
     bool validFlag;
 };
 
+//! a uniform 2d grid over the bounding boxes of a set of edges. Used to find the edges near an
+//! edge without comparing all pairs of edges.
+class edgeBoxIndex
+{
+public:
+    explicit edgeBoxIndex(const std::vector<TopoDS_Edge>& edges);
+    ~edgeBoxIndex() = default;
+
+    //! the indices of the other edges whose boxes intersect the box of this edge, ascending
+    std::vector<int> findNear(int index) const;
+    const Bnd_Box& getBox(int index) const { return boxes.at(index); }
+
+private:
+    void getCells(const Bnd_Box& box, int& iMin, int& jMin, int& iMax, int& jMax) const;
+
+    std::vector<Bnd_Box> boxes;
+    std::vector<std::vector<int>> cells;
+    double xMin {0.0};
+    double yMin {0.0};
+    double cellSize {1.0};
+    int columns {0};
+    int rows {0};
+};
+
 class TechDrawExport DrawProjectSplit
 {
 public:
@@ -104,6 +129,7 @@ public:
     static bool isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, bool allowEnds = false);
     static std::vector<TopoDS_Edge> splitEdges(std::vector<TopoDS_Edge> orig, std::vector<splitPoint> splits);
     static std::vector<TopoDS_Edge> split1Edge(TopoDS_Edge e, std::vector<splitPoint> splitPoints);
+    static std::vector<splitPoint> findSplitPoints(const std::vector<TopoDS_Edge>& edges);
 
     static std::vector<splitPoint> sortSplits(std::vector<splitPoint>& s, bool ascend);
     static bool splitCompare(const splitPoint& p1, const splitPoint& p2);
@@ -87,6 +87,7 @@
 #include "EdgeWalker.h"
 #include "Geometry.h"
 #include "GeometryObject.h"
+#include "HLRCache.h"
 #include "ShapeExtractor.h"
 #include "Preferences.h"
 #include "ShapeUtils.h"
@@ -148,6 +149,12 @@ DrawViewPart::DrawViewPart()
     ADD_PROPERTY_TYPE(ScrubCount, (Preferences::scrubCount()), sgroup, App::Prop_None,
                       "The number of times FreeCAD should try to clean the HLR result.");
 
+    //the saved HLR result is used instead of running HLR when the document is opened again
+    auto hidden = (App::PropertyType)(App::Prop_Hidden | App::Prop_Output | App::Prop_NoRecompute);
+    ADD_PROPERTY_TYPE(HlrCacheKey, (""), sgroup, hidden,
+                      "Identifies the shape and parameters of the saved HLR result");
+    ADD_PROPERTY_TYPE(HlrResult, (TopoDS_Shape()), sgroup, hidden, "The saved HLR result");
+
     //initialize bbox to non-garbage
     bbox = Base::BoundBox3d(Base::Vector3d(0.0, 0.0, 0.0), 0.0);
 }
@@ -252,6 +259,16 @@ App::DocumentObjectExecReturn* DrawViewPart::execute()
     return DrawView::execute();
 }
 
+void DrawViewPart::onDocumentRestored()
+{
+    //make the saved HLR result available before the view is executed
+    if (!HlrCacheKey.isEmpty() && !HlrResult.getValue().IsNull()) {
+        HLRCache::instance().add(HlrCacheKey.getStrValue(),
+                                 HLRCache::fromCompound(HlrResult.getValue()));
+    }
+    DrawView::onDocumentRestored();
+}
+
 short DrawViewPart::mustExecute() const
 {
     if (isRestoring()) {
@@ -396,6 +413,8 @@ void DrawViewPart::onHlrFinished()
         throw Base::RuntimeError("DrawViewPart has lost its geometry object");
     }
 
+    saveHlrResult();
+
     if (!hasGeometry()) {
         Base::Console().error("TechDraw did not retrieve any geometry for %s/%s\n",
                               getNameInDocument(), Label.getValue());
@@ -442,6 +461,25 @@ void DrawViewPart::onHlrFinished()
     }
 }
 
+//! keep the HLR result in the document, so it doesn't need to be recomputed after reopening
+void DrawViewPart::saveHlrResult()
+{
+    const std::string& key = geometryObject->getHlrKey();
+    if (key.empty() || !Preferences::saveHlrResults()) {
+        //the polygon algo isn't cached
+        if (!HlrCacheKey.isEmpty()) {
+            HlrCacheKey.setValue("");
+            HlrResult.setValue(TopoDS_Shape());
+        }
+        return;
+    }
+
+    if (key != HlrCacheKey.getStrValue()) {
+        HlrResult.setValue(HLRCache::toCompound(geometryObject->getHlrResult()));
+        HlrCacheKey.setValue(key);
+    }
+}
+
 //! run any tasks that need to been done after geometry is available
 void DrawViewPart::postHlrTasks()
 {
@@ -607,60 +645,7 @@ void DrawViewPart::findFacesOld(const std::vector<BaseGeomPtr> &goEdges)
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = nonZero.begin();
-    int iOuter = 0;
-    for (; itOuter != nonZero.end(); ++itOuter, iOuter++) {//*** itOuter != nonZero.end() - 1
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::AddOptimal(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            continue;                   //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = nonZero.begin();//***sb itOuter + 1;
-        for (; itInner != nonZero.end(); ++itInner, iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;//skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::AddOptimal(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {//bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (DrawProjectSplit::isOnEdge((*itInner), v1, param, false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(), pnt1.Y(), pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (DrawProjectSplit::isOnEdge((*itInner), v2, param, false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(), pnt2.Y(), pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        }//inner loop
-    }    //outer loop
+    std::vector<splitPoint> splits = DrawProjectSplit::findSplitPoints(nonZero);
 
     std::vector<splitPoint> sorted = DrawProjectSplit::sortSplits(splits, true);
     auto last = std::unique(sorted.begin(), sorted.end(),
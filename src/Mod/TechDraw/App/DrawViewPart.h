@@ -35,6 +35,7 @@
 #include <App/FeaturePython.h>
 #include <App/PropertyLinks.h>
 #include <Base/BoundBox.h>
+#include <Mod/Part/App/PropertyTopoShape.h>
 #include <Mod/TechDraw/TechDrawGlobal.h>
 
 #include "CosmeticExtension.h"
@@ -135,8 +136,12 @@ public:
 
     App::PropertyInteger ScrubCount;
 
+    App::PropertyString HlrCacheKey;
+    Part::PropertyPartShape HlrResult;
+
     short mustExecute() const override;
     App::DocumentObjectExecReturn* execute() override;
+    void onDocumentRestored() override;
     const char* getViewProviderName() const override { return "TechDrawGui::ViewProviderViewPart"; }
     PyObject* getPyObject() override;
     void handleChangedPropertyType(
@@ -252,6 +257,7 @@ public Q_SLOTS:
 
 protected:
     bool checkXDirection() const;
+    void saveHlrResult();
 
     TechDraw::GeometryObjectPtr geometryObject;
     TechDraw::GeometryObjectPtr m_tempGeometryObject;//holds the new GO until hlr is completed
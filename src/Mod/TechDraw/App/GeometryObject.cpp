@@ -71,6 +71,7 @@
 #include "DrawViewPart.h"
 #include "GeometryObject.h"
 #include "DrawProjectSplit.h"
+#include "HLRCache.h"
 #include "ShapeUtils.h"
 
 using namespace TechDraw;
@@ -141,6 +142,15 @@ void GeometryObject::projectShape(const TopoDS_Shape& inShape, const gp_Ax2& vie
 {
     clear();
 
+    //views of the same shape in the same direction share the HLR result
+    m_hlrKey = HLRCache::makeKey(inShape, viewAxis, m_isoCount, m_isPersp, m_focus);
+    HLRCache::Result cached;
+    if (HLRCache::instance().find(m_hlrKey, cached)) {
+        setHlrResult(cached);
+        makeTDGeometry();
+        return;
+    }
+
     Handle(HLRBRep_Algo) brep_hlr;
     try {
         brep_hlr = new HLRBRep_Algo();
@@ -241,9 +251,42 @@ void GeometryObject::projectShape(const TopoDS_Shape& inShape, const gp_Ax2& vie
             "GeometryObject::projectShape - unknown error occurred while extracting edges");
     }
 
+    HLRCache::instance().add(m_hlrKey, getHlrResult());
     makeTDGeometry();
 }
 
+//! returns the edge compounds of the last HLR run
+HLRCache::Result GeometryObject::getHlrResult() const
+{
+    HLRCache::Result result;
+    result[HLRCache::VisHard] = visHard;
+    result[HLRCache::VisOutline] = visOutline;
+    result[HLRCache::VisSmooth] = visSmooth;
+    result[HLRCache::VisSeam] = visSeam;
+    result[HLRCache::VisIso] = visIso;
+    result[HLRCache::HidHard] = hidHard;
+    result[HLRCache::HidOutline] = hidOutline;
+    result[HLRCache::HidSmooth] = hidSmooth;
+    result[HLRCache::HidSeam] = hidSeam;
+    result[HLRCache::HidIso] = hidIso;
+    return result;
+}
+
+//! use a previously computed HLR result instead of running HLR
+void GeometryObject::setHlrResult(const HLRCache::Result& result)
+{
+    visHard = result[HLRCache::VisHard];
+    visOutline = result[HLRCache::VisOutline];
+    visSmooth = result[HLRCache::VisSmooth];
+    visSeam = result[HLRCache::VisSeam];
+    visIso = result[HLRCache::VisIso];
+    hidHard = result[HLRCache::HidHard];
+    hidOutline = result[HLRCache::HidOutline];
+    hidSmooth = result[HLRCache::HidSmooth];
+    hidSeam = result[HLRCache::HidSeam];
+    hidIso = result[HLRCache::HidIso];
+}
+
 //convert the hlr output into TD Geometry
 void GeometryObject::makeTDGeometry()
 {
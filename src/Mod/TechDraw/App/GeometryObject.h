@@ -41,6 +41,7 @@
 #include <Base/Vector3D.h>
 
 #include "Geometry.h"
+#include "HLRCache.h"
 #include "ShapeUtils.h"
 
 
@@ -113,6 +114,11 @@ public:
     TopoDS_Shape getHidSeam() { return hidSeam; }
     TopoDS_Shape getHidIso() { return hidIso; }
 
+    //! the key of the last projectShape in the HLRCache
+    const std::string& getHlrKey() const { return m_hlrKey; }
+    HLRCache::Result getHlrResult() const;
+    void setHlrResult(const HLRCache::Result& result);
+
     void addVertex(TechDraw::VertexPtr v);
     void addEdge(TechDraw::BaseGeomPtr bg);
 
@@ -165,6 +171,7 @@ protected:
     double m_focus;
     bool m_usePolygonHLR;
     int m_scrubCount;
+    std::string m_hlrKey;
 };
 
 using GeometryObjectPtr = std::shared_ptr<GeometryObject>;
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include <BRep_Builder.hxx>
+#include <Standard_Version.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Iterator.hxx>
+
+#include <QCryptographicHash>
+
+#include <Mod/Part/App/TopoShape.h>
+
+#include "HLRCache.h"
+
+using namespace TechDraw;
+
+HLRCache& HLRCache::instance()
+{
+    static HLRCache cache;
+    return cache;
+}
+
+std::string HLRCache::makeKey(
+    const TopoDS_Shape& shape,
+    const gp_Ax2& viewAxis,
+    int isoCount,
+    bool perspective,
+    double focus
+)
+{
+    // the geometry is identified by its BRep text which doesn't contain any triangulation
+    std::ostringstream brep;
+    Part::TopoShape(shape).exportBrep(brep);
+    std::string text = brep.str();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+#if QT_VERSION < QT_VERSION_CHECK(6, 3, 0)
+    hash.addData(text.c_str(), static_cast<int>(text.size()));
+#else
+    hash.addData(QByteArrayView(text.c_str(), text.size()));
+#endif
+
+    auto writeDir = [](std::ostream& out, const gp_XYZ& xyz) {
+        out << ' ' << xyz.X() << ' ' << xyz.Y() << ' ' << xyz.Z();
+    };
+
+    // a different OCC version may give a different result
+    std::ostringstream key;
+    key << std::setprecision(std::numeric_limits<double>::max_digits10)
+        << hash.result().toHex().constData() << ' ' << OCC_VERSION_STRING_EXT;
+    writeDir(key, viewAxis.Location().XYZ());
+    writeDir(key, viewAxis.Direction().XYZ());
+    writeDir(key, viewAxis.XDirection().XYZ());
+    key << ' ' << isoCount << ' ' << perspective;
+    if (perspective) {
+        key << ' ' << focus;
+    }
+    return key.str();
+}
+
+TopoDS_Shape HLRCache::toCompound(const Result& result)
+{
+    // a missing category is stored as empty compound to keep the order
+    BRep_Builder builder;
+    TopoDS_Compound compound;
+    builder.MakeCompound(compound);
+    for (const auto& it : result) {
+        if (it.IsNull()) {
+            TopoDS_Compound empty;
+            builder.MakeCompound(empty);
+            builder.Add(compound, empty);
+        }
+        else {
+            builder.Add(compound, it);
+        }
+    }
+    return compound;
+}
+
+HLRCache::Result HLRCache::fromCompound(const TopoDS_Shape& compound)
+{
+    Result result;
+    if (compound.IsNull()) {
+        return result;
+    }
+
+    std::size_t index = 0;
+    for (TopoDS_Iterator it(compound); it.More() && index < result.size(); it.Next(), index++) {
+        const TopoDS_Shape& shape = it.Value();
+        if (shape.ShapeType() == TopAbs_COMPOUND && !TopoDS_Iterator(shape).More()) {
+            continue;
+        }
+        result[index] = shape;
+    }
+    return result;
+}
+
+bool HLRCache::find(const std::string& key, Result& result)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return false;
+    }
+
+    recent.splice(recent.begin(), recent, it->second.pos);
+    result = it->second.result;
+    return true;
+}
+
+void HLRCache::add(const std::string& key, const Result& result)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        it->second.result = result;
+        recent.splice(recent.begin(), recent, it->second.pos);
+        return;
+    }
+
+    recent.push_front(key);
+    entries[key] = {result, recent.begin()};
+    while (entries.size() > maxEntries) {
+        entries.erase(recent.back());
+        recent.pop_back();
+    }
+}
+
+void HLRCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    recent.clear();
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TECHDRAW_HLRCACHE_H
+#define TECHDRAW_HLRCACHE_H
+
+#include <Mod/TechDraw/TechDrawGlobal.h>
+
+#include <array>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <TopoDS_Shape.hxx>
+#include <gp_Ax2.hxx>
+
+//! a cache of hidden line removal results. Views that project the same shape in the same
+//! direction with the same options share one HLR run. The results can be stored in the
+//! document, so reopened drawings don't need to run HLR again.
+
+namespace TechDraw
+{
+
+class TechDrawExport HLRCache
+{
+public:
+    //! the edge compounds delivered by HLR in the order of GeometryObject
+    enum Category
+    {
+        VisHard,
+        VisOutline,
+        VisSmooth,
+        VisSeam,
+        VisIso,
+        HidHard,
+        HidOutline,
+        HidSmooth,
+        HidSeam,
+        HidIso,
+        CategoryCount
+    };
+    using Result = std::array<TopoDS_Shape, CategoryCount>;
+
+    static HLRCache& instance();
+
+    //! returns a key that identifies the geometry of the shape and the HLR parameters. The key
+    //! is independent of the session, so it can be compared with a key saved in a document.
+    static std::string makeKey(
+        const TopoDS_Shape& shape,
+        const gp_Ax2& viewAxis,
+        int isoCount,
+        bool perspective,
+        double focus
+    );
+
+    //! packs a result into a single compound and back, e.g. to save it in a property
+    static TopoDS_Shape toCompound(const Result& result);
+    static Result fromCompound(const TopoDS_Shape& compound);
+
+    bool find(const std::string& key, Result& result);
+    void add(const std::string& key, const Result& result);
+    void clear();
+
+private:
+    HLRCache() = default;
+
+    // least-recently-used list of keys
+    using KeyList = std::list<std::string>;
+    struct Entry
+    {
+        Result result;
+        KeyList::iterator pos;
+    };
+
+    static constexpr std::size_t maxEntries = 100;
+
+    std::mutex mutex;
+    KeyList recent;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+}  // namespace TechDraw
+
+#endif  // TECHDRAW_HLRCACHE_H
@@ -440,6 +440,13 @@ int Preferences::scrubCount()
     return getPreferenceGroup("General")->GetInt("ScrubCount", 1);
 }
 
+//! true if the HLR results of the views should be saved in the document, so they don't need
+//! to be recomputed when the document is opened again
+bool Preferences::saveHlrResults()
+{
+    return getPreferenceGroup("General")->GetBool("SaveHLRResults", true);
+}
+
 //! Returns the factor for the overlap of svg tiles when hatching faces
 double Preferences::svgHatchFactor()
 {
@@ -9,6 +9,8 @@
 #include <App/Document.h>
 #include <App/DocumentObject.h>
 #include <App/GeoFeatureGroupExtension.h>
+#include <App/Link.h>
+#include <App/Part.h>
 #include <Base/Interpreter.h>
 
 using namespace App;
@@ -155,4 +157,60 @@ TEST_F(DocumentObjectTest, getSubObjectList)
     EXPECT_EQ(sizesFlatten[1], strlen(fuseName) + strlen(boxName) + 2);
 }
 
+TEST_F(DocumentObjectTest, getCachedSubObject)
+{
+    // Arrange
+    auto outer {static_cast<App::Part*>(_doc->addObject("App::Part"))};
+    auto inner {static_cast<App::Part*>(_doc->addObject("App::Part"))};
+    outer->addObject(inner);
+    inner->Placement.setValue(Base::Placement(Base::Vector3d(1, 2, 3), Base::Rotation()));
+    auto subName {std::string(inner->getNameInDocument()) + "."};
+
+    // Act
+    Base::Matrix4D mat;
+    auto sobj {outer->getCachedSubObject(subName.c_str(), &mat)};
+    Base::Matrix4D matCached;
+    auto sobjCached {outer->getCachedSubObject(subName.c_str(), &matCached)};
+
+    // Assert
+    EXPECT_EQ(sobj, inner);
+    EXPECT_EQ(sobjCached, inner);
+    EXPECT_EQ(mat, matCached);
+    EXPECT_EQ(mat.getCol(3), Base::Vector3d(1, 2, 3));
+
+    // A change of an object along the path drops the cached result
+    inner->Placement.setValue(Base::Placement(Base::Vector3d(4, 5, 6), Base::Rotation()));
+    mat.setToUnity();
+    EXPECT_EQ(outer->getCachedSubObject(subName.c_str(), &mat), inner);
+    EXPECT_EQ(mat.getCol(3), Base::Vector3d(4, 5, 6));
+
+    outer->removeObject(inner);
+    EXPECT_EQ(outer->getCachedSubObject(subName.c_str()), nullptr);
+}
+
+TEST_F(DocumentObjectTest, getCachedSubObjectThroughLink)
+{
+    // Arrange
+    auto outer {static_cast<App::Part*>(_doc->addObject("App::Part"))};
+    auto source {static_cast<App::Part*>(_doc->addObject("App::Part"))};
+    auto mid {static_cast<App::Part*>(_doc->addObject("App::Part"))};
+    auto inner {static_cast<App::Part*>(_doc->addObject("App::Part"))};
+    source->addObject(mid);
+    mid->addObject(inner);
+    auto link {static_cast<App::Link*>(_doc->addObject("App::Link"))};
+    link->LinkedObject.setValue(source, (std::string(mid->getNameInDocument()) + ".").c_str());
+    outer->addObject(link);
+    auto subName {std::string(link->getNameInDocument()) + "." + inner->getNameInDocument() + "."};
+
+    // Act
+    auto sobj {outer->getCachedSubObject(subName.c_str())};
+
+    // Assert
+    EXPECT_EQ(sobj, inner);
+
+    // The link resolves its target through 'source', which isn't part of the path itself
+    source->removeObject(mid);
+    EXPECT_EQ(outer->getCachedSubObject(subName.c_str()), nullptr);
+}
+
 // NOLINTEND(readability-magic-numbers, cppcoreguidelines-avoid-magic-numbers)
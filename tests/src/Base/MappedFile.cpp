@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/MappedFile.h>
+#include <Base/Stream.h>
+
+class MappedFileTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        file.setFile(Base::FileInfo::getTempFileName("mappedfile"));
+    }
+
+    void TearDown() override
+    {
+        file.deleteFile();
+    }
+
+    void write(const std::string& content)
+    {
+        Base::ofstream str(file, std::ios::out | std::ios::binary);
+        str << content;
+        str.close();
+    }
+
+protected:
+    Base::FileInfo file;
+};
+
+TEST_F(MappedFileTest, TestMapContent)
+{
+    write("line 1\nline 2\n");
+    Base::MappedFile mapped(file.filePath());
+    EXPECT_TRUE(mapped.isOpen());
+    EXPECT_EQ(mapped.size(), 14);
+    EXPECT_EQ(mapped.view(), "line 1\nline 2\n");
+}
+
+TEST_F(MappedFileTest, TestMapEmptyFile)
+{
+    write("");
+    Base::MappedFile mapped(file.filePath());
+    EXPECT_FALSE(mapped.isOpen());
+    EXPECT_EQ(mapped.size(), 0);
+    EXPECT_TRUE(mapped.view().empty());
+}
+
+TEST_F(MappedFileTest, TestMapMissingFile)
+{
+    EXPECT_THROW(Base::MappedFile(file.filePath() + ".missing"), Base::FileException);
+}
+
+TEST_F(MappedFileTest, TestMove)
+{
+    write("content");
+    Base::MappedFile mapped(file.filePath());
+    Base::MappedFile other(std::move(mapped));
+    EXPECT_FALSE(mapped.isOpen());  // NOLINT
+    EXPECT_EQ(other.view(), "content");
+    other.close();
+    EXPECT_FALSE(other.isOpen());
+}
+
+TEST(SplitAtLines, TestChunksEndAtLineFeed)
+{
+    std::string_view data("aaaa\nbb\ncccccc\nd");
+    auto chunks = Base::splitAtLines(data, 3);
+    ASSERT_EQ(chunks.size(), 4);
+    EXPECT_EQ(chunks[0], "aaaa\n");
+    EXPECT_EQ(chunks[1], "bb\n");
+    EXPECT_EQ(chunks[2], "cccccc\n");
+    EXPECT_EQ(chunks[3], "d");
+}
+
+TEST(SplitAtLines, TestSingleChunk)
+{
+    std::string_view data("aaaa\nbb\n");
+    auto chunks = Base::splitAtLines(data, 100);
+    ASSERT_EQ(chunks.size(), 1);
+    EXPECT_EQ(chunks[0], data);
+}
+
+TEST(SplitAtLines, TestEmpty)
+{
+    EXPECT_TRUE(Base::splitAtLines({}, 10).empty());
+}
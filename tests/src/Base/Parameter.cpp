@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <boost/core/ignore_unused.hpp>
+#include <chrono>
 #include <QLockFile>
 #include <Base/FileInfo.h>
 #include <Base/Parameter.h>
@@ -462,4 +463,113 @@ TEST_F(ParameterTest, TestLockFile)
     lockFile2.unlock();
 }
 
+TEST_F(ParameterTest, TestCachedValues)
+{
+    auto cfg = getCreateConfig();
+    auto grp = cfg->GetGroup("TopLevelGroup");
+
+    // a missing parameter is cached as well
+    EXPECT_EQ(grp->GetInt("Int", 1), 1);
+    EXPECT_EQ(grp->GetInt("Int", 2), 2);
+    grp->SetInt("Int", 3);
+    EXPECT_EQ(grp->GetInt("Int", 1), 3);
+    grp->RemoveInt("Int");
+    EXPECT_EQ(grp->GetInt("Int", 1), 1);
+
+    grp->SetASCII("String", "Value1");
+    EXPECT_EQ(grp->GetASCII("String"), "Value1");
+    grp->SetASCII("String", "Value2");
+    EXPECT_EQ(grp->GetASCII("String"), "Value2");
+
+    // the same name with a different type
+    grp->SetBool("String", true);
+    EXPECT_EQ(grp->GetASCII("String"), "Value2");
+    EXPECT_EQ(grp->GetBool("String", false), true);
+
+    grp->Clear();
+    EXPECT_EQ(grp->GetASCII("String", "Value3"), "Value3");
+    EXPECT_EQ(grp->GetBool("String", false), false);
+}
+
+TEST_F(ParameterTest, TestCachedValuesWithoutName)
+{
+    auto cfg = getCreateConfig();
+    auto grp = cfg->GetGroup("TopLevelGroup");
+
+    // without a name the first parameter of the type is read
+    EXPECT_EQ(grp->GetInt(nullptr, 1), 1);
+    grp->SetInt("Int", 2);
+    EXPECT_EQ(grp->GetInt(nullptr, 1), 2);
+    EXPECT_EQ(grp->GetInt("Int", 1), 2);
+}
+
+TEST_F(ParameterTest, TestCachedValuesInObserver)
+{
+    class ValueObserver: public ParameterGrp::ObserverType
+    {
+    public:
+        void OnChange(ParameterGrp::SubjectType& rCaller, ParameterGrp::MessageType Reason) override
+        {
+            auto& grp = static_cast<ParameterGrp&>(rCaller);
+            value = grp.GetFloat(Reason, -1.0);
+        }
+        double value {};
+    };
+
+    auto cfg = getCreateConfig();
+    auto grp = cfg->GetGroup("TopLevelGroup");
+    grp->SetFloat("Float", 1.5);
+
+    ValueObserver obs;
+    grp->Attach(&obs);
+    grp->SetFloat("Float", 2.5);
+    EXPECT_EQ(obs.value, 2.5);
+    grp->RemoveFloat("Float");
+    EXPECT_EQ(obs.value, -1.0);
+    grp->Detach(&obs);
+}
+
+TEST_F(ParameterTest, TestCachedValuesAfterImport)
+{
+    auto cfg = getCreateConfig();
+    auto grp = cfg->GetGroup("TopLevelGroup");
+    grp->SetUnsigned("Unsigned", 1);
+
+    std::string fn = getFileName();
+    cfg->exportTo(fn.c_str());
+
+    grp->SetUnsigned("Unsigned", 2);
+    EXPECT_EQ(grp->GetUnsigned("Unsigned"), 2);
+
+    cfg->importFrom(fn.c_str());
+    EXPECT_EQ(grp->GetUnsigned("Unsigned"), 1);
+}
+
+TEST_F(ParameterTest, BenchmarkRead)
+{
+    auto cfg = getCreateConfig();
+    auto grp = cfg->GetGroup("TopLevelGroup");
+
+    // many parameters make the search in the DOM slow
+    const int count = 200;
+    for (int i = 0; i < count; i++) {
+        grp->SetFloat(("Float" + std::to_string(i)).c_str(), i);
+        grp->SetBool(("Bool" + std::to_string(i)).c_str(), true);
+    }
+
+    const int reads = 100000;
+    double sum {};
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < reads; i++) {
+        sum += grp->GetFloat("Float199");
+        sum += grp->GetBool("Bool199") ? 1.0 : 0.0;
+        sum += grp->GetFloat("Missing", 0.0);
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    EXPECT_EQ(sum, 200.0 * reads);
+    RecordProperty("ReadsPerMicrosecond", static_cast<int>(3 * reads / (duration.count() + 1)));
+}
+
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -7,6 +7,7 @@
 #endif
 
 #include "Base/Stream.h"
+#include "Base/Vector3D.h"
 
 
 class TextOutputStreamTest: public ::testing::Test
@@ -125,3 +126,102 @@ TEST_F(TextStreamIntegrationTest, OutputThenInputMultiLineWithCarriageReturns)
     // Assert
     EXPECT_EQ(multiLineStringResult, result);
 }
+
+TEST(BinaryStreamTest, BulkWriteMatchesSingleValues)
+{
+    // Arrange
+    std::vector<double> values(3000);
+    for (std::size_t i = 0; i < values.size(); i++) {
+        values[i] = 0.25 * double(i) - 100.0;
+    }
+
+    for (auto order : {Base::Stream::LittleEndian, Base::Stream::BigEndian}) {
+        // Act
+        std::ostringstream single;
+        Base::OutputStream outSingle(single);
+        outSingle.setByteOrder(order);
+        for (double it : values) {
+            outSingle << it;
+        }
+
+        std::ostringstream bulk;
+        Base::OutputStream outBulk(bulk);
+        outBulk.setByteOrder(order);
+        outBulk.write(values.data(), values.size());
+
+        // Assert
+        EXPECT_EQ(single.str(), bulk.str());
+    }
+}
+
+TEST(BinaryStreamTest, BulkReadMatchesSingleValues)
+{
+    // Arrange
+    std::vector<uint32_t> values {0, 1, 0x01020304, 0xFFFFFFFF, 0xA0B0C0D0};
+    std::vector<float> floats {0.0F, -1.5F, 3.25F, 1.0e10F};
+
+    for (auto order : {Base::Stream::LittleEndian, Base::Stream::BigEndian}) {
+        std::ostringstream ssO;
+        Base::OutputStream out(ssO);
+        out.setByteOrder(order);
+        for (uint32_t it : values) {
+            out << it;
+        }
+        for (float it : floats) {
+            out << it;
+        }
+
+        // Act
+        std::istringstream ssI(ssO.str());
+        Base::InputStream in(ssI);
+        in.setByteOrder(order);
+        std::vector<uint32_t> resultValues(values.size());
+        std::vector<float> resultFloats(floats.size());
+        in.read(resultValues.data(), resultValues.size());
+        in.read(resultFloats.data(), resultFloats.size());
+
+        // Assert
+        EXPECT_EQ(values, resultValues);
+        EXPECT_EQ(floats, resultFloats);
+    }
+}
+
+TEST(BinaryStreamTest, BlocksMatchSingleValues)
+{
+    // Arrange
+    // more values than fit into a block, and a number that doesn't divide the block size
+    std::vector<Base::Vector3d> values(5000);
+    for (std::size_t i = 0; i < values.size(); i++) {
+        values[i].Set(double(i), -0.5 * double(i), 1.0);
+    }
+
+    for (auto order : {Base::Stream::LittleEndian, Base::Stream::BigEndian}) {
+        std::ostringstream single;
+        Base::OutputStream outSingle(single);
+        outSingle.setByteOrder(order);
+        for (const auto& it : values) {
+            outSingle << float(it.x) << float(it.y) << float(it.z);
+        }
+
+        // Act
+        std::ostringstream blocks;
+        Base::OutputStream outBlocks(blocks);
+        outBlocks.setByteOrder(order);
+        auto append = [](std::vector<float>& block, const Base::Vector3d& vec) {
+            block.insert(block.end(), {float(vec.x), float(vec.y), float(vec.z)});
+        };
+        outBlocks.writeBlocks<float>(values.begin(), values.end(), append);
+
+        std::istringstream ssI(blocks.str());
+        Base::InputStream in(ssI);
+        in.setByteOrder(order);
+        std::vector<Base::Vector3d> result(values.size());
+        in.readBlocks<float>(result.size(), 3, [&result](std::size_t index, const float* it) {
+            result[index].Set(it[0], it[1], it[2]);
+        });
+
+        // Assert
+        EXPECT_EQ(single.str(), blocks.str());
+        EXPECT_EQ(values, result);
+    }
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshRefTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Base::Vector3f p1 {0, 0, 0};
+        Base::Vector3f p2 {1, 0, 0};
+        Base::Vector3f p3 {0, 1, 0};
+        Base::Vector3f p4 {1, 1, 0};
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p3, p2, p4));
+    }
+
+    void TearDown() override
+    {}
+
+    static std::vector<MeshCore::ElementIndex> ToVector(const MeshCore::MeshIndexRange& range)
+    {
+        return {range.begin(), range.end()};
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(MeshRefTest, TestPointToFacets)
+{
+    MeshCore::MeshRefPointToFacets vf(kernel);
+    using Indices = std::vector<MeshCore::ElementIndex>;
+    EXPECT_EQ(ToVector(vf[0]), Indices({0}));
+    EXPECT_EQ(ToVector(vf[1]), Indices({0, 1}));
+    EXPECT_EQ(ToVector(vf[2]), Indices({0, 1}));
+    EXPECT_EQ(ToVector(vf[3]), Indices({1}));
+    EXPECT_EQ(vf.GetIndices(1, 2), Indices({0, 1}));
+    EXPECT_EQ(vf.GetIndices(0, 1, 2), Indices({0}));
+
+    EXPECT_EQ(vf[1].count(1), 1);
+    EXPECT_EQ(vf[0].count(1), 0);
+    EXPECT_EQ(vf[3].find(0), vf[3].end());
+}
+
+TEST_F(MeshRefTest, TestPointToPoints)
+{
+    MeshCore::MeshRefPointToPoints vv(kernel);
+    using Indices = std::vector<MeshCore::ElementIndex>;
+    EXPECT_EQ(ToVector(vv[0]), Indices({1, 2}));
+    EXPECT_EQ(ToVector(vv[1]), Indices({0, 2, 3}));
+    EXPECT_EQ(ToVector(vv[2]), Indices({0, 1, 3}));
+    EXPECT_EQ(ToVector(vv[3]), Indices({1, 2}));
+}
+
+TEST_F(MeshRefTest, TestFacetToFacets)
+{
+    MeshCore::MeshRefFacetToFacets ff(kernel);
+    using Indices = std::vector<MeshCore::ElementIndex>;
+    EXPECT_EQ(ToVector(ff[0]), Indices({0, 1}));
+    EXPECT_EQ(ToVector(ff[1]), Indices({0, 1}));
+}
+
+TEST_F(MeshRefTest, TestModifyPointToFacets)
+{
+    MeshCore::MeshRefPointToFacets vf(kernel);
+    using Indices = std::vector<MeshCore::ElementIndex>;
+
+    vf.AddNeighbour(0, 1);
+    vf.AddNeighbour(0, 1);
+    EXPECT_EQ(ToVector(vf[0]), Indices({0, 1}));
+
+    vf.RemoveNeighbour(1, 0);
+    EXPECT_EQ(ToVector(vf[1]), Indices({1}));
+
+    // grow a list beyond its reserved space
+    for (MeshCore::ElementIndex i = 20; i > 2; i--) {
+        vf.AddNeighbour(2, i);
+    }
+    Indices expected {0, 1};
+    for (MeshCore::ElementIndex i = 3; i <= 20; i++) {
+        expected.push_back(i);
+    }
+    EXPECT_EQ(ToVector(vf[2]), expected);
+    EXPECT_EQ(ToVector(vf[0]), Indices({0, 1}));
+    EXPECT_EQ(ToVector(vf[3]), Indices({1}));
+
+    vf.RemoveFacet(1);
+    EXPECT_EQ(ToVector(vf[1]), Indices({}));
+    EXPECT_EQ(ToVector(vf[3]), Indices({}));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
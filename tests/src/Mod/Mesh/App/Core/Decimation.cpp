@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <QCoreApplication>
+#include <Base/Exception.h>
+#include <Base/Sequencer.h>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Degeneration.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace
+{
+// A sequencer that aborts as soon as the progress is checked
+class AbortingSequencer: public Base::SequencerBase
+{
+protected:
+    void nextStep(bool canAbort) override
+    {
+        if (canAbort) {
+            throw Base::AbortException();
+        }
+    }
+};
+}  // namespace
+
+class DecimationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {}
+
+    void TearDown() override
+    {}
+
+    // Two open unit squares that meet at a sharp edge along the x axis
+    static MeshCore::MeshKernel CreateFold(int n)
+    {
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        float c = std::cos(1.0F);
+        float s = std::sin(1.0F);
+        for (int i = 0; i <= n; i++) {
+            for (int j = -n; j <= n; j++) {
+                float t = float(std::abs(j)) / n;
+                points.push_back(Base::Vector3f(float(i) / n, j < 0 ? -t * c : t * c, t * s));
+            }
+        }
+
+        auto index = [n](int i, int j) {
+            return MeshCore::PointIndex(i * (2 * n + 1) + j + n);
+        };
+        for (int i = 0; i < n; i++) {
+            for (int j = -n; j < n; j++) {
+                MeshCore::PointIndex p00 = index(i, j);
+                MeshCore::PointIndex p10 = index(i + 1, j);
+                MeshCore::PointIndex p01 = index(i, j + 1);
+                MeshCore::PointIndex p11 = index(i + 1, j + 1);
+                facets.push_back(MeshCore::MeshFacet(p00, p10, p11));
+                facets.push_back(MeshCore::MeshFacet(p00, p11, p01));
+            }
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+};
+
+TEST_F(DecimationTest, TestSeamsStayWelded)
+{
+    // large enough to be decimated in parts
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createCube(130);
+    EXPECT_GE(kernel.CountFacets(), 200000);
+
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.simplify(20000);
+
+    EXPECT_LE(kernel.CountFacets(), 20000);
+    EXPECT_FALSE(kernel.HasOpenEdges());
+    EXPECT_FALSE(kernel.HasNonManifolds());
+    EXPECT_TRUE(MeshCore::MeshEvalDuplicatePoints(kernel).Evaluate());
+    EXPECT_NEAR(kernel.GetVolume(), 1.0F, 1e-3F);
+}
+
+TEST_F(DecimationTest, TestSharpEdge)
+{
+    MeshCore::MeshKernel kernel = CreateFold(64);
+    float area = kernel.GetSurface();
+    Base::BoundBox3f box = kernel.GetBoundBox();
+
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.simplify(20);
+
+    // the sharp edge and the boundary keep their shape
+    float minX = 1.0F;
+    float maxX = 0.0F;
+    for (const auto& it : kernel.GetPoints()) {
+        if (std::fabs(it.y) < 1e-5F && std::fabs(it.z) < 1e-5F) {
+            minX = std::min(minX, it.x);
+            maxX = std::max(maxX, it.x);
+        }
+    }
+    EXPECT_FLOAT_EQ(minX, 0.0F);
+    EXPECT_FLOAT_EQ(maxX, 1.0F);
+    EXPECT_NEAR(kernel.GetSurface(), area, 0.01F * area);
+    const Base::BoundBox3f& result = kernel.GetBoundBox();
+    EXPECT_NEAR(result.MinY, box.MinY, 1e-5F);
+    EXPECT_NEAR(result.MaxY, box.MaxY, 1e-5F);
+    EXPECT_NEAR(result.MaxZ, box.MaxZ, 1e-5F);
+}
+
+TEST_F(DecimationTest, TestAbort)
+{
+    // the progress is only reported with a running event loop
+    std::unique_ptr<QCoreApplication> app;
+    int argc = 1;
+    char name[] = "Mesh_tests_run";
+    char* argv[] = {name, nullptr};
+    if (!QCoreApplication::instance()) {
+        app = std::make_unique<QCoreApplication>(argc, argv);
+    }
+
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createCube(130);
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    MeshCore::MeshFacetArray facets = kernel.GetFacets();
+
+    AbortingSequencer seq;
+    MeshCore::MeshSimplify simplify(kernel);
+    EXPECT_THROW(simplify.simplify(20000), Base::AbortException);
+
+    // the mesh is left unchanged
+    ASSERT_EQ(kernel.CountPoints(), points.size());
+    ASSERT_EQ(kernel.CountFacets(), facets.size());
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        const MeshCore::MeshFacet& facet = kernel.GetFacets()[i];
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(facet._aulPoints[j], facets[i]._aulPoints[j]);
+        }
+    }
+    EXPECT_FALSE(kernel.HasOpenEdges());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
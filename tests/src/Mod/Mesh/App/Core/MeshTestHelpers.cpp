@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <map>
+#include <tuple>
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace MeshTestHelpers
+{
+
+MeshCore::MeshKernel createCube(int n, const Base::Vector3f& origin)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    std::map<std::tuple<int, int, int>, MeshCore::PointIndex> index;
+    auto point = [&](int side, int i, int j) {
+        int axis = side / 2;
+        int coord[3];
+        coord[axis] = (side % 2) ? n : 0;
+        coord[(axis + 1) % 3] = i;
+        coord[(axis + 2) % 3] = j;
+        auto key = std::make_tuple(coord[0], coord[1], coord[2]);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            return it->second;
+        }
+        MeshCore::PointIndex pos = points.size();
+        index[key] = pos;
+        points.push_back(
+            origin + Base::Vector3f(float(coord[0]) / n, float(coord[1]) / n, float(coord[2]) / n)
+        );
+        return pos;
+    };
+
+    for (int side = 0; side < 6; side++) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                MeshCore::PointIndex p00 = point(side, i, j);
+                MeshCore::PointIndex p10 = point(side, i + 1, j);
+                MeshCore::PointIndex p01 = point(side, i, j + 1);
+                MeshCore::PointIndex p11 = point(side, i + 1, j + 1);
+                if (side % 2) {
+                    facets.push_back(MeshCore::MeshFacet(p00, p10, p11));
+                    facets.push_back(MeshCore::MeshFacet(p00, p11, p01));
+                }
+                else {
+                    facets.push_back(MeshCore::MeshFacet(p00, p11, p10));
+                    facets.push_back(MeshCore::MeshFacet(p00, p01, p11));
+                }
+            }
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    return kernel;
+}
+
+}  // namespace MeshTestHelpers
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
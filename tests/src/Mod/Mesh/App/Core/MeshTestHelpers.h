@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <Base/Vector3D.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+namespace MeshTestHelpers
+{
+
+/// A closed unit cube at \a origin with an outward oriented n x n grid on each side
+MeshCore::MeshKernel createCube(int n, const Base::Vector3f& origin = Base::Vector3f());
+
+}  // namespace MeshTestHelpers
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/SetOperations.h>
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SetOperationsTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // two unit cubes that overlap in a box of 0.5 x 0.75 x 0.7
+        box1 = MeshTestHelpers::createCube(3);
+        box2 = MeshTestHelpers::createCube(3, Base::Vector3f(0.5F, 0.25F, 0.3F));
+    }
+
+    void TearDown() override
+    {}
+
+    MeshCore::MeshKernel Compute(MeshCore::SetOperations::OperationType type) const
+    {
+        MeshCore::MeshKernel result;
+        MeshCore::SetOperations setOp(box1, box2, result, type);
+        setOp.Do();
+        return result;
+    }
+
+    MeshCore::MeshKernel box1;
+    MeshCore::MeshKernel box2;
+};
+
+TEST_F(SetOperationsTest, TestUnion)
+{
+    MeshCore::MeshKernel result = Compute(MeshCore::SetOperations::Union);
+    EXPECT_FALSE(result.HasOpenEdges());
+    EXPECT_FALSE(result.HasNonManifolds());
+    EXPECT_NEAR(result.GetVolume(), 1.7375F, 1e-4F);
+}
+
+TEST_F(SetOperationsTest, TestIntersect)
+{
+    MeshCore::MeshKernel result = Compute(MeshCore::SetOperations::Intersect);
+    EXPECT_FALSE(result.HasOpenEdges());
+    EXPECT_FALSE(result.HasNonManifolds());
+    EXPECT_NEAR(result.GetVolume(), 0.2625F, 1e-4F);
+}
+
+TEST_F(SetOperationsTest, TestDifference)
+{
+    MeshCore::MeshKernel result = Compute(MeshCore::SetOperations::Difference);
+    EXPECT_FALSE(result.HasOpenEdges());
+    EXPECT_FALSE(result.HasNonManifolds());
+    EXPECT_NEAR(result.GetVolume(), 0.7375F, 1e-4F);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SmoothingTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a flat 4x4 grid with two raised inner points
+        auto point = [](int i, int j) {
+            float z = (i == 1 && (j == 1 || j == 2)) ? 1.0F : 0.0F;
+            return Base::Vector3f(float(i), float(j), z);
+        };
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                kernel.AddFacet(
+                    MeshCore::MeshGeomFacet(point(i, j), point(i + 1, j), point(i, j + 1))
+                );
+                kernel.AddFacet(
+                    MeshCore::MeshGeomFacet(point(i, j + 1), point(i + 1, j), point(i + 1, j + 1))
+                );
+            }
+        }
+    }
+
+    void TearDown() override
+    {}
+
+    MeshCore::PointIndex FindPoint(float x, float y) const
+    {
+        const MeshCore::MeshPointArray& points = kernel.GetPoints();
+        for (MeshCore::PointIndex i = 0; i < points.size(); i++) {
+            if (points[i].x == x && points[i].y == y) {
+                return i;
+            }
+        }
+        return MeshCore::POINT_INDEX_MAX;
+    }
+
+    float MaxHeight() const
+    {
+        float height = 0.0F;
+        for (const auto& it : kernel.GetPoints()) {
+            height = std::max(height, it.z);
+        }
+        return height;
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(SmoothingTest, TestLaplace)
+{
+    MeshCore::PointIndex p1 = FindPoint(1, 1);
+    MeshCore::PointIndex p2 = FindPoint(1, 2);
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.SetLambda(0.5);
+    smooth.Smooth(1);
+
+    // both points are moved from the original coordinates
+    EXPECT_FLOAT_EQ(kernel.GetPoint(p1).z, 1.0F - 0.5F * 5.0F / 6.0F);
+    EXPECT_FLOAT_EQ(kernel.GetPoint(p2).z, 1.0F - 0.5F * 5.0F / 6.0F);
+
+    // border points are kept
+    EXPECT_FLOAT_EQ(kernel.GetPoint(FindPoint(0, 1)).z, 0.0F);
+    EXPECT_FLOAT_EQ(kernel.GetPoint(FindPoint(3, 3)).z, 0.0F);
+}
+
+TEST_F(SmoothingTest, TestLaplacePoints)
+{
+    MeshCore::PointIndex p1 = FindPoint(1, 1);
+    MeshCore::PointIndex p2 = FindPoint(1, 2);
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.SetLambda(0.5);
+    smooth.SmoothPoints(3, {p1});
+
+    EXPECT_LT(kernel.GetPoint(p1).z, 1.0F);
+    EXPECT_FLOAT_EQ(kernel.GetPoint(p2).z, 1.0F);
+}
+
+TEST_F(SmoothingTest, TestTaubin)
+{
+    MeshCore::TaubinSmoothing smooth(kernel);
+    smooth.Smooth(4);
+    EXPECT_LT(MaxHeight(), 1.0F);
+    EXPECT_GT(MaxHeight(), 0.0F);
+}
+
+TEST_F(SmoothingTest, TestPlaneFit)
+{
+    MeshCore::PlaneFitSmoothing smooth(kernel);
+    smooth.Smooth(2);
+    EXPECT_LT(MaxHeight(), 1.0F);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Mod/Points/App/PointTiles.h>
+#include <Mod/Points/App/PointsAlgos.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointTilesTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        tmp.setFile(Base::FileInfo::getTempFileName());
+
+        // a regular 20x20x20 grid of points
+        for (int i = 0; i < 20; i++) {
+            for (int j = 0; j < 20; j++) {
+                for (int k = 0; k < 20; k++) {
+                    points.emplace_back(float(i), float(j), float(k));
+                }
+            }
+        }
+
+        Points::PointTilesWriter writer(getFileName(), 100);
+        writer.add(points);
+        writer.finish();
+    }
+
+    void TearDown() override
+    {
+        tmp.deleteFile();
+    }
+
+    std::string getFileName() const
+    {
+        return tmp.filePath();
+    }
+    const std::vector<Base::Vector3f>& getPoints() const
+    {
+        return points;
+    }
+
+private:
+    std::vector<Base::Vector3f> points;
+    Base::FileInfo tmp;
+};
+
+TEST_F(PointTilesTest, TestTiles)
+{
+    Points::PointTiles tiles(getFileName());
+    EXPECT_EQ(tiles.countPoints(), getPoints().size());
+    EXPECT_GT(tiles.countTiles(), 1);
+
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i < tiles.countTiles(); i++) {
+        const Points::PointTiles::Tile& tile = tiles.getTile(i);
+        EXPECT_LE(tile.count, 100);
+        EXPECT_EQ(tile.offset, count);
+        count += tile.count;
+
+        auto kernel = tiles.getTilePoints(i);
+        EXPECT_EQ(kernel->size(), tile.count);
+        for (const auto& it : kernel->getBasicPoints()) {
+            EXPECT_TRUE(tile.box.IsInBox(it));
+        }
+    }
+    EXPECT_EQ(count, getPoints().size());
+}
+
+TEST_F(PointTilesTest, TestResidentTiles)
+{
+    // only a single tile stays resident
+    Points::PointTiles tiles(getFileName(), 1);
+    auto kernel1 = tiles.getTilePoints(0);
+    EXPECT_EQ(tiles.getTilePoints(0), kernel1);
+
+    // the first tile falls out of the cache
+    tiles.getTilePoints(1);
+    auto kernel2 = tiles.getTilePoints(0);
+    EXPECT_NE(kernel2, kernel1);
+    EXPECT_EQ(kernel2->getBasicPoints(), kernel1->getBasicPoints());
+}
+
+TEST_F(PointTilesTest, TestReadPoints)
+{
+    Points::PointTiles tiles(getFileName());
+    Base::BoundBox3f box(2.5F, 2.5F, 2.5F, 7.5F, 7.5F, 7.5F);
+    Points::PointKernel kernel;
+    tiles.readPoints(box, kernel);
+    EXPECT_EQ(kernel.size(), 125);
+    for (const auto& it : kernel.getBasicPoints()) {
+        EXPECT_TRUE(box.IsInBox(it));
+    }
+}
+
+TEST_F(PointTilesTest, TestReadSample)
+{
+    Points::PointTiles tiles(getFileName());
+    Points::PointKernel kernel;
+    tiles.readSample(1000, kernel);
+    EXPECT_EQ(kernel.size(), 1000);
+
+    Points::PointKernel all;
+    tiles.readSample(100000, all);
+    EXPECT_EQ(all.size(), getPoints().size());
+}
+
+TEST_F(PointTilesTest, TestInvalidFile)
+{
+    Base::FileInfo fi(Base::FileInfo::getTempFileName());
+    Base::ofstream str(fi, std::ios::out | std::ios::binary);
+    str << "no tile file but long enough to contain a header, which is 56 bytes";
+    str.close();
+    EXPECT_THROW(Points::PointTiles tiles(fi.filePath()), Base::BadFormatError);
+    fi.deleteFile();
+}
+
+TEST_F(PointTilesTest, TestOversizedTile)
+{
+    // points that cannot be split end up in a single tile of any size
+    Base::FileInfo fi(Base::FileInfo::getTempFileName());
+    std::vector<Base::Vector3f> same(5000, Base::Vector3f(1.0F, 2.0F, 3.0F));
+    same.emplace_back(4.0F, 5.0F, 6.0F);
+    Points::PointTilesWriter writer(fi.filePath(), 100);
+    writer.add(same);
+    writer.finish();
+
+    Points::PointTiles tiles(fi.filePath());
+    EXPECT_EQ(tiles.countPoints(), same.size());
+    Points::PointKernel all;
+    tiles.readSample(100000, all);
+    EXPECT_EQ(all.size(), same.size());
+    fi.deleteFile();
+}
+
+TEST_F(PointTilesTest, TestNaNPoints)
+{
+    // points without valid coordinates are skipped
+    Base::FileInfo fi(Base::FileInfo::getTempFileName());
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    float inf = std::numeric_limits<float>::infinity();
+    Points::PointTilesWriter writer(fi.filePath(), 100);
+    writer.add(Base::Vector3f(nan, nan, nan));
+    writer.add(getPoints());
+    writer.add(Base::Vector3f(0.0F, nan, 1.0F));
+    writer.add(Base::Vector3f(inf, 0.0F, 0.0F));
+    writer.finish();
+
+    Points::PointTiles tiles(fi.filePath());
+    EXPECT_EQ(tiles.countPoints(), getPoints().size());
+    EXPECT_GT(tiles.countTiles(), 1);
+    for (std::size_t i = 0; i < tiles.countTiles(); i++) {
+        const Points::PointTiles::Tile& tile = tiles.getTile(i);
+        EXPECT_LE(tile.count, 100);
+        EXPECT_GE(tile.box.MinX, 0.0F);
+        EXPECT_LE(tile.box.MaxX, 19.0F);
+    }
+    fi.deleteFile();
+}
+
+TEST_F(PointTilesTest, TestReadTiles)
+{
+    Base::FileInfo ply(Base::FileInfo::getTempFileName() + std::string(".ply"));
+    Base::ofstream str(ply, std::ios::out);
+    str << "ply\nformat ascii 1.0\nelement vertex " << getPoints().size() << "\n"
+        << "property float x\nproperty float y\nproperty float z\nend_header\n";
+    for (const auto& it : getPoints()) {
+        str << it.x << " " << it.y << " " << it.z << "\n";
+    }
+    str.close();
+
+    // the reader passes the points to the tiles without keeping them
+    Base::FileInfo fi(Base::FileInfo::getTempFileName());
+    Points::PlyReader reader;
+    Points::PointTilesWriter writer(fi.filePath(), 100);
+    reader.readTiles(ply.filePath(), writer);
+    writer.finish();
+    EXPECT_EQ(reader.getPoints().size(), 0);
+
+    Points::PointTiles tiles(fi.filePath());
+    EXPECT_EQ(tiles.countPoints(), getPoints().size());
+    ply.deleteFile();
+    fi.deleteFile();
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
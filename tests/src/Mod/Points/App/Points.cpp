@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
 #include <Base/FileInfo.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
@@ -240,4 +242,32 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestPCDWithNaN)
+{
+    // invalid points of a structured cloud are written as 'nan'
+    std::vector<Base::Vector3f> points = getKernel().getBasicPoints();
+    points[2].x = std::numeric_limits<float>::quiet_NaN();
+    points[2].y = std::numeric_limits<float>::quiet_NaN();
+    points[2].z = std::numeric_limits<float>::quiet_NaN();
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(points);
+
+    std::string name = getFileName();
+    Points::PcdWriter writer(kernel);
+    writer.setWidth(4);
+    writer.setHeight(2);
+    writer.write(name);
+
+    Points::PcdReader reader;
+    reader.read(name);
+
+    EXPECT_TRUE(reader.isStructured());
+    const std::vector<Base::Vector3f>& read = reader.getPoints().getBasicPoints();
+    ASSERT_EQ(read.size(), points.size());
+    EXPECT_TRUE(std::isnan(read[2].x));
+    EXPECT_TRUE(std::isnan(read[2].y));
+    EXPECT_TRUE(std::isnan(read[2].z));
+    EXPECT_EQ(read[3], points[3]);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
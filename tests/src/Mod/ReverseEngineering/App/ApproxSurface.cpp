@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <Geom_BSplineSurface.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <Mod/ReverseEngineering/App/ApproxSurface.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class ApproxSurfaceTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {}
+
+    void TearDown() override
+    {}
+
+    // A bicubic B-spline surface over [0,1] x [0,1] with uniform knots. The x and y values
+    // of the control points are the Greville abscissae, so that x = u and y = v.
+    static Handle(Geom_BSplineSurface) CreateSurface(int numPoles)
+    {
+        const int degree = 3;
+        const int numKnots = numPoles - degree + 1;
+        TColStd_Array1OfReal knots(1, numKnots);
+        TColStd_Array1OfInteger mults(1, numKnots);
+        for (int i = 1; i <= numKnots; i++) {
+            knots(i) = double(i - 1) / (numKnots - 1);
+            mults(i) = 1;
+        }
+        mults(1) = degree + 1;
+        mults(numKnots) = degree + 1;
+
+        std::vector<double> flatKnots;
+        for (int i = 1; i <= numKnots; i++) {
+            flatKnots.insert(flatKnots.end(), mults(i), knots(i));
+        }
+        std::vector<double> greville;
+        for (int i = 0; i < numPoles; i++) {
+            greville.push_back((flatKnots[i + 1] + flatKnots[i + 2] + flatKnots[i + 3]) / 3.0);
+        }
+
+        TColgp_Array2OfPnt poles(1, numPoles, 1, numPoles);
+        for (int i = 0; i < numPoles; i++) {
+            for (int j = 0; j < numPoles; j++) {
+                double z = 0.2 * std::sin(double(i)) * std::cos(0.7 * j);
+                poles(i + 1, j + 1) = gp_Pnt(greville[i], greville[j], z);
+            }
+        }
+
+        return new Geom_BSplineSurface(poles, knots, knots, mults, mults, degree, degree);
+    }
+};
+
+TEST_F(ApproxSurfaceTest, TestSparseUnevenSampling)
+{
+    Handle(Geom_BSplineSurface) surface = CreateSurface(8);
+
+    // Dense and uneven in the lower left quarter, a few points along two edges and the
+    // opposite corner. Most control points of the upper right part have no points in
+    // their support.
+    std::vector<gp_Pnt> samples;
+    for (int i = 0; i <= 20; i++) {
+        for (int j = 0; j <= 20; j++) {
+            samples.push_back(surface->Value(0.5 * i * i / 400.0, 0.5 * j / 20.0));
+        }
+    }
+    for (int i = 0; i <= 10; i++) {
+        samples.push_back(surface->Value(0.5 + 0.05 * i, 0.0));
+        samples.push_back(surface->Value(0.0, 0.5 + 0.05 * i));
+    }
+    samples.push_back(surface->Value(1.0, 1.0));
+
+    TColgp_Array1OfPnt points(0, int(samples.size()) - 1);
+    for (std::size_t i = 0; i < samples.size(); i++) {
+        points(int(i)) = samples[i];
+    }
+
+    Reen::BSplineParameterCorrection approx(4, 4, 8, 8);
+    approx.SetUV(Base::Vector3d(1.0, 0.0, 0.0), Base::Vector3d(0.0, 1.0, 0.0));
+    Handle(Geom_BSplineSurface) fitted = approx.CreateSurface(points, 5, true, 1.0);
+    ASSERT_FALSE(fitted.IsNull());
+
+    for (int i = 1; i <= fitted->NbUPoles(); i++) {
+        for (int j = 1; j <= fitted->NbVPoles(); j++) {
+            const gp_Pnt& pole = fitted->Pole(i, j);
+            EXPECT_TRUE(std::isfinite(pole.X()) && std::isfinite(pole.Y())
+                        && std::isfinite(pole.Z()));
+        }
+    }
+
+    // the fitted surface reproduces the known one at the points
+    for (const auto& it : samples) {
+        gp_Pnt pnt = fitted->Value(it.X(), it.Y());
+        EXPECT_LT(pnt.Distance(it), 1e-4);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -50,3 +50,65 @@ TEST_F(GCSTest, clearConstraints)  // NOLINT
     // Assert
     EXPECT_EQ(0, System()->getNumberOfConstraints());
 }
+
+TEST_F(GCSTest, restoreDiagnosisAfterValueChange)  // NOLINT
+{
+    // Arrange
+    std::vector<double> values {0.0, 0.0, 3.0, 4.0};
+    double xCoord = 0.0;
+    double distance = 5.0;
+    GCS::Point p1;
+    GCS::Point p2;
+    p1.x = &values[0];
+    p1.y = &values[1];
+    p2.x = &values[2];
+    p2.y = &values[3];
+    GCS::VEC_pD params {&values[0], &values[1], &values[2], &values[3]};
+
+    System()->addConstraintCoordinateX(p1, &xCoord, 1);
+    System()->addConstraintP2PDistance(p1, p2, &distance, 2);
+    System()->declareUnknowns(params);
+    System()->initSolution();
+    GCS::SavedDiagnosis saved;
+    ASSERT_TRUE(System()->saveDiagnosis(saved));
+
+    // Act
+    System()->clear();
+    distance = 7.0;
+    System()->addConstraintCoordinateX(p1, &xCoord, 1);
+    System()->addConstraintP2PDistance(p1, p2, &distance, 2);
+    System()->declareUnknowns(params);
+    bool restored = System()->restoreDiagnosis(saved);
+    System()->initSolution();
+
+    // Assert
+    EXPECT_TRUE(restored);
+    EXPECT_EQ(System()->dofsNumber(), 2);
+    EXPECT_EQ(System()->solve(), GCS::Success);
+    System()->applySolution();
+    EXPECT_NEAR(std::hypot(values[2] - values[0], values[3] - values[1]), 7.0, 1e-8);
+}
+
+TEST_F(GCSTest, noSavedDiagnosisWithRedundantConstraints)  // NOLINT
+{
+    // Arrange
+    std::vector<double> values {0.0, 0.0};
+    double xCoord = 0.0;
+    GCS::Point p1;
+    p1.x = &values[0];
+    p1.y = &values[1];
+    GCS::VEC_pD params {&values[0], &values[1]};
+
+    System()->addConstraintCoordinateX(p1, &xCoord, 1);
+    System()->addConstraintCoordinateX(p1, &xCoord, 2);
+    System()->declareUnknowns(params);
+    System()->initSolution();
+
+    // Act
+    GCS::SavedDiagnosis saved;
+    bool isSaved = System()->saveDiagnosis(saved);
+
+    // Assert
+    EXPECT_TRUE(System()->hasRedundant());
+    EXPECT_FALSE(isSaved);
+}